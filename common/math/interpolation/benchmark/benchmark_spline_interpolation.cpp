@@ -0,0 +1,131 @@
+// Copyright 2021 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "interpolation/spline_interpolation.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+namespace
+{
+constexpr size_t num_base = 1000;
+constexpr size_t num_query = 2000;
+constexpr size_t num_channels = 4;  // x, y, z and velocity
+
+struct Inputs
+{
+  std::vector<double> base_keys;
+  std::vector<std::vector<double>> base_values{num_channels};
+  std::vector<double> query_keys;
+
+  // uniform keys, where slerp() and SplineInterpolation give the same values
+  Inputs()
+  {
+    std::mt19937 engine(0);
+    std::uniform_real_distribution<double> noise(-0.1, 0.1);
+    for (size_t i = 0; i < num_base; ++i) {
+      const double s = static_cast<double>(i);
+      base_keys.push_back(s);
+      base_values.at(0).push_back(s * std::cos(0.01 * s));
+      base_values.at(1).push_back(s * std::sin(0.01 * s));
+      base_values.at(2).push_back(noise(engine));
+      base_values.at(3).push_back(10.0 + noise(engine));
+    }
+    for (size_t i = 0; i < num_query; ++i) {
+      query_keys.push_back(base_keys.back() * static_cast<double>(i) / (num_query - 1));
+    }
+  }
+};
+
+const Inputs & getInputs()
+{
+  static const Inputs inputs;
+  return inputs;
+}
+}  // namespace
+
+static void Slerp(benchmark::State & state)
+{
+  const auto & in = getInputs();
+  for (auto _ : state) {
+    for (const auto & values : in.base_values) {
+      benchmark::DoNotOptimize(interpolation::slerp(in.base_keys, values, in.query_keys));
+    }
+  }
+}
+BENCHMARK(Slerp);
+
+static void SplineInterpolationValues(benchmark::State & state)
+{
+  const auto & in = getInputs();
+  for (auto _ : state) {
+    const interpolation::SplineInterpolation spline(in.base_keys, in.base_values);
+    benchmark::DoNotOptimize(spline.getValues(in.query_keys));
+  }
+
+  // the largest difference from slerp()
+  double max_diff = 0.0;
+  const interpolation::SplineInterpolation spline(in.base_keys, in.base_values);
+  const auto spline_values = spline.getValues(in.query_keys);
+  for (size_t channel = 0; channel < num_channels; ++channel) {
+    const auto slerp_values =
+      interpolation::slerp(in.base_keys, in.base_values.at(channel), in.query_keys);
+    for (size_t i = 0; i < num_query; ++i) {
+      max_diff = std::max(max_diff, std::abs(slerp_values.at(i) - spline_values.at(channel).at(i)));
+    }
+  }
+  state.counters["max_diff"] = max_diff;
+}
+BENCHMARK(SplineInterpolationValues);
+
+// fit with the keys factored once
+static void SplineInterpolationFit(benchmark::State & state)
+{
+  const auto & in = getInputs();
+  interpolation::SplineInterpolation spline(in.base_keys);
+  for (auto _ : state) {
+    spline.fit(in.base_values);
+    benchmark::DoNotOptimize(spline.getCoefficients(0).a.back());
+  }
+}
+BENCHMARK(SplineInterpolationFit);
+
+static void SplineInterpolationEvaluate(benchmark::State & state)
+{
+  const auto & in = getInputs();
+  const interpolation::SplineInterpolation spline(in.base_keys, in.base_values);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(spline.getValues(in.query_keys));
+  }
+}
+BENCHMARK(SplineInterpolationEvaluate);
+
+// with the 1st and 2nd derivatives
+static void SplineInterpolationDiff(benchmark::State & state)
+{
+  const auto & in = getInputs();
+  for (auto _ : state) {
+    const interpolation::SplineInterpolation spline(in.base_keys, in.base_values);
+    std::vector<std::vector<double>> values;
+    std::vector<std::vector<double>> diff_values;
+    std::vector<std::vector<double>> quad_diff_values;
+    spline.evaluate(in.query_keys, &values, &diff_values, &quad_diff_values);
+    benchmark::DoNotOptimize(quad_diff_values);
+  }
+}
+BENCHMARK(SplineInterpolationDiff);
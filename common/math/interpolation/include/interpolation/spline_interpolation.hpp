@@ -43,6 +43,65 @@ struct MultiSplineCoef
 std::vector<double> slerp(
   const std::vector<double> & base_keys, const std::vector<double> & base_values,
   const std::vector<double> & query_keys);
+
+/**
+ * @brief Spline interpolation of several channels sharing the same base keys.
+ *
+ * The tridiagonal system of the natural spline only depends on the base keys, so it is factored
+ * once in the constructor and every channel given to fit() is solved with the stored
+ * factorization. Values and derivatives of all channels are evaluated for a sorted batch of query
+ * keys with one walk over the base keys.
+ * NOTE: The forward sweep of slerp() divides by the super-diagonal element of the previous row,
+ *       so its result differs from this class when the intervals of base keys are not uniform.
+ */
+class SplineInterpolation
+{
+public:
+  explicit SplineInterpolation(const std::vector<double> & base_keys);
+  SplineInterpolation(
+    const std::vector<double> & base_keys, const std::vector<std::vector<double>> & base_values);
+
+  /**
+   * @brief replace the channels with the given ones, each of which has the size of base keys
+   */
+  void fit(const std::vector<std::vector<double>> & base_values);
+
+  size_t getNumChannels() const { return coefs_.size(); }
+  const std::vector<double> & getBaseKeys() const { return base_keys_; }
+  const MultiSplineCoef & getCoefficients(const size_t channel) const { return coefs_.at(channel); }
+
+  /**
+   * @brief evaluate all channels at the sorted query keys. Each output is resized to
+   *        [channel][query] and skipped when it is nullptr.
+   */
+  void evaluate(
+    const std::vector<double> & query_keys, std::vector<std::vector<double>> * values,
+    std::vector<std::vector<double>> * diff_values = nullptr,
+    std::vector<std::vector<double>> * quad_diff_values = nullptr) const;
+
+  std::vector<std::vector<double>> getValues(const std::vector<double> & query_keys) const;
+  std::vector<std::vector<double>> getDiffValues(const std::vector<double> & query_keys) const;
+  std::vector<std::vector<double>> getQuadDiffValues(const std::vector<double> & query_keys) const;
+
+private:
+  std::vector<double> base_keys_;
+  std::vector<double> diff_keys_;      // N
+  std::vector<double> inv_diff_keys_;  // N
+  // forward sweep of the tridiagonal matrix (N-1 rows): off-diagonal elements, inverse of the
+  // denominators and coefficients of the next unknown
+  std::vector<double> tdma_a_;
+  std::vector<double> tdma_inv_den_;
+  std::vector<double> tdma_p_;
+
+  std::vector<MultiSplineCoef> coefs_;
+
+  // workspace of fitChannel()
+  std::vector<double> slopes_;
+  std::vector<double> v_;
+  std::vector<double> q_;
+
+  void fitChannel(const std::vector<double> & base_values, MultiSplineCoef & multi_spline_coef);
+};
 }  // namespace interpolation
 
 #endif  // INTERPOLATION__SPLINE_INTERPOLATION_HPP_
@@ -16,6 +16,8 @@
 
 #include "interpolation/interpolation_utils.hpp"
 
+#include <stdexcept>
+#include <string>
 #include <vector>
 
 namespace
@@ -166,4 +168,175 @@ std::vector<double> slerp(
   // interpolate base_keys at query_keys
   return getSplineInterpolatedValues(base_keys, query_keys, multi_spline_coef);
 }
+
+SplineInterpolation::SplineInterpolation(const std::vector<double> & base_keys)
+: base_keys_(base_keys)
+{
+  if (base_keys_.size() < 2) {
+    throw std::invalid_argument(
+      "The size of points is less than 2. base_keys.size() = " +
+      std::to_string(base_keys_.size()));
+  }
+  if (!interpolation_utils::isIncreasing(base_keys_)) {
+    throw std::invalid_argument("base_keys is not sorted.");
+  }
+
+  const size_t num_base = base_keys_.size();  // N+1
+  diff_keys_.resize(num_base - 1);
+  inv_diff_keys_.resize(num_base - 1);
+  for (size_t i = 0; i < num_base - 1; ++i) {
+    diff_keys_[i] = base_keys_[i + 1] - base_keys_[i];
+    inv_diff_keys_[i] = 1.0 / diff_keys_[i];
+  }
+
+  // forward sweep of the tridiagonal matrix algorithm, which only depends on the keys
+  if (num_base <= 2) {
+    return;
+  }
+  const size_t num_row = num_base - 2;  // N-1
+  tdma_a_.resize(num_row - 1);
+  tdma_inv_den_.resize(num_row);
+  tdma_p_.resize(num_row - 1);
+  for (size_t i = 0; i < num_row; ++i) {
+    const double b = 2 * (diff_keys_[i] + diff_keys_[i + 1]);
+    const double den = i == 0 ? b : b + tdma_a_[i - 1] * tdma_p_[i - 1];
+    tdma_inv_den_[i] = 1.0 / den;
+    if (i + 1 < num_row) {
+      // the matrix is symmetric: a_i = c_i = h_{i+1}
+      tdma_a_[i] = diff_keys_[i + 1];
+      tdma_p_[i] = -tdma_a_[i] / den;
+    }
+  }
+}
+
+SplineInterpolation::SplineInterpolation(
+  const std::vector<double> & base_keys, const std::vector<std::vector<double>> & base_values)
+: SplineInterpolation(base_keys)
+{
+  fit(base_values);
+}
+
+void SplineInterpolation::fit(const std::vector<std::vector<double>> & base_values)
+{
+  const size_t num_base = base_keys_.size();  // N+1
+  for (const auto & values : base_values) {
+    if (values.size() != num_base) {
+      throw std::invalid_argument("The size of base_keys and base_values are not the same.");
+    }
+  }
+
+  // reuse the coefficients of the previous fit
+  coefs_.resize(base_values.size(), MultiSplineCoef(num_base - 1));
+  for (size_t channel = 0; channel < base_values.size(); ++channel) {
+    fitChannel(base_values[channel], coefs_[channel]);
+  }
+}
+
+void SplineInterpolation::fitChannel(
+  const std::vector<double> & base_values, MultiSplineCoef & multi_spline_coef)
+{
+  const size_t num_base = base_keys_.size();  // N+1
+
+  slopes_.resize(num_base - 1);  // N
+  for (size_t i = 0; i < num_base - 1; ++i) {
+    slopes_[i] = (base_values[i + 1] - base_values[i]) * inv_diff_keys_[i];
+  }
+
+  // second derivatives at the base keys, with zero at both ends
+  v_.assign(num_base, 0.0);
+  if (num_base > 2) {
+    const size_t num_row = num_base - 2;  // N-1
+    q_.resize(num_row);
+    for (size_t i = 0; i < num_row; ++i) {
+      const double d = 6.0 * (slopes_[i + 1] - slopes_[i]);
+      q_[i] = (i == 0 ? d : d - tdma_a_[i - 1] * q_[i - 1]) * tdma_inv_den_[i];
+    }
+
+    v_[num_row] = q_[num_row - 1];
+    for (size_t j = num_row - 1; j-- > 0;) {
+      v_[j + 1] = tdma_p_[j] * v_[j + 2] + q_[j];
+    }
+  }
+
+  for (size_t i = 0; i < num_base - 1; ++i) {
+    multi_spline_coef.a[i] = (v_[i + 1] - v_[i]) * inv_diff_keys_[i] / 6.0;
+    multi_spline_coef.b[i] = v_[i] / 2.0;
+    multi_spline_coef.c[i] = slopes_[i] - diff_keys_[i] * (2 * v_[i] + v_[i + 1]) / 6.0;
+    multi_spline_coef.d[i] = base_values[i];
+  }
+}
+
+void SplineInterpolation::evaluate(
+  const std::vector<double> & query_keys, std::vector<std::vector<double>> * values,
+  std::vector<std::vector<double>> * diff_values,
+  std::vector<std::vector<double>> * quad_diff_values) const
+{
+  if (!query_keys.empty()) {
+    if (!interpolation_utils::isNotDecreasing(query_keys)) {
+      throw std::invalid_argument("query_keys is not sorted.");
+    }
+    if (query_keys.front() < base_keys_.front() || base_keys_.back() < query_keys.back()) {
+      throw std::invalid_argument("query_keys is out of base_keys");
+    }
+  }
+
+  for (auto * output : {values, diff_values, quad_diff_values}) {
+    if (output) {
+      output->assign(coefs_.size(), std::vector<double>(query_keys.size()));
+    }
+  }
+
+  // segment of each query key, shared by all channels
+  std::vector<size_t> segment_indices(query_keys.size());
+  std::vector<double> segment_offsets(query_keys.size());
+  size_t j = 0;
+  for (size_t k = 0; k < query_keys.size(); ++k) {
+    while (base_keys_[j + 1] < query_keys[k]) {
+      ++j;
+    }
+    segment_indices[k] = j;
+    segment_offsets[k] = query_keys[k] - base_keys_[j];
+  }
+
+  for (size_t channel = 0; channel < coefs_.size(); ++channel) {
+    const auto & coef = coefs_[channel];
+    for (size_t k = 0; k < query_keys.size(); ++k) {
+      const size_t i = segment_indices[k];
+      const double ds = segment_offsets[k];
+      if (values) {
+        (*values)[channel][k] = coef.d[i] + (coef.c[i] + (coef.b[i] + coef.a[i] * ds) * ds) * ds;
+      }
+      if (diff_values) {
+        (*diff_values)[channel][k] = coef.c[i] + (2.0 * coef.b[i] + 3.0 * coef.a[i] * ds) * ds;
+      }
+      if (quad_diff_values) {
+        (*quad_diff_values)[channel][k] = 2.0 * coef.b[i] + 6.0 * coef.a[i] * ds;
+      }
+    }
+  }
+}
+
+std::vector<std::vector<double>> SplineInterpolation::getValues(
+  const std::vector<double> & query_keys) const
+{
+  std::vector<std::vector<double>> values;
+  evaluate(query_keys, &values);
+  return values;
+}
+
+std::vector<std::vector<double>> SplineInterpolation::getDiffValues(
+  const std::vector<double> & query_keys) const
+{
+  std::vector<std::vector<double>> diff_values;
+  evaluate(query_keys, nullptr, &diff_values);
+  return diff_values;
+}
+
+std::vector<std::vector<double>> SplineInterpolation::getQuadDiffValues(
+  const std::vector<double> & query_keys) const
+{
+  std::vector<std::vector<double>> quad_diff_values;
+  evaluate(query_keys, nullptr, nullptr, &quad_diff_values);
+  return quad_diff_values;
+}
 }  // namespace interpolation
@@ -95,3 +95,102 @@ TEST(spline_interpolation, slerp)
     }
   }
 }
+
+TEST(spline_interpolation, SplineInterpolation)
+{
+  {  // same as slerp for each channel with uniform base keys
+    const std::vector<double> base_keys{0.0, 1.0, 2.0, 3.0, 4.0, 5.0};
+    const std::vector<std::vector<double>> base_values{
+      {-1.2, 0.5, 1.0, 1.2, 2.0, 1.0}, {0.0, 1.5, 3.0, 4.5, 6.0, 7.5}};
+    const std::vector<double> query_keys{0.0, 0.3, 2.0, 2.5, 4.9, 5.0};
+
+    const interpolation::SplineInterpolation spline(base_keys, base_values);
+    const auto query_values = spline.getValues(query_keys);
+    ASSERT_EQ(query_values.size(), 2U);
+    for (size_t channel = 0; channel < base_values.size(); ++channel) {
+      const auto ans = interpolation::slerp(base_keys, base_values.at(channel), query_keys);
+      ASSERT_EQ(query_values.at(channel).size(), ans.size());
+      for (size_t i = 0; i < ans.size(); ++i) {
+        EXPECT_NEAR(query_values.at(channel).at(i), ans.at(i), epsilon);
+      }
+    }
+  }
+
+  {  // natural spline with non-uniform base keys
+    const std::vector<double> base_keys{-1.5, 1.0, 5.0, 10.0, 15.0, 20.0};
+    const std::vector<double> base_values{-1.2, 0.5, 1.0, 1.2, 2.0, 1.0};
+    const std::vector<double> query_keys{-1.5, 0.0, 8.0, 18.0, 20.0};
+    const std::vector<double> ans{-1.2, -0.076114, 1.001217, 1.573640, 1.0};
+
+    const interpolation::SplineInterpolation spline(base_keys, {base_values});
+    const auto query_values = spline.getValues(query_keys).front();
+    for (size_t i = 0; i < ans.size(); ++i) {
+      EXPECT_NEAR(query_values.at(i), ans.at(i), epsilon);
+    }
+  }
+
+  {  // size of base_keys is 2 and 3
+    const std::vector<double> query_keys{0.0, 0.2, 0.7, 1.0};
+    const interpolation::SplineInterpolation spline2({0.0, 1.0}, {{0.0, 1.0}});
+    const auto query_values2 = spline2.getValues(query_keys).front();
+    const auto ans2 = interpolation::slerp({0.0, 1.0}, {0.0, 1.0}, query_keys);
+    for (size_t i = 0; i < ans2.size(); ++i) {
+      EXPECT_NEAR(query_values2.at(i), ans2.at(i), epsilon);
+    }
+
+    // the second derivative at the middle key is 3.0
+    const interpolation::SplineInterpolation spline3({0.0, 1.0, 3.0}, {{0.0, 1.0, 9.0}});
+    EXPECT_NEAR(spline3.getValues({0.7}).front().front(), 0.5215, epsilon);
+    EXPECT_NEAR(spline3.getQuadDiffValues({1.0}).front().front(), 3.0, epsilon);
+  }
+
+  {  // derivatives of a straight line
+    const std::vector<double> base_keys{0.0, 1.0, 2.0, 3.0, 4.0};
+    const std::vector<double> base_values{0.0, 1.5, 3.0, 4.5, 6.0};
+    const std::vector<double> query_keys{0.0, 0.7, 1.9, 4.0};
+
+    const interpolation::SplineInterpolation spline(base_keys, {base_values});
+    std::vector<std::vector<double>> values;
+    std::vector<std::vector<double>> diff_values;
+    std::vector<std::vector<double>> quad_diff_values;
+    spline.evaluate(query_keys, &values, &diff_values, &quad_diff_values);
+    for (size_t i = 0; i < query_keys.size(); ++i) {
+      EXPECT_NEAR(values.front().at(i), 1.5 * query_keys.at(i), epsilon);
+      EXPECT_NEAR(diff_values.front().at(i), 1.5, epsilon);
+      EXPECT_NEAR(quad_diff_values.front().at(i), 0.0, epsilon);
+    }
+  }
+
+  {  // derivatives are continuous at the base keys
+    const std::vector<double> base_keys{-1.5, 1.0, 5.0, 10.0, 15.0, 20.0};
+    const std::vector<double> base_values{-1.2, 0.5, 1.0, 1.2, 2.0, 1.0};
+    const interpolation::SplineInterpolation spline(base_keys, {base_values});
+    constexpr double ds = 1e-7;
+    const std::vector<double> query_keys{5.0 - ds, 5.0 + ds};
+    const auto diff_values = spline.getDiffValues(query_keys).front();
+    const auto quad_diff_values = spline.getQuadDiffValues(query_keys).front();
+    EXPECT_NEAR(diff_values.at(0), diff_values.at(1), 1e-5);
+    EXPECT_NEAR(quad_diff_values.at(0), quad_diff_values.at(1), 1e-5);
+  }
+
+  {  // refit with the same keys
+    const std::vector<double> base_keys{0.0, 1.0, 2.0, 3.0};
+    interpolation::SplineInterpolation spline(base_keys);
+    EXPECT_EQ(spline.getNumChannels(), 0U);
+    spline.fit({{0.0, 1.0, 4.0, 9.0}, {1.0, 1.0, 1.0, 1.0}, {3.0, 2.0, 1.0, 0.0}});
+    EXPECT_EQ(spline.getNumChannels(), 3U);
+    EXPECT_NEAR(spline.getValues({2.5}).at(1).front(), 1.0, epsilon);
+  }
+
+  {  // invalid arguments
+    EXPECT_THROW(interpolation::SplineInterpolation({0.0}), std::invalid_argument);
+    EXPECT_THROW(interpolation::SplineInterpolation({0.0, 2.0, 1.0}), std::invalid_argument);
+    EXPECT_THROW(
+      interpolation::SplineInterpolation({0.0, 1.0, 2.0}, {{0.0, 1.0}}), std::invalid_argument);
+
+    const interpolation::SplineInterpolation spline({0.0, 1.0, 2.0}, {{0.0, 1.0, 0.0}});
+    EXPECT_THROW(spline.getValues({-0.1, 1.0}), std::invalid_argument);
+    EXPECT_THROW(spline.getValues({0.0, 2.1}), std::invalid_argument);
+    EXPECT_THROW(spline.getValues({1.0, 0.5}), std::invalid_argument);
+  }
+}
@@ -55,6 +55,11 @@ private:
   bool8_t m_work_initialized = false;
   // Exitflag
   int64_t m_exitflag;
+  // Sparsity patterns of the current P and A, to check if the workspace can be updated in place
+  CSC_Matrix m_P_csc;
+  CSC_Matrix m_A_csc;
+  // Dual solution of all the constraints of the latest problem solved
+  std::vector<float64_t> m_latest_dual_solution;
 
   // Runs the solver on the stored problem.
   std::tuple<std::vector<float64_t>, std::vector<float64_t>, int64_t, int64_t> solve();
@@ -128,6 +133,21 @@ public:
     const Eigen::MatrixXd & P, const Eigen::MatrixXd & A, const std::vector<float64_t> & q,
     const std::vector<float64_t> & l, const std::vector<float64_t> & u);
 
+  /// \brief Updates the whole problem while keeping the workspace if possible.
+  /// \details When P and A have the same sizes and sparsity patterns as the current problem, only
+  /// \details their values, q and the bounds are updated, which avoids setting up and allocating
+  /// \details a new workspace. The solution of the previous problem is kept as the initial value of
+  /// \details the next solve. Otherwise a new workspace is set up with initializeProblem().
+  /// \return true if the current workspace is reused.
+  bool8_t updateProblem(
+    const Eigen::MatrixXd & P, const Eigen::MatrixXd & A, const std::vector<float64_t> & q,
+    const std::vector<float64_t> & l, const std::vector<float64_t> & u);
+
+  /// \brief Sets the initial primal (n) and dual (m) variables of the next solve.
+  /// \return true if the sizes match the current problem and the variables are set.
+  bool8_t setWarmStart(
+    const std::vector<float64_t> & primal_variables, const std::vector<float64_t> & dual_variables);
+
   // Updates problem parameters while keeping solution in memory.
   //
   // Args:
@@ -150,6 +170,8 @@ public:
   void updateRho(const double rho);
   void updateAlpha(const double alpha);
 
+  /// \brief Get the dual solution of all the (m) constraints of the latest problem solved
+  inline const std::vector<float64_t> & getDualSolution() const { return m_latest_dual_solution; }
   /// \brief Get the number of iteration taken to solve the problem
   inline int64_t getTakenIter() const { return static_cast<int64_t>(m_latest_work_info.iter); }
   /// \brief Get the status message for the latest problem solved
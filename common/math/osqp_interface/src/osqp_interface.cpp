@@ -88,6 +88,46 @@ void OSQPInterface::updateA(const Eigen::MatrixXd & A_new)
   return;
 }
 
+bool8_t OSQPInterface::updateProblem(
+  const Eigen::MatrixXd & P, const Eigen::MatrixXd & A, const std::vector<float64_t> & q,
+  const std::vector<float64_t> & l, const std::vector<float64_t> & u)
+{
+  CSC_Matrix P_csc = calCSCMatrixTrapezoidal(P);
+  CSC_Matrix A_csc = calCSCMatrix(A);
+  const bool8_t is_same_structure = m_work_initialized && P.rows() == m_param_n &&
+                                    A.rows() == static_cast<Eigen::Index>(m_data->m) &&
+                                    P_csc.m_row_idxs == m_P_csc.m_row_idxs &&
+                                    P_csc.m_col_idxs == m_P_csc.m_col_idxs &&
+                                    A_csc.m_row_idxs == m_A_csc.m_row_idxs &&
+                                    A_csc.m_col_idxs == m_A_csc.m_col_idxs;
+  if (!is_same_structure) {
+    initializeProblem(P, A, q, l, u);
+    return false;
+  }
+
+  osqp_update_P_A(
+    m_work, P_csc.m_vals.data(), OSQP_NULL, static_cast<c_int>(P_csc.m_vals.size()),
+    A_csc.m_vals.data(), OSQP_NULL, static_cast<c_int>(A_csc.m_vals.size()));
+  std::vector<float64_t> q_tmp(q.begin(), q.end());
+  osqp_update_lin_cost(m_work, q_tmp.data());
+  updateBounds(l, u);
+  return true;
+}
+
+bool8_t OSQPInterface::setWarmStart(
+  const std::vector<float64_t> & primal_variables, const std::vector<float64_t> & dual_variables)
+{
+  if (
+    !m_work_initialized || static_cast<int64_t>(primal_variables.size()) != m_param_n ||
+    static_cast<c_int>(dual_variables.size()) != m_data->m) {
+    return false;
+  }
+  std::vector<float64_t> x_tmp(primal_variables.begin(), primal_variables.end());
+  std::vector<float64_t> y_tmp(dual_variables.begin(), dual_variables.end());
+  osqp_warm_start(m_work, x_tmp.data(), y_tmp.data());
+  return true;
+}
+
 void OSQPInterface::updateL(const std::vector<double> & l_new)
 {
   std::vector<double> l_tmp(l_new.begin(), l_new.end());
@@ -172,8 +212,10 @@ int64_t OSQPInterface::initializeProblem(
   /*******************
    * SET UP MATRICES
    *******************/
-  CSC_Matrix P_csc = calCSCMatrixTrapezoidal(P);
-  CSC_Matrix A_csc = calCSCMatrix(A);
+  m_P_csc = calCSCMatrixTrapezoidal(P);
+  m_A_csc = calCSCMatrix(A);
+  CSC_Matrix & P_csc = m_P_csc;
+  CSC_Matrix & A_csc = m_A_csc;
   // Dynamic float arrays
   std::vector<float64_t> q_tmp(q.begin(), q.end());
   std::vector<float64_t> l_tmp(l.begin(), l.end());
@@ -205,7 +247,11 @@ int64_t OSQPInterface::initializeProblem(
   m_data->l = l_dyn;
   m_data->u = u_dyn;
 
-  // Setup workspace
+  // Setup workspace, cleaning up the previous one
+  if (m_work) {
+    osqp_cleanup(m_work);
+    m_work = nullptr;
+  }
   m_exitflag = osqp_setup(&m_work, m_data.get(), m_settings.get());
   m_work_initialized = true;
 
@@ -232,6 +278,7 @@ std::tuple<std::vector<float64_t>, std::vector<float64_t>, int64_t, int64_t> OSQ
   float64_t * sol_y = m_work->solution->y;
   std::vector<float64_t> sol_primal(sol_x, sol_x + m_param_n);
   std::vector<float64_t> sol_lagrange_multiplier(sol_y, sol_y + m_param_n);
+  m_latest_dual_solution.assign(sol_y, sol_y + m_data->m);
   // Solver polish status
   int64_t status_polish = m_work->info->status_polish;
   // Solver solution status
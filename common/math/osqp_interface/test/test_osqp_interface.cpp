@@ -88,4 +88,45 @@ TEST(TestOsqpInterface, BasicQp) {
     check_result(result);
   }
 }
+
+TEST(TestOsqpInterface, UpdateProblem) {
+  Eigen::MatrixXd P(2, 2);
+  P << 4, 1, 1, 2;
+  Eigen::MatrixXd A(3, 2);
+  A << 1, 1, 1, 0, 0, 1;
+  std::vector<float64_t> q = {1.0, 1.0};
+  std::vector<float64_t> l = {1.0, 0.0, 0.0};
+  std::vector<float64_t> u = {1.0, 0.7, 0.7};
+
+  autoware::common::osqp::OSQPInterface osqp;
+  // No workspace yet
+  EXPECT_FALSE(osqp.updateProblem(P, A, q, l, u));
+  auto result = osqp.optimize();
+  EXPECT_EQ(std::get<3>(result), 1);
+  EXPECT_NEAR(std::get<0>(result)[0], 0.3, 1e-6);
+  EXPECT_NEAR(std::get<0>(result)[1], 0.7, 1e-6);
+  const auto dual_solution = osqp.getDualSolution();
+  ASSERT_EQ(dual_solution.size(), size_t(3));
+  EXPECT_NEAR(dual_solution[0], -2.9, 1e-6);
+  EXPECT_NEAR(dual_solution[2], 0.2, 1e-6);
+
+  // Same sparsity pattern: the workspace is reused
+  const std::vector<float64_t> q_new = {2.0, 3.0};
+  EXPECT_TRUE(osqp.updateProblem(P, A, q_new, l, u));
+  EXPECT_FALSE(osqp.setWarmStart({0.3}, dual_solution));
+  EXPECT_TRUE(osqp.setWarmStart(std::get<0>(result), dual_solution));
+  result = osqp.optimize();
+  EXPECT_EQ(std::get<3>(result), 1);
+  EXPECT_NEAR(std::get<0>(result)[0], 0.5, 1e-6);
+  EXPECT_NEAR(std::get<0>(result)[1], 0.5, 1e-6);
+
+  // Different sparsity pattern: a new workspace is set up
+  Eigen::MatrixXd A_new = A;
+  A_new(1, 0) = 0.0;
+  EXPECT_FALSE(osqp.updateProblem(P, A_new, q_new, l, u));
+  result = osqp.optimize();
+  EXPECT_EQ(std::get<3>(result), 1);
+  EXPECT_NEAR(std::get<0>(result)[0], 0.5, 1e-6);
+  EXPECT_NEAR(std::get<0>(result)[1], 0.5, 1e-6);
+}
 }  // namespace
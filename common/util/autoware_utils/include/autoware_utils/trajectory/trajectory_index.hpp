@@ -0,0 +1,479 @@
+// Copyright 2021 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef AUTOWARE_UTILS__TRAJECTORY__TRAJECTORY_INDEX_HPP_
+#define AUTOWARE_UTILS__TRAJECTORY__TRAJECTORY_INDEX_HPP_
+
+#include "autoware_utils/geometry/geometry.hpp"
+#include "autoware_utils/math/normalization.hpp"
+#include "autoware_utils/trajectory/trajectory.hpp"
+
+#include <boost/optional.hpp>
+
+#include <tf2/utils.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <limits>
+#include <stdexcept>
+#include <unordered_map>
+#include <vector>
+
+namespace autoware_utils
+{
+/**
+ * @brief Precomputed geometry of the points of a trajectory, path, ...
+ *
+ * Holds the 2d position and yaw of every point, the cumulative arc length from the front point and
+ * the direction and length of every segment, so that the overloads of the functions in
+ * trajectory.hpp taking this index do not touch the message types nor accumulate the arc length
+ * on every call. With a positive grid_cell_size, the points are also bucketed in a coarse grid for
+ * the nearest point search. The index is a snapshot: it has to be rebuilt when the points change.
+ */
+class TrajectoryIndex
+{
+public:
+  TrajectoryIndex() = default;
+
+  template <class T>
+  explicit TrajectoryIndex(const T & points, const double grid_cell_size = 0.0)
+  : grid_cell_size_(grid_cell_size)
+  {
+    x_.reserve(points.size());
+    y_.reserve(points.size());
+    yaw_.reserve(points.size());
+    for (const auto & p : points) {
+      const auto pose = getPose(p);
+      x_.push_back(pose.position.x);
+      y_.push_back(pose.position.y);
+      yaw_.push_back(tf2::getYaw(pose.orientation));
+    }
+
+    arc_length_.resize(x_.size(), 0.0);
+    for (size_t i = 0; i + 1 < x_.size(); ++i) {
+      const double dx = x_.at(i + 1) - x_.at(i);
+      const double dy = y_.at(i + 1) - y_.at(i);
+      segment_dx_.push_back(dx);
+      segment_dy_.push_back(dy);
+      segment_length_.push_back(std::sqrt(dx * dx + dy * dy));
+      arc_length_.at(i + 1) = arc_length_.at(i) + std::hypot(dx, dy);
+    }
+
+    if (grid_cell_size_ > 0.0 && !x_.empty()) {
+      buildGrid();
+    }
+  }
+
+  size_t size() const { return x_.size(); }
+  bool empty() const { return x_.empty(); }
+
+  double getX(const size_t idx) const { return x_.at(idx); }
+  double getY(const size_t idx) const { return y_.at(idx); }
+  double getYaw(const size_t idx) const { return yaw_.at(idx); }
+
+  /**
+   * @brief arc length from the front point to the idx-th point
+   */
+  double getArcLength(const size_t idx) const { return arc_length_.at(idx); }
+  double getTotalArcLength() const { return arc_length_.empty() ? 0.0 : arc_length_.back(); }
+
+  /**
+   * @brief direction (not normalized) and length of the segment from seg_idx to seg_idx + 1
+   */
+  double getSegmentDx(const size_t seg_idx) const { return segment_dx_.at(seg_idx); }
+  double getSegmentDy(const size_t seg_idx) const { return segment_dy_.at(seg_idx); }
+  double getSegmentLength(const size_t seg_idx) const { return segment_length_.at(seg_idx); }
+
+  double calcSquaredDistance2d(const size_t idx, const geometry_msgs::msg::Point & point) const
+  {
+    const auto dx = x_.at(idx) - point.x;
+    const auto dy = y_.at(idx) - point.y;
+    return dx * dx + dy * dy;
+  }
+
+  /**
+   * @brief index of the nearest point, the first one among the nearest points with the same
+   *        distance. Uses the grid when it is built.
+   */
+  size_t findNearestIndex(const geometry_msgs::msg::Point & point) const
+  {
+    if (!grid_.empty()) {
+      size_t min_idx = 0;
+      if (findNearestIndexInGrid(point, min_idx)) {
+        return min_idx;
+      }
+    }
+    return findNearestIndexInRange(point, 0, size());
+  }
+
+  /**
+   * @brief index of the nearest point in [begin_idx, end_idx)
+   */
+  size_t findNearestIndexInRange(
+    const geometry_msgs::msg::Point & point, const size_t begin_idx, const size_t end_idx) const
+  {
+    double min_dist = std::numeric_limits<double>::max();
+    size_t min_idx = begin_idx;
+    for (size_t i = begin_idx; i < end_idx; ++i) {
+      const auto dist = calcSquaredDistance2d(i, point);
+      if (dist < min_dist) {
+        min_dist = dist;
+        min_idx = i;
+      }
+    }
+    return min_idx;
+  }
+
+  /**
+   * @brief index of the segment which contains the given arc length from the front point,
+   *        clamped to the first and the last segment. O(log n).
+   */
+  size_t findSegmentIndexFromArcLength(const double arc_length) const
+  {
+    if (arc_length_.size() < 2) {
+      return 0;
+    }
+    const auto itr = std::upper_bound(arc_length_.begin(), arc_length_.end(), arc_length);
+    const auto idx = static_cast<size_t>(std::distance(arc_length_.begin(), itr));
+    return std::min(std::max(idx, size_t{1}) - 1, arc_length_.size() - 2);
+  }
+
+private:
+  std::vector<double> x_;
+  std::vector<double> y_;
+  std::vector<double> yaw_;
+  std::vector<double> arc_length_;
+  std::vector<double> segment_dx_;
+  std::vector<double> segment_dy_;
+  std::vector<double> segment_length_;
+
+  double grid_cell_size_ = 0.0;
+  std::unordered_map<uint64_t, std::vector<size_t>> grid_;
+  int64_t min_cx_ = 0;
+  int64_t max_cx_ = 0;
+  int64_t min_cy_ = 0;
+  int64_t max_cy_ = 0;
+
+  // also false for non-finite values
+  bool isInGridRange(const double v) const { return std::fabs(v / grid_cell_size_) < 1e9; }
+
+  int64_t toCell(const double v) const
+  {
+    return static_cast<int64_t>(std::floor(v / grid_cell_size_));
+  }
+
+  static uint64_t toKey(const int64_t cx, const int64_t cy)
+  {
+    return (static_cast<uint64_t>(cx) << 32) | (static_cast<uint64_t>(cy) & 0xffffffff);
+  }
+
+  void buildGrid()
+  {
+    for (size_t i = 0; i < size(); ++i) {
+      // points too far away to be bucketed are searched linearly instead
+      if (!isInGridRange(x_.at(i)) || !isInGridRange(y_.at(i))) {
+        grid_.clear();
+        return;
+      }
+      const auto cx = toCell(x_.at(i));
+      const auto cy = toCell(y_.at(i));
+      min_cx_ = i == 0 ? cx : std::min(min_cx_, cx);
+      max_cx_ = i == 0 ? cx : std::max(max_cx_, cx);
+      min_cy_ = i == 0 ? cy : std::min(min_cy_, cy);
+      max_cy_ = i == 0 ? cy : std::max(max_cy_, cy);
+      grid_[toKey(cx, cy)].push_back(i);
+    }
+  }
+
+  // Visits the rings of cells around the point until no unvisited point can be nearer. Gives up
+  // when more cells than points would be visited, e.g. for a point far from the trajectory.
+  bool findNearestIndexInGrid(const geometry_msgs::msg::Point & point, size_t & min_idx) const
+  {
+    if (!isInGridRange(point.x) || !isInGridRange(point.y)) {
+      return false;
+    }
+    const auto cx = toCell(point.x);
+    const auto cy = toCell(point.y);
+    const int64_t max_ring = std::max(
+      std::max(std::abs(cx - min_cx_), std::abs(max_cx_ - cx)),
+      std::max(std::abs(cy - min_cy_), std::abs(max_cy_ - cy)));
+
+    double min_dist = std::numeric_limits<double>::max();
+    bool is_found = false;
+    int64_t num_visited_cells = 0;
+    const auto visit = [&](const int64_t x, const int64_t y) {
+      const auto itr = grid_.find(toKey(x, y));
+      if (itr == grid_.end()) {
+        return;
+      }
+      for (const auto i : itr->second) {
+        const auto dist = calcSquaredDistance2d(i, point);
+        if (dist < min_dist || (dist == min_dist && i < min_idx)) {
+          min_dist = dist;
+          min_idx = i;
+          is_found = true;
+        }
+      }
+    };
+
+    for (int64_t ring = 0; ring <= max_ring; ++ring) {
+      num_visited_cells += ring == 0 ? 1 : 8 * ring;
+      if (num_visited_cells > static_cast<int64_t>(size())) {
+        return false;
+      }
+      if (ring == 0) {
+        visit(cx, cy);
+      } else {
+        for (int64_t d = -ring; d <= ring; ++d) {
+          visit(cx + d, cy - ring);
+          visit(cx + d, cy + ring);
+        }
+        for (int64_t d = -ring + 1; d <= ring - 1; ++d) {
+          visit(cx - ring, cy + d);
+          visit(cx + ring, cy + d);
+        }
+      }
+      // the points out of the visited rings are at least ring * grid_cell_size_ away
+      const double unvisited_dist = static_cast<double>(ring) * grid_cell_size_;
+      if (is_found && min_dist < unvisited_dist * unvisited_dist) {
+        return true;
+      }
+    }
+    return is_found;
+  }
+};
+
+inline void validateNonEmpty(const TrajectoryIndex & index)
+{
+  if (index.empty()) {
+    throw std::invalid_argument("Points is empty.");
+  }
+}
+
+/**
+ * @brief findNearestIndex() with the precomputed index
+ */
+inline size_t findNearestIndex(
+  const TrajectoryIndex & index, const geometry_msgs::msg::Point & point)
+{
+  validateNonEmpty(index);
+
+  return index.findNearestIndex(point);
+}
+
+/**
+ * @brief nearest index searched only within [hint_idx - window, hint_idx + window], e.g. around
+ *        the nearest index of the previous cycle
+ */
+inline size_t findNearestIndex(
+  const TrajectoryIndex & index, const geometry_msgs::msg::Point & point, const size_t hint_idx,
+  const size_t window)
+{
+  validateNonEmpty(index);
+
+  const size_t hint = std::min(hint_idx, index.size() - 1);
+  const size_t begin_idx = hint > window ? hint - window : 0;
+  const size_t end_idx = std::min(index.size(), hint + window + 1);
+  return index.findNearestIndexInRange(point, begin_idx, end_idx);
+}
+
+inline boost::optional<size_t> findNearestIndex(
+  const TrajectoryIndex & index, const geometry_msgs::msg::Pose & pose,
+  const double max_dist = std::numeric_limits<double>::max(),
+  const double max_yaw = std::numeric_limits<double>::max())
+{
+  validateNonEmpty(index);
+
+  const double max_squared_dist = max_dist * max_dist;
+  const double target_yaw = tf2::getYaw(pose.orientation);
+
+  double min_squared_dist = std::numeric_limits<double>::max();
+  bool is_nearest_found = false;
+  size_t min_idx = 0;
+
+  for (size_t i = 0; i < index.size(); ++i) {
+    const auto squared_dist = index.calcSquaredDistance2d(i, pose.position);
+    if (squared_dist > max_squared_dist || squared_dist >= min_squared_dist) {
+      continue;
+    }
+
+    const auto yaw = normalizeRadian(target_yaw - index.getYaw(i));
+    if (std::fabs(yaw) > max_yaw) {
+      continue;
+    }
+
+    min_squared_dist = squared_dist;
+    min_idx = i;
+    is_nearest_found = true;
+  }
+  return is_nearest_found ? boost::optional<size_t>(min_idx) : boost::none;
+}
+
+/**
+ * @brief calcLongitudinalOffsetToSegment() with the precomputed index
+ */
+inline double calcLongitudinalOffsetToSegment(
+  const TrajectoryIndex & index, const size_t seg_idx, const geometry_msgs::msg::Point & p_target)
+{
+  validateNonEmpty(index);
+
+  const double segment_length = index.getSegmentLength(seg_idx);
+  if (segment_length == 0.0) {
+    throw std::runtime_error("Same points are given.");
+  }
+
+  const double target_dx = p_target.x - index.getX(seg_idx);
+  const double target_dy = p_target.y - index.getY(seg_idx);
+  return (index.getSegmentDx(seg_idx) * target_dx + index.getSegmentDy(seg_idx) * target_dy) /
+         segment_length;
+}
+
+namespace detail
+{
+inline size_t toNearestSegmentIndex(
+  const TrajectoryIndex & index, const size_t nearest_idx, const geometry_msgs::msg::Point & point)
+{
+  if (nearest_idx == 0) {
+    return 0;
+  }
+  if (nearest_idx == index.size() - 1) {
+    return index.size() - 2;
+  }
+
+  const double signed_length = calcLongitudinalOffsetToSegment(index, nearest_idx, point);
+
+  if (signed_length <= 0) {
+    return nearest_idx - 1;
+  }
+
+  return nearest_idx;
+}
+}  // namespace detail
+
+/**
+ * @brief findNearestSegmentIndex() with the precomputed index
+ */
+inline size_t findNearestSegmentIndex(
+  const TrajectoryIndex & index, const geometry_msgs::msg::Point & point)
+{
+  return detail::toNearestSegmentIndex(index, findNearestIndex(index, point), point);
+}
+
+/**
+ * @brief nearest segment index searched only around hint_idx, see findNearestIndex()
+ */
+inline size_t findNearestSegmentIndex(
+  const TrajectoryIndex & index, const geometry_msgs::msg::Point & point, const size_t hint_idx,
+  const size_t window)
+{
+  return detail::toNearestSegmentIndex(
+    index, findNearestIndex(index, point, hint_idx, window), point);
+}
+
+/**
+ * @brief calcLateralOffset() with the precomputed index
+ */
+inline double calcLateralOffset(
+  const TrajectoryIndex & index, const geometry_msgs::msg::Point & p_target)
+{
+  validateNonEmpty(index);
+
+  const size_t seg_idx = findNearestSegmentIndex(index, p_target);
+
+  const double segment_length = index.getSegmentLength(seg_idx);
+  if (segment_length == 0.0) {
+    throw std::runtime_error("Same points are given.");
+  }
+
+  const double target_dx = p_target.x - index.getX(seg_idx);
+  const double target_dy = p_target.y - index.getY(seg_idx);
+  return (index.getSegmentDx(seg_idx) * target_dy - index.getSegmentDy(seg_idx) * target_dx) /
+         segment_length;
+}
+
+/**
+ * @brief calcSignedArcLength from index to index in O(1)
+ */
+inline double calcSignedArcLength(
+  const TrajectoryIndex & index, const size_t src_idx, const size_t dst_idx)
+{
+  validateNonEmpty(index);
+
+  return index.getArcLength(dst_idx) - index.getArcLength(src_idx);
+}
+
+/**
+ * @brief calcSignedArcLength from point to index
+ */
+inline double calcSignedArcLength(
+  const TrajectoryIndex & index, const geometry_msgs::msg::Point & src_point,
+  const size_t & dst_idx)
+{
+  validateNonEmpty(index);
+
+  const size_t src_seg_idx = findNearestSegmentIndex(index, src_point);
+
+  const double signed_length_on_traj = calcSignedArcLength(index, src_seg_idx, dst_idx);
+  const double signed_length_src_offset =
+    calcLongitudinalOffsetToSegment(index, src_seg_idx, src_point);
+
+  return signed_length_on_traj - signed_length_src_offset;
+}
+
+/**
+ * @brief calcSignedArcLength from index to point
+ */
+inline double calcSignedArcLength(
+  const TrajectoryIndex & index, const size_t src_idx, const geometry_msgs::msg::Point & dst_point)
+{
+  validateNonEmpty(index);
+
+  return -calcSignedArcLength(index, dst_point, src_idx);
+}
+
+/**
+ * @brief calcSignedArcLength from point to point
+ */
+inline double calcSignedArcLength(
+  const TrajectoryIndex & index, const geometry_msgs::msg::Point & src_point,
+  const geometry_msgs::msg::Point & dst_point)
+{
+  validateNonEmpty(index);
+
+  const size_t src_seg_idx = findNearestSegmentIndex(index, src_point);
+  const size_t dst_seg_idx = findNearestSegmentIndex(index, dst_point);
+
+  const double signed_length_on_traj = calcSignedArcLength(index, src_seg_idx, dst_seg_idx);
+  const double signed_length_src_offset =
+    calcLongitudinalOffsetToSegment(index, src_seg_idx, src_point);
+  const double signed_length_dst_offset =
+    calcLongitudinalOffsetToSegment(index, dst_seg_idx, dst_point);
+
+  return signed_length_on_traj - signed_length_src_offset + signed_length_dst_offset;
+}
+
+/**
+ * @brief calcArcLength for the whole length in O(1)
+ */
+inline double calcArcLength(const TrajectoryIndex & index)
+{
+  validateNonEmpty(index);
+
+  return index.getTotalArcLength();
+}
+}  // namespace autoware_utils
+
+#endif  // AUTOWARE_UTILS__TRAJECTORY__TRAJECTORY_INDEX_HPP_
@@ -0,0 +1,176 @@
+// Copyright 2021 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "autoware_utils/trajectory/trajectory.hpp"
+#include "autoware_utils/trajectory/trajectory_index.hpp"
+
+#include <gtest/gtest.h>
+
+#include <random>
+#include <vector>
+
+namespace
+{
+using TrajectoryPointArray = std::vector<autoware_auto_planning_msgs::msg::TrajectoryPoint>;
+using autoware_utils::createPoint;
+using autoware_utils::createQuaternionFromYaw;
+using autoware_utils::TrajectoryIndex;
+
+constexpr double epsilon = 1e-6;
+
+TrajectoryPointArray generateTestTrajectoryPointArray(
+  const size_t num_points, const double point_interval, const double init_theta = 0.0,
+  const double delta_theta = 0.0)
+{
+  TrajectoryPointArray traj;
+  for (size_t i = 0; i < num_points; ++i) {
+    const double theta = init_theta + i * delta_theta;
+    const double x = i * point_interval * std::cos(theta);
+    const double y = i * point_interval * std::sin(theta);
+
+    autoware_auto_planning_msgs::msg::TrajectoryPoint p;
+    p.pose.position = createPoint(x, y, 0.0);
+    p.pose.orientation = createQuaternionFromYaw(theta);
+    traj.push_back(p);
+  }
+
+  return traj;
+}
+}  // namespace
+
+TEST(trajectory_index, validateNonEmpty)
+{
+  using autoware_utils::findNearestIndex;
+
+  const TrajectoryIndex index(TrajectoryPointArray{});
+  EXPECT_TRUE(index.empty());
+  EXPECT_THROW(findNearestIndex(index, createPoint(0.0, 0.0, 0.0)), std::invalid_argument);
+}
+
+TEST(trajectory_index, arcLength)
+{
+  using autoware_utils::calcArcLength;
+  using autoware_utils::calcSignedArcLength;
+
+  const auto traj = generateTestTrajectoryPointArray(50, 1.0, 0.0, 0.05);
+  const TrajectoryIndex index(traj);
+
+  EXPECT_NEAR(calcArcLength(index), calcArcLength(traj), epsilon);
+  EXPECT_NEAR(calcSignedArcLength(index, 3, 40), calcSignedArcLength(traj, 3, 40), epsilon);
+  EXPECT_NEAR(calcSignedArcLength(index, 40, 3), calcSignedArcLength(traj, 40, 3), epsilon);
+
+  const auto p_src = createPoint(5.3, 1.2, 0.0);
+  const auto p_dst = createPoint(20.5, 9.7, 0.0);
+  EXPECT_NEAR(
+    calcSignedArcLength(index, p_src, size_t{30}), calcSignedArcLength(traj, p_src, size_t{30}),
+    epsilon);
+  EXPECT_NEAR(
+    calcSignedArcLength(index, size_t{30}, p_src), calcSignedArcLength(traj, size_t{30}, p_src),
+    epsilon);
+  EXPECT_NEAR(
+    calcSignedArcLength(index, p_src, p_dst), calcSignedArcLength(traj, p_src, p_dst), epsilon);
+
+  // Segment containing the arc length
+  EXPECT_EQ(index.findSegmentIndexFromArcLength(-1.0), 0U);
+  EXPECT_EQ(index.findSegmentIndexFromArcLength(0.0), 0U);
+  EXPECT_EQ(index.findSegmentIndexFromArcLength(index.getArcLength(10) + 0.1), 10U);
+  EXPECT_EQ(index.findSegmentIndexFromArcLength(index.getTotalArcLength()), 48U);
+  EXPECT_EQ(index.findSegmentIndexFromArcLength(1000.0), 48U);
+}
+
+TEST(trajectory_index, findNearestIndex_SameAsPoints)
+{
+  using autoware_utils::findNearestIndex;
+  using autoware_utils::findNearestSegmentIndex;
+
+  std::mt19937 engine(0);
+  std::uniform_real_distribution<double> position(-30.0, 80.0);
+
+  // a trajectory passing the same place twice
+  auto traj = generateTestTrajectoryPointArray(60, 1.0, 0.0, 0.1);
+  const auto traj_back = generateTestTrajectoryPointArray(60, 1.0, 0.0, 0.1);
+  traj.insert(traj.end(), traj_back.rbegin(), traj_back.rend());
+
+  for (const double grid_cell_size : {0.0, 0.5, 2.0, 50.0}) {
+    const TrajectoryIndex index(traj, grid_cell_size);
+    for (size_t i = 0; i < 500; ++i) {
+      // integer coordinates give ties, which have to be resolved as the linear search
+      const auto p = createPoint(std::round(position(engine)), std::round(position(engine)), 0.0);
+      EXPECT_EQ(findNearestIndex(index, p), findNearestIndex(traj, p));
+      EXPECT_EQ(findNearestSegmentIndex(index, p), findNearestSegmentIndex(traj, p));
+    }
+    // far from the trajectory
+    const auto p_far = createPoint(10000.0, -5000.0, 0.0);
+    EXPECT_EQ(findNearestIndex(index, p_far), findNearestIndex(traj, p_far));
+  }
+}
+
+TEST(trajectory_index, findNearestIndex_Window)
+{
+  using autoware_utils::findNearestIndex;
+
+  const auto traj = generateTestTrajectoryPointArray(100, 1.0);
+  const TrajectoryIndex index(traj);
+
+  // The nearest point is in the window
+  EXPECT_EQ(findNearestIndex(index, createPoint(20.2, 1.0, 0.0), 18, 5), 20U);
+  EXPECT_EQ(findNearestIndex(index, createPoint(20.2, 1.0, 0.0), 0, 100), 20U);
+  // The nearest point is out of the window
+  EXPECT_EQ(findNearestIndex(index, createPoint(20.2, 1.0, 0.0), 5, 5), 10U);
+  EXPECT_EQ(findNearestIndex(index, createPoint(-3.0, 0.0, 0.0), 50, 5), 45U);
+  // The hint is clamped to the last point
+  EXPECT_EQ(findNearestIndex(index, createPoint(120.0, 0.0, 0.0), 1000, 3), 99U);
+}
+
+TEST(trajectory_index, findNearestIndex_Pose)
+{
+  using autoware_utils::findNearestIndex;
+
+  const auto traj = generateTestTrajectoryPointArray(10, 1.0);
+  const TrajectoryIndex index(traj);
+
+  geometry_msgs::msg::Pose pose;
+  pose.position = createPoint(4.2, 0.5, 0.0);
+  pose.orientation = createQuaternionFromYaw(0.3);
+
+  EXPECT_EQ(*findNearestIndex(index, pose), *findNearestIndex(traj, pose));
+  EXPECT_EQ(*findNearestIndex(index, pose, 1.0), *findNearestIndex(traj, pose, 1.0));
+  EXPECT_EQ(*findNearestIndex(index, pose, 1.0, 0.5), *findNearestIndex(traj, pose, 1.0, 0.5));
+  EXPECT_FALSE(findNearestIndex(index, pose, 0.1));
+  EXPECT_FALSE(findNearestIndex(index, pose, 1.0, 0.2));
+}
+
+TEST(trajectory_index, calcLateralOffset)
+{
+  using autoware_utils::calcLateralOffset;
+  using autoware_utils::calcLongitudinalOffsetToSegment;
+
+  const auto traj = generateTestTrajectoryPointArray(30, 1.0, 0.2, 0.03);
+  const TrajectoryIndex index(traj);
+
+  for (const auto & p : {createPoint(3.0, 2.0, 0.0), createPoint(10.0, -1.0, 0.0)}) {
+    EXPECT_NEAR(calcLateralOffset(index, p), calcLateralOffset(traj, p), epsilon);
+    EXPECT_NEAR(
+      calcLongitudinalOffsetToSegment(index, 5, p), calcLongitudinalOffsetToSegment(traj, 5, p),
+      epsilon);
+  }
+
+  // Same points
+  auto traj_with_same_points = traj;
+  traj_with_same_points.at(1) = traj_with_same_points.at(0);
+  const TrajectoryIndex index_with_same_points(traj_with_same_points);
+  EXPECT_THROW(
+    calcLongitudinalOffsetToSegment(index_with_same_points, 0, createPoint(0.0, 0.0, 0.0)),
+    std::runtime_error);
+}
@@ -18,6 +18,7 @@
 #define EIGEN_MPL2_ONLY
 
 #include <Eigen/Core>
+#include <Eigen/Geometry>
 #include <image_transport/image_transport.hpp>
 #include <rclcpp/rclcpp.hpp>
 
@@ -36,6 +37,7 @@
 
 #include <map>
 #include <memory>
+#include <utility>
 #include <vector>
 
 namespace roi_cluster_fusion
@@ -60,6 +62,43 @@ private:
   std::vector<boost::circular_buffer<sensor_msgs::msg::Image::ConstSharedPtr>> image_buffers_;
 };
 
+// xyz of all cluster points packed into one buffer in the cluster frame
+struct PackedClusters
+{
+  // three floats per point, points of cluster i are in [offsets[i], offsets[i + 1])
+  std::vector<float> points;
+  std::vector<size_t> offsets;
+  // bounding sphere of each cluster for early rejection
+  std::vector<Eigen::Vector3d> centers;
+  std::vector<double> radii;
+};
+
+struct CameraFusionInput
+{
+  int id;
+  int width;
+  int height;
+  Eigen::Matrix<double, 3, 4> projection;
+  Eigen::Affine3d transform;  // cluster frame to camera optical frame
+  autoware_perception_msgs::msg::DetectedObjectsWithFeature::ConstSharedPtr roi_msg;
+
+  EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+};
+
+struct RoiMatch
+{
+  size_t cluster_index;
+  double iou;
+};
+
+struct CameraFusionResult
+{
+  // best cluster for each image roi
+  std::vector<RoiMatch> matches;
+  std::vector<sensor_msgs::msg::RegionOfInterest> debug_pointcloud_rois;
+  std::vector<Eigen::Vector2d> debug_image_points;
+};
+
 class RoiClusterFusionNodelet : public rclcpp::Node
 {
 public:
@@ -78,15 +117,26 @@ private:
     autoware_perception_msgs::msg::DetectedObjectsWithFeature::ConstSharedPtr input_roi7_msg);
   void cameraInfoCallback(
     const sensor_msgs::msg::CameraInfo::ConstSharedPtr input_camera_info_msg, const int id);
+  static void packClusters(
+    const autoware_perception_msgs::msg::DetectedObjectsWithFeature & cluster_msg,
+    PackedClusters & packed_clusters);
+  void projectClusters(
+    const PackedClusters & packed_clusters, const CameraFusionInput & camera,
+    std::vector<std::pair<size_t, sensor_msgs::msg::RegionOfInterest>> & cluster_rois,
+    std::vector<Eigen::Vector2d> * debug_image_points) const;
+  void matchRois(
+    const std::vector<std::pair<size_t, sensor_msgs::msg::RegionOfInterest>> & cluster_rois,
+    const autoware_perception_msgs::msg::DetectedObjectsWithFeature & roi_msg,
+    std::vector<RoiMatch> & matches) const;
   double calcIoU(
     const sensor_msgs::msg::RegionOfInterest & roi_1,
-    const sensor_msgs::msg::RegionOfInterest & roi_2);
+    const sensor_msgs::msg::RegionOfInterest & roi_2) const;
   double calcIoUX(
     const sensor_msgs::msg::RegionOfInterest & roi_1,
-    const sensor_msgs::msg::RegionOfInterest & roi_2);
+    const sensor_msgs::msg::RegionOfInterest & roi_2) const;
   double calcIoUY(
     const sensor_msgs::msg::RegionOfInterest & roi_1,
-    const sensor_msgs::msg::RegionOfInterest & roi_2);
+    const sensor_msgs::msg::RegionOfInterest & roi_2) const;
 
   rclcpp::Publisher<autoware_perception_msgs::msg::DetectedObjectsWithFeature>::SharedPtr
     labeled_cluster_pub_;
@@ -128,6 +178,7 @@ private:
   int rois_number_;
   std::map<int, sensor_msgs::msg::CameraInfo> m_camera_info_;
   std::shared_ptr<Debugger> debugger_;
+  PackedClusters packed_clusters_;
 };
 
 }  // namespace roi_cluster_fusion
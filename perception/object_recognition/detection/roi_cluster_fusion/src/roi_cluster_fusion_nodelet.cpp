@@ -29,9 +29,13 @@
 #include <tf2_sensor_msgs/tf2_sensor_msgs.h>
 
 #include <algorithm>
+#include <array>
 #include <chrono>
+#include <cstring>
+#include <limits>
 #include <map>
 #include <memory>
+#include <numeric>
 #include <utility>
 #include <vector>
 
@@ -271,174 +275,304 @@ void RoiClusterFusionNodelet::fusionCallback(
     }
   }
 
+  // pack all cluster points once, they are shared by every camera
+  packClusters(*input_cluster_msg, packed_clusters_);
+
+  const std::array<autoware_perception_msgs::msg::DetectedObjectsWithFeature::ConstSharedPtr, 8>
+    input_roi_msgs{{input_roi0_msg, input_roi1_msg, input_roi2_msg, input_roi3_msg,
+                    input_roi4_msg, input_roi5_msg, input_roi6_msg, input_roi7_msg}};
+
   // check camera info
+  std::vector<CameraFusionInput, Eigen::aligned_allocator<CameraFusionInput>> cameras;
   for (int id = 0; id < static_cast<int>(v_roi_sub_.size()); ++id) {
-    // debug variable
-    std::vector<sensor_msgs::msg::RegionOfInterest> debug_image_rois;
-    std::vector<sensor_msgs::msg::RegionOfInterest> debug_pointcloud_rois;
-    std::vector<Eigen::Vector2d> debug_image_points;
     // cannot find camera info
     if (m_camera_info_.find(id) == m_camera_info_.end()) {
       RCLCPP_WARN(this->get_logger(), "no camera info. id is %d", id);
       continue;
     }
+    const auto & camera_info = m_camera_info_.at(id);
+
+    CameraFusionInput camera;
+    camera.id = id;
+    camera.width = static_cast<int>(camera_info.width);
+    camera.height = static_cast<int>(camera_info.height);
+    camera.roi_msg = input_roi_msgs.at(id);
 
     // projection matrix
-    Eigen::Matrix4d projection;
-    projection << m_camera_info_.at(id).p.at(0), m_camera_info_.at(id).p.at(1),
-      m_camera_info_.at(id).p.at(2), m_camera_info_.at(id).p.at(3), m_camera_info_.at(id).p.at(4),
-      m_camera_info_.at(id).p.at(5), m_camera_info_.at(id).p.at(6), m_camera_info_.at(id).p.at(7),
-      m_camera_info_.at(id).p.at(8), m_camera_info_.at(id).p.at(9), m_camera_info_.at(id).p.at(10),
-      m_camera_info_.at(id).p.at(11);
+    camera.projection << camera_info.p.at(0), camera_info.p.at(1), camera_info.p.at(2),
+      camera_info.p.at(3), camera_info.p.at(4), camera_info.p.at(5), camera_info.p.at(6),
+      camera_info.p.at(7), camera_info.p.at(8), camera_info.p.at(9), camera_info.p.at(10),
+      camera_info.p.at(11);
 
     // get transform from cluster frame id to camera optical frame id
     geometry_msgs::msg::TransformStamped transform_stamped;
     try {
       transform_stamped = tf_buffer_.lookupTransform(
-        /*target*/ m_camera_info_.at(id).header.frame_id,
+        /*target*/ camera_info.header.frame_id,
         /*src*/ input_cluster_msg->header.frame_id, tf2::TimePointZero);
     } catch (tf2::TransformException & ex) {
       RCLCPP_WARN(this->get_logger(), "%s", ex.what());
       return;
     }
+    const auto & translation = transform_stamped.transform.translation;
+    const auto & rotation = transform_stamped.transform.rotation;
+    camera.transform = Eigen::Translation3d(translation.x, translation.y, translation.z) *
+                       Eigen::Quaterniond(rotation.w, rotation.x, rotation.y, rotation.z);
+    cameras.push_back(camera);
+  }
 
-    // build cluster roi
-    std::map<size_t, sensor_msgs::msg::RegionOfInterest> m_cluster_roi;
-    for (size_t i = 0; i < input_cluster_msg->feature_objects.size(); ++i) {
-      if (input_cluster_msg->feature_objects.at(i).feature.cluster.data.empty()) {
-        continue;
+  // project clusters and match rois for each camera in parallel
+  std::vector<CameraFusionResult> results(cameras.size());
+#pragma omp parallel for
+  for (int i = 0; i < static_cast<int>(cameras.size()); ++i) {
+    const auto & camera = cameras.at(i);
+    auto & result = results.at(i);
+    std::vector<std::pair<size_t, sensor_msgs::msg::RegionOfInterest>> cluster_rois;
+    projectClusters(
+      packed_clusters_, camera, cluster_rois, debugger_ ? &result.debug_image_points : nullptr);
+    if (debugger_) {
+      for (const auto & cluster_roi : cluster_rois) {
+        result.debug_pointcloud_rois.push_back(cluster_roi.second);
       }
+    }
+    matchRois(cluster_rois, *camera.roi_msg, result.matches);
+  }
 
-      sensor_msgs::msg::PointCloud2 transformed_cluster;
-      tf2::doTransform(
-        input_cluster_msg->feature_objects.at(i).feature.cluster, transformed_cluster,
-        transform_stamped);
-
-      // for reduce calc cost
-      // Eigen::Vector3d centroid_point;
-      // centroid_point << 0, 0, 0;
-      // for (sensor_msgs::PointCloud2ConstIterator<float> iter_x(transformed_cluster, "x"),
-      // iter_y(transformed_cluster,
-      // "y"), iter_z(transformed_cluster, "z");
-      //      iter_x != iter_x.end();
-      //      ++iter_x, ++iter_y, ++iter_z)
-      // {
-      //     centroid_point += Eigen::Vector3d(*iter_x, *iter_y, *iter_z);
-      // }
-      // centroid_point *= 1.0 / static_cast<double>(
-      //  input_cluster_msg->feature_objects.at(i).feature.cluster.data.size());
-      //     if (centroid_point.z() <= 0.0)
-      //         continue;
-
-      std::vector<Eigen::Vector2d> projected_points;
-      projected_points.reserve(transformed_cluster.data.size());
-      int min_x(m_camera_info_.at(id).width), min_y(m_camera_info_.at(id).height), max_x(0),
-        max_y(0);
-      for (sensor_msgs::PointCloud2ConstIterator<float> iter_x(transformed_cluster, "x"),
-           iter_y(transformed_cluster, "y"), iter_z(transformed_cluster, "z");
-           iter_x != iter_x.end(); ++iter_x, ++iter_y, ++iter_z) {
-        if (*iter_z <= 0.0) {
-          continue;
+  // overwrite labels in camera order so that the result does not depend on the thread schedule
+  for (size_t i = 0; i < cameras.size(); ++i) {
+    const auto & input_roi_msg = cameras.at(i).roi_msg;
+    const auto & matches = results.at(i).matches;
+    std::vector<sensor_msgs::msg::RegionOfInterest> debug_image_rois;
+    for (size_t j = 0; j < input_roi_msg->feature_objects.size(); ++j) {
+      const auto & roi_object = input_roi_msg->feature_objects.at(j).object;
+      const auto & match = matches.at(j);
+      if (
+        iou_threshold_ < match.iou &&
+        output_msg.feature_objects.at(match.cluster_index).object.existence_probability <=
+          roi_object.existence_probability &&
+        roi_object.classification.front().label !=
+          autoware_auto_perception_msgs::msg::ObjectClassification::UNKNOWN) {
+        output_msg.feature_objects.at(match.cluster_index).object.classification =
+          roi_object.classification;
+      }
+      debug_image_rois.push_back(input_roi_msg->feature_objects.at(j).feature.roi);
+    }
+    if (debugger_) {
+      debugger_->showImage(
+        cameras.at(i).id, input_roi_msg->header.stamp, debug_image_rois,
+        results.at(i).debug_pointcloud_rois, results.at(i).debug_image_points);
+    }
+  }
+  // publish output msg
+  labeled_cluster_pub_->publish(output_msg);
+}
+
+void RoiClusterFusionNodelet::packClusters(
+  const autoware_perception_msgs::msg::DetectedObjectsWithFeature & cluster_msg,
+  PackedClusters & packed_clusters)
+{
+  const size_t cluster_num = cluster_msg.feature_objects.size();
+  packed_clusters.points.clear();
+  packed_clusters.offsets.assign(1, 0);
+  packed_clusters.centers.assign(cluster_num, Eigen::Vector3d::Zero());
+  packed_clusters.radii.assign(cluster_num, 0.0);
+
+  size_t total_point_num = 0;
+  for (const auto & feature_object : cluster_msg.feature_objects) {
+    const auto & cluster = feature_object.feature.cluster;
+    if (cluster.point_step > 0) {
+      total_point_num += cluster.data.size() / cluster.point_step;
+    }
+  }
+  packed_clusters.points.reserve(3 * total_point_num);
+
+  for (size_t i = 0; i < cluster_num; ++i) {
+    const auto & cluster = cluster_msg.feature_objects.at(i).feature.cluster;
+    int offsets[3] = {-1, -1, -1};
+    const char * names[3] = {"x", "y", "z"};
+    for (const auto & field : cluster.fields) {
+      for (int axis = 0; axis < 3; ++axis) {
+        if (field.name == names[axis] && field.datatype == sensor_msgs::msg::PointField::FLOAT32) {
+          offsets[axis] = static_cast<int>(field.offset);
         }
-        Eigen::Vector4d projected_point =
-          projection * Eigen::Vector4d(*iter_x, *iter_y, *iter_z, 1.0);
-        Eigen::Vector2d normalized_projected_point = Eigen::Vector2d(
-          projected_point.x() / projected_point.z(), projected_point.y() / projected_point.z());
-        if (
-          0 <= static_cast<int>(normalized_projected_point.x()) &&
-          static_cast<int>(normalized_projected_point.x()) <=
-            static_cast<int>(m_camera_info_.at(id).width) - 1 &&
-          0 <= static_cast<int>(normalized_projected_point.y()) &&
-          static_cast<int>(normalized_projected_point.y()) <=
-            static_cast<int>(m_camera_info_.at(id).height) - 1) {
-          min_x = std::min(static_cast<int>(normalized_projected_point.x()), min_x);
-          min_y = std::min(static_cast<int>(normalized_projected_point.y()), min_y);
-          max_x = std::max(static_cast<int>(normalized_projected_point.x()), max_x);
-          max_y = std::max(static_cast<int>(normalized_projected_point.y()), max_y);
-          projected_points.push_back(normalized_projected_point);
-          debug_image_points.push_back(normalized_projected_point);
+      }
+    }
+    const bool has_xyz = 0 <= offsets[0] && 0 <= offsets[1] && 0 <= offsets[2];
+    if (has_xyz && 0 < cluster.point_step) {
+      Eigen::Vector3d min_point = Eigen::Vector3d::Constant(std::numeric_limits<double>::max());
+      Eigen::Vector3d max_point = Eigen::Vector3d::Constant(std::numeric_limits<double>::lowest());
+      const size_t point_num = cluster.data.size() / cluster.point_step;
+      for (size_t j = 0; j < point_num; ++j) {
+        const uint8_t * point_data = cluster.data.data() + j * cluster.point_step;
+        float xyz[3];
+        for (int axis = 0; axis < 3; ++axis) {
+          std::memcpy(&xyz[axis], point_data + offsets[axis], sizeof(float));
+          packed_clusters.points.push_back(xyz[axis]);
         }
+        const Eigen::Vector3d point(xyz[0], xyz[1], xyz[2]);
+        min_point = min_point.cwiseMin(point);
+        max_point = max_point.cwiseMax(point);
       }
-      if (projected_points.empty()) {
-        continue;
+      if (0 < point_num) {
+        packed_clusters.centers.at(i) = 0.5 * (min_point + max_point);
+        packed_clusters.radii.at(i) = 0.5 * (max_point - min_point).norm();
       }
+    }
+    packed_clusters.offsets.push_back(packed_clusters.points.size() / 3);
+  }
+}
+
+void RoiClusterFusionNodelet::projectClusters(
+  const PackedClusters & packed_clusters, const CameraFusionInput & camera,
+  std::vector<std::pair<size_t, sensor_msgs::msg::RegionOfInterest>> & cluster_rois,
+  std::vector<Eigen::Vector2d> * debug_image_points) const
+{
+  const Eigen::Matrix3d rotation = camera.transform.linear();
+  const Eigen::Vector3d translation = camera.transform.translation();
 
-      sensor_msgs::msg::RegionOfInterest roi;
-      // roi.do_rectify = m_camera_info_.at(id).do_rectify;
-      roi.x_offset = min_x;
-      roi.y_offset = min_y;
-      roi.width = max_x - min_x;
-      roi.height = max_y - min_y;
-      m_cluster_roi.insert(std::make_pair(i, roi));
-      debug_pointcloud_rois.push_back(roi);
+  // A point is kept when z > 0, -1 < u < width and -1 < v < height, because the pixel
+  // coordinates are truncated toward zero. Each bound is a half space in the camera frame, so
+  // a cluster whose bounding sphere lies entirely outside one of them cannot be seen.
+  const Eigen::RowVector4d row_u = camera.projection.row(0);
+  const Eigen::RowVector4d row_v = camera.projection.row(1);
+  const Eigen::RowVector4d row_w = camera.projection.row(2);
+  const std::array<Eigen::RowVector4d, 5> frustum_planes{
+    {Eigen::RowVector4d(0.0, 0.0, 1.0, 0.0), row_u + row_w,
+     static_cast<double>(camera.width) * row_w - row_u, row_v + row_w,
+     static_cast<double>(camera.height) * row_w - row_v}};
+  const auto is_outside_frustum = [&frustum_planes](
+                                    const Eigen::Vector3d & center, const double radius) {
+    for (const auto & plane : frustum_planes) {
+      if (plane.head<3>().dot(center) + plane(3) < -radius * plane.head<3>().norm()) {
+        return true;
+      }
     }
+    return false;
+  };
 
-    // calc iou
-    autoware_perception_msgs::msg::DetectedObjectsWithFeature::ConstSharedPtr input_roi_msg;
-    if (id == 0) {
-      input_roi_msg = input_roi0_msg;
-    } else if (id == 1) {
-      input_roi_msg = input_roi1_msg;
-    } else if (id == 2) {
-      input_roi_msg = input_roi2_msg;
-    } else if (id == 3) {
-      input_roi_msg = input_roi3_msg;
-    } else if (id == 4) {
-      input_roi_msg = input_roi4_msg;
-    } else if (id == 5) {
-      input_roi_msg = input_roi5_msg;
-    } else if (id == 6) {
-      input_roi_msg = input_roi6_msg;
-    } else if (id == 7) {
-      input_roi_msg = input_roi7_msg;
+  Eigen::Matrix3Xd camera_points;
+  Eigen::Matrix3Xd image_points;
+  for (size_t i = 0; i + 1 < packed_clusters.offsets.size(); ++i) {
+    const size_t begin = packed_clusters.offsets.at(i);
+    const size_t point_num = packed_clusters.offsets.at(i + 1) - begin;
+    if (point_num == 0) {
+      continue;
     }
-    for (size_t i = 0; i < input_roi_msg->feature_objects.size(); ++i) {
-      int index = 0;
-      double max_iou = 0.0;
-      for (auto m_cluster_roi_itr = m_cluster_roi.begin(); m_cluster_roi_itr != m_cluster_roi.end();
-           ++m_cluster_roi_itr) {
-        double iou(0.0), iou_x(0.0), iou_y(0.0);
-        if (use_iou_) {
-          iou =
-            calcIoU(m_cluster_roi_itr->second, input_roi_msg->feature_objects.at(i).feature.roi);
-        }
-        if (use_iou_x_) {
-          iou_x =
-            calcIoUX(m_cluster_roi_itr->second, input_roi_msg->feature_objects.at(i).feature.roi);
-        }
-        if (use_iou_y_) {
-          iou_y =
-            calcIoUY(m_cluster_roi_itr->second, input_roi_msg->feature_objects.at(i).feature.roi);
-        }
-        if (max_iou < iou + iou_x + iou_y) {
-          index = m_cluster_roi_itr->first;
-          max_iou = iou + iou_x + iou_y;
+    if (is_outside_frustum(
+          camera.transform * packed_clusters.centers.at(i), packed_clusters.radii.at(i))) {
+      continue;
+    }
+
+    // transform and project every point of the cluster at once
+    const Eigen::Map<const Eigen::Matrix3Xf> cluster_points(
+      packed_clusters.points.data() + 3 * begin, 3, point_num);
+    camera_points.noalias() = rotation * cluster_points.cast<double>();
+    camera_points.colwise() += translation;
+    image_points.noalias() = camera.projection.leftCols<3>() * camera_points;
+    image_points.colwise() += camera.projection.col(3);
+
+    int min_x(camera.width), min_y(camera.height), max_x(0), max_y(0);
+    bool has_projected_point = false;
+    for (size_t j = 0; j < point_num; ++j) {
+      if (camera_points(2, j) <= 0.0) {
+        continue;
+      }
+      const Eigen::Vector2d normalized_projected_point(
+        image_points(0, j) / image_points(2, j), image_points(1, j) / image_points(2, j));
+      const int px = static_cast<int>(normalized_projected_point.x());
+      const int py = static_cast<int>(normalized_projected_point.y());
+      if (0 <= px && px <= camera.width - 1 && 0 <= py && py <= camera.height - 1) {
+        min_x = std::min(px, min_x);
+        min_y = std::min(py, min_y);
+        max_x = std::max(px, max_x);
+        max_y = std::max(py, max_y);
+        has_projected_point = true;
+        if (debug_image_points) {
+          debug_image_points->push_back(normalized_projected_point);
         }
       }
+    }
+    if (!has_projected_point) {
+      continue;
+    }
+
+    sensor_msgs::msg::RegionOfInterest roi;
+    roi.x_offset = min_x;
+    roi.y_offset = min_y;
+    roi.width = max_x - min_x;
+    roi.height = max_y - min_y;
+    cluster_rois.emplace_back(i, roi);
+  }
+}
+
+void RoiClusterFusionNodelet::matchRois(
+  const std::vector<std::pair<size_t, sensor_msgs::msg::RegionOfInterest>> & cluster_rois,
+  const autoware_perception_msgs::msg::DetectedObjectsWithFeature & roi_msg,
+  std::vector<RoiMatch> & matches) const
+{
+  // sort cluster rois by their left edge, then every image roi only has to visit the clusters
+  // whose left edge lies in [left - max_width, right]
+  std::vector<size_t> order(cluster_rois.size());
+  std::iota(order.begin(), order.end(), 0);
+  std::sort(order.begin(), order.end(), [&cluster_rois](const size_t a, const size_t b) {
+    return cluster_rois.at(a).second.x_offset < cluster_rois.at(b).second.x_offset;
+  });
+  int64_t max_width = 0;
+  std::vector<int64_t> sorted_x_offsets;
+  sorted_x_offsets.reserve(order.size());
+  for (const auto i : order) {
+    sorted_x_offsets.push_back(cluster_rois.at(i).second.x_offset);
+    max_width = std::max<int64_t>(max_width, cluster_rois.at(i).second.width);
+  }
+
+  matches.clear();
+  for (const auto & feature_object : roi_msg.feature_objects) {
+    const auto & image_roi = feature_object.feature.roi;
+    const int64_t image_min_x = image_roi.x_offset;
+    const int64_t image_max_x = image_min_x + image_roi.width;
+    const int64_t image_min_y = image_roi.y_offset;
+    const int64_t image_max_y = image_min_y + image_roi.height;
+
+    // every IoU is zero unless the rois overlap along both axes, and ties go to the smallest
+    // cluster index as in a scan in index order
+    RoiMatch match{0, 0.0};
+    auto itr = std::lower_bound(
+      sorted_x_offsets.begin(), sorted_x_offsets.end(), image_min_x - max_width);
+    for (; itr != sorted_x_offsets.end() && *itr <= image_max_x; ++itr) {
+      const auto & cluster_roi = cluster_rois.at(order.at(itr - sorted_x_offsets.begin()));
+      const int64_t cluster_max_x = *itr + cluster_roi.second.width;
+      const int64_t cluster_min_y = cluster_roi.second.y_offset;
+      const int64_t cluster_max_y = cluster_min_y + cluster_roi.second.height;
+      if (
+        cluster_max_x < image_min_x || image_max_y < cluster_min_y ||
+        cluster_max_y < image_min_y) {
+        continue;
+      }
+      double iou(0.0), iou_x(0.0), iou_y(0.0);
+      if (use_iou_) {
+        iou = calcIoU(cluster_roi.second, image_roi);
+      }
+      if (use_iou_x_) {
+        iou_x = calcIoUX(cluster_roi.second, image_roi);
+      }
+      if (use_iou_y_) {
+        iou_y = calcIoUY(cluster_roi.second, image_roi);
+      }
+      const double score = iou + iou_x + iou_y;
       if (
-        iou_threshold_ < max_iou &&
-        output_msg.feature_objects.at(index).object.existence_probability <=
-          input_roi_msg->feature_objects.at(i).object.existence_probability &&
-        input_roi_msg->feature_objects.at(i).object.classification.front().label !=
-          autoware_auto_perception_msgs::msg::ObjectClassification::UNKNOWN) {
-        output_msg.feature_objects.at(index).object.classification =
-          input_roi_msg->feature_objects.at(i).object.classification;
+        match.iou < score ||
+        (0.0 < match.iou && match.iou == score && cluster_roi.first < match.cluster_index)) {
+        match.cluster_index = cluster_roi.first;
+        match.iou = score;
       }
-      debug_image_rois.push_back(input_roi_msg->feature_objects.at(i).feature.roi);
-    }
-    if (debugger_) {
-      debugger_->showImage(
-        id, input_roi_msg->header.stamp, debug_image_rois, debug_pointcloud_rois,
-        debug_image_points);
     }
+    matches.push_back(match);
   }
-  // publish output msg
-  labeled_cluster_pub_->publish(output_msg);
 }
 
 double RoiClusterFusionNodelet::calcIoU(
   const sensor_msgs::msg::RegionOfInterest & roi_1,
-  const sensor_msgs::msg::RegionOfInterest & roi_2)
+  const sensor_msgs::msg::RegionOfInterest & roi_2) const
 {
   double s_1, s_2;
   s_1 = static_cast<double>(roi_1.width * static_cast<double>(roi_1.height));
@@ -462,7 +596,7 @@ double RoiClusterFusionNodelet::calcIoU(
 }
 double RoiClusterFusionNodelet::calcIoUX(
   const sensor_msgs::msg::RegionOfInterest & roi_1,
-  const sensor_msgs::msg::RegionOfInterest & roi_2)
+  const sensor_msgs::msg::RegionOfInterest & roi_2) const
 {
   double s_1, s_2;
   s_1 = static_cast<double>(roi_1.width);
@@ -485,7 +619,7 @@ double RoiClusterFusionNodelet::calcIoUX(
 }
 double RoiClusterFusionNodelet::calcIoUY(
   const sensor_msgs::msg::RegionOfInterest & roi_1,
-  const sensor_msgs::msg::RegionOfInterest & roi_2)
+  const sensor_msgs::msg::RegionOfInterest & roi_2) const
 {
   double s_1, s_2;
   s_1 = static_cast<double>(roi_1.height);
@@ -37,6 +37,7 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 namespace occupancy_grid_map_outlier_filter
 {
@@ -46,6 +47,32 @@ using sensor_msgs::msg::PointCloud2;
 using std_msgs::msg::Header;
 using PclPointCloud = pcl::PointCloud<pcl::PointXYZ>;
 
+/**
+ * @brief uniform 2d hash grid that only counts neighbors within a fixed radius.
+ * The cell size equals the search radius, so a query visits at most 3x3 cells.
+ * Internal buffers are kept between frames to avoid reallocation.
+ */
+class RadiusSearch2dGrid
+{
+public:
+  explicit RadiusSearch2dGrid(const float search_radius);
+  void setInputCloud(const std::vector<const PclPointCloud *> & clouds);
+  int countNeighbors(const float x, const float y, const int max_count) const;
+
+private:
+  size_t getBucketIndex(const int64_t ix, const int64_t iy) const;
+  int64_t toCellIndex(const float v) const;
+
+  float search_radius_;
+  float inv_cell_size_;
+  size_t bucket_mask_;
+  std::vector<uint32_t> bucket_offsets_;
+  std::vector<uint32_t> bucket_cursors_;
+  std::vector<float> xs_;
+  std::vector<float> ys_;
+  std::vector<size_t> point_buckets_;
+};
+
 class RadiusSearch2dfilter
 {
 public:
@@ -58,11 +85,16 @@ public:
     PclPointCloud & output, PclPointCloud & outlier);
 
 private:
+  void filterByGrid(
+    const PclPointCloud & input, const Pose & pose, PclPointCloud & output,
+    PclPointCloud & outlier);
+  int getMinPointsThreshold(const float distance) const;
+
   float search_radius_;
   float min_points_and_distance_ratio_;
   int min_points_;
   int max_points_;
-  pcl::search::Search<pcl::PointXY>::Ptr kd_tree_;
+  RadiusSearch2dGrid grid_;
 };
 
 class OccupancyGridMapOutlierFilterComponent : public rclcpp::Node
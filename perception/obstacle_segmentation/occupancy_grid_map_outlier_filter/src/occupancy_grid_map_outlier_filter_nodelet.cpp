@@ -24,6 +24,8 @@
 #include <tf2_eigen/tf2_eigen.h>
 
 #include <algorithm>
+#include <array>
+#include <cstring>
 #include <memory>
 #include <string>
 #include <utility>
@@ -92,86 +94,177 @@ boost::optional<char> getCost(
   return boost::none;
 }
 
+// offset of a FLOAT32 field in a point, which is none when the field is missing, of another type
+// or out of the point
+boost::optional<uint32_t> getFloatFieldOffset(
+  const sensor_msgs::msg::PointCloud2 & cloud, const std::string & name)
+{
+  const auto field = std::find_if(
+    cloud.fields.cbegin(), cloud.fields.cend(),
+    [&name](const sensor_msgs::msg::PointField & field) { return field.name == name; });
+  if (
+    field == cloud.fields.cend() || field->datatype != sensor_msgs::msg::PointField::FLOAT32 ||
+    cloud.point_step < field->offset + sizeof(float)) {
+    return boost::none;
+  }
+  return field->offset;
+}
+
 }  // namespace
 
 namespace occupancy_grid_map_outlier_filter
 {
-RadiusSearch2dfilter::RadiusSearch2dfilter(rclcpp::Node & node)
+RadiusSearch2dGrid::RadiusSearch2dGrid(const float search_radius)
+: search_radius_(search_radius), inv_cell_size_(1.0f / search_radius), bucket_mask_(0)
 {
-  search_radius_ = node.declare_parameter("radius_search_2d_filter.search_radius", 1.0f);
-  min_points_and_distance_ratio_ =
-    node.declare_parameter("radius_search_2d_filter.min_points_and_distance_ratio", 400.0f);
-  min_points_ = node.declare_parameter("radius_search_2d_filter.min_points", 4);
-  max_points_ = node.declare_parameter("radius_search_2d_filter.max_points", 70);
-  kd_tree_ = boost::make_shared<pcl::search::KdTree<pcl::PointXY>>(false);
 }
 
-void RadiusSearch2dfilter::filter(
-  const PclPointCloud & input, const Pose & pose, PclPointCloud & output, PclPointCloud & outlier)
+int64_t RadiusSearch2dGrid::toCellIndex(const float v) const
+{
+  return static_cast<int64_t>(std::floor(v * inv_cell_size_));
+}
+
+size_t RadiusSearch2dGrid::getBucketIndex(const int64_t ix, const int64_t iy) const
+{
+  const uint64_t hash =
+    (static_cast<uint64_t>(ix) * 73856093ULL) ^ (static_cast<uint64_t>(iy) * 19349663ULL);
+  return static_cast<size_t>(hash) & bucket_mask_;
+}
+
+void RadiusSearch2dGrid::setInputCloud(const std::vector<const PclPointCloud *> & clouds)
 {
-  const auto & xyz_cloud = input;
-  pcl::PointCloud<pcl::PointXY>::Ptr xy_cloud(new pcl::PointCloud<pcl::PointXY>);
-  xy_cloud->points.resize(xyz_cloud.points.size());
-  for (size_t i = 0; i < xyz_cloud.points.size(); ++i) {
-    xy_cloud->points[i].x = xyz_cloud.points[i].x;
-    xy_cloud->points[i].y = xyz_cloud.points[i].y;
+  size_t num_points = 0;
+  for (const auto & cloud : clouds) {
+    num_points += cloud->points.size();
   }
 
-  std::vector<int> k_indices(xy_cloud->points.size());
-  std::vector<float> k_dists(xy_cloud->points.size());
-  kd_tree_->setInputCloud(xy_cloud);
-  for (size_t i = 0; i < xy_cloud->points.size(); ++i) {
-    const float distance =
-      std::hypot(xy_cloud->points[i].x - pose.position.x, xy_cloud->points[i].y - pose.position.y);
-    const int min_points_threshold = std::min(
-      std::max(static_cast<int>(min_points_and_distance_ratio_ / distance + 0.5f), min_points_),
-      max_points_);
-    const int points_num = kd_tree_->radiusSearch(i, search_radius_, k_indices, k_dists);
-
-    if (min_points_threshold <= points_num) {
-      output.points.push_back(xyz_cloud.points.at(i));
-    } else {
-      outlier.points.push_back(xyz_cloud.points.at(i));
+  // power of two bucket count, at least twice the number of points to keep collisions rare
+  size_t num_buckets = 16;
+  while (num_buckets < 2 * num_points) {
+    num_buckets <<= 1;
+  }
+  bucket_mask_ = num_buckets - 1;
+
+  // counting sort of the points by bucket into contiguous coordinate arrays
+  point_buckets_.resize(num_points);
+  bucket_offsets_.assign(num_buckets + 1, 0);
+  {
+    size_t i = 0;
+    for (const auto & cloud : clouds) {
+      for (const auto & p : cloud->points) {
+        point_buckets_[i] = getBucketIndex(toCellIndex(p.x), toCellIndex(p.y));
+        ++bucket_offsets_[point_buckets_[i] + 1];
+        ++i;
+      }
+    }
+  }
+  for (size_t b = 0; b < num_buckets; ++b) {
+    bucket_offsets_[b + 1] += bucket_offsets_[b];
+  }
+
+  xs_.resize(num_points);
+  ys_.resize(num_points);
+  bucket_cursors_.assign(bucket_offsets_.begin(), bucket_offsets_.end() - 1);
+  size_t i = 0;
+  for (const auto & cloud : clouds) {
+    for (const auto & p : cloud->points) {
+      const uint32_t dst = bucket_cursors_[point_buckets_[i]]++;
+      xs_[dst] = p.x;
+      ys_[dst] = p.y;
+      ++i;
     }
   }
 }
 
-void RadiusSearch2dfilter::filter(
-  const PclPointCloud & high_conf_input, const PclPointCloud & low_conf_input, const Pose & pose,
-  PclPointCloud & output, PclPointCloud & outlier)
+int RadiusSearch2dGrid::countNeighbors(const float x, const float y, const int max_count) const
 {
-  const auto & high_conf_xyz_cloud = high_conf_input;
-  const auto & low_conf_xyz_cloud = low_conf_input;
-  pcl::PointCloud<pcl::PointXY>::Ptr xy_cloud(new pcl::PointCloud<pcl::PointXY>);
-  xy_cloud->points.resize(low_conf_xyz_cloud.points.size() + high_conf_xyz_cloud.points.size());
-  for (size_t i = 0; i < low_conf_xyz_cloud.points.size(); ++i) {
-    xy_cloud->points[i].x = low_conf_xyz_cloud.points[i].x;
-    xy_cloud->points[i].y = low_conf_xyz_cloud.points[i].y;
+  const float squared_radius = search_radius_ * search_radius_;
+  const int64_t ix = toCellIndex(x);
+  const int64_t iy = toCellIndex(y);
+
+  std::array<size_t, 9> visited_buckets{};
+  size_t num_visited = 0;
+  int count = 0;
+  for (int64_t dy = -1; dy <= 1; ++dy) {
+    for (int64_t dx = -1; dx <= 1; ++dx) {
+      const size_t bucket = getBucketIndex(ix + dx, iy + dy);
+      // different cells can share a bucket, which must not be counted twice
+      if (
+        std::find(visited_buckets.begin(), visited_buckets.begin() + num_visited, bucket) !=
+        visited_buckets.begin() + num_visited) {
+        continue;
+      }
+      visited_buckets[num_visited++] = bucket;
+      for (uint32_t i = bucket_offsets_[bucket]; i < bucket_offsets_[bucket + 1]; ++i) {
+        const float diff_x = xs_[i] - x;
+        const float diff_y = ys_[i] - y;
+        if (diff_x * diff_x + diff_y * diff_y <= squared_radius) {
+          if (max_count <= ++count) {
+            return count;
+          }
+        }
+      }
+    }
   }
-  for (size_t i = low_conf_xyz_cloud.points.size(); i < xy_cloud->points.size(); ++i) {
-    xy_cloud->points[i].x = high_conf_xyz_cloud.points[i - low_conf_xyz_cloud.points.size()].x;
-    xy_cloud->points[i].y = high_conf_xyz_cloud.points[i - low_conf_xyz_cloud.points.size()].y;
+  return count;
+}
+
+RadiusSearch2dfilter::RadiusSearch2dfilter(rclcpp::Node & node)
+: search_radius_(node.declare_parameter("radius_search_2d_filter.search_radius", 1.0f)),
+  min_points_and_distance_ratio_(
+    node.declare_parameter("radius_search_2d_filter.min_points_and_distance_ratio", 400.0f)),
+  min_points_(node.declare_parameter("radius_search_2d_filter.min_points", 4)),
+  max_points_(node.declare_parameter("radius_search_2d_filter.max_points", 70)),
+  grid_(search_radius_)
+{
+}
+
+int RadiusSearch2dfilter::getMinPointsThreshold(const float distance) const
+{
+  return std::min(
+    std::max(static_cast<int>(min_points_and_distance_ratio_ / distance + 0.5f), min_points_),
+    max_points_);
+}
+
+void RadiusSearch2dfilter::filterByGrid(
+  const PclPointCloud & input, const Pose & pose, PclPointCloud & output, PclPointCloud & outlier)
+{
+  const int num_points = static_cast<int>(input.points.size());
+  std::vector<uint8_t> is_inlier(num_points);
+
+#pragma omp parallel for
+  for (int i = 0; i < num_points; ++i) {
+    const auto & p = input.points[i];
+    const float distance = std::hypot(p.x - pose.position.x, p.y - pose.position.y);
+    const int min_points_threshold = getMinPointsThreshold(distance);
+    is_inlier[i] = min_points_threshold <= grid_.countNeighbors(p.x, p.y, min_points_threshold);
   }
 
-  std::vector<int> k_indices(xy_cloud->points.size());
-  std::vector<float> k_dists(xy_cloud->points.size());
-  kd_tree_->setInputCloud(xy_cloud);
-  for (size_t i = 0; i < low_conf_xyz_cloud.points.size(); ++i) {
-    const float distance =
-      std::hypot(xy_cloud->points[i].x - pose.position.x, xy_cloud->points[i].y - pose.position.y);
-    const int min_points_threshold = std::min(
-      std::max(static_cast<int>(min_points_and_distance_ratio_ / distance + 0.5f), min_points_),
-      max_points_);
-    const int points_num = kd_tree_->radiusSearch(i, search_radius_, k_indices, k_dists);
-
-    if (min_points_threshold <= points_num) {
-      output.points.push_back(low_conf_xyz_cloud.points.at(i));
+  for (int i = 0; i < num_points; ++i) {
+    if (is_inlier[i]) {
+      output.points.push_back(input.points[i]);
     } else {
-      outlier.points.push_back(low_conf_xyz_cloud.points.at(i));
+      outlier.points.push_back(input.points[i]);
     }
   }
 }
 
+void RadiusSearch2dfilter::filter(
+  const PclPointCloud & input, const Pose & pose, PclPointCloud & output, PclPointCloud & outlier)
+{
+  grid_.setInputCloud({&input});
+  filterByGrid(input, pose, output, outlier);
+}
+
+void RadiusSearch2dfilter::filter(
+  const PclPointCloud & high_conf_input, const PclPointCloud & low_conf_input, const Pose & pose,
+  PclPointCloud & output, PclPointCloud & outlier)
+{
+  // neighbors are counted over all points, but only low confidence points are judged
+  grid_.setInputCloud({&low_conf_input, &high_conf_input});
+  filterByGrid(low_conf_input, pose, output, outlier);
+}
+
 OccupancyGridMapOutlierFilterComponent::OccupancyGridMapOutlierFilterComponent(
   const rclcpp::NodeOptions & options)
 : Node("OccupancyGridMapOutlierFilter", options)
@@ -257,18 +350,52 @@ void OccupancyGridMapOutlierFilterComponent::filterByOccupancyGridMap(
   const OccupancyGrid & occupancy_grid_map, const PointCloud2 & pointcloud,
   PclPointCloud & high_confidence, PclPointCloud & low_confidence)
 {
-  for (sensor_msgs::PointCloud2ConstIterator<float> x(pointcloud, "x"), y(pointcloud, "y"),
-       z(pointcloud, "z");
-       x != x.end(); ++x, ++y, ++z) {
-    const auto cost = getCost(occupancy_grid_map, *x, *y);
-    if (cost) {
-      if (cost_threshold_ < *cost) {
-        high_confidence.push_back(pcl::PointXYZ(*x, *y, *z));
-      } else {
-        low_confidence.push_back(pcl::PointXYZ(*x, *y, *z));
-      }
+  // read coordinates directly from the buffer so that points can be classified in parallel
+  const auto x_offset = getFloatFieldOffset(pointcloud, "x");
+  const auto y_offset = getFloatFieldOffset(pointcloud, "y");
+  const auto z_offset = getFloatFieldOffset(pointcloud, "z");
+  if (!x_offset || !y_offset || !z_offset) {
+    RCLCPP_WARN(get_logger(), "input pointcloud does not have float32 x, y and z fields");
+    return;
+  }
+  if (pointcloud.width == 0 || pointcloud.height == 0) {
+    return;
+  }
+  // rows of an organized pointcloud may be padded, so the points are located by row_step
+  const size_t row_size = static_cast<size_t>(pointcloud.width) * pointcloud.point_step;
+  if (
+    pointcloud.row_step < row_size ||
+    pointcloud.data.size() <
+      static_cast<size_t>(pointcloud.height - 1) * pointcloud.row_step + row_size) {
+    RCLCPP_WARN(get_logger(), "input pointcloud data is smaller than its width and height");
+    return;
+  }
+  const auto get_point = [&](const size_t i) {
+    const uint8_t * point_ptr = &pointcloud.data[(i / pointcloud.width) * pointcloud.row_step +
+                                                 (i % pointcloud.width) * pointcloud.point_step];
+    pcl::PointXYZ p;
+    std::memcpy(&p.x, point_ptr + *x_offset, sizeof(float));
+    std::memcpy(&p.y, point_ptr + *y_offset, sizeof(float));
+    std::memcpy(&p.z, point_ptr + *z_offset, sizeof(float));
+    return p;
+  };
+
+  const int num_points = static_cast<int>(pointcloud.width * pointcloud.height);
+  std::vector<uint8_t> is_low_confidence(num_points);
+#pragma omp parallel for
+  for (int i = 0; i < num_points; ++i) {
+    const auto p = get_point(i);
+    const auto cost = getCost(occupancy_grid_map, p.x, p.y);
+    is_low_confidence[i] = cost && *cost <= cost_threshold_;
+  }
+
+  high_confidence.reserve(num_points);
+  low_confidence.reserve(num_points);
+  for (int i = 0; i < num_points; ++i) {
+    if (is_low_confidence[i]) {
+      low_confidence.push_back(get_point(i));
     } else {
-      high_confidence.push_back(pcl::PointXYZ(*x, *y, *z));
+      high_confidence.push_back(get_point(i));
     }
   }
 }
@@ -0,0 +1,141 @@
+// Copyright 2021 Tier IV, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "occupancy_grid_map_outlier_filter/occupancy_grid_map_outlier_filter_nodelet.hpp"
+
+#include <gtest/gtest.h>
+#include <pcl/point_types.h>
+#include <pcl/search/kdtree.h>
+
+#include <limits>
+#include <random>
+#include <vector>
+
+using occupancy_grid_map_outlier_filter::PclPointCloud;
+using occupancy_grid_map_outlier_filter::RadiusSearch2dGrid;
+
+namespace
+{
+constexpr float search_radius = 1.0f;
+
+// dense clusters on top of sparse noise, including negative coordinates and far away cells
+PclPointCloud createCloud(const unsigned int seed, const size_t num_noise)
+{
+  std::mt19937 engine(seed);
+  std::uniform_real_distribution<float> noise(-100.0f, 100.0f);
+  std::normal_distribution<float> cluster(0.0f, 0.8f);
+
+  PclPointCloud cloud;
+  for (size_t i = 0; i < num_noise; ++i) {
+    const float x = noise(engine);
+    const float y = noise(engine);
+    cloud.push_back(pcl::PointXYZ(x, y, 0.0f));
+  }
+  for (const float center : {-30.0f, -0.5f, 12.0f}) {
+    for (int i = 0; i < 300; ++i) {
+      const float x = center + cluster(engine);
+      const float y = -center + cluster(engine);
+      cloud.push_back(pcl::PointXYZ(x, y, 0.0f));
+    }
+  }
+  return cloud;
+}
+
+// previous implementation: number of points within the radius found by a kd-tree
+std::vector<int> countNeighborsByKdTree(
+  const std::vector<const PclPointCloud *> & clouds, const size_t num_queries)
+{
+  pcl::PointCloud<pcl::PointXY>::Ptr xy_cloud(new pcl::PointCloud<pcl::PointXY>);
+  for (const auto & cloud : clouds) {
+    for (const auto & p : cloud->points) {
+      pcl::PointXY xy;
+      xy.x = p.x;
+      xy.y = p.y;
+      xy_cloud->points.push_back(xy);
+    }
+  }
+
+  pcl::search::KdTree<pcl::PointXY> kd_tree(false);
+  kd_tree.setInputCloud(xy_cloud);
+  std::vector<int> k_indices;
+  std::vector<float> k_dists;
+  std::vector<int> counts;
+  for (size_t i = 0; i < num_queries; ++i) {
+    counts.push_back(kd_tree.radiusSearch(static_cast<int>(i), search_radius, k_indices, k_dists));
+  }
+  return counts;
+}
+
+void expectSameCounts(
+  const RadiusSearch2dGrid & grid, const PclPointCloud & queries,
+  const std::vector<int> & expected)
+{
+  ASSERT_EQ(queries.points.size(), expected.size());
+  for (size_t i = 0; i < expected.size(); ++i) {
+    const auto & p = queries.points.at(i);
+    EXPECT_EQ(grid.countNeighbors(p.x, p.y, std::numeric_limits<int>::max()), expected.at(i))
+      << "point " << i;
+    // counting stops at the threshold, which must not change the inlier decision
+    for (const int threshold : {1, 4, 20, 70}) {
+      EXPECT_EQ(
+        grid.countNeighbors(p.x, p.y, threshold) >= threshold, expected.at(i) >= threshold)
+        << "point " << i << ", threshold " << threshold;
+    }
+  }
+}
+}  // namespace
+
+TEST(RadiusSearch2dGrid, SameCountsAsKdTree)
+{
+  const auto cloud = createCloud(0, 2000);
+
+  RadiusSearch2dGrid grid(search_radius);
+  grid.setInputCloud({&cloud});
+  expectSameCounts(grid, cloud, countNeighborsByKdTree({&cloud}, cloud.points.size()));
+}
+
+TEST(RadiusSearch2dGrid, SameCountsAsKdTreeOverTwoClouds)
+{
+  const auto low_conf_cloud = createCloud(1, 500);
+  const auto high_conf_cloud = createCloud(2, 3000);
+
+  // only the low confidence points are judged, against the neighbors in both clouds
+  RadiusSearch2dGrid grid(search_radius);
+  grid.setInputCloud({&low_conf_cloud, &high_conf_cloud});
+  expectSameCounts(
+    grid, low_conf_cloud,
+    countNeighborsByKdTree({&low_conf_cloud, &high_conf_cloud}, low_conf_cloud.points.size()));
+}
+
+TEST(RadiusSearch2dGrid, ReuseAcrossFrames)
+{
+  const auto large_cloud = createCloud(3, 5000);
+  const auto small_cloud = createCloud(4, 10);
+
+  // the buffers sized for a larger frame must not leave stale points behind
+  RadiusSearch2dGrid grid(search_radius);
+  grid.setInputCloud({&large_cloud});
+  grid.setInputCloud({&small_cloud});
+  expectSameCounts(
+    grid, small_cloud, countNeighborsByKdTree({&small_cloud}, small_cloud.points.size()));
+}
+
+TEST(RadiusSearch2dGrid, EmptyCloud)
+{
+  const PclPointCloud cloud;
+
+  RadiusSearch2dGrid grid(search_radius);
+  grid.setInputCloud({&cloud});
+  EXPECT_EQ(grid.countNeighbors(0.0f, 0.0f, std::numeric_limits<int>::max()), 0);
+}
@@ -0,0 +1,37 @@
+// Copyright 2020 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TRAFFIC_LIGHT_MAP_BASED_DETECTOR__FRUSTUM_FOOTPRINT_HPP_
+#define TRAFFIC_LIGHT_MAP_BASED_DETECTOR__FRUSTUM_FOOTPRINT_HPP_
+
+#include <geometry_msgs/msg/pose.hpp>
+
+#include <image_geometry/pinhole_camera_model.h>
+
+namespace traffic_light
+{
+/**
+ * @brief bounding box on the ground plane of the camera frustum within max_distance_range of the
+ * camera in 2d. The pitch and roll of the camera are taken into account, and the image is widened
+ * by a margin for lens distortion. The whole square around the camera is returned when the frustum
+ * contains the vertical direction.
+ */
+void getFrustumFootprintBox(
+  const geometry_msgs::msg::Pose & camera_pose,
+  const image_geometry::PinholeCameraModel & pinhole_camera_model,
+  const double max_distance_range, double & min_x, double & min_y, double & max_x,
+  double & max_y);
+}  // namespace traffic_light
+
+#endif  // TRAFFIC_LIGHT_MAP_BASED_DETECTOR__FRUSTUM_FOOTPRINT_HPP_
@@ -48,6 +48,7 @@
 #include <lanelet2_core/LaneletMap.h>
 #include <lanelet2_routing/RoutingGraph.h>
 #include <lanelet2_traffic_rules/TrafficRulesFactory.h>
+#include <tf2/LinearMath/Transform.h>
 #include <tf2_ros/buffer.h>
 #include <tf2_ros/transform_listener.h>
 
@@ -57,6 +58,33 @@
 
 namespace traffic_light
 {
+/**
+ * @brief uniform 2d grid over the center positions of traffic lights, stored as one contiguous
+ * array sorted by cell, to collect the traffic lights in a box on the ground plane
+ */
+class TrafficLightGrid
+{
+public:
+  TrafficLightGrid(
+    const std::vector<lanelet::ConstLineString3d> & traffic_lights, const double cell_size);
+
+  void query(
+    const double min_x, const double min_y, const double max_x, const double max_y,
+    std::vector<lanelet::ConstLineString3d> & traffic_lights) const;
+
+private:
+  int64_t toCellX(const double x) const;
+  int64_t toCellY(const double y) const;
+
+  double cell_size_;
+  double min_x_{0.0};
+  double min_y_{0.0};
+  int64_t width_{0};
+  int64_t height_{0};
+  std::vector<size_t> cell_offsets_;
+  std::vector<lanelet::ConstLineString3d> traffic_lights_;
+};
+
 class MapBasedDetector : public rclcpp::Node
 {
 public:
@@ -96,6 +124,8 @@ private:
 
   std::shared_ptr<TrafficLightSet> all_traffic_lights_ptr_;
   std::shared_ptr<TrafficLightSet> route_traffic_lights_ptr_;
+  std::shared_ptr<TrafficLightGrid> all_traffic_lights_grid_ptr_;
+  std::shared_ptr<TrafficLightGrid> route_traffic_lights_grid_ptr_;
 
   lanelet::LaneletMapPtr lanelet_map_ptr_;
   lanelet::traffic_rules::TrafficRulesPtr traffic_rules_ptr_;
@@ -106,7 +136,7 @@ private:
   void cameraInfoCallback(const sensor_msgs::msg::CameraInfo::ConstSharedPtr input_msg);
   void routeCallback(const autoware_auto_planning_msgs::msg::HADMapRoute::ConstSharedPtr input_msg);
   void getVisibleTrafficLights(
-    const TrafficLightSet & all_traffic_lights, const geometry_msgs::msg::Pose & camera_pose,
+    const TrafficLightGrid & traffic_light_grid, const geometry_msgs::msg::Pose & camera_pose,
     const image_geometry::PinholeCameraModel & pinhole_camera_model,
     std::vector<lanelet::ConstLineString3d> & visible_traffic_lights);
   bool isInDistanceRange(
@@ -118,7 +148,7 @@ private:
     const image_geometry::PinholeCameraModel & pinhole_camera_model,
     const geometry_msgs::msg::Point & point) const;
   bool getTrafficLightRoi(
-    const geometry_msgs::msg::Pose & camera_pose,
+    const tf2::Transform & tf_camera2map,
     const image_geometry::PinholeCameraModel & pinhole_camera_model,
     const lanelet::ConstLineString3d traffic_light, const Config & config,
     autoware_auto_perception_msgs::msg::TrafficLightRoi & tl_roi);
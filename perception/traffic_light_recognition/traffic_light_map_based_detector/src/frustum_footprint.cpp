@@ -0,0 +1,115 @@
+// Copyright 2020 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "traffic_light_map_based_detector/frustum_footprint.hpp"
+
+#include <autoware_utils/math/normalization.hpp>
+#include <autoware_utils/math/unit_conversion.hpp>
+
+#include <tf2/LinearMath/Matrix3x3.h>
+#include <tf2/LinearMath/Quaternion.h>
+#include <tf2/LinearMath/Vector3.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+namespace traffic_light
+{
+void getFrustumFootprintBox(
+  const geometry_msgs::msg::Pose & camera_pose,
+  const image_geometry::PinholeCameraModel & pinhole_camera_model,
+  const double max_distance_range, double & min_x, double & min_y, double & max_x,
+  double & max_y)
+{
+  const double camera_x = camera_pose.position.x;
+  const double camera_y = camera_pose.position.y;
+  min_x = camera_x - max_distance_range;
+  min_y = camera_y - max_distance_range;
+  max_x = camera_x + max_distance_range;
+  max_y = camera_y + max_distance_range;
+
+  const double fx = pinhole_camera_model.fx();
+  const double fy = pinhole_camera_model.fy();
+  if (fx <= 0.0 || fy <= 0.0) {
+    return;
+  }
+
+  // image borders on the plane at unit depth in the camera frame, with a margin for distortion
+  const double margin = std::tan(autoware_utils::deg2rad(10.0));
+  const double cx = pinhole_camera_model.cx();
+  const double cy = pinhole_camera_model.cy();
+  const double left = -cx / fx - margin;
+  const double right = (pinhole_camera_model.cameraInfo().width - cx) / fx + margin;
+  const double top = -cy / fy - margin;
+  const double bottom = (pinhole_camera_model.cameraInfo().height - cy) / fy + margin;
+
+  // rays through the image corners in order around the optical axis, in the map frame
+  const tf2::Matrix3x3 rotation(tf2::Quaternion(
+    camera_pose.orientation.x, camera_pose.orientation.y, camera_pose.orientation.z,
+    camera_pose.orientation.w));
+  const tf2::Vector3 optical_axis = rotation * tf2::Vector3(0.0, 0.0, 1.0);
+  const std::array<tf2::Vector3, 4> corner_rays = {
+    rotation * tf2::Vector3(left, top, 1.0), rotation * tf2::Vector3(right, top, 1.0),
+    rotation * tf2::Vector3(right, bottom, 1.0), rotation * tf2::Vector3(left, bottom, 1.0)};
+
+  // the frustum contains the vertical direction if it is inside all the side planes, and then the
+  // footprint surrounds the camera
+  bool contains_up = true;
+  bool contains_down = true;
+  for (size_t i = 0; i < corner_rays.size(); ++i) {
+    tf2::Vector3 inward_normal = corner_rays.at(i).cross(corner_rays.at((i + 1) % 4));
+    if (inward_normal.dot(optical_axis) < 0.0) {
+      inward_normal = -inward_normal;
+    }
+    contains_up = contains_up && 0.0 <= inward_normal.z();
+    contains_down = contains_down && inward_normal.z() <= 0.0;
+  }
+  if (contains_up || contains_down) {
+    return;
+  }
+
+  // otherwise the footprint is a sector narrower than pi around the optical axis, whose sides are
+  // the corner rays
+  const double axis_yaw = std::atan2(optical_axis.y(), optical_axis.x());
+  double min_yaw = 0.0;
+  double max_yaw = 0.0;
+  for (const auto & ray : corner_rays) {
+    const double yaw = autoware_utils::normalizeRadian(std::atan2(ray.y(), ray.x()) - axis_yaw);
+    min_yaw = std::min(min_yaw, yaw);
+    max_yaw = std::max(max_yaw, yaw);
+  }
+
+  // bounding box of the sector
+  const auto add_point = [&](const double angle) {
+    const double x = camera_x + max_distance_range * std::cos(angle);
+    const double y = camera_y + max_distance_range * std::sin(angle);
+    min_x = std::min(min_x, x);
+    min_y = std::min(min_y, y);
+    max_x = std::max(max_x, x);
+    max_y = std::max(max_y, y);
+  };
+  min_x = max_x = camera_x;
+  min_y = max_y = camera_y;
+  add_point(axis_yaw + min_yaw);
+  add_point(axis_yaw + max_yaw);
+  for (int i = 0; i < 4; ++i) {
+    const double axis_angle = i * M_PI_2;
+    const double yaw = autoware_utils::normalizeRadian(axis_angle - axis_yaw);
+    if (min_yaw <= yaw && yaw <= max_yaw) {
+      add_point(axis_angle);
+    }
+  }
+}
+}  // namespace traffic_light
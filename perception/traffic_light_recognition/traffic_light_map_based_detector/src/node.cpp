@@ -32,6 +32,8 @@
 
 #include "traffic_light_map_based_detector/node.hpp"
 
+#include "traffic_light_map_based_detector/frustum_footprint.hpp"
+
 #include <autoware_utils/autoware_utils.hpp>
 #include <lanelet2_extension/utility/message_conversion.hpp>
 #include <lanelet2_extension/utility/utilities.hpp>
@@ -50,6 +52,8 @@
 #include <tf2/LinearMath/Transform.h>
 
 #include <algorithm>
+#include <cmath>
+#include <limits>
 #include <memory>
 #include <string>
 #include <vector>
@@ -60,6 +64,8 @@
 
 namespace
 {
+constexpr double traffic_light_grid_cell_size = 50.0;
+
 cv::Point2d calcRawImagePointFromPoint3D(
   const image_geometry::PinholeCameraModel & pinhole_camera_model, const cv::Point3d & point3d)
 {
@@ -75,6 +81,27 @@ cv::Point2d calcRawImagePointFromPoint3D(
     pinhole_camera_model, cv::Point3d(point3d.x, point3d.y, point3d.z));
 }
 
+geometry_msgs::msg::Point getTrafficLightCentralPoint(
+  const lanelet::ConstLineString3d & traffic_light)
+{
+  const auto & tl_left_down_point = traffic_light.front();
+  const auto & tl_right_down_point = traffic_light.back();
+  const double tl_height = traffic_light.attributeOr("height", 0.0);
+
+  geometry_msgs::msg::Point tl_central_point;
+  tl_central_point.x = (tl_right_down_point.x() + tl_left_down_point.x()) / 2.0;
+  tl_central_point.y = (tl_right_down_point.y() + tl_left_down_point.y()) / 2.0;
+  tl_central_point.z = (tl_right_down_point.z() + tl_left_down_point.z() + tl_height) / 2.0;
+  return tl_central_point;
+}
+
+tf2::Transform toTransform(const geometry_msgs::msg::Pose & pose)
+{
+  return tf2::Transform(
+    tf2::Quaternion(pose.orientation.x, pose.orientation.y, pose.orientation.z, pose.orientation.w),
+    tf2::Vector3(pose.position.x, pose.position.y, pose.position.z));
+}
+
 void roundInImageFrame(
   const image_geometry::PinholeCameraModel & pinhole_camera_model, cv::Point2d & point)
 {
@@ -88,6 +115,78 @@ void roundInImageFrame(
 
 namespace traffic_light
 {
+TrafficLightGrid::TrafficLightGrid(
+  const std::vector<lanelet::ConstLineString3d> & traffic_lights, const double cell_size)
+: cell_size_(cell_size)
+{
+  if (traffic_lights.empty()) {
+    return;
+  }
+
+  std::vector<geometry_msgs::msg::Point> central_points;
+  central_points.reserve(traffic_lights.size());
+  double max_x = std::numeric_limits<double>::lowest();
+  double max_y = std::numeric_limits<double>::lowest();
+  min_x_ = std::numeric_limits<double>::max();
+  min_y_ = std::numeric_limits<double>::max();
+  for (const auto & traffic_light : traffic_lights) {
+    central_points.push_back(getTrafficLightCentralPoint(traffic_light));
+    min_x_ = std::min(min_x_, central_points.back().x);
+    min_y_ = std::min(min_y_, central_points.back().y);
+    max_x = std::max(max_x, central_points.back().x);
+    max_y = std::max(max_y, central_points.back().y);
+  }
+  width_ = toCellX(max_x) + 1;
+  height_ = toCellY(max_y) + 1;
+
+  // counting sort of the traffic lights by cell
+  std::vector<size_t> cell_indices(traffic_lights.size());
+  cell_offsets_.assign(width_ * height_ + 1, 0);
+  for (size_t i = 0; i < traffic_lights.size(); ++i) {
+    cell_indices.at(i) = toCellY(central_points.at(i).y) * width_ + toCellX(central_points.at(i).x);
+    ++cell_offsets_.at(cell_indices.at(i) + 1);
+  }
+  for (size_t i = 1; i < cell_offsets_.size(); ++i) {
+    cell_offsets_.at(i) += cell_offsets_.at(i - 1);
+  }
+  std::vector<size_t> cursors(cell_offsets_.begin(), cell_offsets_.end() - 1);
+  traffic_lights_.resize(traffic_lights.size());
+  for (size_t i = 0; i < traffic_lights.size(); ++i) {
+    traffic_lights_.at(cursors.at(cell_indices.at(i))++) = traffic_lights.at(i);
+  }
+}
+
+int64_t TrafficLightGrid::toCellX(const double x) const
+{
+  return static_cast<int64_t>(std::floor((x - min_x_) / cell_size_));
+}
+
+int64_t TrafficLightGrid::toCellY(const double y) const
+{
+  return static_cast<int64_t>(std::floor((y - min_y_) / cell_size_));
+}
+
+void TrafficLightGrid::query(
+  const double min_x, const double min_y, const double max_x, const double max_y,
+  std::vector<lanelet::ConstLineString3d> & traffic_lights) const
+{
+  if (traffic_lights_.empty()) {
+    return;
+  }
+  const int64_t cell_min_x = std::max<int64_t>(toCellX(min_x), 0);
+  const int64_t cell_min_y = std::max<int64_t>(toCellY(min_y), 0);
+  const int64_t cell_max_x = std::min<int64_t>(toCellX(max_x), width_ - 1);
+  const int64_t cell_max_y = std::min<int64_t>(toCellY(max_y), height_ - 1);
+  for (int64_t cell_y = cell_min_y; cell_y <= cell_max_y; ++cell_y) {
+    for (int64_t cell_x = cell_min_x; cell_x <= cell_max_x; ++cell_x) {
+      const size_t cell_index = cell_y * width_ + cell_x;
+      traffic_lights.insert(
+        traffic_lights.end(), traffic_lights_.begin() + cell_offsets_.at(cell_index),
+        traffic_lights_.begin() + cell_offsets_.at(cell_index + 1));
+    }
+  }
+}
+
 MapBasedDetector::MapBasedDetector(const rclcpp::NodeOptions & node_options)
 : Node("traffic_light_map_based_detector", node_options),
   tf_buffer_(this->get_clock()),
@@ -152,14 +251,14 @@ void MapBasedDetector::cameraInfoCallback(
    */
   std::vector<lanelet::ConstLineString3d> visible_traffic_lights;
   // If get a route, use only traffic lights on the route.
-  if (route_traffic_lights_ptr_ != nullptr) {
+  if (route_traffic_lights_grid_ptr_ != nullptr) {
     getVisibleTrafficLights(
-      *route_traffic_lights_ptr_, camera_pose_stamped.pose, pinhole_camera_model,
+      *route_traffic_lights_grid_ptr_, camera_pose_stamped.pose, pinhole_camera_model,
       visible_traffic_lights);
     // If don't get a route, use the traffic lights around ego vehicle.
-  } else if (all_traffic_lights_ptr_ != nullptr) {
+  } else if (all_traffic_lights_grid_ptr_ != nullptr) {
     getVisibleTrafficLights(
-      *all_traffic_lights_ptr_, camera_pose_stamped.pose, pinhole_camera_model,
+      *all_traffic_lights_grid_ptr_, camera_pose_stamped.pose, pinhole_camera_model,
       visible_traffic_lights);
     // This shouldn't run.
   } else {
@@ -170,10 +269,10 @@ void MapBasedDetector::cameraInfoCallback(
    * Get the ROI from the lanelet and the intrinsic matrix of camera to determine where it appears
    * in image.
    */
+  const tf2::Transform tf_camera2map = toTransform(camera_pose_stamped.pose).inverse();
   for (const auto & traffic_light : visible_traffic_lights) {
     autoware_auto_perception_msgs::msg::TrafficLightRoi tl_roi;
-    if (!getTrafficLightRoi(
-          camera_pose_stamped.pose, pinhole_camera_model, traffic_light, config_, tl_roi)) {
+    if (!getTrafficLightRoi(tf_camera2map, pinhole_camera_model, traffic_light, config_, tl_roi)) {
       continue;
     }
     output_msg.rois.push_back(tl_roi);
@@ -183,7 +282,7 @@ void MapBasedDetector::cameraInfoCallback(
 }
 
 bool MapBasedDetector::getTrafficLightRoi(
-  const geometry_msgs::msg::Pose & camera_pose,
+  const tf2::Transform & tf_camera2map,
   const image_geometry::PinholeCameraModel & pinhole_camera_model,
   const lanelet::ConstLineString3d traffic_light, const Config & config,
   autoware_auto_perception_msgs::msg::TrafficLightRoi & tl_roi)
@@ -192,11 +291,6 @@ bool MapBasedDetector::getTrafficLightRoi(
   const auto & tl_left_down_point = traffic_light.front();
   const auto & tl_right_down_point = traffic_light.back();
 
-  tf2::Transform tf_map2camera(
-    tf2::Quaternion(
-      camera_pose.orientation.x, camera_pose.orientation.y, camera_pose.orientation.z,
-      camera_pose.orientation.w),
-    tf2::Vector3(camera_pose.position.x, camera_pose.position.y, camera_pose.position.z));
   // id
   tl_roi.id = traffic_light.id();
 
@@ -207,7 +301,7 @@ bool MapBasedDetector::getTrafficLightRoi(
       tf2::Vector3(
         tl_left_down_point.x(), tl_left_down_point.y(), tl_left_down_point.z() + tl_height));
     tf2::Transform tf_camera2tl;
-    tf_camera2tl = tf_map2camera.inverse() * tf_map2tl;
+    tf_camera2tl = tf_camera2map * tf_map2tl;
     // max vibration
     const double max_vibration_x =
       std::sin(config.max_vibration_yaw * 0.5) * tf_camera2tl.getOrigin().z() +
@@ -236,7 +330,7 @@ bool MapBasedDetector::getTrafficLightRoi(
       tf2::Quaternion(0, 0, 0, 1),
       tf2::Vector3(tl_right_down_point.x(), tl_right_down_point.y(), tl_right_down_point.z()));
     tf2::Transform tf_camera2tl;
-    tf_camera2tl = tf_map2camera.inverse() * tf_map2tl;
+    tf_camera2tl = tf_camera2map * tf_map2tl;
     // max vibration
     const double max_vibration_x =
       std::sin(config.max_vibration_yaw * 0.5) * tf_camera2tl.getOrigin().z() +
@@ -286,6 +380,10 @@ void MapBasedDetector::mapCallback(
       all_traffic_lights_ptr_->insert(static_cast<lanelet::ConstLineString3d>(lsp));
     }
   }
+  all_traffic_lights_grid_ptr_ = std::make_shared<TrafficLightGrid>(
+    std::vector<lanelet::ConstLineString3d>(
+      all_traffic_lights_ptr_->begin(), all_traffic_lights_ptr_->end()),
+    traffic_light_grid_cell_size);
 }
 
 void MapBasedDetector::routeCallback(
@@ -321,25 +419,49 @@ void MapBasedDetector::routeCallback(
       route_traffic_lights_ptr_->insert(static_cast<lanelet::ConstLineString3d>(lsp));
     }
   }
+  route_traffic_lights_grid_ptr_ = std::make_shared<TrafficLightGrid>(
+    std::vector<lanelet::ConstLineString3d>(
+      route_traffic_lights_ptr_->begin(), route_traffic_lights_ptr_->end()),
+    traffic_light_grid_cell_size);
 }
 
 void MapBasedDetector::getVisibleTrafficLights(
-  const MapBasedDetector::TrafficLightSet & all_traffic_lights,
-  const geometry_msgs::msg::Pose & camera_pose,
+  const TrafficLightGrid & traffic_light_grid, const geometry_msgs::msg::Pose & camera_pose,
   const image_geometry::PinholeCameraModel & pinhole_camera_model,
   std::vector<lanelet::ConstLineString3d> & visible_traffic_lights)
 {
-  for (const auto & traffic_light : all_traffic_lights) {
+  constexpr double max_distance_range = 200.0;
+  constexpr double max_angle_range = autoware_utils::deg2rad(40.0);
+
+  // get direction of z axis
+  tf2::Vector3 camera_z_dir(0, 0, 1);
+  tf2::Matrix3x3 camera_rotation_matrix(tf2::Quaternion(
+    camera_pose.orientation.x, camera_pose.orientation.y, camera_pose.orientation.z,
+    camera_pose.orientation.w));
+  camera_z_dir = camera_rotation_matrix * camera_z_dir;
+  double camera_yaw = std::atan2(camera_z_dir.y(), camera_z_dir.x());
+  camera_yaw = autoware_utils::normalizeRadian(camera_yaw);
+
+  const tf2::Transform tf_camera2map = toTransform(camera_pose).inverse();
+
+  // only the traffic lights around the ground footprint of the camera frustum are checked
+  double min_x{};
+  double min_y{};
+  double max_x{};
+  double max_y{};
+  getFrustumFootprintBox(
+    camera_pose, pinhole_camera_model, max_distance_range, min_x, min_y, max_x, max_y);
+  std::vector<lanelet::ConstLineString3d> candidate_traffic_lights;
+  traffic_light_grid.query(min_x, min_y, max_x, max_y, candidate_traffic_lights);
+  // keep the same order as the traffic light set
+  std::sort(candidate_traffic_lights.begin(), candidate_traffic_lights.end(), IdLessThan{});
+
+  for (const auto & traffic_light : candidate_traffic_lights) {
     const auto & tl_left_down_point = traffic_light.front();
     const auto & tl_right_down_point = traffic_light.back();
-    const double tl_height = traffic_light.attributeOr("height", 0.0);
 
     // check distance range
-    geometry_msgs::msg::Point tl_central_point;
-    tl_central_point.x = (tl_right_down_point.x() + tl_left_down_point.x()) / 2.0;
-    tl_central_point.y = (tl_right_down_point.y() + tl_left_down_point.y()) / 2.0;
-    tl_central_point.z = (tl_right_down_point.z() + tl_left_down_point.z() + tl_height) / 2.0;
-    constexpr double max_distance_range = 200.0;
+    const geometry_msgs::msg::Point tl_central_point = getTrafficLightCentralPoint(traffic_light);
     if (!isInDistanceRange(tl_central_point, camera_pose.position, max_distance_range)) {
       continue;
     }
@@ -350,36 +472,18 @@ void MapBasedDetector::getVisibleTrafficLights(
         tl_right_down_point.y() - tl_left_down_point.y(),
         tl_right_down_point.x() - tl_left_down_point.x()) +
       M_PI_2);
-    constexpr double max_angle_range = autoware_utils::deg2rad(40.0);
-
-    // get direction of z axis
-    tf2::Vector3 camera_z_dir(0, 0, 1);
-    tf2::Matrix3x3 camera_rotation_matrix(tf2::Quaternion(
-      camera_pose.orientation.x, camera_pose.orientation.y, camera_pose.orientation.z,
-      camera_pose.orientation.w));
-    camera_z_dir = camera_rotation_matrix * camera_z_dir;
-    double camera_yaw = std::atan2(camera_z_dir.y(), camera_z_dir.x());
-    camera_yaw = autoware_utils::normalizeRadian(camera_yaw);
     if (!isInAngleRange(tl_yaw, camera_yaw, max_angle_range)) {
       continue;
     }
 
     // check within image frame
-    tf2::Transform tf_map2camera(
-      tf2::Quaternion(
-        camera_pose.orientation.x, camera_pose.orientation.y, camera_pose.orientation.z,
-        camera_pose.orientation.w),
-      tf2::Vector3(camera_pose.position.x, camera_pose.position.y, camera_pose.position.z));
-    tf2::Transform tf_map2tl(
-      tf2::Quaternion(0, 0, 0, 1),
-      tf2::Vector3(tl_central_point.x, tl_central_point.y, tl_central_point.z));
-    tf2::Transform tf_camera2tl;
-    tf_camera2tl = tf_map2camera.inverse() * tf_map2tl;
+    const tf2::Vector3 camera2tl_origin =
+      tf_camera2map * tf2::Vector3(tl_central_point.x, tl_central_point.y, tl_central_point.z);
 
     geometry_msgs::msg::Point camera2tl_point;
-    camera2tl_point.x = tf_camera2tl.getOrigin().x();
-    camera2tl_point.y = tf_camera2tl.getOrigin().y();
-    camera2tl_point.z = tf_camera2tl.getOrigin().z();
+    camera2tl_point.x = camera2tl_origin.x();
+    camera2tl_point.y = camera2tl_origin.y();
+    camera2tl_point.z = camera2tl_origin.z();
     if (!isInImageFrame(pinhole_camera_model, camera2tl_point)) {
       continue;
     }
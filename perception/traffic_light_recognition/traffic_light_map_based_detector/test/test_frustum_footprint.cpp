@@ -0,0 +1,200 @@
+// Copyright 2020 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "traffic_light_map_based_detector/frustum_footprint.hpp"
+
+#include <sensor_msgs/msg/camera_info.hpp>
+
+#include <gtest/gtest.h>
+#include <tf2/LinearMath/Matrix3x3.h>
+#include <tf2/LinearMath/Quaternion.h>
+#include <tf2/LinearMath/Vector3.h>
+
+#include <cmath>
+#include <random>
+
+namespace
+{
+constexpr double max_distance_range = 200.0;
+
+image_geometry::PinholeCameraModel createCameraModel(
+  const double focal_length, const double cx, const double cy)
+{
+  sensor_msgs::msg::CameraInfo camera_info;
+  camera_info.width = 1920;
+  camera_info.height = 1080;
+  camera_info.distortion_model = "plumb_bob";
+  camera_info.d = {0.0, 0.0, 0.0, 0.0, 0.0};
+  camera_info.k = {focal_length, 0.0, cx, 0.0, focal_length, cy, 0.0, 0.0, 1.0};
+  camera_info.r = {1.0, 0.0, 0.0, 0.0, 1.0, 0.0, 0.0, 0.0, 1.0};
+  camera_info.p = {focal_length, 0.0, cx, 0.0, 0.0, focal_length, cy, 0.0, 0.0, 0.0, 1.0, 0.0};
+  image_geometry::PinholeCameraModel pinhole_camera_model;
+  pinhole_camera_model.fromCameraInfo(camera_info);
+  return pinhole_camera_model;
+}
+
+// pose of the optical frame (z forward, x right and y down) of a camera mounted with the angles
+geometry_msgs::msg::Pose createCameraPose(
+  const double x, const double y, const double z, const double roll, const double pitch,
+  const double yaw)
+{
+  tf2::Quaternion mount_quaternion;
+  mount_quaternion.setRPY(roll, pitch, yaw);
+  tf2::Quaternion optical_quaternion;
+  optical_quaternion.setRPY(-M_PI_2, 0.0, -M_PI_2);
+  const auto quaternion = mount_quaternion * optical_quaternion;
+
+  geometry_msgs::msg::Pose pose;
+  pose.position.x = x;
+  pose.position.y = y;
+  pose.position.z = z;
+  pose.orientation.x = quaternion.x();
+  pose.orientation.y = quaternion.y();
+  pose.orientation.z = quaternion.z();
+  pose.orientation.w = quaternion.w();
+  return pose;
+}
+
+// the checks of MapBasedDetector without the pre-filter: in the distance range and in the image
+bool isVisible(
+  const geometry_msgs::msg::Pose & camera_pose,
+  const image_geometry::PinholeCameraModel & pinhole_camera_model, const tf2::Vector3 & point)
+{
+  const double dx = point.x() - camera_pose.position.x;
+  const double dy = point.y() - camera_pose.position.y;
+  if (max_distance_range * max_distance_range <= dx * dx + dy * dy) {
+    return false;
+  }
+
+  const tf2::Matrix3x3 rotation(tf2::Quaternion(
+    camera_pose.orientation.x, camera_pose.orientation.y, camera_pose.orientation.z,
+    camera_pose.orientation.w));
+  const tf2::Vector3 camera_point =
+    rotation.transpose() *
+    (point - tf2::Vector3(camera_pose.position.x, camera_pose.position.y, camera_pose.position.z));
+  if (camera_point.z() <= 0.0) {
+    return false;
+  }
+  const cv::Point2d image_point = pinhole_camera_model.unrectifyPoint(
+    pinhole_camera_model.project3dToPixel(
+      cv::Point3d(camera_point.x(), camera_point.y(), camera_point.z())));
+  return 0 <= image_point.x && image_point.x < pinhole_camera_model.cameraInfo().width &&
+         0 <= image_point.y && image_point.y < pinhole_camera_model.cameraInfo().height;
+}
+
+void expectWholeSquare(
+  const geometry_msgs::msg::Pose & camera_pose,
+  const image_geometry::PinholeCameraModel & pinhole_camera_model)
+{
+  double min_x{};
+  double min_y{};
+  double max_x{};
+  double max_y{};
+  traffic_light::getFrustumFootprintBox(
+    camera_pose, pinhole_camera_model, max_distance_range, min_x, min_y, max_x, max_y);
+  EXPECT_DOUBLE_EQ(min_x, camera_pose.position.x - max_distance_range);
+  EXPECT_DOUBLE_EQ(min_y, camera_pose.position.y - max_distance_range);
+  EXPECT_DOUBLE_EQ(max_x, camera_pose.position.x + max_distance_range);
+  EXPECT_DOUBLE_EQ(max_y, camera_pose.position.y + max_distance_range);
+}
+
+bool isInBox(
+  const tf2::Vector3 & point, const double min_x, const double min_y, const double max_x,
+  const double max_y)
+{
+  return min_x <= point.x() && point.x() <= max_x && min_y <= point.y() && point.y() <= max_y;
+}
+}  // namespace
+
+TEST(FrustumFootprint, ContainsVisiblePoints)
+{
+  std::mt19937 engine(0);
+  std::uniform_real_distribution<double> unit_dist(-1.0, 1.0);
+  int num_visible = 0;
+  int num_culled = 0;
+  for (int i = 0; i < 2000; ++i) {
+    const auto pinhole_camera_model = createCameraModel(
+      500.0 + 1000.0 * std::fabs(unit_dist(engine)), 960.0 + 100.0 * unit_dist(engine),
+      540.0 + 100.0 * unit_dist(engine));
+    // pitched and rolled cameras as well as a level one
+    const auto camera_pose = createCameraPose(
+      100.0 * unit_dist(engine), 100.0 * unit_dist(engine), 2.0, 0.3 * unit_dist(engine),
+      0.8 * unit_dist(engine), M_PI * unit_dist(engine));
+
+    double min_x{};
+    double min_y{};
+    double max_x{};
+    double max_y{};
+    traffic_light::getFrustumFootprintBox(
+      camera_pose, pinhole_camera_model, max_distance_range, min_x, min_y, max_x, max_y);
+
+    // the pre-filter must not drop any traffic light which the other checks accept
+    for (int j = 0; j < 500; ++j) {
+      const tf2::Vector3 point(
+        camera_pose.position.x + max_distance_range * unit_dist(engine),
+        camera_pose.position.y + max_distance_range * unit_dist(engine),
+        camera_pose.position.z + 20.0 * unit_dist(engine));
+      const bool is_in_box = isInBox(point, min_x, min_y, max_x, max_y);
+      if (isVisible(camera_pose, pinhole_camera_model, point)) {
+        ++num_visible;
+        ASSERT_TRUE(is_in_box) << "camera: " << i << ", point: " << j;
+      } else if (!is_in_box) {
+        ++num_culled;
+      }
+    }
+  }
+  EXPECT_GT(num_visible, 10000);
+  EXPECT_GT(num_culled, 100000);
+}
+
+TEST(FrustumFootprint, PitchedCamera)
+{
+  // camera pitched up, whose upper image corners are farther to the sides on the ground than the
+  // horizontal angle of view
+  const auto pinhole_camera_model = createCameraModel(800.0, 960.0, 540.0);
+  const auto camera_pose = createCameraPose(0.0, 0.0, 2.0, 0.0, -0.6, 0.0);
+
+  double min_x{};
+  double min_y{};
+  double max_x{};
+  double max_y{};
+  traffic_light::getFrustumFootprintBox(
+    camera_pose, pinhole_camera_model, max_distance_range, min_x, min_y, max_x, max_y);
+
+  // near the top left corner of the image
+  const tf2::Matrix3x3 rotation(tf2::Quaternion(
+    camera_pose.orientation.x, camera_pose.orientation.y, camera_pose.orientation.z,
+    camera_pose.orientation.w));
+  const tf2::Vector3 ray = rotation * tf2::Vector3(-950.0 / 800.0, -530.0 / 800.0, 1.0);
+  const double scale = 150.0 / std::hypot(ray.x(), ray.y());
+  const tf2::Vector3 point(ray.x() * scale, ray.y() * scale, 2.0 + ray.z() * scale);
+  ASSERT_TRUE(isVisible(camera_pose, pinhole_camera_model, point));
+  EXPECT_TRUE(isInBox(point, min_x, min_y, max_x, max_y));
+  // out of the horizontal angle of view even with a margin of 10 degrees
+  EXPECT_LT(std::atan2(960.0, 800.0) + 10.0 * M_PI / 180.0, std::atan2(point.y(), point.x()));
+
+  // the camera looks forward
+  EXPECT_GT(min_x, -max_distance_range);
+}
+
+TEST(FrustumFootprint, WholeSquare)
+{
+  const auto pinhole_camera_model = createCameraModel(1000.0, 960.0, 540.0);
+  // looking up and down
+  expectWholeSquare(createCameraPose(10.0, 20.0, 2.0, 0.0, -M_PI_2, 0.3), pinhole_camera_model);
+  expectWholeSquare(createCameraPose(10.0, 20.0, 2.0, 0.0, 1.4, 0.3), pinhole_camera_model);
+  // no camera info
+  expectWholeSquare(
+    createCameraPose(10.0, 20.0, 2.0, 0.0, 0.0, 0.3), image_geometry::PinholeCameraModel());
+}
@@ -24,14 +24,31 @@
 #include <diagnostic_msgs/msg/diagnostic_array.hpp>
 
 #include <string>
+#include <vector>
 
 namespace planning_diagnostics
 {
 using autoware_auto_planning_msgs::msg::Trajectory;
 using autoware_auto_planning_msgs::msg::TrajectoryPoint;
+using diagnostic_msgs::msg::DiagnosticArray;
 using diagnostic_updater::DiagnosticStatusWrapper;
 using diagnostic_updater::Updater;
 
+struct TrajectoryCheckResult
+{
+  bool is_valid{true};
+  std::string error_msg;
+  std::vector<size_t> error_point_indices;  // points visualized on ~/debug/marker
+};
+
+struct TrajectoryCheckResults
+{
+  TrajectoryCheckResult point_value;
+  TrajectoryCheckResult interval;
+  TrajectoryCheckResult curvature;
+  TrajectoryCheckResult relative_angle;
+};
+
 class PlanningErrorMonitorNode : public rclcpp::Node
 {
 public:
@@ -56,17 +73,37 @@ public:
     const Trajectory & traj, const double & curvature_threshold, std::string & error_msg,
     PlanningErrorMonitorDebugNode & debug_marker);
 
+  /**
+   * @brief run all the checks above in a single pass over the trajectory. Each result is the same
+   *        as the one of the corresponding check function.
+   */
+  static TrajectoryCheckResults checkTrajectory(
+    const Trajectory & traj, const double interval_threshold, const double curvature_threshold,
+    const double relative_angle_threshold, const double min_dist_threshold);
+
 private:
   static bool checkFinite(const TrajectoryPoint & p);
+  static bool checkInterval(
+    const Trajectory & traj, const size_t p2_id, const double interval_threshold);
+  static bool checkRelativeAngle(
+    const Trajectory & traj, const size_t p1_id, const double angle_threshold,
+    const double min_dist_threshold);
+  static bool checkCurvature(
+    const Trajectory & traj, const size_t p1_id, const size_t p2_id, const size_t p3_id,
+    const double curvature_threshold);
   static size_t getIndexAfterDistance(
     const Trajectory & traj, const size_t curr_id, const double distance);
 
+  void publishCheckResults(const std_msgs::msg::Header & header) const;
+
   // ROS
   rclcpp::Subscription<Trajectory>::SharedPtr traj_sub_;
+  rclcpp::Publisher<DiagnosticArray>::SharedPtr check_result_pub_;
   rclcpp::TimerBase::SharedPtr timer_;
   Updater updater_{this};
 
   Trajectory::ConstSharedPtr current_trajectory_;
+  TrajectoryCheckResults current_check_results_;
 
   // Parameter
   double error_interval_;
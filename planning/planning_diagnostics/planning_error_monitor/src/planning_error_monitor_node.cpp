@@ -19,6 +19,7 @@
 #include <memory>
 #include <string>
 #include <utility>
+#include <vector>
 
 namespace planning_diagnostics
 {
@@ -26,6 +27,30 @@ using autoware_utils::calcCurvature;
 using autoware_utils::calcDistance2d;
 using diagnostic_msgs::msg::DiagnosticStatus;
 
+namespace
+{
+constexpr char valid_point_value_msg[] = "This Trajectory doesn't have any invalid values";
+constexpr char invalid_point_value_msg[] = "This trajectory has an infinite value";
+constexpr char valid_interval_msg[] = "Trajectory Interval Length is within the expected range";
+constexpr char invalid_interval_msg[] =
+  "Trajectory Interval Length is longer than the expected range";
+constexpr char valid_relative_angle_msg[] =
+  "This trajectory's relative angle is within the expected range";
+constexpr char invalid_relative_angle_msg[] =
+  "This Trajectory's relative angle has larger value than the expected value";
+constexpr char valid_curvature_msg[] = "This trajectory's curvature is within the expected range";
+constexpr char invalid_curvature_msg[] =
+  "This Trajectory's curvature has larger value than the expected value";
+
+// distance between the three points used to calculate the curvature
+constexpr double curvature_points_distance = 1.0;
+
+uint8_t toDiagnosticLevel(const TrajectoryCheckResult & result)
+{
+  return result.is_valid ? DiagnosticStatus::OK : DiagnosticStatus::ERROR;
+}
+}  // namespace
+
 PlanningErrorMonitorNode::PlanningErrorMonitorNode(const rclcpp::NodeOptions & node_options)
 : Node("planning_error_monitor", node_options)
 {
@@ -34,6 +59,7 @@ PlanningErrorMonitorNode::PlanningErrorMonitorNode(const rclcpp::NodeOptions & n
 
   debug_marker_.initialize(this);
 
+  check_result_pub_ = create_publisher<DiagnosticArray>("~/output/trajectory_validation", 1);
   traj_sub_ = create_subscription<Trajectory>(
     "~/input/trajectory", 1, std::bind(&PlanningErrorMonitorNode::onCurrentTrajectory, this, _1));
 
@@ -71,6 +97,33 @@ void PlanningErrorMonitorNode::onTimer()
 void PlanningErrorMonitorNode::onCurrentTrajectory(const Trajectory::ConstSharedPtr msg)
 {
   current_trajectory_ = msg;
+  current_check_results_ = checkTrajectory(
+    *msg, error_interval_, error_curvature_, error_sharp_angle_, ignore_too_close_points_);
+  publishCheckResults(msg->header);
+}
+
+void PlanningErrorMonitorNode::publishCheckResults(const std_msgs::msg::Header & header) const
+{
+  const auto createStatus = [](const std::string & name, const TrajectoryCheckResult & result) {
+    DiagnosticStatus status;
+    status.level = toDiagnosticLevel(result);
+    status.name = name;
+    status.message = result.error_msg;
+    status.hardware_id = "planning_error_monitor";
+    return status;
+  };
+
+  DiagnosticArray msg;
+  msg.header = header;
+  msg.status.push_back(
+    createStatus("trajectory_point_validation", current_check_results_.point_value));
+  msg.status.push_back(
+    createStatus("trajectory_interval_validation", current_check_results_.interval));
+  msg.status.push_back(
+    createStatus("trajectory_curvature_validation", current_check_results_.curvature));
+  msg.status.push_back(
+    createStatus("trajectory_relative_angle_validation", current_check_results_.relative_angle));
+  check_result_pub_->publish(msg);
 }
 
 void PlanningErrorMonitorNode::onTrajectoryPointValueChecker(DiagnosticStatusWrapper & stat)
@@ -79,11 +132,8 @@ void PlanningErrorMonitorNode::onTrajectoryPointValueChecker(DiagnosticStatusWra
     return;
   }
 
-  std::string error_msg;
-  const auto diag_level = checkTrajectoryPointValue(*current_trajectory_, error_msg)
-                            ? DiagnosticStatus::OK
-                            : DiagnosticStatus::ERROR;
-  stat.summary(diag_level, error_msg);
+  const auto & result = current_check_results_.point_value;
+  stat.summary(toDiagnosticLevel(result), result.error_msg);
 }
 
 void PlanningErrorMonitorNode::onTrajectoryIntervalChecker(DiagnosticStatusWrapper & stat)
@@ -92,12 +142,12 @@ void PlanningErrorMonitorNode::onTrajectoryIntervalChecker(DiagnosticStatusWrapp
     return;
   }
 
-  std::string error_msg;
-  const auto diag_level =
-    checkTrajectoryInterval(*current_trajectory_, error_interval_, error_msg, debug_marker_)
-      ? DiagnosticStatus::OK
-      : DiagnosticStatus::ERROR;
-  stat.summary(diag_level, error_msg);
+  const auto & result = current_check_results_.interval;
+  debug_marker_.clearPoseMarker("trajectory_interval");
+  for (const auto id : result.error_point_indices) {
+    debug_marker_.pushPoseMarker(current_trajectory_->points.at(id).pose, "trajectory_interval");
+  }
+  stat.summary(toDiagnosticLevel(result), result.error_msg);
 }
 
 void PlanningErrorMonitorNode::onTrajectoryCurvatureChecker(DiagnosticStatusWrapper & stat)
@@ -106,12 +156,12 @@ void PlanningErrorMonitorNode::onTrajectoryCurvatureChecker(DiagnosticStatusWrap
     return;
   }
 
-  std::string error_msg;
-  const auto diag_level =
-    checkTrajectoryCurvature(*current_trajectory_, error_curvature_, error_msg, debug_marker_)
-      ? DiagnosticStatus::OK
-      : DiagnosticStatus::ERROR;
-  stat.summary(diag_level, error_msg);
+  const auto & result = current_check_results_.curvature;
+  debug_marker_.clearPoseMarker("trajectory_curvature");
+  for (const auto id : result.error_point_indices) {
+    debug_marker_.pushPoseMarker(current_trajectory_->points.at(id).pose, "trajectory_curvature");
+  }
+  stat.summary(toDiagnosticLevel(result), result.error_msg);
 }
 
 void PlanningErrorMonitorNode::onTrajectoryRelativeAngleChecker(DiagnosticStatusWrapper & stat)
@@ -120,22 +170,79 @@ void PlanningErrorMonitorNode::onTrajectoryRelativeAngleChecker(DiagnosticStatus
     return;
   }
 
-  std::string error_msg;
-  const auto diag_level =
-    checkTrajectoryRelativeAngle(
-      *current_trajectory_, error_sharp_angle_, ignore_too_close_points_, error_msg, debug_marker_)
-      ? DiagnosticStatus::OK
-      : DiagnosticStatus::ERROR;
-  stat.summary(diag_level, error_msg);
+  const auto & result = current_check_results_.relative_angle;
+  debug_marker_.clearPoseMarker("trajectory_relative_angle");
+  for (size_t i = 0; i < result.error_point_indices.size(); ++i) {
+    // the three points are colored in red, green and blue
+    debug_marker_.pushPoseMarker(
+      current_trajectory_->points.at(result.error_point_indices.at(i)).pose,
+      "trajectory_relative_angle", static_cast<int>(i));
+  }
+  stat.summary(toDiagnosticLevel(result), result.error_msg);
+}
+
+TrajectoryCheckResults PlanningErrorMonitorNode::checkTrajectory(
+  const Trajectory & traj, const double interval_threshold, const double curvature_threshold,
+  const double relative_angle_threshold, const double min_dist_threshold)
+{
+  TrajectoryCheckResults results;
+  results.point_value.error_msg = valid_point_value_msg;
+  results.interval.error_msg = valid_interval_msg;
+  results.curvature.error_msg = valid_curvature_msg;
+  results.relative_angle.error_msg = valid_relative_angle_msg;
+
+  const size_t points_num = traj.points.size();
+
+  // p2 of a point is p1 of a later point, so that getIndexAfterDistance() is called at most once
+  // for each point
+  std::vector<size_t> index_after_distance(points_num, points_num);
+  const auto getCachedIndexAfterDistance = [&](const size_t curr_id) {
+    if (index_after_distance.at(curr_id) == points_num) {
+      index_after_distance.at(curr_id) =
+        getIndexAfterDistance(traj, curr_id, curvature_points_distance);
+    }
+    return index_after_distance.at(curr_id);
+  };
+  bool is_curvature_checked = false;
+
+  // Each check keeps the first error found in the same order as its check function
+  for (size_t i = 0; i < points_num; ++i) {
+    if (results.point_value.is_valid && !checkFinite(traj.points.at(i))) {
+      results.point_value = {false, invalid_point_value_msg, {}};
+    }
+
+    if (i >= 1 && results.interval.is_valid && !checkInterval(traj, i, interval_threshold)) {
+      results.interval = {false, invalid_interval_msg, {i - 1, i}};
+    }
+
+    if (
+      i >= 2 && results.relative_angle.is_valid &&
+      !checkRelativeAngle(traj, i - 2, relative_angle_threshold, min_dist_threshold)) {
+      results.relative_angle = {false, invalid_relative_angle_msg, {i - 2, i - 1, i}};
+    }
+
+    if (!is_curvature_checked && i + 2 < points_num) {
+      const size_t p2_id = getCachedIndexAfterDistance(i);
+      const size_t p3_id = getCachedIndexAfterDistance(p2_id);
+      if (i == p2_id || i == p3_id || p2_id == p3_id) {
+        is_curvature_checked = true;
+      } else if (!checkCurvature(traj, i, p2_id, p3_id, curvature_threshold)) {
+        results.curvature = {false, invalid_curvature_msg, {i, p2_id, p3_id}};
+        is_curvature_checked = true;
+      }
+    }
+  }
+
+  return results;
 }
 
 bool PlanningErrorMonitorNode::checkTrajectoryPointValue(
   const Trajectory & traj, std::string & error_msg)
 {
-  error_msg = "This Trajectory doesn't have any invalid values";
+  error_msg = valid_point_value_msg;
   for (const auto & p : traj.points) {
     if (!checkFinite(p)) {
-      error_msg = "This trajectory has an infinite value";
+      error_msg = invalid_point_value_msg;
       return false;
     }
   }
@@ -164,13 +271,11 @@ bool PlanningErrorMonitorNode::checkTrajectoryInterval(
   const Trajectory & traj, const double & interval_threshold, std::string & error_msg,
   PlanningErrorMonitorDebugNode & debug_marker)
 {
-  error_msg = "Trajectory Interval Length is within the expected range";
+  error_msg = valid_interval_msg;
   debug_marker.clearPoseMarker("trajectory_interval");
   for (size_t i = 1; i < traj.points.size(); ++i) {
-    double ds = calcDistance2d(traj.points.at(i), traj.points.at(i - 1));
-
-    if (ds > interval_threshold) {
-      error_msg = "Trajectory Interval Length is longer than the expected range";
+    if (!checkInterval(traj, i, interval_threshold)) {
+      error_msg = invalid_interval_msg;
       debug_marker.pushPoseMarker(traj.points.at(i - 1).pose, "trajectory_interval");
       debug_marker.pushPoseMarker(traj.points.at(i).pose, "trajectory_interval");
       return false;
@@ -179,11 +284,18 @@ bool PlanningErrorMonitorNode::checkTrajectoryInterval(
   return true;
 }
 
+bool PlanningErrorMonitorNode::checkInterval(
+  const Trajectory & traj, const size_t p2_id, const double interval_threshold)
+{
+  const double ds = calcDistance2d(traj.points.at(p2_id), traj.points.at(p2_id - 1));
+  return !(ds > interval_threshold);
+}
+
 bool PlanningErrorMonitorNode::checkTrajectoryRelativeAngle(
   const Trajectory & traj, const double angle_threshold, const double min_dist_threshold,
   std::string & error_msg, PlanningErrorMonitorDebugNode & debug_marker)
 {
-  error_msg = "This trajectory's relative angle is within the expected range";
+  error_msg = valid_relative_angle_msg;
   debug_marker.clearPoseMarker("trajectory_relative_angle");
 
   // We need at least three points to compute relative angle
@@ -193,41 +305,8 @@ bool PlanningErrorMonitorNode::checkTrajectoryRelativeAngle(
   }
 
   for (size_t p1_id = 0; p1_id <= traj.points.size() - relative_angle_points_num; ++p1_id) {
-    // Get Point1
-    const auto & p1 = traj.points.at(p1_id).pose.position;
-
-    // Get Point2
-    const auto & p2 = traj.points.at(p1_id + 1).pose.position;
-
-    // Get Point3
-    const auto & p3 = traj.points.at(p1_id + 2).pose.position;
-
-    // ignore invert driving direction
-    if (
-      traj.points.at(p1_id).longitudinal_velocity_mps < 0 ||
-      traj.points.at(p1_id + 1).longitudinal_velocity_mps < 0 ||
-      traj.points.at(p1_id + 2).longitudinal_velocity_mps < 0) {
-      continue;
-    }
-
-    // convert to p1 coordinate
-    const double x3 = p3.x - p1.x;
-    const double x2 = p2.x - p1.x;
-    const double y3 = p3.y - p1.y;
-    const double y2 = p2.y - p1.y;
-
-    // skip too close points case
-    if (std::hypot(x3, y3) < min_dist_threshold || std::hypot(x2, y2) < min_dist_threshold) {
-      continue;
-    }
-
-    // calculate relative angle of vector p3 based on p1p2 vector
-    const double th = std::atan2(y2, x2);
-    const double th2 =
-      std::atan2(-x3 * std::sin(th) + y3 * std::cos(th), x3 * std::cos(th) + y3 * std::sin(th));
-    if (std::abs(th2) > angle_threshold) {
-      error_msg = "This Trajectory's relative angle has larger value than the expected value";
-      // std::cout << error_msg << std::endl;
+    if (!checkRelativeAngle(traj, p1_id, angle_threshold, min_dist_threshold)) {
+      error_msg = invalid_relative_angle_msg;
       debug_marker.pushPoseMarker(traj.points.at(p1_id).pose, "trajectory_relative_angle", 0);
       debug_marker.pushPoseMarker(traj.points.at(p1_id + 1).pose, "trajectory_relative_angle", 1);
       debug_marker.pushPoseMarker(traj.points.at(p1_id + 2).pose, "trajectory_relative_angle", 2);
@@ -236,11 +315,51 @@ bool PlanningErrorMonitorNode::checkTrajectoryRelativeAngle(
   }
   return true;
 }
+
+bool PlanningErrorMonitorNode::checkRelativeAngle(
+  const Trajectory & traj, const size_t p1_id, const double angle_threshold,
+  const double min_dist_threshold)
+{
+  // Get Point1
+  const auto & p1 = traj.points.at(p1_id).pose.position;
+
+  // Get Point2
+  const auto & p2 = traj.points.at(p1_id + 1).pose.position;
+
+  // Get Point3
+  const auto & p3 = traj.points.at(p1_id + 2).pose.position;
+
+  // ignore invert driving direction
+  if (
+    traj.points.at(p1_id).longitudinal_velocity_mps < 0 ||
+    traj.points.at(p1_id + 1).longitudinal_velocity_mps < 0 ||
+    traj.points.at(p1_id + 2).longitudinal_velocity_mps < 0) {
+    return true;
+  }
+
+  // convert to p1 coordinate
+  const double x3 = p3.x - p1.x;
+  const double x2 = p2.x - p1.x;
+  const double y3 = p3.y - p1.y;
+  const double y2 = p2.y - p1.y;
+
+  // skip too close points case
+  if (std::hypot(x3, y3) < min_dist_threshold || std::hypot(x2, y2) < min_dist_threshold) {
+    return true;
+  }
+
+  // calculate relative angle of vector p3 based on p1p2 vector
+  const double th = std::atan2(y2, x2);
+  const double th2 =
+    std::atan2(-x3 * std::sin(th) + y3 * std::cos(th), x3 * std::cos(th) + y3 * std::sin(th));
+  return !(std::abs(th2) > angle_threshold);
+}
+
 bool PlanningErrorMonitorNode::checkTrajectoryCurvature(
   const Trajectory & traj, const double & curvature_threshold, std::string & error_msg,
   PlanningErrorMonitorDebugNode & debug_marker)
 {
-  error_msg = "This trajectory's curvature is within the expected range";
+  error_msg = valid_curvature_msg;
   debug_marker.clearPoseMarker("trajectory_curvature");
 
   // We need at least three points to compute curvature
@@ -248,29 +367,20 @@ bool PlanningErrorMonitorNode::checkTrajectoryCurvature(
     return true;
   }
 
-  constexpr double points_distance = 1.0;
-
   for (size_t p1_id = 0; p1_id < traj.points.size() - 2; ++p1_id) {
-    // Get Point1
-    const auto p1 = traj.points.at(p1_id).pose.position;
-
     // Get Point2
-    const auto p2_id = getIndexAfterDistance(traj, p1_id, points_distance);
-    const auto p2 = traj.points.at(p2_id).pose.position;
+    const auto p2_id = getIndexAfterDistance(traj, p1_id, curvature_points_distance);
 
     // Get Point3
-    const auto p3_id = getIndexAfterDistance(traj, p2_id, points_distance);
-    const auto p3 = traj.points.at(p3_id).pose.position;
+    const auto p3_id = getIndexAfterDistance(traj, p2_id, curvature_points_distance);
 
     // no need to check for pi, since there is no point with "points_distance" from p1.
     if (p1_id == p2_id || p1_id == p3_id || p2_id == p3_id) {
       break;
     }
 
-    const double curvature = calcCurvature(p1, p2, p3);
-
-    if (std::fabs(curvature) > curvature_threshold) {
-      error_msg = "This Trajectory's curvature has larger value than the expected value";
+    if (!checkCurvature(traj, p1_id, p2_id, p3_id, curvature_threshold)) {
+      error_msg = invalid_curvature_msg;
       debug_marker.pushPoseMarker(traj.points.at(p1_id).pose, "trajectory_curvature");
       debug_marker.pushPoseMarker(traj.points.at(p2_id).pose, "trajectory_curvature");
       debug_marker.pushPoseMarker(traj.points.at(p3_id).pose, "trajectory_curvature");
@@ -280,6 +390,16 @@ bool PlanningErrorMonitorNode::checkTrajectoryCurvature(
   return true;
 }
 
+bool PlanningErrorMonitorNode::checkCurvature(
+  const Trajectory & traj, const size_t p1_id, const size_t p2_id, const size_t p3_id,
+  const double curvature_threshold)
+{
+  const double curvature = calcCurvature(
+    traj.points.at(p1_id).pose.position, traj.points.at(p2_id).pose.position,
+    traj.points.at(p3_id).pose.position);
+  return !(std::fabs(curvature) > curvature_threshold);
+}
+
 size_t PlanningErrorMonitorNode::getIndexAfterDistance(
   const Trajectory & traj, const size_t curr_id, const double distance)
 {
@@ -18,6 +18,7 @@
 #include <gtest/gtest.h>
 
 #include <string>
+#include <vector>
 
 constexpr double NOMINAL_INTERVAL = 1.0;
 constexpr double ERROR_INTERVAL = 1000.0;
@@ -155,3 +156,49 @@ TEST(PlanningErrorMonitor, TrajectoryRelativeAngleChecker)
       valid_error_msg, "This Trajectory's relative angle has larger value than the expected value");
   }
 }
+
+TEST(PlanningErrorMonitor, TrajectoryFusedChecker)
+{
+  using autoware_auto_planning_msgs::msg::Trajectory;
+  using planning_diagnostics::PlanningErrorMonitorNode;
+  PlanningErrorMonitorDebugNode debug_marker;
+  const double too_close_dist = 0.05;
+  const double too_sharp_turn = M_PI_4;
+
+  Trajectory sharp_turn_traj = generateTrajectory(NOMINAL_INTERVAL);
+  sharp_turn_traj.points[4].pose.position.x = 3;
+  sharp_turn_traj.points[4].pose.position.y = 10;
+
+  for (const auto & traj :
+       {generateTrajectory(NOMINAL_INTERVAL), generateTrajectory(ERROR_INTERVAL),
+        generateNanTrajectory(), generateBadCurvatureTrajectory(), sharp_turn_traj}) {
+    const auto results = PlanningErrorMonitorNode::checkTrajectory(
+      traj, NOMINAL_INTERVAL, ERROR_CURVATURE, too_sharp_turn, too_close_dist);
+
+    // Same results as each check function
+    std::string error_msg;
+    EXPECT_EQ(
+      results.point_value.is_valid,
+      PlanningErrorMonitorNode::checkTrajectoryPointValue(traj, error_msg));
+    EXPECT_EQ(results.point_value.error_msg, error_msg);
+    EXPECT_EQ(
+      results.interval.is_valid, PlanningErrorMonitorNode::checkTrajectoryInterval(
+                                   traj, NOMINAL_INTERVAL, error_msg, debug_marker));
+    EXPECT_EQ(results.interval.error_msg, error_msg);
+    EXPECT_EQ(
+      results.curvature.is_valid, PlanningErrorMonitorNode::checkTrajectoryCurvature(
+                                    traj, ERROR_CURVATURE, error_msg, debug_marker));
+    EXPECT_EQ(results.curvature.error_msg, error_msg);
+    EXPECT_EQ(
+      results.relative_angle.is_valid,
+      PlanningErrorMonitorNode::checkTrajectoryRelativeAngle(
+        traj, too_sharp_turn, too_close_dist, error_msg, debug_marker));
+    EXPECT_EQ(results.relative_angle.error_msg, error_msg);
+  }
+
+  // Points of the error
+  const auto results = PlanningErrorMonitorNode::checkTrajectory(
+    sharp_turn_traj, ERROR_INTERVAL, ERROR_CURVATURE, too_sharp_turn, too_close_dist);
+  EXPECT_FALSE(results.relative_angle.is_valid);
+  EXPECT_EQ(results.relative_angle.error_point_indices, (std::vector<size_t>{2, 3, 4}));
+}
@@ -0,0 +1,202 @@
+// Copyright 2021 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "autoware_utils/autoware_utils.hpp"
+#include "eigen3/Eigen/Core"
+#include "planning_evaluator/metrics/deviation_metrics.hpp"
+#include "planning_evaluator/metrics/obstacle_metrics.hpp"
+#include "planning_evaluator/metrics/stability_metrics.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <random>
+
+namespace
+{
+using autoware_auto_perception_msgs::msg::PredictedObject;
+using autoware_auto_perception_msgs::msg::PredictedObjects;
+using autoware_auto_planning_msgs::msg::Trajectory;
+using autoware_auto_planning_msgs::msg::TrajectoryPoint;
+using autoware_utils::calcDistance2d;
+using planning_diagnostics::Stat;
+
+constexpr size_t num_points = 1000;
+constexpr size_t num_objects = 200;
+
+// a winding trajectory with points 1 m apart, laterally offset by the given distance
+Trajectory makeTrajectory(const double lateral_offset, const double velocity)
+{
+  Trajectory traj;
+  for (size_t i = 0; i < num_points; ++i) {
+    const double s = static_cast<double>(i);
+    const double yaw = 0.3 * std::sin(s / 50.0);
+    TrajectoryPoint p;
+    p.pose.position.x = s - lateral_offset * std::sin(yaw);
+    p.pose.position.y = 15.0 * std::cos(s / 50.0) + lateral_offset * std::cos(yaw);
+    p.pose.orientation = autoware_utils::createQuaternionFromYaw(yaw);
+    p.longitudinal_velocity_mps = static_cast<float>(velocity);
+    traj.points.push_back(p);
+  }
+  return traj;
+}
+
+// the metrics before they were reimplemented in planning_evaluator/metrics
+Stat<double> calcFrechetDistanceByMatrix(const Trajectory & traj1, const Trajectory & traj2)
+{
+  Stat<double> stat;
+  Eigen::MatrixXd ca = Eigen::MatrixXd::Zero(traj1.points.size(), traj2.points.size());
+  for (size_t i = 0; i < traj1.points.size(); ++i) {
+    for (size_t j = 0; j < traj2.points.size(); ++j) {
+      const double dist = calcDistance2d(traj1.points[i], traj2.points[j]);
+      if (i > 0 && j > 0) {
+        ca(i, j) = std::max(std::min(ca(i - 1, j), std::min(ca(i - 1, j - 1), ca(i, j - 1))), dist);
+      } else if (i > 0) {
+        ca(i, j) = std::max(ca(i - 1, 0), dist);
+      } else if (j > 0) {
+        ca(i, j) = std::max(ca(0, j - 1), dist);
+      } else {
+        ca(i, j) = dist;
+      }
+    }
+  }
+  stat.add(ca(traj1.points.size() - 1, traj2.points.size() - 1));
+  return stat;
+}
+
+Stat<double> calcLateralDeviationByLinearSearch(const Trajectory & ref, const Trajectory & traj)
+{
+  Stat<double> stat;
+  for (const TrajectoryPoint & p : traj.points) {
+    const size_t nearest_index = autoware_utils::findNearestIndex(ref.points, p.pose.position);
+    stat.add(autoware_utils::calcLateralDeviation(ref.points[nearest_index].pose, p.pose.position));
+  }
+  return stat;
+}
+
+Stat<double> calcDistanceToObstacleByLinearSearch(
+  const PredictedObjects & obstacles, const Trajectory & traj)
+{
+  Stat<double> stat;
+  for (const TrajectoryPoint & p : traj.points) {
+    double min_dist = std::numeric_limits<double>::max();
+    for (const auto & object : obstacles.objects) {
+      const auto dist = calcDistance2d(object.kinematics.initial_pose_with_covariance.pose, p);
+      min_dist = std::min(min_dist, dist);
+    }
+    stat.add(min_dist);
+  }
+  return stat;
+}
+
+double diff(const Stat<double> & stat1, const Stat<double> & stat2)
+{
+  return std::max(
+    std::max(std::abs(stat1.min() - stat2.min()), std::abs(stat1.max() - stat2.max())),
+    static_cast<double>(std::abs(stat1.mean() - stat2.mean())));
+}
+
+struct Inputs
+{
+  Trajectory ref = makeTrajectory(0.0, 10.0);
+  Trajectory traj = makeTrajectory(0.7, 8.0);
+  PredictedObjects objects;
+
+  Inputs()
+  {
+    std::mt19937 engine(0);
+    std::uniform_real_distribution<double> x_dist(0.0, static_cast<double>(num_points));
+    std::uniform_real_distribution<double> y_dist(-40.0, 40.0);
+    for (size_t i = 0; i < num_objects; ++i) {
+      PredictedObject object;
+      object.kinematics.initial_pose_with_covariance.pose.position.x = x_dist(engine);
+      object.kinematics.initial_pose_with_covariance.pose.position.y = y_dist(engine);
+      objects.objects.push_back(object);
+    }
+  }
+};
+
+const Inputs & getInputs()
+{
+  static const Inputs inputs;
+  return inputs;
+}
+}  // namespace
+
+namespace metrics = planning_diagnostics::metrics;
+
+static void FrechetDistanceByMatrix(benchmark::State & state)
+{
+  const auto & in = getInputs();
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(calcFrechetDistanceByMatrix(in.ref, in.traj));
+  }
+}
+BENCHMARK(FrechetDistanceByMatrix)->Unit(benchmark::kMillisecond);
+
+static void FrechetDistanceByTwoRows(benchmark::State & state)
+{
+  const auto & in = getInputs();
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(metrics::calcFrechetDistance(in.ref, in.traj));
+  }
+  // the largest difference of the statistics from the previous implementation
+  state.counters["max_diff"] = diff(
+    calcFrechetDistanceByMatrix(in.ref, in.traj), metrics::calcFrechetDistance(in.ref, in.traj));
+}
+BENCHMARK(FrechetDistanceByTwoRows)->Unit(benchmark::kMillisecond);
+
+static void LateralDeviationByLinearSearch(benchmark::State & state)
+{
+  const auto & in = getInputs();
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(calcLateralDeviationByLinearSearch(in.ref, in.traj));
+  }
+}
+BENCHMARK(LateralDeviationByLinearSearch)->Unit(benchmark::kMillisecond);
+
+static void LateralDeviationByGrid(benchmark::State & state)
+{
+  const auto & in = getInputs();
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(metrics::calcLateralDeviation(in.ref, in.traj));
+  }
+  state.counters["max_diff"] = diff(
+    calcLateralDeviationByLinearSearch(in.ref, in.traj),
+    metrics::calcLateralDeviation(in.ref, in.traj));
+}
+BENCHMARK(LateralDeviationByGrid)->Unit(benchmark::kMillisecond);
+
+static void DistanceToObstacleByLinearSearch(benchmark::State & state)
+{
+  const auto & in = getInputs();
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(calcDistanceToObstacleByLinearSearch(in.objects, in.traj));
+  }
+}
+BENCHMARK(DistanceToObstacleByLinearSearch)->Unit(benchmark::kMillisecond);
+
+static void DistanceToObstacleByGrid(benchmark::State & state)
+{
+  const auto & in = getInputs();
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(metrics::calcDistanceToObstacle(in.objects, in.traj));
+  }
+  state.counters["max_diff"] = diff(
+    calcDistanceToObstacleByLinearSearch(in.objects, in.traj),
+    metrics::calcDistanceToObstacle(in.objects, in.traj));
+}
+BENCHMARK(DistanceToObstacleByGrid)->Unit(benchmark::kMillisecond);
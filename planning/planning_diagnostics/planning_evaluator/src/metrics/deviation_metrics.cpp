@@ -22,6 +22,13 @@ namespace metrics
 {
 using autoware_auto_planning_msgs::msg::Trajectory;
 using autoware_auto_planning_msgs::msg::TrajectoryPoint;
+using autoware_utils::TrajectoryIndex;
+
+namespace
+{
+// the points of a reference trajectory are about 1 m apart, so a cell holds a few of them
+constexpr double reference_grid_cell_size = 2.0;
+}  // namespace
 
 Stat<double> calcLateralDeviation(const Trajectory & ref, const Trajectory & traj)
 {
@@ -34,8 +41,9 @@ Stat<double> calcLateralDeviation(const Trajectory & ref, const Trajectory & tra
   /** TODO(Maxime CLEMENT):
    * need more precise calculation, e.g., lateral distance from spline of the reference traj
    */
-  for (TrajectoryPoint p : traj.points) {
-    const size_t nearest_index = autoware_utils::findNearestIndex(ref.points, p.pose.position);
+  const TrajectoryIndex ref_index(ref.points, reference_grid_cell_size);
+  for (const TrajectoryPoint & p : traj.points) {
+    const size_t nearest_index = autoware_utils::findNearestIndex(ref_index, p.pose.position);
     stat.add(autoware_utils::calcLateralDeviation(ref.points[nearest_index].pose, p.pose.position));
   }
   return stat;
@@ -52,8 +60,9 @@ Stat<double> calcYawDeviation(const Trajectory & ref, const Trajectory & traj)
   /** TODO(Maxime CLEMENT):
    * need more precise calculation, e.g., yaw distance from spline of the reference traj
    */
-  for (TrajectoryPoint p : traj.points) {
-    const size_t nearest_index = autoware_utils::findNearestIndex(ref.points, p.pose.position);
+  const TrajectoryIndex ref_index(ref.points, reference_grid_cell_size);
+  for (const TrajectoryPoint & p : traj.points) {
+    const size_t nearest_index = autoware_utils::findNearestIndex(ref_index, p.pose.position);
     stat.add(autoware_utils::calcYawDeviation(ref.points[nearest_index].pose, p.pose));
   }
   return stat;
@@ -68,8 +77,9 @@ Stat<double> calcVelocityDeviation(const Trajectory & ref, const Trajectory & tr
   }
 
   // TODO(Maxime CLEMENT) need more precise calculation
-  for (TrajectoryPoint p : traj.points) {
-    const size_t nearest_index = autoware_utils::findNearestIndex(ref.points, p.pose.position);
+  const TrajectoryIndex ref_index(ref.points, reference_grid_cell_size);
+  for (const TrajectoryPoint & p : traj.points) {
+    const size_t nearest_index = autoware_utils::findNearestIndex(ref_index, p.pose.position);
     stat.add(p.longitudinal_velocity_mps - ref.points[nearest_index].longitudinal_velocity_mps);
   }
   return stat;
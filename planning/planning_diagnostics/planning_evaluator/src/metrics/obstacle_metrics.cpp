@@ -18,9 +18,11 @@
 #include "eigen3/Eigen/Core"
 
 #include "autoware_auto_planning_msgs/msg/trajectory_point.hpp"
+#include "geometry_msgs/msg/pose.hpp"
 
 #include <algorithm>
 #include <limits>
+#include <vector>
 
 namespace planning_diagnostics
 {
@@ -28,18 +30,43 @@ namespace metrics
 {
 using autoware_auto_planning_msgs::msg::TrajectoryPoint;
 using autoware_utils::calcDistance2d;
+using autoware_utils::TrajectoryIndex;
+
+namespace
+{
+constexpr double object_grid_cell_size = 10.0;
+
+// the positions of the objects bucketed in a grid to find the nearest object to a point
+TrajectoryIndex makeObjectIndex(const PredictedObjects & obstacles)
+{
+  std::vector<geometry_msgs::msg::Pose> object_poses;
+  object_poses.reserve(obstacles.objects.size());
+  for (const auto & object : obstacles.objects) {
+    object_poses.push_back(object.kinematics.initial_pose_with_covariance.pose);
+  }
+  return TrajectoryIndex(object_poses, object_grid_cell_size);
+}
+
+double calcDistanceToNearestObstacle(
+  const PredictedObjects & obstacles, const TrajectoryIndex & object_index,
+  const TrajectoryPoint & p)
+{
+  if (object_index.empty()) {
+    return std::numeric_limits<double>::max();
+  }
+  // TODO(Maxime CLEMENT): take into account the shape, not only the centroid
+  const size_t nearest_idx = object_index.findNearestIndex(p.pose.position);
+  const auto & nearest_object = obstacles.objects.at(nearest_idx);
+  return calcDistance2d(nearest_object.kinematics.initial_pose_with_covariance.pose, p);
+}
+}  // namespace
 
 Stat<double> calcDistanceToObstacle(const PredictedObjects & obstacles, const Trajectory & traj)
 {
   Stat<double> stat;
+  const auto object_index = makeObjectIndex(obstacles);
   for (const TrajectoryPoint & p : traj.points) {
-    double min_dist = std::numeric_limits<double>::max();
-    for (const auto & object : obstacles.objects) {
-      // TODO(Maxime CLEMENT): take into account the shape, not only the centroid
-      const auto dist = calcDistance2d(object.kinematics.initial_pose_with_covariance.pose, p);
-      min_dist = std::min(min_dist, dist);
-    }
-    stat.add(min_dist);
+    stat.add(calcDistanceToNearestObstacle(obstacles, object_index, p));
   }
   return stat;
 }
@@ -56,25 +83,23 @@ Stat<double> calcTimeToCollision(
     p0 = traj.points.front();
   }
 
+  if (obstacles.objects.empty()) {
+    return stat;
+  }
+  const auto object_index = makeObjectIndex(obstacles);
+
   double t = 0.0;  // [s] time from start of trajectory
   for (const TrajectoryPoint & p : traj.points) {
     const double traj_dist = calcDistance2d(p0, p);
     if (p0.longitudinal_velocity_mps != 0) {
       const double dt = traj_dist / std::abs(p0.longitudinal_velocity_mps);
       t += dt;
-      for (auto obstacle : obstacles.objects) {
-        const double obstacle_dist =
-          calcDistance2d(p, obstacle.kinematics.initial_pose_with_covariance.pose);
-        // TODO(Maxime CLEMENT): take shape into consideration
-        if (obstacle_dist <= distance_threshold) {
-          stat.add(t);
-          break;
-        }
+      // TODO(Maxime CLEMENT): take shape into consideration
+      if (calcDistanceToNearestObstacle(obstacles, object_index, p) <= distance_threshold) {
+        stat.add(t);
+        break;
       }
     }
-    if (stat.count() > 0) {
-      break;
-    }
     p0 = p;
   }
   return stat;
@@ -15,17 +15,25 @@
 #include "planning_evaluator/metrics/stability_metrics.hpp"
 
 #include "autoware_utils/autoware_utils.hpp"
-#include "eigen3/Eigen/Core"
 
 #include "autoware_auto_planning_msgs/msg/trajectory_point.hpp"
 
 #include <algorithm>
+#include <utility>
+#include <vector>
 
 namespace planning_diagnostics
 {
 namespace metrics
 {
 using autoware_auto_planning_msgs::msg::TrajectoryPoint;
+using autoware_utils::TrajectoryIndex;
+
+namespace
+{
+// the points of a trajectory are about 1 m apart, so a cell holds a few of them
+constexpr double trajectory_grid_cell_size = 2.0;
+}  // namespace
 
 Stat<double> calcFrechetDistance(const Trajectory & traj1, const Trajectory & traj2)
 {
@@ -35,23 +43,26 @@ Stat<double> calcFrechetDistance(const Trajectory & traj1, const Trajectory & tr
     return stat;
   }
 
-  Eigen::MatrixXd ca = Eigen::MatrixXd::Zero(traj1.points.size(), traj2.points.size());
+  // the coupling distances of row i only depend on rows i and i - 1, so two rows are kept
+  std::vector<double> prev_ca(traj2.points.size());
+  std::vector<double> ca(traj2.points.size());
 
   for (size_t i = 0; i < traj1.points.size(); ++i) {
     for (size_t j = 0; j < traj2.points.size(); ++j) {
       const double dist = autoware_utils::calcDistance2d(traj1.points[i], traj2.points[j]);
       if (i > 0 && j > 0) {
-        ca(i, j) = std::max(std::min(ca(i - 1, j), std::min(ca(i - 1, j - 1), ca(i, j - 1))), dist);
+        ca[j] = std::max(std::min(prev_ca[j], std::min(prev_ca[j - 1], ca[j - 1])), dist);
       } else if (i > 0 /*&& j == 0*/) {
-        ca(i, j) = std::max(ca(i - 1, 0), dist);
+        ca[j] = std::max(prev_ca[0], dist);
       } else if (j > 0 /*&& i == 0*/) {
-        ca(i, j) = std::max(ca(0, j - 1), dist);
+        ca[j] = std::max(ca[j - 1], dist);
       } else { /* i == j == 0 */
-        ca(i, j) = dist;
+        ca[j] = dist;
       }
     }
+    std::swap(prev_ca, ca);
   }
-  stat.add(ca(traj1.points.size() - 1, traj2.points.size() - 1));
+  stat.add(prev_ca.back());
   return stat;
 }
 
@@ -61,22 +72,23 @@ Stat<double> calcLateralDistance(const Trajectory & traj1, const Trajectory & tr
   if (traj1.points.empty()) {
     return stat;
   }
-  for (const auto point : traj2.points) {
+  const TrajectoryIndex traj1_index(traj1.points, trajectory_grid_cell_size);
+  for (const auto & point : traj2.points) {
     const auto p0 = autoware_utils::getPoint(point.pose);
     // find nearest segment
-    const size_t nearest_segment_idx = autoware_utils::findNearestSegmentIndex(traj1.points, p0);
+    const size_t nearest_segment_idx = autoware_utils::findNearestSegmentIndex(traj1_index, p0);
     double dist;
     // distance to segment
     if (
       nearest_segment_idx == traj1.points.size() - 2 &&
-      autoware_utils::calcLongitudinalOffsetToSegment(traj1.points, nearest_segment_idx, p0) >
+      autoware_utils::calcLongitudinalOffsetToSegment(traj1_index, nearest_segment_idx, p0) >
         autoware_utils::calcDistance2d(
           traj1.points[nearest_segment_idx], traj1.points[nearest_segment_idx + 1])) {
       // distance to last point
       dist = autoware_utils::calcDistance2d(traj1.points.back(), p0);
     } else if (  // NOLINT
       nearest_segment_idx == 0 &&
-      autoware_utils::calcLongitudinalOffsetToSegment(traj1.points, nearest_segment_idx, p0) <= 0) {
+      autoware_utils::calcLongitudinalOffsetToSegment(traj1_index, nearest_segment_idx, p0) <= 0) {
       // distance to first point
       dist = autoware_utils::calcDistance2d(traj1.points.front(), p0);
     } else {
@@ -35,7 +35,11 @@
 #include <lanelet2_traffic_rules/TrafficRulesFactory.h>
 
 #include <limits>
+#include <map>
 #include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 namespace route_handler
@@ -144,6 +148,31 @@ private:
   Pose pull_over_goal_pose_;
   HADMapRoute route_msg_;
 
+  // id-keyed index of the lanelets above, rebuilt whenever the route or the map is set
+  std::unordered_set<lanelet::Id> route_lanelet_ids_;
+  std::unordered_set<lanelet::Id> preferred_lanelet_ids_;
+  std::unordered_set<lanelet::Id> start_lanelet_ids_;
+  std::unordered_set<lanelet::Id> goal_lanelet_ids_;
+  std::unordered_set<lanelet::Id> goal_section_lanelet_ids_;
+  std::unordered_set<lanelet::Id> shoulder_lanelet_ids_;
+  // following and previous lanelets of each route lanelet which are also in the route
+  std::unordered_map<lanelet::Id, lanelet::ConstLanelets> following_lanelets_within_route_;
+  std::unordered_map<lanelet::Id, lanelet::ConstLanelets> previous_lanelets_within_route_;
+
+  // centerline points of a lanelet sequence with the 2d arc length from its first point
+  struct CenterLine
+  {
+    std::vector<lanelet::BasicPoint3d> points;
+    std::vector<lanelet::Id> lane_ids;
+    std::vector<double> speed_limits;
+    std::vector<double> arc_lengths;
+    // distance to the next point in the same lanelet, 0 for the last point of a lanelet
+    std::vector<double> distances;
+  };
+  static constexpr size_t max_centerline_cache_size_{64};
+  mutable std::mutex centerline_cache_mutex_;
+  mutable std::map<lanelet::Ids, std::shared_ptr<const CenterLine>> centerline_cache_;
+
   rclcpp::Logger logger_{rclcpp::get_logger("route_handler")};
 
   bool is_route_msg_ready_{false};
@@ -152,12 +181,18 @@ private:
 
   // non-const methods
   void setLaneletsFromRouteMsg();
+  void updateRouteIndex();
 
   // const methods
   // for routing
   lanelet::ConstLanelets getMainLanelets(const lanelet::ConstLanelets & path_lanelets) const;
 
   // for lanelet
+  bool isRouteLanelet(const lanelet::ConstLanelet & lanelet) const;
+  lanelet::ConstLanelets getFollowingLaneletsWithinRoute(
+    const lanelet::ConstLanelet & lanelet) const;
+  lanelet::ConstLanelets getPreviousLaneletsWithinRoute(
+    const lanelet::ConstLanelet & lanelet) const;
   bool isInTargetLane(const PoseStamped & pose, const lanelet::ConstLanelets & target) const;
   bool isInPreferredLane(const PoseStamped & pose) const;
   bool isBijectiveConnection(
@@ -204,7 +239,8 @@ private:
   lanelet::ConstLanelets getNextLaneSequence(const lanelet::ConstLanelets & lane_sequence) const;
 
   // for path
-
+  std::shared_ptr<const CenterLine> getCenterLine(
+    const lanelet::ConstLanelets & lanelet_sequence) const;
   PathWithLaneId updatePathTwist(const PathWithLaneId & path) const;
 };
 }  // namespace route_handler
@@ -39,16 +39,6 @@ using autoware_auto_planning_msgs::msg::PathWithLaneId;
 using geometry_msgs::msg::Pose;
 using lanelet::utils::to2D;
 
-bool exists(const std::vector<MapPrimitive> & primitives, const int64_t & id)
-{
-  for (const auto & p : primitives) {
-    if (p.id == id) {
-      return true;
-    }
-  }
-  return false;
-}
-
 template <typename T>
 bool exists(const std::vector<T> & vectors, const T & item)
 {
@@ -76,31 +66,6 @@ bool isRouteLooped(const autoware_auto_planning_msgs::msg::HADMapRoute & route_m
   return false;
 }
 
-lanelet::ConstPoint3d get3DPointFrom2DArcLength(
-  const lanelet::ConstLanelets & lanelet_sequence, const double s)
-{
-  double accumulated_distance2d = 0;
-  for (const auto & llt : lanelet_sequence) {
-    const auto & centerline = llt.centerline();
-    lanelet::ConstPoint3d prev_pt;
-    if (!centerline.empty()) {
-      prev_pt = centerline.front();
-    }
-    for (const auto & pt : centerline) {
-      double distance2d = lanelet::geometry::distance2d(to2D(prev_pt), to2D(pt));
-      if (accumulated_distance2d + distance2d > s) {
-        double ratio = (s - accumulated_distance2d) / distance2d;
-        auto interpolated_pt = prev_pt.basicPoint() * (1 - ratio) + pt.basicPoint() * ratio;
-        return lanelet::ConstPoint3d(
-          lanelet::InvalId, interpolated_pt.x(), interpolated_pt.y(), interpolated_pt.z());
-      }
-      accumulated_distance2d += distance2d;
-      prev_pt = pt;
-    }
-  }
-  return lanelet::ConstPoint3d();
-}
-
 Path convertToPathFromPathWithLaneId(const PathWithLaneId & path_with_lane_id)
 {
   Path path;
@@ -189,6 +154,14 @@ void RouteHandler::setMap(const HADMapBin & map_msg)
   lanelet::ConstLanelets all_lanelets = lanelet::utils::query::laneletLayer(lanelet_map_ptr_);
   road_lanelets_ = lanelet::utils::query::roadLanelets(all_lanelets);
   shoulder_lanelets_ = lanelet::utils::query::shoulderLanelets(all_lanelets);
+  shoulder_lanelet_ids_.clear();
+  for (const auto & llt : shoulder_lanelets_) {
+    shoulder_lanelet_ids_.insert(llt.id());
+  }
+  {
+    std::lock_guard<std::mutex> lock(centerline_cache_mutex_);
+    centerline_cache_.clear();
+  }
 
   is_map_msg_ready_ = true;
   is_handler_ready_ = false;
@@ -200,6 +173,12 @@ void RouteHandler::setRoute(const HADMapRoute & route_msg)
 {
   if (!isRouteLooped(route_msg)) {
     route_msg_ = route_msg;
+    goal_section_lanelet_ids_.clear();
+    if (!route_msg_.segments.empty()) {
+      for (const auto & primitive : route_msg_.segments.back().primitives) {
+        goal_section_lanelet_ids_.insert(primitive.id);
+      }
+    }
     is_route_msg_ready_ = true;
     is_handler_ready_ = false;
     setLaneletsFromRouteMsg();
@@ -220,6 +199,14 @@ void RouteHandler::setRouteLanelets(const lanelet::ConstLanelets & path_lanelets
     auto last_lanelet = path_lanelets.back();
     goal_lanelets_ = lanelet::utils::query::getAllNeighbors(routing_graph_ptr_, last_lanelet);
   }
+  start_lanelet_ids_.clear();
+  for (const auto & llt : start_lanelets_) {
+    start_lanelet_ids_.insert(llt.id());
+  }
+  goal_lanelet_ids_.clear();
+  for (const auto & llt : goal_lanelets_) {
+    goal_lanelet_ids_.insert(llt.id());
+  }
 
   // set route lanelets
   std::unordered_set<lanelet::Id> route_lanelets_id;
@@ -250,7 +237,7 @@ void RouteHandler::setRouteLanelets(const lanelet::ConstLanelets & path_lanelets
     auto previous_lanelets = routing_graph_ptr_->previous(lanelet);
     bool is_connected_to_main_lanes_prev = false;
     bool is_connected_to_candidate_prev = true;
-    if (exists(start_lanelets_, lanelet)) {
+    if (start_lanelet_ids_.count(lanelet.id()) > 0) {
       is_connected_to_candidate_prev = false;
     }
     while (!previous_lanelets.empty() && is_connected_to_candidate_prev &&
@@ -262,7 +249,7 @@ void RouteHandler::setRouteLanelets(const lanelet::ConstLanelets & path_lanelets
           is_connected_to_main_lanes_prev = true;
           break;
         }
-        if (exists(start_lanelets_, prev_lanelet)) {
+        if (start_lanelet_ids_.count(prev_lanelet.id()) > 0) {
           break;
         }
 
@@ -277,7 +264,7 @@ void RouteHandler::setRouteLanelets(const lanelet::ConstLanelets & path_lanelets
     auto following_lanelets = routing_graph_ptr_->following(lanelet);
     bool is_connected_to_main_lanes_next = false;
     bool is_connected_to_candidate_next = true;
-    if (exists(goal_lanelets_, lanelet)) {
+    if (goal_lanelet_ids_.count(lanelet.id()) > 0) {
       is_connected_to_candidate_next = false;
     }
     while (!following_lanelets.empty() && is_connected_to_candidate_next &&
@@ -288,7 +275,7 @@ void RouteHandler::setRouteLanelets(const lanelet::ConstLanelets & path_lanelets
           is_connected_to_main_lanes_next = true;
           break;
         }
-        if (exists(goal_lanelets_, next_lanelet)) {
+        if (goal_lanelet_ids_.count(next_lanelet.id()) > 0) {
           break;
         }
         if (candidate_lanes_id.find(next_lanelet.id()) != candidate_lanes_id.end()) {
@@ -308,6 +295,7 @@ void RouteHandler::setRouteLanelets(const lanelet::ConstLanelets & path_lanelets
   for (const auto & id : route_lanelets_id) {
     route_lanelets_.push_back(lanelet_map_ptr_->laneletLayer.get(id));
   }
+  updateRouteIndex();
 }
 
 void RouteHandler::setLaneletsFromRouteMsg()
@@ -341,9 +329,42 @@ void RouteHandler::setLaneletsFromRouteMsg()
       start_lanelets_.push_back(llt);
     }
   }
+  updateRouteIndex();
   is_handler_ready_ = true;
 }
 
+void RouteHandler::updateRouteIndex()
+{
+  const auto to_id_set = [](const lanelet::ConstLanelets & lanelets) {
+    std::unordered_set<lanelet::Id> ids;
+    for (const auto & llt : lanelets) {
+      ids.insert(llt.id());
+    }
+    return ids;
+  };
+  route_lanelet_ids_ = to_id_set(route_lanelets_);
+  preferred_lanelet_ids_ = to_id_set(preferred_lanelets_);
+  start_lanelet_ids_ = to_id_set(start_lanelets_);
+  goal_lanelet_ids_ = to_id_set(goal_lanelets_);
+
+  following_lanelets_within_route_.clear();
+  previous_lanelets_within_route_.clear();
+  for (const auto & route_lanelet : route_lanelets_) {
+    auto & following_lanelets = following_lanelets_within_route_[route_lanelet.id()];
+    for (const auto & llt : routing_graph_ptr_->following(route_lanelet)) {
+      if (isRouteLanelet(llt)) {
+        following_lanelets.push_back(llt);
+      }
+    }
+    auto & previous_lanelets = previous_lanelets_within_route_[route_lanelet.id()];
+    for (const auto & llt : routing_graph_ptr_->previous(route_lanelet)) {
+      if (isRouteLanelet(llt)) {
+        previous_lanelets.push_back(llt);
+      }
+    }
+  }
+}
+
 lanelet::ConstPolygon3d RouteHandler::getIntersectionAreaById(const lanelet::Id id) const
 {
   return lanelet_map_ptr_->polygonLayer.get(id);
@@ -419,22 +440,16 @@ lanelet::Id RouteHandler::getGoalLaneId() const
 bool RouteHandler::getGoalLanelet(lanelet::ConstLanelet * goal_lanelet) const
 {
   const lanelet::Id goal_lane_id = getGoalLaneId();
-  for (const auto & llt : route_lanelets_) {
-    if (llt.id() == goal_lane_id) {
-      *goal_lanelet = llt;
-      return true;
-    }
+  if (route_lanelet_ids_.count(goal_lane_id) == 0) {
+    return false;
   }
-  return false;
+  *goal_lanelet = lanelet_map_ptr_->laneletLayer.get(goal_lane_id);
+  return true;
 }
 
 bool RouteHandler::isInGoalRouteSection(const lanelet::ConstLanelet & lanelet) const
 {
-  if (route_msg_.segments.empty()) {
-    return false;
-  } else {
-    return exists(route_msg_.segments.back().primitives, lanelet.id());
-  }
+  return goal_section_lanelet_ids_.count(lanelet.id()) > 0;
 }
 
 lanelet::ConstLanelets RouteHandler::getLaneletsFromIds(const lanelet::Ids ids) const
@@ -464,7 +479,7 @@ lanelet::ConstLanelets RouteHandler::getLaneletSequenceAfter(
   const lanelet::ConstLanelet & lanelet, const double min_length) const
 {
   lanelet::ConstLanelets lanelet_sequence_forward;
-  if (!exists(route_lanelets_, lanelet)) {
+  if (!isRouteLanelet(lanelet)) {
     return lanelet_sequence_forward;
   }
 
@@ -487,7 +502,7 @@ lanelet::ConstLanelets RouteHandler::getLaneletSequenceUpTo(
   const lanelet::ConstLanelet & lanelet, const double min_length) const
 {
   lanelet::ConstLanelets lanelet_sequence_backward;
-  if (!exists(route_lanelets_, lanelet)) {
+  if (!isRouteLanelet(lanelet)) {
     return lanelet_sequence_backward;
   }
 
@@ -521,7 +536,7 @@ lanelet::ConstLanelets RouteHandler::getLaneletSequence(
   lanelet::ConstLanelets lanelet_sequence;
   lanelet::ConstLanelets lanelet_sequence_backward;
   lanelet::ConstLanelets lanelet_sequence_forward;
-  if (!exists(route_lanelets_, lanelet)) {
+  if (!isRouteLanelet(lanelet)) {
     return lanelet_sequence;
   }
 
@@ -554,7 +569,7 @@ lanelet::ConstLanelets RouteHandler::getLaneletSequence(
   lanelet::ConstLanelets lanelet_sequence;
   lanelet::ConstLanelets lanelet_sequence_backward;
   lanelet::ConstLanelets lanelet_sequence_forward;
-  if (!exists(route_lanelets_, lanelet)) {
+  if (!isRouteLanelet(lanelet)) {
     return lanelet_sequence;
   }
 
@@ -611,7 +626,7 @@ lanelet::ConstLanelets RouteHandler::getShoulderLaneletSequenceAfter(
   const lanelet::ConstLanelet & lanelet, const double min_length) const
 {
   lanelet::ConstLanelets lanelet_sequence_forward;
-  if (!exists(shoulder_lanelets_, lanelet)) {
+  if (shoulder_lanelet_ids_.count(lanelet.id()) == 0) {
     return lanelet_sequence_forward;
   }
 
@@ -661,7 +676,7 @@ lanelet::ConstLanelets RouteHandler::getShoulderLaneletSequenceUpTo(
   const lanelet::ConstLanelet & lanelet, const double min_length) const
 {
   lanelet::ConstLanelets lanelet_sequence_backward;
-  if (!exists(shoulder_lanelets_, lanelet)) {
+  if (shoulder_lanelet_ids_.count(lanelet.id()) == 0) {
     return lanelet_sequence_backward;
   }
 
@@ -688,7 +703,7 @@ lanelet::ConstLanelets RouteHandler::getShoulderLaneletSequence(
   lanelet::ConstLanelets lanelet_sequence;
   lanelet::ConstLanelets lanelet_sequence_backward;
   lanelet::ConstLanelets lanelet_sequence_forward;
-  if (!exists(shoulder_lanelets_, lanelet)) {
+  if (shoulder_lanelet_ids_.count(lanelet.id()) == 0) {
     return lanelet_sequence;
   }
 
@@ -721,36 +736,73 @@ bool RouteHandler::getClosestLaneletWithinRoute(
   return lanelet::utils::query::getClosestLanelet(route_lanelets_, search_pose, closest_lanelet);
 }
 
+bool RouteHandler::isRouteLanelet(const lanelet::ConstLanelet & lanelet) const
+{
+  return route_lanelet_ids_.count(lanelet.id()) > 0;
+}
+
+lanelet::ConstLanelets RouteHandler::getFollowingLaneletsWithinRoute(
+  const lanelet::ConstLanelet & lanelet) const
+{
+  const auto itr = following_lanelets_within_route_.find(lanelet.id());
+  if (itr != following_lanelets_within_route_.end()) {
+    return itr->second;
+  }
+
+  // lanelets out of the route are not in the table
+  lanelet::ConstLanelets following_lanelets;
+  for (const auto & llt : routing_graph_ptr_->following(lanelet)) {
+    if (isRouteLanelet(llt)) {
+      following_lanelets.push_back(llt);
+    }
+  }
+  return following_lanelets;
+}
+
+lanelet::ConstLanelets RouteHandler::getPreviousLaneletsWithinRoute(
+  const lanelet::ConstLanelet & lanelet) const
+{
+  const auto itr = previous_lanelets_within_route_.find(lanelet.id());
+  if (itr != previous_lanelets_within_route_.end()) {
+    return itr->second;
+  }
+
+  // lanelets out of the route are not in the table
+  lanelet::ConstLanelets previous_lanelets;
+  for (const auto & llt : routing_graph_ptr_->previous(lanelet)) {
+    if (isRouteLanelet(llt)) {
+      previous_lanelets.push_back(llt);
+    }
+  }
+  return previous_lanelets;
+}
+
 bool RouteHandler::getNextLaneletWithinRoute(
   const lanelet::ConstLanelet & lanelet, lanelet::ConstLanelet * next_lanelet) const
 {
-  if (exists(goal_lanelets_, lanelet)) {
+  if (goal_lanelet_ids_.count(lanelet.id()) > 0) {
     return false;
   }
-  lanelet::ConstLanelets following_lanelets = routing_graph_ptr_->following(lanelet);
-  for (const auto & llt : following_lanelets) {
-    if (exists(route_lanelets_, llt)) {
-      *next_lanelet = llt;
-      return true;
-    }
+  const auto following_lanelets = getFollowingLaneletsWithinRoute(lanelet);
+  if (following_lanelets.empty()) {
+    return false;
   }
-  return false;
+  *next_lanelet = following_lanelets.front();
+  return true;
 }
 
 bool RouteHandler::getPreviousLaneletWithinRoute(
   const lanelet::ConstLanelet & lanelet, lanelet::ConstLanelet * prev_lanelet) const
 {
-  if (exists(start_lanelets_, lanelet)) {
+  if (start_lanelet_ids_.count(lanelet.id()) > 0) {
     return false;
   }
-  lanelet::ConstLanelets previous_lanelets = routing_graph_ptr_->previous(lanelet);
-  for (const auto & llt : previous_lanelets) {
-    if (exists(route_lanelets_, llt)) {
-      *prev_lanelet = llt;
-      return true;
-    }
+  const auto previous_lanelets = getPreviousLaneletsWithinRoute(lanelet);
+  if (previous_lanelets.empty()) {
+    return false;
   }
-  return false;
+  *prev_lanelet = previous_lanelets.front();
+  return true;
 }
 
 bool RouteHandler::getRightLaneletWithinRoute(
@@ -759,7 +811,7 @@ bool RouteHandler::getRightLaneletWithinRoute(
   auto opt_right_lanelet = routing_graph_ptr_->right(lanelet);
   if (!!opt_right_lanelet) {
     *right_lanelet = opt_right_lanelet.get();
-    return exists(route_lanelets_, *right_lanelet);
+    return isRouteLanelet(*right_lanelet);
   } else {
     return false;
   }
@@ -768,12 +820,11 @@ bool RouteHandler::getRightLaneletWithinRoute(
 bool RouteHandler::getNextLaneletWithinRouteExceptStart(
   const lanelet::ConstLanelet & lanelet, lanelet::ConstLanelet * next_lanelet) const
 {
-  if (exists(goal_lanelets_, lanelet)) {
+  if (goal_lanelet_ids_.count(lanelet.id()) > 0) {
     return false;
   }
-  lanelet::ConstLanelets following_lanelets = routing_graph_ptr_->following(lanelet);
-  for (const auto & llt : following_lanelets) {
-    if (exists(route_lanelets_, llt) && !exists(start_lanelets_, llt)) {
+  for (const auto & llt : getFollowingLaneletsWithinRoute(lanelet)) {
+    if (start_lanelet_ids_.count(llt.id()) == 0) {
       *next_lanelet = llt;
       return true;
     }
@@ -784,12 +835,11 @@ bool RouteHandler::getNextLaneletWithinRouteExceptStart(
 bool RouteHandler::getPreviousLaneletWithinRouteExceptGoal(
   const lanelet::ConstLanelet & lanelet, lanelet::ConstLanelet * prev_lanelet) const
 {
-  if (exists(start_lanelets_, lanelet)) {
+  if (start_lanelet_ids_.count(lanelet.id()) > 0) {
     return false;
   }
-  lanelet::ConstLanelets previous_lanelets = routing_graph_ptr_->previous(lanelet);
-  for (const auto & llt : previous_lanelets) {
-    if (exists(route_lanelets_, llt) && !(exists(goal_lanelets_, llt))) {
+  for (const auto & llt : getPreviousLaneletsWithinRoute(lanelet)) {
+    if (goal_lanelet_ids_.count(llt.id()) == 0) {
       *prev_lanelet = llt;
       return true;
     }
@@ -835,7 +885,7 @@ bool RouteHandler::getLeftLaneletWithinRoute(
   auto opt_left_lanelet = routing_graph_ptr_->left(lanelet);
   if (!!opt_left_lanelet) {
     *left_lanelet = opt_left_lanelet.get();
-    return exists(route_lanelets_, *left_lanelet);
+    return isRouteLanelet(*left_lanelet);
   } else {
     return false;
   }
@@ -915,14 +965,14 @@ lanelet::ConstLanelets RouteHandler::getClosestLaneletSequence(const Pose & pose
 int RouteHandler::getNumLaneToPreferredLane(const lanelet::ConstLanelet & lanelet) const
 {
   int num = 0;
-  if (exists(preferred_lanelets_, lanelet)) {
+  if (preferred_lanelet_ids_.count(lanelet.id()) > 0) {
     return num;
   }
   const auto & right_lanes =
     lanelet::utils::query::getAllNeighborsRight(routing_graph_ptr_, lanelet);
   for (const auto & right : right_lanes) {
     num--;
-    if (exists(preferred_lanelets_, right)) {
+    if (preferred_lanelet_ids_.count(right.id()) > 0) {
       return num;
     }
   }
@@ -930,7 +980,7 @@ int RouteHandler::getNumLaneToPreferredLane(const lanelet::ConstLanelet & lanele
   num = 0;
   for (const auto & left : left_lanes) {
     num++;
-    if (exists(preferred_lanelets_, left)) {
+    if (preferred_lanelet_ids_.count(left.id()) > 0) {
       return num;
     }
   }
@@ -944,7 +994,7 @@ bool RouteHandler::isInPreferredLane(const PoseStamped & pose) const
   if (!getClosestLaneletWithinRoute(pose.pose, &lanelet)) {
     return false;
   }
-  return exists(preferred_lanelets_, lanelet);
+  return preferred_lanelet_ids_.count(lanelet.id()) > 0;
 }
 bool RouteHandler::isInTargetLane(
   const PoseStamped & pose, const lanelet::ConstLanelets & target) const
@@ -956,46 +1006,103 @@ bool RouteHandler::isInTargetLane(
   return exists(target, lanelet);
 }
 
-PathWithLaneId RouteHandler::getCenterLinePath(
-  const lanelet::ConstLanelets & lanelet_sequence, const double s_start, const double s_end,
-  bool use_exact) const
+std::shared_ptr<const RouteHandler::CenterLine> RouteHandler::getCenterLine(
+  const lanelet::ConstLanelets & lanelet_sequence) const
 {
-  PathWithLaneId reference_path{};
-  double s = 0;
-
+  lanelet::Ids lanelet_ids;
+  lanelet_ids.reserve(lanelet_sequence.size());
   for (const auto & llt : lanelet_sequence) {
-    lanelet::traffic_rules::SpeedLimitInformation limit = traffic_rules_ptr_->speedLimit(llt);
-    const lanelet::ConstLineString3d centerline = llt.centerline();
+    lanelet_ids.push_back(llt.id());
+  }
 
-    const auto addPathPoint = [&reference_path, &limit, &llt](const auto & pt) {
-      PathPointWithLaneId p{};
-      p.point.pose.position = lanelet::utils::conversion::toGeomMsgPt(pt);
-      p.lane_ids.push_back(llt.id());
-      p.point.longitudinal_velocity_mps = limit.speedLimit.value();
-      reference_path.points.push_back(p);
-    };
+  std::lock_guard<std::mutex> lock(centerline_cache_mutex_);
+  const auto itr = centerline_cache_.find(lanelet_ids);
+  if (itr != centerline_cache_.end()) {
+    return itr->second;
+  }
 
+  auto centerline_ptr = std::make_shared<CenterLine>();
+  auto & cache = *centerline_ptr;
+  double s = 0;
+  for (const auto & llt : lanelet_sequence) {
+    const lanelet::traffic_rules::SpeedLimitInformation limit = traffic_rules_ptr_->speedLimit(llt);
+    const lanelet::ConstLineString3d centerline = llt.centerline();
     for (size_t i = 0; i < centerline.size(); i++) {
       const lanelet::ConstPoint3d pt = centerline[i];
-      lanelet::ConstPoint3d next_pt =
+      const lanelet::ConstPoint3d next_pt =
         (i + 1 < centerline.size()) ? centerline[i + 1] : centerline[i];
-      double distance = lanelet::geometry::distance2d(to2D(pt), to2D(next_pt));
-
-      if (s < s_start && s + distance > s_start) {
-        const auto p = use_exact ? get3DPointFrom2DArcLength(lanelet_sequence, s_start) : pt;
-        addPathPoint(p);
-      }
-      if (s >= s_start && s <= s_end) {
-        addPathPoint(pt);
-      }
-      if (s < s_end && s + distance > s_end) {
-        const auto p = use_exact ? get3DPointFrom2DArcLength(lanelet_sequence, s_end) : next_pt;
-        addPathPoint(p);
-      }
+      const double distance = lanelet::geometry::distance2d(to2D(pt), to2D(next_pt));
+      cache.points.push_back(pt.basicPoint());
+      cache.lane_ids.push_back(llt.id());
+      cache.speed_limits.push_back(limit.speedLimit.value());
+      cache.arc_lengths.push_back(s);
+      cache.distances.push_back(distance);
       s += distance;
     }
   }
 
+  // the sequences change as the vehicle moves, so old ones are dropped all at once
+  if (centerline_cache_.size() >= max_centerline_cache_size_) {
+    centerline_cache_.clear();
+  }
+  centerline_cache_.emplace(std::move(lanelet_ids), centerline_ptr);
+  return centerline_ptr;
+}
+
+PathWithLaneId RouteHandler::getCenterLinePath(
+  const lanelet::ConstLanelets & lanelet_sequence, const double s_start, const double s_end,
+  bool use_exact) const
+{
+  PathWithLaneId reference_path{};
+  const auto centerline_ptr = getCenterLine(lanelet_sequence);
+  const auto & centerline = *centerline_ptr;
+  const auto & arc_lengths = centerline.arc_lengths;
+  const auto & distances = centerline.distances;
+
+  const auto addPathPoint = [&reference_path, &centerline](
+                              const size_t idx, const lanelet::BasicPoint3d & pt) {
+    PathPointWithLaneId p{};
+    p.point.pose.position = lanelet::utils::conversion::toGeomMsgPt(pt);
+    p.lane_ids.push_back(centerline.lane_ids.at(idx));
+    p.point.longitudinal_velocity_mps = centerline.speed_limits.at(idx);
+    reference_path.points.push_back(p);
+  };
+  // point at the arc length s on the segment from idx
+  const auto interpolate = [&centerline](const size_t idx, const double s) {
+    const double ratio = (s - centerline.arc_lengths.at(idx)) / centerline.distances.at(idx);
+    const lanelet::BasicPoint3d pt =
+      centerline.points.at(idx) * (1 - ratio) + centerline.points.at(idx + 1) * ratio;
+    return pt;
+  };
+
+  // only the points whose segment ends after s_start and which start before s_end are used.
+  // A segment ends at the arc length of the next point, including the last one of a lanelet.
+  const double s_min = std::min(s_start, s_end);
+  const double s_max = std::max(s_start, s_end);
+  const size_t begin_idx =
+    arc_lengths.empty()
+      ? 0
+      : static_cast<size_t>(
+          std::lower_bound(arc_lengths.begin() + 1, arc_lengths.end(), s_min) -
+          arc_lengths.begin() - 1);
+  const size_t end_idx = static_cast<size_t>(
+    std::upper_bound(arc_lengths.begin(), arc_lengths.end(), s_max) - arc_lengths.begin());
+
+  for (size_t i = begin_idx; i < end_idx; i++) {
+    const double s = arc_lengths.at(i);
+    const double distance = distances.at(i);
+    // a segment with length has the next point in the same lanelet
+    if (s < s_start && s + distance > s_start) {
+      addPathPoint(i, use_exact ? interpolate(i, s_start) : centerline.points.at(i));
+    }
+    if (s >= s_start && s <= s_end) {
+      addPathPoint(i, centerline.points.at(i));
+    }
+    if (s < s_end && s + distance > s_end) {
+      addPathPoint(i, use_exact ? interpolate(i, s_end) : centerline.points.at(i + 1));
+    }
+  }
+
   reference_path = removeOverlappingPoints(reference_path);
 
   // append a point only when having one point so that yaw calculation would work
@@ -1215,7 +1322,7 @@ lanelet::ConstLanelets RouteHandler::getPreviousLaneletSequence(
   }
 
   auto first_lane = lanelet_sequence.front();
-  if (exists(start_lanelets_, first_lane)) {
+  if (start_lanelet_ids_.count(first_lane.id()) > 0) {
     return previous_lanelet_sequence;
   }
 
@@ -1253,7 +1360,7 @@ lanelet::ConstLanelets RouteHandler::getLaneSequenceUpTo(
   const lanelet::ConstLanelet & lanelet) const
 {
   lanelet::ConstLanelets lane_sequence_backward;
-  if (!exists(route_lanelets_, lanelet)) {
+  if (!isRouteLanelet(lanelet)) {
     return lane_sequence_backward;
   }
 
@@ -1281,7 +1388,7 @@ lanelet::ConstLanelets RouteHandler::getLaneSequenceAfter(
   const lanelet::ConstLanelet & lanelet) const
 {
   lanelet::ConstLanelets lane_sequence_forward;
-  if (!exists(route_lanelets_, lanelet)) {
+  if (!isRouteLanelet(lanelet)) {
     return lane_sequence_forward;
   }
   lane_sequence_forward.push_back(lanelet);
@@ -1312,7 +1419,7 @@ lanelet::ConstLanelets RouteHandler::getNeighborsWithinRoute(
     lanelet::utils::query::getAllNeighbors(routing_graph_ptr_, lanelet);
   lanelet::ConstLanelets neighbors_within_route;
   for (const auto & llt : neighbor_lanelets) {
-    if (exists(route_lanelets_, llt)) {
+    if (isRouteLanelet(llt)) {
       neighbors_within_route.push_back(llt);
     }
   }
@@ -17,6 +17,7 @@
 
 #include "autoware_utils/geometry/geometry.hpp"
 #include "autoware_utils/math/unit_conversion.hpp"
+#include "autoware_utils/ros/processing_time_publisher.hpp"
 #include "autoware_utils/ros/self_pose_listener.hpp"
 #include "autoware_utils/system/stop_watch.hpp"
 #include "autoware_utils/trajectory/tmp_conversion.hpp"
@@ -38,6 +39,7 @@
 #include "nav_msgs/msg/odometry.hpp"
 
 #include <iostream>
+#include <map>
 #include <memory>
 #include <string>
 #include <tuple>
@@ -48,6 +50,7 @@
 // *INDENT-ON*
 #include "motion_velocity_smoother/smoother/smoother_base.hpp"
 #include "motion_velocity_smoother/trajectory_utils.hpp"
+#include "motion_velocity_smoother/trajectory_workspace.hpp"
 
 namespace motion_velocity_smoother
 {
@@ -92,6 +95,13 @@ private:
 
   autoware_utils::SelfPoseListener self_pose_listener_{this};
 
+  // buffers reused across cycles
+  TrajectoryPoints input_points_;      // input trajectory
+  TrajectoryPoints extracted_points_;  // input trajectory around ego vehicle
+  TrajectoryPoints clipped_points_;    // resampled trajectory from the closest point
+  TrajectoryPoints output_points_;     // smoothed trajectory
+  TrajectoryWorkspace workspace_;      // trajectory of the current stage
+
   enum class AlgorithmType {
     INVALID = 0,
     JERK_FILTERED = 1,
@@ -164,15 +174,26 @@ private:
 
   AlgorithmType getAlgorithmType(const std::string & algorithm_name) const;
 
-  TrajectoryPoints calcTrajectoryVelocity(const TrajectoryPoints & input) const;
+  // non-const methods working on the reused buffers
+  // return the arc length of the point closest to ego vehicle in the output,
+  // or none when the velocity could not be calculated and prev_output_ should be used instead.
+  boost::optional<double> calcTrajectoryVelocity(
+    const TrajectoryPoints & input, TrajectoryPoints & output);
+
+  boost::optional<double> smoothVelocity(
+    const TrajectoryPoints & input, const double input_closest_arc_length,
+    TrajectoryPoints & traj_smoothed);
 
-  bool smoothVelocity(const TrajectoryPoints & input, TrajectoryPoints & traj_smoothed) const;
+  // closest index to ego vehicle in workspace_,
+  // searched around arc_length_hint if it is given.
+  boost::optional<size_t> findNearestIndexFromWorkspace(
+    const boost::optional<double> & arc_length_hint = boost::none) const;
 
   std::tuple<double, double, InitializeType> calcInitialMotion(
     const TrajectoryPoints & input_traj, const size_t input_closest,
     const TrajectoryPoints & prev_traj) const;
 
-  void applyExternalVelocityLimit(TrajectoryPoints & traj) const;
+  void applyExternalVelocityLimit(const size_t closest_idx, TrajectoryPoints & traj) const;
 
   void insertBehindVelocity(
     const size_t output_closest, const InitializeType type, TrajectoryPoints & output) const;
@@ -187,6 +208,8 @@ private:
 
   void publishDebugTrajectories(const std::vector<TrajectoryPoints> & debug_trajectories) const;
 
+  void publishQPSolverStatus();
+
   void publishClosestVelocity(
     const TrajectoryPoints & trajectory, const Pose & current_pose,
     const rclcpp::Publisher<Float32Stamped>::SharedPtr pub) const;
@@ -209,6 +232,8 @@ private:
 
   // debug
   autoware_utils::StopWatch<std::chrono::milliseconds> stop_watch_;
+  std::map<std::string, double> processing_time_map_;  // [ms] for each stage
+  autoware_utils::ProcessingTimePublisher processing_time_publisher_{this};
   std::shared_ptr<rclcpp::Time> prev_time_;
   double prev_acc_;
   rclcpp::Publisher<Float32Stamped>::SharedPtr pub_dist_to_stopline_;
@@ -228,6 +253,7 @@ private:
   rclcpp::Publisher<Trajectory>::SharedPtr pub_backward_filtered_trajectory_;
   rclcpp::Publisher<Trajectory>::SharedPtr pub_merged_filtered_trajectory_;
   rclcpp::Publisher<Float32Stamped>::SharedPtr pub_closest_merged_velocity_;
+  rclcpp::Publisher<Float32Stamped>::SharedPtr pub_qp_solver_iterations_;
 };
 }  // namespace motion_velocity_smoother
 
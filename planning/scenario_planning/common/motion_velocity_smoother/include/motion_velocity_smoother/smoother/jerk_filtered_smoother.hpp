@@ -40,6 +40,14 @@ public:
     double jerk_filter_ds;
   };
 
+  struct QPSolverStatus
+  {
+    int64_t iterations{0};            // iterations taken by the latest solve
+    double solve_time_ms{0.0};        // [ms] run time of the latest solve reported by the solver
+    bool is_workspace_reused{false};  // the problem was updated without setting up the solver
+    bool is_warm_started{false};      // the previous solution was used as the initial value
+  };
+
   explicit JerkFilteredSmoother(const Param & p);
 
   bool apply(
@@ -51,9 +59,18 @@ public:
 
   void setParam(const Param & param);
 
+  const QPSolverStatus & getQPSolverStatus() const { return qp_solver_status_; }
+
 private:
   Param smoother_param_;
   autoware::common::osqp::OSQPInterface qp_solver_;
+  QPSolverStatus qp_solver_status_;
+
+  // the latest successful solution, which is used for the warm start of the next cycle
+  TrajectoryPoints prev_solution_points_;
+  std::vector<double> prev_solution_arc_length_;
+  std::vector<double> prev_primal_solution_;
+  std::vector<double> prev_dual_solution_;
   rclcpp::Logger logger_{rclcpp::get_logger("smoother").get_child("jerk_filtered_smoother")};
 
   TrajectoryPoints forwardJerkFilter(
@@ -62,6 +79,7 @@ private:
   TrajectoryPoints backwardJerkFilter(
     const double v0, const double a0, const double a_min, const double a_stop, const double j_min,
     const TrajectoryPoints & input) const;
+  bool setWarmStart(const TrajectoryPoints & trajectory, const std::vector<double> & arc_length);
   TrajectoryPoints mergeFilteredTrajectory(
     const double v0, const double a0, const double a_min, const double j_min,
     const TrajectoryPoints & forward_filtered, const TrajectoryPoints & backward_filtered) const;
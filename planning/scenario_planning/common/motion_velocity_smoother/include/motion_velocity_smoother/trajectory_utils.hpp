@@ -44,6 +44,14 @@ boost::optional<TrajectoryPoints> extractPathAroundIndex(
   const TrajectoryPoints & trajectory, const size_t index, const double & ahead_length,
   const double & behind_length);
 
+/**
+ * @brief same as extractPathAroundIndex() but writes into extracted_traj to reuse its capacity.
+ * @return index in extracted_traj of the point at the given index
+ */
+boost::optional<size_t> extractPathAroundIndex(
+  const TrajectoryPoints & trajectory, const size_t index, const double & ahead_length,
+  const double & behind_length, TrajectoryPoints & extracted_traj);
+
 double calcArcLength(const TrajectoryPoints & trajectory, const int idx1, const int idx2);
 
 std::vector<double> calcArclengthArray(const TrajectoryPoints & trajectory);
@@ -0,0 +1,80 @@
+// Copyright 2021 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef MOTION_VELOCITY_SMOOTHER__TRAJECTORY_WORKSPACE_HPP_
+#define MOTION_VELOCITY_SMOOTHER__TRAJECTORY_WORKSPACE_HPP_
+
+#include "autoware_auto_planning_msgs/msg/trajectory_point.hpp"
+#include "geometry_msgs/msg/pose.hpp"
+#include "geometry_msgs/msg/quaternion.hpp"
+
+#include "boost/optional.hpp"
+
+#include <vector>
+
+namespace motion_velocity_smoother
+{
+using autoware_auto_planning_msgs::msg::TrajectoryPoint;
+using TrajectoryPoints = std::vector<TrajectoryPoint>;
+using geometry_msgs::msg::Pose;
+using geometry_msgs::msg::Quaternion;
+
+/**
+ * @brief Cache for the closest point search of each stage of the smoother, holding the arc
+ *        length, position and orientation of the trajectory. The stages themselves still work on
+ *        TrajectoryPoints. It is kept by the node and refilled by every stage, so the buffers are
+ *        allocated only when the trajectory becomes longer than ever before. The yaw is computed
+ *        only for the points near enough to the searched pose.
+ */
+class TrajectoryWorkspace
+{
+public:
+  void assign(const TrajectoryPoints & points);
+
+  size_t size() const { return s_.size(); }
+  bool empty() const { return s_.empty(); }
+
+  const std::vector<double> & s() const { return s_; }  // arc length from the first point [m]
+  const std::vector<double> & x() const { return x_; }
+  const std::vector<double> & y() const { return y_; }
+
+  /**
+   * @brief same as autoware_utils::findNearestIndex() with the pose, max_dist and max_yaw.
+   */
+  boost::optional<size_t> findNearestIndex(
+    const Pose & pose, const double max_dist, const double max_yaw) const;
+
+  /**
+   * @brief findNearestIndex() over the points within search_length of arc length from
+   *        arc_length_hint and the points just outside of it. The whole trajectory is searched
+   *        when none of them satisfies max_dist and max_yaw.
+   * @param arc_length_hint arc length of the nearest point in the previous stage of the same cycle
+   */
+  boost::optional<size_t> findNearestIndex(
+    const Pose & pose, const double max_dist, const double max_yaw, const double arc_length_hint,
+    const double search_length) const;
+
+private:
+  std::vector<double> s_;
+  std::vector<double> x_;
+  std::vector<double> y_;
+  std::vector<Quaternion> orientation_;
+
+  boost::optional<size_t> findNearestIndexInRange(
+    const Pose & pose, const double max_dist, const double max_yaw, const size_t begin,
+    const size_t end) const;
+};
+}  // namespace motion_velocity_smoother
+
+#endif  // MOTION_VELOCITY_SMOOTHER__TRAJECTORY_WORKSPACE_HPP_
@@ -58,6 +58,8 @@ MotionVelocitySmootherNode::MotionVelocitySmootherNode(const rclcpp::NodeOptions
         create_publisher<Trajectory>("~/debug/merged_filtered_trajectory", 1);
       pub_closest_merged_velocity_ =
         create_publisher<Float32Stamped>("~/closest_merged_velocity", 1);
+      pub_qp_solver_iterations_ =
+        create_publisher<Float32Stamped>("~/debug/qp_solver_iterations", 1);
       break;
     }
     case AlgorithmType::L2: {
@@ -454,17 +456,21 @@ void MotionVelocitySmootherNode::onCurrentTrajectory(const Trajectory::ConstShar
   }
 
   // calculate trajectory velocity
-  TrajectoryPoints output =
-    calcTrajectoryVelocity(autoware_utils::convertToTrajectoryPointArray(*base_traj_raw_ptr_));
+  processing_time_map_.clear();
+  input_points_.assign(base_traj_raw_ptr_->points.begin(), base_traj_raw_ptr_->points.end());
+  const auto output_closest_arc_length = calcTrajectoryVelocity(input_points_, output_points_);
+  // the previous output is used again when the velocity could not be calculated
+  const auto & output = output_closest_arc_length ? output_points_ : prev_output_;
   if (output.empty()) {
     RCLCPP_WARN(get_logger(), "Output Point is empty");
     return;
   }
 
+  stop_watch_.tic("post_process");
+
   // Get the nearest point
-  const auto output_closest_idx = autoware_utils::findNearestIndex(
-    output, current_pose_ptr_->pose, std::numeric_limits<double>::max(),
-    node_param_.delta_yaw_threshold);
+  workspace_.assign(output);
+  const auto output_closest_idx = findNearestIndexFromWorkspace(output_closest_arc_length);
   const auto output_closest_point =
     trajectory_utils::calcInterpolatedTrajectoryPoint(output, current_pose_ptr_->pose);
   if (!output_closest_idx) {
@@ -486,6 +492,7 @@ void MotionVelocitySmootherNode::onCurrentTrajectory(const Trajectory::ConstShar
   if (!output_resampled->empty()) {
     output_resampled->back().longitudinal_velocity_mps = 0.0;
   }
+  processing_time_map_["post_process"] = stop_watch_.toc("post_process");
 
   // publish message
   publishTrajectory(*output_resampled);
@@ -494,7 +501,10 @@ void MotionVelocitySmootherNode::onCurrentTrajectory(const Trajectory::ConstShar
   publishStopDistance(output, *output_closest_idx);
   publishClosestState(output_closest_point);
 
-  prev_output_ = output;
+  // keep the output and reuse the buffer of the previous one in the next cycle
+  if (output_closest_arc_length) {
+    prev_output_.swap(output_points_);
+  }
   prev_closest_point_ = output_closest_point;
 
   // Publish Calculation Time
@@ -502,73 +512,73 @@ void MotionVelocitySmootherNode::onCurrentTrajectory(const Trajectory::ConstShar
   calculation_time_data.stamp = this->now();
   calculation_time_data.data = stop_watch_.toc();
   debug_calculation_time_->publish(calculation_time_data);
+  processing_time_map_["total"] = calculation_time_data.data;
+  processing_time_publisher_.publish(processing_time_map_);
   RCLCPP_DEBUG(get_logger(), "run: calculation time = %f [ms]", calculation_time_data.data);
   RCLCPP_DEBUG(get_logger(), "========================== run() end ==========================\n\n");
 }
 
-TrajectoryPoints MotionVelocitySmootherNode::calcTrajectoryVelocity(
-  const TrajectoryPoints & traj_input) const
+boost::optional<double> MotionVelocitySmootherNode::calcTrajectoryVelocity(
+  const TrajectoryPoints & traj_input, TrajectoryPoints & output)
 {
-  TrajectoryPoints output{};  // velocity is optimized by qp solver
+  stop_watch_.tic("extract");
 
   // Extract trajectory around self-position with desired forward-backward length
-  const auto input_closest = autoware_utils::findNearestIndex(
-    traj_input, current_pose_ptr_->pose, std::numeric_limits<double>::max(),
-    node_param_.delta_yaw_threshold);
+  workspace_.assign(traj_input);
+  const auto input_closest = findNearestIndexFromWorkspace();
   if (!input_closest) {
     auto clock{rclcpp::Clock{RCL_ROS_TIME}};
     RCLCPP_WARN_THROTTLE(
       get_logger(), clock, 5000, "Cannot find the closest point from input trajectory");
-    return prev_output_;
+    return {};
   }
 
-  auto traj_extracted = trajectory_utils::extractPathAroundIndex(
-    traj_input, *input_closest, node_param_.extract_ahead_dist, node_param_.extract_behind_dist);
-  if (!traj_extracted) {
+  // The extracted trajectory is a part of the input, so the closest point is the same one.
+  auto & traj_extracted = extracted_points_;
+  const auto traj_extracted_closest = trajectory_utils::extractPathAroundIndex(
+    traj_input, *input_closest, node_param_.extract_ahead_dist, node_param_.extract_behind_dist,
+    traj_extracted);
+  if (!traj_extracted_closest) {
     RCLCPP_WARN(get_logger(), "Fail to extract the path from the input trajectory");
-    return prev_output_;
+    return {};
   }
+  const double traj_extracted_closest_arc_length =
+    workspace_.s().at(*input_closest) - workspace_.s().at(*input_closest - *traj_extracted_closest);
 
   // Smoother can not handle negative velocity,
   // so multiple -1 to velocity if any trajectory points have reverse
   // velocity
   const bool is_reverse = std::any_of(
-    traj_extracted->begin(), traj_extracted->end(),
+    traj_extracted.begin(), traj_extracted.end(),
     [](auto & pt) { return pt.longitudinal_velocity_mps < 0; });
   if (is_reverse) {
-    for (auto & pt : *traj_extracted) {
+    for (auto & pt : traj_extracted) {
       pt.longitudinal_velocity_mps *= -1.0;
     }
   }
 
   // Debug
   if (publish_debug_trajs_) {
-    pub_trajectory_raw_->publish(toTrajectoryMsg(*traj_extracted, base_traj_raw_ptr_->header));
+    pub_trajectory_raw_->publish(toTrajectoryMsg(traj_extracted, base_traj_raw_ptr_->header));
   }
 
   // Apply external velocity limit
-  applyExternalVelocityLimit(*traj_extracted);
-
-  // Change trajectory velocity to zero when current_velocity == 0 & stop_dist is close
-  const auto traj_extracted_closest = autoware_utils::findNearestIndex(
-    *traj_extracted, current_pose_ptr_->pose, std::numeric_limits<double>::max(),
-    node_param_.delta_yaw_threshold);
-  if (!traj_extracted_closest) {
-    RCLCPP_WARN(get_logger(), "Cannot find the closest point from extracted trajectory");
-    return prev_output_;
-  }
+  applyExternalVelocityLimit(*traj_extracted_closest, traj_extracted);
 
   // Apply velocity to approach stop point
-  applyStopApproachingVelocity(*traj_extracted);
+  applyStopApproachingVelocity(traj_extracted);
 
   // Debug
   if (publish_debug_trajs_) {
-    pub_trajectory_vel_lim_->publish(toTrajectoryMsg(*traj_extracted, base_traj_raw_ptr_->header));
+    pub_trajectory_vel_lim_->publish(toTrajectoryMsg(traj_extracted, base_traj_raw_ptr_->header));
   }
+  processing_time_map_["extract"] = stop_watch_.toc("extract");
 
   // Smoothing velocity
-  if (!smoothVelocity(*traj_extracted, output)) {
-    return prev_output_;
+  const auto output_closest_arc_length =
+    smoothVelocity(traj_extracted, traj_extracted_closest_arc_length, output);
+  if (!output_closest_arc_length) {
+    return {};
   }
 
   // for reverse velocity
@@ -578,28 +588,40 @@ TrajectoryPoints MotionVelocitySmootherNode::calcTrajectoryVelocity(
     }
   }
 
-  return output;
+  return output_closest_arc_length;
 }
 
-bool MotionVelocitySmootherNode::smoothVelocity(
-  const TrajectoryPoints & input, TrajectoryPoints & traj_smoothed) const
+boost::optional<double> MotionVelocitySmootherNode::smoothVelocity(
+  const TrajectoryPoints & input, const double input_closest_arc_length,
+  TrajectoryPoints & traj_smoothed)
 {
   // Lateral acceleration limit
+  stop_watch_.tic("lateral_acceleration_filter");
   const auto traj_lateral_acc_filtered = smoother_->applyLateralAccelerationFilter(input);
   if (!traj_lateral_acc_filtered) {
-    return false;
+    return {};
   }
+  processing_time_map_["lateral_acceleration_filter"] =
+    stop_watch_.toc("lateral_acceleration_filter");
 
   // Resample trajectory with ego-velocity based interval distance
-  const auto traj_pre_resampled_closest = autoware_utils::findNearestIndex(
-    *traj_lateral_acc_filtered, current_pose_ptr_->pose, std::numeric_limits<double>::max(),
-    node_param_.delta_yaw_threshold);
+  // The filter and the resampling keep the arc length from the first point, so the closest point
+  // is searched around the closest point of the previous stage.
+  stop_watch_.tic("resample");
+  workspace_.assign(*traj_lateral_acc_filtered);
+  const auto traj_pre_resampled_closest = findNearestIndexFromWorkspace(input_closest_arc_length);
+  if (!traj_pre_resampled_closest) {
+    RCLCPP_WARN(get_logger(), "Cannot find closest waypoint for lateral acc filtered trajectory");
+    return {};
+  }
+  const double traj_pre_resampled_closest_arc_length =
+    workspace_.s().at(*traj_pre_resampled_closest);
   auto traj_resampled = smoother_->resampleTrajectory(
     *traj_lateral_acc_filtered, current_odometry_ptr_->twist.twist.linear.x,
     *traj_pre_resampled_closest);
   if (!traj_resampled) {
     RCLCPP_WARN(get_logger(), "Fail to do resampling before the optimization");
-    return false;
+    return {};
   }
 
   // Set 0[m/s] in the terminal point
@@ -614,26 +636,35 @@ bool MotionVelocitySmootherNode::smoothVelocity(
   double initial_vel{};
   double initial_acc{};
   InitializeType type{};
-  const auto traj_resampled_closest = autoware_utils::findNearestIndex(
-    *traj_resampled, current_pose_ptr_->pose, std::numeric_limits<double>::max(),
-    node_param_.delta_yaw_threshold);
+  workspace_.assign(*traj_resampled);
+  const auto traj_resampled_closest =
+    findNearestIndexFromWorkspace(traj_pre_resampled_closest_arc_length);
   if (!traj_resampled_closest) {
     RCLCPP_WARN(get_logger(), "Cannot find closest waypoint for resampled trajectory");
-    return false;
+    return {};
   }
+  const double traj_resampled_closest_arc_length = workspace_.s().at(*traj_resampled_closest);
   std::tie(initial_vel, initial_acc, type) =
     calcInitialMotion(*traj_resampled, *traj_resampled_closest, prev_output_);
+  processing_time_map_["resample"] = stop_watch_.toc("resample");
 
   // Clip trajectory from closest point
-  TrajectoryPoints clipped;
-  clipped.insert(
-    clipped.end(), traj_resampled->begin() + *traj_resampled_closest, traj_resampled->end());
+  stop_watch_.tic("optimize");
+  clipped_points_.assign(traj_resampled->begin() + *traj_resampled_closest, traj_resampled->end());
 
   std::vector<TrajectoryPoints> debug_trajectories;
-  if (!smoother_->apply(initial_vel, initial_acc, clipped, traj_smoothed, debug_trajectories)) {
+  if (!smoother_->apply(
+        initial_vel, initial_acc, clipped_points_, traj_smoothed, debug_trajectories)) {
     RCLCPP_WARN(get_logger(), "Fail to solve optimization.");
   }
+  processing_time_map_["optimize"] = stop_watch_.toc("optimize");
+  if (node_param_.algorithm_type == AlgorithmType::JERK_FILTERED) {
+    publishQPSolverStatus();
+  }
 
+  // The smoothed trajectory starts from the closest point of the resampled trajectory, so the
+  // closest point is at the same arc length after the points behind it are inserted.
+  stop_watch_.tic("post_optimize");
   traj_smoothed.insert(
     traj_smoothed.begin(), traj_resampled->begin(),
     traj_resampled->begin() + *traj_resampled_closest);
@@ -652,6 +683,7 @@ bool MotionVelocitySmootherNode::smoothVelocity(
 
   // Insert behind velocity for output's consistency
   insertBehindVelocity(*traj_resampled_closest, type, traj_smoothed);
+  processing_time_map_["post_optimize"] = stop_watch_.toc("post_optimize");
 
   RCLCPP_DEBUG(get_logger(), "smoothVelocity : traj_smoothed.size() = %lu", traj_smoothed.size());
   if (publish_debug_trajs_) {
@@ -674,7 +706,22 @@ bool MotionVelocitySmootherNode::smoothVelocity(
     publishDebugTrajectories(debug_trajectories);
   }
 
-  return true;
+  return traj_resampled_closest_arc_length;
+}
+
+boost::optional<size_t> MotionVelocitySmootherNode::findNearestIndexFromWorkspace(
+  const boost::optional<double> & arc_length_hint) const
+{
+  // [m] range of arc length searched around the closest point of the previous stage
+  constexpr double closest_search_length = 5.0;
+
+  const auto & pose = current_pose_ptr_->pose;
+  constexpr double max_dist = std::numeric_limits<double>::max();
+  if (!arc_length_hint) {
+    return workspace_.findNearestIndex(pose, max_dist, node_param_.delta_yaw_threshold);
+  }
+  return workspace_.findNearestIndex(
+    pose, max_dist, node_param_.delta_yaw_threshold, *arc_length_hint, closest_search_length);
 }
 
 void MotionVelocitySmootherNode::insertBehindVelocity(
@@ -846,7 +893,8 @@ void MotionVelocitySmootherNode::overwriteStopPoint(
   }
 }
 
-void MotionVelocitySmootherNode::applyExternalVelocityLimit(TrajectoryPoints & traj) const
+void MotionVelocitySmootherNode::applyExternalVelocityLimit(
+  const size_t closest_idx, TrajectoryPoints & traj) const
 {
   if (traj.size() < 1) {
     return;
@@ -855,15 +903,8 @@ void MotionVelocitySmootherNode::applyExternalVelocityLimit(TrajectoryPoints & t
   trajectory_utils::applyMaximumVelocityLimit(
     0, traj.size(), max_velocity_with_deceleration_, traj);
 
-  const auto closest_idx = autoware_utils::findNearestIndex(
-    traj, current_pose_ptr_->pose, std::numeric_limits<double>::max(),
-    node_param_.delta_yaw_threshold);
-  if (!closest_idx) {
-    return;
-  }
-
   double dist = 0.0;
-  for (size_t idx = *closest_idx; idx < traj.size() - 1; ++idx) {
+  for (size_t idx = closest_idx; idx < traj.size() - 1; ++idx) {
     dist += autoware_utils::calcDistance2d(traj.at(idx), traj.at(idx + 1));
     if (dist > external_velocity_limit_dist_) {
       trajectory_utils::applyMaximumVelocityLimit(
@@ -911,6 +952,21 @@ void MotionVelocitySmootherNode::publishDebugTrajectories(
   }
 }
 
+void MotionVelocitySmootherNode::publishQPSolverStatus()
+{
+  const auto jerk_filtered_smoother = std::dynamic_pointer_cast<JerkFilteredSmoother>(smoother_);
+  if (!jerk_filtered_smoother) {
+    return;
+  }
+  const auto & status = jerk_filtered_smoother->getQPSolverStatus();
+  processing_time_map_["qp_solver"] = status.solve_time_ms;
+
+  Float32Stamped iterations{};
+  iterations.stamp = this->now();
+  iterations.data = static_cast<float>(status.iterations);
+  pub_qp_solver_iterations_->publish(iterations);
+}
+
 void MotionVelocitySmootherNode::publishClosestVelocity(
   const TrajectoryPoints & trajectory, const Pose & current_pose,
   const rclcpp::Publisher<Float32Stamped>::SharedPtr pub) const
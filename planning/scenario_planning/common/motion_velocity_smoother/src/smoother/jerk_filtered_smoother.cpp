@@ -20,12 +20,40 @@
 #include <algorithm>
 #include <chrono>
 #include <cmath>
+#include <exception>
 #include <limits>
 #include <numeric>
 #include <vector>
 
 namespace motion_velocity_smoother
 {
+namespace
+{
+// Append the values of a block of the solution at the query arc lengths. The values are linearly
+// interpolated by the arc length, and the end values are kept outside of the base arc lengths.
+void appendInterpolatedBlock(
+  const std::vector<double> & base_arc_length, const std::vector<double>::const_iterator base_begin,
+  const size_t base_size, const std::vector<double> & query_arc_length, const size_t query_size,
+  std::vector<double> & values)
+{
+  size_t j = 0;
+  for (size_t i = 0; i < query_size; ++i) {
+    const double s = query_arc_length.at(i);
+    if (base_size == 1) {
+      values.push_back(*base_begin);
+      continue;
+    }
+    while (j + 2 < base_size && base_arc_length.at(j + 1) < s) {
+      ++j;
+    }
+    const double ds = base_arc_length.at(j + 1) - base_arc_length.at(j);
+    const double ratio =
+      ds > 1.0e-6 ? std::min(std::max((s - base_arc_length.at(j)) / ds, 0.0), 1.0) : 0.0;
+    values.push_back((1.0 - ratio) * *(base_begin + j) + ratio * *(base_begin + j + 1));
+  }
+}
+}  // namespace
+
 JerkFilteredSmoother::JerkFilteredSmoother(const Param & smoother_param)
 : smoother_param_{smoother_param}
 {
@@ -46,6 +74,7 @@ bool JerkFilteredSmoother::apply(
   std::vector<TrajectoryPoints> & debug_trajectories)
 {
   output = input;
+  qp_solver_status_ = QPSolverStatus{};
 
   if (input.empty()) {
     RCLCPP_WARN(logger_, "Input TrajectoryPoints to the jerk filtered optimization is empty.");
@@ -274,13 +303,29 @@ bool JerkFilteredSmoother::apply(
   }
 
   // execute optimization
-  const auto result = qp_solver_.optimize(P, A, q, lower_bound, upper_bound);
+  // The workspace is kept while the problem has the same structure, and the solution of the
+  // previous cycle is used as the initial value after it is shifted by the travel distance.
+  std::vector<double> arc_length(N, 0.0);
+  for (size_t i = 1; i < N; ++i) {
+    arc_length.at(i) = arc_length.at(i - 1) + interval_dist_arr.at(i - 1);
+  }
+  qp_solver_status_.is_workspace_reused =
+    qp_solver_.updateProblem(P, A, q, lower_bound, upper_bound);
+  qp_solver_status_.is_warm_started = setWarmStart(*opt_resampled_trajectory, arc_length);
+  const auto result = qp_solver_.optimize();
   const std::vector<double> optval = std::get<0>(result);
+  qp_solver_status_.iterations = qp_solver_.getTakenIter();
+  qp_solver_status_.solve_time_ms = qp_solver_.getRunTime() * 1.0e3;
 
   const auto tf1 = std::chrono::system_clock::now();
   const double dt_ms1 =
     std::chrono::duration_cast<std::chrono::nanoseconds>(tf1 - ts).count() * 1.0e-6;
-  RCLCPP_DEBUG(logger_, "optimization time = %f [ms]", dt_ms1);
+  RCLCPP_DEBUG(
+    logger_,
+    "optimization time = %f [ms], solver: iterations = %ld, time = %f [ms], "
+    "workspace reused = %d, warm started = %d",
+    dt_ms1, qp_solver_status_.iterations, qp_solver_status_.solve_time_ms,
+    qp_solver_status_.is_workspace_reused, qp_solver_status_.is_warm_started);
 
   // get velocity & acceleration
   for (size_t i = 0; i < N; ++i) {
@@ -296,6 +341,13 @@ bool JerkFilteredSmoother::apply(
   const int status_val = std::get<3>(result);
   if (status_val != 1) {
     RCLCPP_ERROR(logger_, "optimization failed : %s", qp_solver_.getStatusMessage().c_str());
+    prev_solution_points_.clear();
+  } else {
+    prev_solution_points_.assign(
+      opt_resampled_trajectory->begin(), opt_resampled_trajectory->begin() + N);
+    prev_solution_arc_length_ = arc_length;
+    prev_primal_solution_ = optval;
+    prev_dual_solution_ = qp_solver_.getDualSolution();
   }
 
   if (TMP_SHOW_DEBUG_INFO) {
@@ -456,6 +508,59 @@ TrajectoryPoints JerkFilteredSmoother::mergeFilteredTrajectory(
   return merged;
 }
 
+bool JerkFilteredSmoother::setWarmStart(
+  const TrajectoryPoints & trajectory, const std::vector<double> & arc_length)
+{
+  const size_t N = arc_length.size();
+  const size_t prev_N = prev_solution_points_.size();
+  if (prev_N < 2 || N < 2) {
+    return false;
+  }
+
+  // arc length of the first point on the previous trajectory
+  double offset{};
+  try {
+    offset = autoware_utils::calcSignedArcLength(
+      prev_solution_points_, 0, trajectory.front().pose.position);
+  } catch (const std::exception & e) {
+    RCLCPP_DEBUG(logger_, "skip the warm start: %s", e.what());
+    return false;
+  }
+  std::vector<double> query_arc_length(N);
+  for (size_t i = 0; i < N; ++i) {
+    query_arc_length.at(i) = arc_length.at(i) + offset;
+  }
+
+  // x = [b, a, delta, sigma, gamma], each of which has N values
+  std::vector<double> primal;
+  primal.reserve(5 * N);
+  for (size_t k = 0; k < 5; ++k) {
+    appendInterpolatedBlock(
+      prev_solution_arc_length_, prev_primal_solution_.begin() + k * prev_N, prev_N,
+      query_arc_length, N, primal);
+  }
+
+  // y = [velocity (N), acceleration (N), jerk (N - 1), b' = 2a (N - 1), initial condition (2)]
+  std::vector<double> dual;
+  dual.reserve(4 * N + 1);
+  const auto prev_dual_begin = prev_dual_solution_.begin();
+  appendInterpolatedBlock(
+    prev_solution_arc_length_, prev_dual_begin, prev_N, query_arc_length, N, dual);
+  appendInterpolatedBlock(
+    prev_solution_arc_length_, prev_dual_begin + prev_N, prev_N, query_arc_length, N, dual);
+  appendInterpolatedBlock(
+    prev_solution_arc_length_, prev_dual_begin + 2 * prev_N, prev_N - 1, query_arc_length, N - 1,
+    dual);
+  appendInterpolatedBlock(
+    prev_solution_arc_length_, prev_dual_begin + 3 * prev_N - 1, prev_N - 1, query_arc_length,
+    N - 1, dual);
+  dual.push_back(prev_dual_solution_.at(4 * prev_N - 2));
+  dual.push_back(prev_dual_solution_.at(4 * prev_N - 1));
+  dual.resize(4 * N + 1, 0.0);
+
+  return qp_solver_.setWarmStart(primal, dual);
+}
+
 boost::optional<TrajectoryPoints> JerkFilteredSmoother::resampleTrajectory(
   const TrajectoryPoints & input, const double /*v_current*/, const int closest_id) const
 {
@@ -102,6 +102,18 @@ TrajectoryPoint calcInterpolatedTrajectoryPoint(
 boost::optional<TrajectoryPoints> extractPathAroundIndex(
   const TrajectoryPoints & trajectory, const size_t index, const double & ahead_length,
   const double & behind_length)
+{
+  TrajectoryPoints extracted_traj{};
+  if (!extractPathAroundIndex(trajectory, index, ahead_length, behind_length, extracted_traj)) {
+    return {};
+  }
+
+  return boost::optional<TrajectoryPoints>(extracted_traj);
+}
+
+boost::optional<size_t> extractPathAroundIndex(
+  const TrajectoryPoints & trajectory, const size_t index, const double & ahead_length,
+  const double & behind_length, TrajectoryPoints & extracted_traj)
 {
   if (trajectory.size() == 0 || trajectory.size() - 1 < index) {
     return {};
@@ -134,12 +146,9 @@ boost::optional<TrajectoryPoints> extractPathAroundIndex(
   }
 
   // extract trajectory
-  TrajectoryPoints extracted_traj{};
-  for (size_t i = behind_index; i < ahead_index + 1; ++i) {
-    extracted_traj.push_back(trajectory.at(i));
-  }
+  extracted_traj.assign(trajectory.begin() + behind_index, trajectory.begin() + ahead_index + 1);
 
-  return boost::optional<TrajectoryPoints>(extracted_traj);
+  return index - behind_index;
 }
 
 double calcArcLength(const TrajectoryPoints & path, const int idx1, const int idx2)
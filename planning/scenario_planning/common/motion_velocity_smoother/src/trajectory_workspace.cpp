@@ -0,0 +1,94 @@
+// Copyright 2021 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "motion_velocity_smoother/trajectory_workspace.hpp"
+
+#include "autoware_utils/math/normalization.hpp"
+#include "tf2/utils.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+namespace motion_velocity_smoother
+{
+void TrajectoryWorkspace::assign(const TrajectoryPoints & points)
+{
+  const size_t n = points.size();
+  s_.resize(n);
+  x_.resize(n);
+  y_.resize(n);
+  orientation_.resize(n);
+
+  for (size_t i = 0; i < n; ++i) {
+    const auto & p = points[i];
+    x_[i] = p.pose.position.x;
+    y_[i] = p.pose.position.y;
+    orientation_[i] = p.pose.orientation;
+    s_[i] = i == 0 ? 0.0 : s_[i - 1] + std::hypot(x_[i] - x_[i - 1], y_[i] - y_[i - 1]);
+  }
+}
+
+boost::optional<size_t> TrajectoryWorkspace::findNearestIndex(
+  const Pose & pose, const double max_dist, const double max_yaw) const
+{
+  return findNearestIndexInRange(pose, max_dist, max_yaw, 0, size());
+}
+
+boost::optional<size_t> TrajectoryWorkspace::findNearestIndex(
+  const Pose & pose, const double max_dist, const double max_yaw, const double arc_length_hint,
+  const double search_length) const
+{
+  // include one more point on each side so that a sparse trajectory is still searched around
+  // the hint
+  const auto itr_begin = std::lower_bound(s_.begin(), s_.end(), arc_length_hint - search_length);
+  const auto itr_end = std::upper_bound(itr_begin, s_.end(), arc_length_hint + search_length);
+  const size_t begin = static_cast<size_t>(std::max(itr_begin - s_.begin() - 1, ptrdiff_t{0}));
+  const size_t end = std::min(static_cast<size_t>(itr_end - s_.begin()) + 1, size());
+
+  const auto nearest_idx = findNearestIndexInRange(pose, max_dist, max_yaw, begin, end);
+  if (nearest_idx || (begin == 0 && end == size())) {
+    return nearest_idx;
+  }
+  return findNearestIndex(pose, max_dist, max_yaw);
+}
+
+boost::optional<size_t> TrajectoryWorkspace::findNearestIndexInRange(
+  const Pose & pose, const double max_dist, const double max_yaw, const size_t begin,
+  const size_t end) const
+{
+  const double max_squared_dist = max_dist * max_dist;
+  const double target_yaw = tf2::getYaw(pose.orientation);
+
+  double min_squared_dist = std::numeric_limits<double>::max();
+  boost::optional<size_t> nearest_idx;
+  for (size_t i = begin; i < end; ++i) {
+    const double dx = x_[i] - pose.position.x;
+    const double dy = y_[i] - pose.position.y;
+    const double squared_dist = dx * dx + dy * dy;
+    if (squared_dist > max_squared_dist || squared_dist >= min_squared_dist) {
+      continue;
+    }
+    const double yaw = tf2::getYaw(orientation_[i]);
+    if (std::fabs(autoware_utils::normalizeRadian(target_yaw - yaw)) > max_yaw) {
+      continue;
+    }
+    min_squared_dist = squared_dist;
+    nearest_idx = i;
+  }
+  return nearest_idx;
+}
+}  // namespace motion_velocity_smoother
@@ -0,0 +1,165 @@
+// Copyright 2021 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "motion_velocity_smoother/trajectory_workspace.hpp"
+
+#include "autoware_utils/geometry/geometry.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <limits>
+#include <vector>
+
+namespace
+{
+using motion_velocity_smoother::Pose;
+using motion_velocity_smoother::TrajectoryPoint;
+using motion_velocity_smoother::TrajectoryPoints;
+using motion_velocity_smoother::TrajectoryWorkspace;
+
+constexpr double max_dist = std::numeric_limits<double>::max();
+constexpr double max_yaw = M_PI_4;
+
+Pose createPose(const double x, const double y, const double yaw)
+{
+  Pose pose;
+  pose.position.x = x;
+  pose.position.y = y;
+  pose.orientation = autoware_utils::createQuaternionFromYaw(yaw);
+  return pose;
+}
+
+TrajectoryPoint createPoint(const double x, const double y, const double yaw)
+{
+  TrajectoryPoint point;
+  point.pose = createPose(x, y, yaw);
+  return point;
+}
+
+// straight trajectory along the x axis with 1 m interval
+TrajectoryPoints createStraightTrajectory(const size_t num)
+{
+  TrajectoryPoints points;
+  for (size_t i = 0; i < num; ++i) {
+    points.push_back(createPoint(static_cast<double>(i), 0.0, 0.0));
+  }
+  return points;
+}
+
+// goes along the x axis until x = 50 and comes back along y = 1
+TrajectoryPoints createTurningTrajectory()
+{
+  TrajectoryPoints points;
+  for (int i = 0; i <= 50; ++i) {
+    points.push_back(createPoint(i, 0.0, 0.0));
+  }
+  for (int i = 50; i >= 0; --i) {
+    points.push_back(createPoint(i, 1.0, M_PI));
+  }
+  return points;
+}
+}  // namespace
+
+TEST(TrajectoryWorkspace, Assign)
+{
+  TrajectoryWorkspace workspace;
+  EXPECT_TRUE(workspace.empty());
+  EXPECT_FALSE(workspace.findNearestIndex(createPose(0.0, 0.0, 0.0), max_dist, max_yaw));
+  EXPECT_FALSE(
+    workspace.findNearestIndex(createPose(0.0, 0.0, 0.0), max_dist, max_yaw, 0.0, 5.0));
+
+  workspace.assign(createTurningTrajectory());
+  ASSERT_EQ(workspace.size(), 102U);
+  EXPECT_DOUBLE_EQ(workspace.s().front(), 0.0);
+  EXPECT_DOUBLE_EQ(workspace.s().at(50), 50.0);
+  EXPECT_DOUBLE_EQ(workspace.s().at(51), 51.0);
+  EXPECT_DOUBLE_EQ(workspace.s().back(), 101.0);
+  EXPECT_DOUBLE_EQ(workspace.x().back(), 0.0);
+  EXPECT_DOUBLE_EQ(workspace.y().back(), 1.0);
+
+  // shorter trajectory reuses the buffers
+  workspace.assign(createStraightTrajectory(3));
+  EXPECT_EQ(workspace.size(), 3U);
+  EXPECT_DOUBLE_EQ(workspace.s().back(), 2.0);
+}
+
+TEST(TrajectoryWorkspace, FindNearestIndex)
+{
+  TrajectoryWorkspace workspace;
+  workspace.assign(createTurningTrajectory());
+
+  EXPECT_EQ(*workspace.findNearestIndex(createPose(30.2, 0.3, 0.0), max_dist, max_yaw), 30U);
+  // the point on the way back for the opposite direction
+  EXPECT_EQ(*workspace.findNearestIndex(createPose(30.2, 0.3, M_PI), max_dist, max_yaw), 71U);
+  EXPECT_FALSE(workspace.findNearestIndex(createPose(30.2, 0.3, M_PI_2), max_dist, max_yaw));
+  EXPECT_FALSE(workspace.findNearestIndex(createPose(30.2, 10.0, 0.0), 5.0, max_yaw));
+}
+
+TEST(TrajectoryWorkspace, FindNearestIndexAroundHint)
+{
+  TrajectoryWorkspace workspace;
+  workspace.assign(createStraightTrajectory(101));
+
+  // the same result as the whole search for any hint near the pose
+  for (double x = 0.0; x <= 100.0; x += 0.7) {
+    const auto pose = createPose(x, 0.5, 0.1);
+    const auto expected = workspace.findNearestIndex(pose, max_dist, max_yaw);
+    ASSERT_TRUE(expected);
+    for (const double hint_offset : {-4.0, 0.0, 4.0}) {
+      const auto nearest_idx =
+        workspace.findNearestIndex(pose, max_dist, max_yaw, x + hint_offset, 5.0);
+      ASSERT_TRUE(nearest_idx);
+      EXPECT_EQ(*nearest_idx, *expected);
+    }
+  }
+
+  // the nearest point in the window is returned even if a nearer one is outside of it
+  EXPECT_EQ(
+    *workspace.findNearestIndex(createPose(30.2, 0.0, 0.0), max_dist, max_yaw, 80.0, 5.0), 74U);
+}
+
+TEST(TrajectoryWorkspace, FindNearestIndexAroundHintSparse)
+{
+  TrajectoryWorkspace workspace;
+  workspace.assign(
+    {createPoint(0.0, 0.0, 0.0), createPoint(10.0, 0.0, 0.0), createPoint(20.0, 0.0, 0.0),
+     createPoint(30.0, 0.0, 0.0)});
+
+  // the points just outside of the window are also searched, but not the ones beyond them
+  EXPECT_EQ(
+    *workspace.findNearestIndex(createPose(11.0, 0.0, 0.0), max_dist, max_yaw, 14.0, 1.0), 1U);
+  EXPECT_EQ(
+    *workspace.findNearestIndex(createPose(19.0, 0.0, 0.0), max_dist, max_yaw, 14.0, 1.0), 2U);
+  EXPECT_EQ(
+    *workspace.findNearestIndex(createPose(29.0, 0.0, 0.0), max_dist, max_yaw, 14.0, 1.0), 2U);
+}
+
+TEST(TrajectoryWorkspace, FindNearestIndexAroundHintFallback)
+{
+  TrajectoryWorkspace workspace;
+  workspace.assign(createTurningTrajectory());
+
+  // no point in the window has the direction of the pose
+  const auto opposite_pose = createPose(30.2, 0.7, M_PI);
+  EXPECT_EQ(*workspace.findNearestIndex(opposite_pose, max_dist, max_yaw, 30.0, 5.0), 71U);
+
+  // no point in the window is within max_dist
+  const auto far_pose = createPose(5.0, 0.0, 0.0);
+  EXPECT_EQ(*workspace.findNearestIndex(far_pose, 3.0, max_yaw, 30.0, 5.0), 5U);
+
+  // neither the window nor the whole trajectory has a point satisfying the conditions
+  const auto side_pose = createPose(30.0, 0.5, M_PI_2);
+  EXPECT_FALSE(workspace.findNearestIndex(side_pose, max_dist, max_yaw, 30.0, 5.0));
+}
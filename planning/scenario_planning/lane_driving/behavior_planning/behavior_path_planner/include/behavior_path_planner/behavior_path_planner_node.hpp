@@ -35,6 +35,7 @@
 #include <autoware_auto_planning_msgs/msg/path_with_lane_id.hpp>
 #include <autoware_auto_vehicle_msgs/msg/hazard_lights_command.hpp>
 #include <autoware_auto_vehicle_msgs/msg/turn_indicators_command.hpp>
+#include <autoware_debug_msgs/msg/int64_multi_array_stamped.hpp>
 #include <autoware_planning_msgs/msg/approval.hpp>
 #include <autoware_planning_msgs/msg/path_change_module.hpp>
 #include <autoware_planning_msgs/msg/path_change_module_array.hpp>
@@ -61,6 +62,7 @@ using autoware_auto_planning_msgs::msg::Path;
 using autoware_auto_planning_msgs::msg::PathWithLaneId;
 using autoware_auto_vehicle_msgs::msg::HazardLightsCommand;
 using autoware_auto_vehicle_msgs::msg::TurnIndicatorsCommand;
+using autoware_debug_msgs::msg::Int64MultiArrayStamped;
 using autoware_planning_msgs::msg::PathChangeModule;
 using autoware_planning_msgs::msg::PathChangeModuleArray;
 using geometry_msgs::msg::TwistStamped;
@@ -158,7 +160,9 @@ private:
   rclcpp::Publisher<OccupancyGrid>::SharedPtr debug_drivable_area_publisher_;
   rclcpp::Publisher<Path>::SharedPtr debug_path_publisher_;
   rclcpp::Publisher<MarkerArray>::SharedPtr debug_marker_publisher_;
+  rclcpp::Publisher<Int64MultiArrayStamped>::SharedPtr debug_context_cache_publisher_;
   void publishDebugMarker(const std::vector<MarkerArray> & debug_markers);
+  void publishPlannerContextStatistics();
 };
 }  // namespace behavior_path_planner
 
@@ -41,6 +41,9 @@ using geometry_msgs::msg::PoseStamped;
 using geometry_msgs::msg::TwistStamped;
 using nav_msgs::msg::Odometry;
 using route_handler::RouteHandler;
+
+class PlannerContext;
+
 struct BoolStamped
 {
   explicit BoolStamped(bool in_data) : data(in_data) {}
@@ -71,6 +74,8 @@ struct PlannerData
   lanelet::ConstLanelets current_lanes{};
   std::shared_ptr<RouteHandler> route_handler{std::make_shared<RouteHandler>()};
   Approval approval{};
+  // per-tick cache shared by the scene modules, renewed in BehaviorTreeManager::run()
+  std::shared_ptr<PlannerContext> context{};
 };
 
 }  // namespace behavior_path_planner
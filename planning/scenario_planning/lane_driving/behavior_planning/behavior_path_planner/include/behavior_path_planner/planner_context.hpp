@@ -0,0 +1,163 @@
+// Copyright 2021 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef BEHAVIOR_PATH_PLANNER__PLANNER_CONTEXT_HPP_
+#define BEHAVIOR_PATH_PLANNER__PLANNER_CONTEXT_HPP_
+
+#include "behavior_path_planner/data_manager.hpp"
+
+#include <autoware_auto_planning_msgs/msg/path_with_lane_id.hpp>
+#include <geometry_msgs/msg/pose.hpp>
+
+#include <lanelet2_core/primitives/Lanelet.h>
+
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <vector>
+
+namespace behavior_path_planner
+{
+using autoware_auto_planning_msgs::msg::PathWithLaneId;
+using geometry_msgs::msg::Pose;
+
+struct CacheCounter
+{
+  int64_t hit{0};
+  int64_t miss{0};
+};
+
+struct PlannerContextStatistics
+{
+  CacheCounter lanes{};
+  CacheCounter center_line_path{};
+  CacheCounter resampled_path{};
+  CacheCounter expanded_lanelets{};
+  CacheCounter objects_in_lanelets{};
+
+  // hit and miss of each cache in the above order
+  std::vector<int64_t> toArray() const;
+};
+
+/**
+ * @brief Data derived from PlannerData which is shared by all scene modules within one tick.
+ *
+ * Every value is computed on the first request and memoized with its arguments as the key, so
+ * modules asking for the same lanes or paths in the same tick share one computation. A new
+ * context is created at the beginning of every BehaviorTreeManager::run(), which invalidates all
+ * cached values. The returned references stay valid until the context is destroyed.
+ */
+class PlannerContext
+{
+public:
+  explicit PlannerContext(const PlannerData & planner_data);
+
+  /**
+   * @brief lanelet sequence around the pose, with the given backward length and the common
+   *        forward_path_length. Empty if no lanelet within the route is found.
+   */
+  const lanelet::ConstLanelets & getLanesAroundPose(
+    const Pose & pose, const double backward_length);
+
+  /**
+   * @brief lanelet sequence around the ego pose with the common path lengths.
+   */
+  const lanelet::ConstLanelets & getCurrentLanes();
+
+  /**
+   * @brief center line path on getLanesAroundPose() with the route header.
+   */
+  const PathWithLaneId & getCenterLinePath(const Pose & pose, const double backward_length);
+
+  /**
+   * @brief getCenterLinePath() resampled with the given interval.
+   */
+  const PathWithLaneId & getResampledCenterLinePath(
+    const Pose & pose, const double backward_length, const double resample_interval);
+
+  /**
+   * @brief arc length of each point of getResampledCenterLinePath() from its front point.
+   */
+  const std::vector<double> & getResampledCenterLinePathArcLength(
+    const Pose & pose, const double backward_length, const double resample_interval);
+
+  const lanelet::ConstLanelets & getExpandedLanelets(
+    const lanelet::ConstLanelets & lanelets, const double left_offset, const double right_offset);
+
+  /**
+   * @brief indices of PlannerData::dynamic_object whose polygon overlaps with the lanelets.
+   */
+  const std::vector<size_t> & getObjectIndicesInLanelets(const lanelet::ConstLanelets & lanelets);
+
+  const PlannerContextStatistics & getStatistics() const { return statistics_; }
+
+private:
+  struct LanesEntry
+  {
+    Pose pose;
+    double backward_length;
+    lanelet::ConstLanelets lanes;
+  };
+
+  struct CenterLinePathEntry
+  {
+    Pose pose;
+    double backward_length;
+    PathWithLaneId path;
+  };
+
+  struct ResampledPathEntry
+  {
+    Pose pose;
+    double backward_length;
+    double resample_interval;
+    PathWithLaneId path;
+    std::vector<double> arclength;
+  };
+
+  struct ExpandedLaneletsEntry
+  {
+    lanelet::ConstLanelets lanelets;
+    double left_offset;
+    double right_offset;
+    lanelet::ConstLanelets expanded_lanelets;
+  };
+
+  struct ObjectIndicesEntry
+  {
+    lanelet::ConstLanelets lanelets;
+    std::vector<size_t> indices;
+  };
+
+  std::shared_ptr<RouteHandler> route_handler_;
+  PoseStamped::ConstSharedPtr self_pose_;
+  PredictedObjects::ConstSharedPtr dynamic_object_;
+  BehaviorPathPlannerParameters parameters_;
+
+  // std::deque keeps references to its elements valid on push_back
+  std::deque<LanesEntry> lanes_cache_;
+  std::deque<CenterLinePathEntry> center_line_path_cache_;
+  std::deque<ResampledPathEntry> resampled_path_cache_;
+  std::deque<ExpandedLaneletsEntry> expanded_lanelets_cache_;
+  std::deque<ObjectIndicesEntry> object_indices_cache_;
+
+  PlannerContextStatistics statistics_;
+
+  const ResampledPathEntry & getResampledPathEntry(
+    const Pose & pose, const double backward_length, const double resample_interval);
+};
+
+}  // namespace behavior_path_planner
+
+#endif  // BEHAVIOR_PATH_PLANNER__PLANNER_CONTEXT_HPP_
@@ -159,8 +159,8 @@ private:
   // ========= helper functions ==========
   // =====================================
 
-  PathWithLaneId calcCenterLinePath(
-    const std::shared_ptr<const PlannerData> & planner_data, const PoseStamped & pose) const;
+  double calcCenterLineBackwardLength(
+    const std::shared_ptr<const PlannerData> & planner_data) const;
 
   void clipPathLength(PathWithLaneId & path) const;
 
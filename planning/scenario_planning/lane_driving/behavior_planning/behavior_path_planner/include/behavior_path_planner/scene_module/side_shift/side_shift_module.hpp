@@ -105,8 +105,8 @@ private:
   // NOTE: this function is ported from avoidance.
   PoseStamped getUnshiftedEgoPose(const ShiftedPath & prev_path) const;
   inline PoseStamped getEgoPose() const { return *(planner_data_->self_pose); }
-  PathWithLaneId calcCenterLinePath(
-    const std::shared_ptr<const PlannerData> & planner_data, const PoseStamped & pose) const;
+  double calcCenterLineBackwardLength(
+    const std::shared_ptr<const PlannerData> & planner_data) const;
 };
 
 }  // namespace behavior_path_planner
@@ -15,6 +15,7 @@
 #include "behavior_path_planner/behavior_path_planner_node.hpp"
 
 #include "behavior_path_planner/path_utilities.hpp"
+#include "behavior_path_planner/planner_context.hpp"
 #include "behavior_path_planner/scene_module/avoidance/avoidance_module.hpp"
 #include "behavior_path_planner/scene_module/lane_change/lane_change_module.hpp"
 #include "behavior_path_planner/scene_module/pull_out/pull_out_module.hpp"
@@ -81,6 +82,8 @@ BehaviorPathPlannerNode::BehaviorPathPlannerNode(const rclcpp::NodeOptions & nod
 
   // Debug
   debug_marker_publisher_ = create_publisher<MarkerArray>("~/debug/markers", 1);
+  debug_context_cache_publisher_ =
+    create_publisher<Int64MultiArrayStamped>("~/debug/planner_context_cache", 1);
 
   // behavior tree manager
   {
@@ -495,6 +498,8 @@ void BehaviorPathPlannerNode::run()
 
   publishDebugMarker(bt_manager_->getDebugMarkers());
 
+  publishPlannerContextStatistics();
+
   RCLCPP_DEBUG(get_logger(), "----- behavior path planner end -----\n\n");
 }
 
@@ -606,6 +611,17 @@ void BehaviorPathPlannerNode::publishDebugMarker(const std::vector<MarkerArray>
   debug_marker_publisher_->publish(msg);
 }
 
+void BehaviorPathPlannerNode::publishPlannerContextStatistics()
+{
+  if (!planner_data_->context) {
+    return;
+  }
+  Int64MultiArrayStamped msg{};
+  msg.stamp = this->now();
+  msg.data = planner_data_->context->getStatistics().toArray();
+  debug_context_cache_publisher_->publish(msg);
+}
+
 void BehaviorPathPlannerNode::updateCurrentPose()
 {
   auto self_pose = self_pose_listener_.getCurrentPose();
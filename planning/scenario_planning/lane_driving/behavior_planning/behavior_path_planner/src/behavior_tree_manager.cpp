@@ -14,6 +14,7 @@
 
 #include "behavior_path_planner/behavior_tree_manager.hpp"
 
+#include "behavior_path_planner/planner_context.hpp"
 #include "behavior_path_planner/scene_module/scene_module_bt_node_interface.hpp"
 #include "behavior_path_planner/scene_module/scene_module_interface.hpp"
 #include "behavior_path_planner/utilities.hpp"
@@ -90,6 +91,9 @@ BehaviorModuleOutput BehaviorTreeManager::run(const std::shared_ptr<PlannerData>
 {
   current_planner_data_ = data;
 
+  // values cached in the previous tick are no longer valid
+  data->context = std::make_shared<PlannerContext>(*data);
+
   // set planner_data & reset status
   std::for_each(
     scene_modules_.begin(), scene_modules_.end(), [&data](const auto & m) { m->setData(data); });
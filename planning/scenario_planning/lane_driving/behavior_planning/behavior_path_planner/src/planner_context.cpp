@@ -0,0 +1,192 @@
+// Copyright 2021 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "behavior_path_planner/planner_context.hpp"
+
+#include "behavior_path_planner/path_utilities.hpp"
+#include "behavior_path_planner/utilities.hpp"
+
+#include <lanelet2_extension/utility/utilities.hpp>
+
+#include <vector>
+
+namespace
+{
+// Expanded lanelets keep the id of their original lanelet, so lanelets are compared by their
+// underlying data instead of their ids.
+bool isSameLanelets(
+  const lanelet::ConstLanelets & lanelets1, const lanelet::ConstLanelets & lanelets2)
+{
+  if (lanelets1.size() != lanelets2.size()) {
+    return false;
+  }
+  for (size_t i = 0; i < lanelets1.size(); ++i) {
+    if (
+      lanelets1.at(i).constData() != lanelets2.at(i).constData() ||
+      lanelets1.at(i).inverted() != lanelets2.at(i).inverted()) {
+      return false;
+    }
+  }
+  return true;
+}
+}  // namespace
+
+namespace behavior_path_planner
+{
+std::vector<int64_t> PlannerContextStatistics::toArray() const
+{
+  return {lanes.hit,
+          lanes.miss,
+          center_line_path.hit,
+          center_line_path.miss,
+          resampled_path.hit,
+          resampled_path.miss,
+          expanded_lanelets.hit,
+          expanded_lanelets.miss,
+          objects_in_lanelets.hit,
+          objects_in_lanelets.miss};
+}
+
+PlannerContext::PlannerContext(const PlannerData & planner_data)
+: route_handler_(planner_data.route_handler),
+  self_pose_(planner_data.self_pose),
+  dynamic_object_(planner_data.dynamic_object),
+  parameters_(planner_data.parameters)
+{
+}
+
+const lanelet::ConstLanelets & PlannerContext::getLanesAroundPose(
+  const Pose & pose, const double backward_length)
+{
+  for (const auto & entry : lanes_cache_) {
+    if (entry.pose == pose && entry.backward_length == backward_length) {
+      ++statistics_.lanes.hit;
+      return entry.lanes;
+    }
+  }
+  ++statistics_.lanes.miss;
+
+  LanesEntry entry{pose, backward_length, {}};
+  lanelet::ConstLanelet current_lane;
+  if (route_handler_->getClosestLaneletWithinRoute(pose, &current_lane)) {
+    // For current_lanes with desired length
+    entry.lanes = route_handler_->getLaneletSequence(
+      current_lane, pose, backward_length, parameters_.forward_path_length);
+  } else {
+    RCLCPP_ERROR(
+      rclcpp::get_logger("behavior_path_planner").get_child("planner_context"),
+      "failed to find closest lanelet within route!!!");
+  }
+  lanes_cache_.push_back(entry);
+  return lanes_cache_.back().lanes;
+}
+
+const lanelet::ConstLanelets & PlannerContext::getCurrentLanes()
+{
+  return getLanesAroundPose(self_pose_->pose, parameters_.backward_path_length);
+}
+
+const PathWithLaneId & PlannerContext::getCenterLinePath(
+  const Pose & pose, const double backward_length)
+{
+  for (const auto & entry : center_line_path_cache_) {
+    if (entry.pose == pose && entry.backward_length == backward_length) {
+      ++statistics_.center_line_path.hit;
+      return entry.path;
+    }
+  }
+  ++statistics_.center_line_path.miss;
+
+  const auto & lanes = getLanesAroundPose(pose, backward_length);
+  CenterLinePathEntry entry{pose, backward_length, {}};
+  entry.path = util::getCenterLinePath(
+    *route_handler_, lanes, pose, backward_length, parameters_.forward_path_length, parameters_);
+  entry.path.header = route_handler_->getRouteHeader();
+  center_line_path_cache_.push_back(entry);
+  return center_line_path_cache_.back().path;
+}
+
+const PlannerContext::ResampledPathEntry & PlannerContext::getResampledPathEntry(
+  const Pose & pose, const double backward_length, const double resample_interval)
+{
+  for (const auto & entry : resampled_path_cache_) {
+    if (
+      entry.pose == pose && entry.backward_length == backward_length &&
+      entry.resample_interval == resample_interval) {
+      ++statistics_.resampled_path.hit;
+      return entry;
+    }
+  }
+  ++statistics_.resampled_path.miss;
+
+  const auto & center_line_path = getCenterLinePath(pose, backward_length);
+  ResampledPathEntry entry{pose, backward_length, resample_interval, {}, {}};
+  entry.path = util::resamplePathWithSpline(center_line_path, resample_interval);
+  entry.arclength = util::calcPathArcLengthArray(entry.path);
+  resampled_path_cache_.push_back(entry);
+  return resampled_path_cache_.back();
+}
+
+const PathWithLaneId & PlannerContext::getResampledCenterLinePath(
+  const Pose & pose, const double backward_length, const double resample_interval)
+{
+  return getResampledPathEntry(pose, backward_length, resample_interval).path;
+}
+
+const std::vector<double> & PlannerContext::getResampledCenterLinePathArcLength(
+  const Pose & pose, const double backward_length, const double resample_interval)
+{
+  return getResampledPathEntry(pose, backward_length, resample_interval).arclength;
+}
+
+const lanelet::ConstLanelets & PlannerContext::getExpandedLanelets(
+  const lanelet::ConstLanelets & lanelets, const double left_offset, const double right_offset)
+{
+  for (const auto & entry : expanded_lanelets_cache_) {
+    if (
+      isSameLanelets(entry.lanelets, lanelets) && entry.left_offset == left_offset &&
+      entry.right_offset == right_offset) {
+      ++statistics_.expanded_lanelets.hit;
+      return entry.expanded_lanelets;
+    }
+  }
+  ++statistics_.expanded_lanelets.miss;
+
+  ExpandedLaneletsEntry entry{lanelets, left_offset, right_offset, {}};
+  entry.expanded_lanelets =
+    lanelet::utils::getExpandedLanelets(lanelets, left_offset, right_offset);
+  expanded_lanelets_cache_.push_back(entry);
+  return expanded_lanelets_cache_.back().expanded_lanelets;
+}
+
+const std::vector<size_t> & PlannerContext::getObjectIndicesInLanelets(
+  const lanelet::ConstLanelets & lanelets)
+{
+  for (const auto & entry : object_indices_cache_) {
+    if (isSameLanelets(entry.lanelets, lanelets)) {
+      ++statistics_.objects_in_lanelets.hit;
+      return entry.indices;
+    }
+  }
+  ++statistics_.objects_in_lanelets.miss;
+
+  ObjectIndicesEntry entry{lanelets, {}};
+  if (dynamic_object_) {
+    entry.indices = util::filterObjectsByLanelets(*dynamic_object_, lanelets);
+  }
+  object_indices_cache_.push_back(entry);
+  return object_indices_cache_.back().indices;
+}
+
+}  // namespace behavior_path_planner
@@ -15,6 +15,7 @@
 #include "behavior_path_planner/scene_module/avoidance/avoidance_module.hpp"
 
 #include "behavior_path_planner/path_utilities.hpp"
+#include "behavior_path_planner/planner_context.hpp"
 #include "behavior_path_planner/scene_module/avoidance/avoidance_utils.hpp"
 #include "behavior_path_planner/scene_module/avoidance/debug.hpp"
 #include "behavior_path_planner/utilities.hpp"
@@ -117,28 +118,39 @@ AvoidancePlanningData AvoidanceModule::calcAvoidancePlanningData(DebugData & deb
   data.reference_pose = reference_pose.pose;
 
   // center line path (output of this function must have size > 1)
-  const auto center_path = calcCenterLinePath(planner_data_, reference_pose);
+  // NOTE: the paths are shared through the planner context, since this function is called
+  // several times in a tick with the same reference pose.
+  auto & context = *planner_data_->context;
+  const auto backward_length = calcCenterLineBackwardLength(planner_data_);
+  const auto & center_path = context.getCenterLinePath(reference_pose.pose, backward_length);
   debug.center_line = center_path;
   if (center_path.points.size() < 2) {
     RCLCPP_WARN_THROTTLE(
-      getLogger(), *clock_, 5000, "calcCenterLinePath() must return path which size > 1");
+      getLogger(), *clock_, 5000, "getCenterLinePath() must return path which size > 1");
     return data;
   }
 
   // reference path
-  data.reference_path =
-    util::resamplePathWithSpline(center_path, parameters_.resample_interval_for_planning);
-  if (data.reference_path.points.size() < 2) {
-    // if the resampled path has only 1 point, use original path.
-    data.reference_path = center_path;
-  }
+  const auto & resampled_path = context.getResampledCenterLinePath(
+    reference_pose.pose, backward_length, parameters_.resample_interval_for_planning);
+  // if the resampled path has only 1 point, use original path.
+  const bool use_resampled_path = resampled_path.points.size() > 1;
+  data.reference_path = use_resampled_path ? resampled_path : center_path;
   data.ego_closest_path_index =
     findNearestIndex(data.reference_path.points, data.reference_pose.position);
 
   // arclength from ego pose (used in many functions)
-  data.arclength_from_ego = util::calcPathArcLengthArray(
-    data.reference_path, 0, data.reference_path.points.size(),
-    calcSignedArcLength(data.reference_path.points, getEgoPosition(), 0));
+  const auto ego_offset = calcSignedArcLength(data.reference_path.points, getEgoPosition(), 0);
+  if (use_resampled_path) {
+    data.arclength_from_ego = context.getResampledCenterLinePathArcLength(
+      reference_pose.pose, backward_length, parameters_.resample_interval_for_planning);
+    for (auto & s : data.arclength_from_ego) {
+      s += ego_offset;
+    }
+  } else {
+    data.arclength_from_ego = util::calcPathArcLengthArray(
+      data.reference_path, 0, data.reference_path.points.size(), ego_offset);
+  }
 
   // lanelet info
   data.current_lanelets = calcLaneAroundPose(
@@ -159,20 +171,26 @@ ObjectDataArray AvoidanceModule::calcAvoidanceTargetObjects(
   const auto & path_points = reference_path.points;
   const auto & ego_pos = getEgoPosition();
 
-  // velocity filter: only for stopped vehicle
-  const auto objects_candidate = util::filterObjectsByVelocity(
-    *planner_data_->dynamic_object, parameters_.threshold_speed_object_is_stopped);
-
   // detection area filter
-  const auto expanded_lanelets = lanelet::utils::getExpandedLanelets(
+  auto & context = *planner_data_->context;
+  const auto & expanded_lanelets = context.getExpandedLanelets(
     current_lanes, parameters_.detection_area_left_expand_dist,
     parameters_.detection_area_right_expand_dist);
-  const auto lane_filtered_objects_index =
-    util::filterObjectsByLanelets(objects_candidate, expanded_lanelets);
+  const auto & lane_filtered_objects_index = context.getObjectIndicesInLanelets(expanded_lanelets);
+
+  // velocity filter: only for stopped vehicle
+  const auto & objects = planner_data_->dynamic_object->objects;
+  std::vector<size_t> objects_candidate_index;
+  for (const auto & i : lane_filtered_objects_index) {
+    const auto v = std::abs(objects.at(i).kinematics.initial_twist_with_covariance.twist.linear.x);
+    if (v < parameters_.threshold_speed_object_is_stopped) {
+      objects_candidate_index.push_back(i);
+    }
+  }
 
-  DEBUG_PRINT("dynamic_objects size = %lu", planner_data_->dynamic_object->objects.size());
-  DEBUG_PRINT("object_candidate size = %lu", objects_candidate.objects.size());
+  DEBUG_PRINT("dynamic_objects size = %lu", objects.size());
   DEBUG_PRINT("lane_filtered_objects size = %lu", lane_filtered_objects_index.size());
+  DEBUG_PRINT("object_candidate size = %lu", objects_candidate_index.size());
 
   // for goal
   const auto & rh = planner_data_->route_handler;
@@ -183,8 +201,8 @@ ObjectDataArray AvoidanceModule::calcAvoidanceTargetObjects(
 
   // for filtered objects
   ObjectDataArray target_objects;
-  for (const auto & i : lane_filtered_objects_index) {
-    const auto & object = objects_candidate.objects.at(i);
+  for (const auto & i : objects_candidate_index) {
+    const auto & object = objects.at(i);
     const auto & object_pos = object.kinematics.initial_pose_with_covariance.pose.position;
 
     if (!isTargetObjectType(object)) {
@@ -1661,14 +1679,10 @@ void AvoidanceModule::modifyPathVelocityToPreventAccelerationOnAvoidance(Shifted
     parameters_.max_avoidance_acceleration, vmax, ego_idx, target_idx);
 }
 
-// TODO(Horibe) clean up functions: there is a similar code in util as well.
-PathWithLaneId AvoidanceModule::calcCenterLinePath(
-  const std::shared_ptr<const PlannerData> & planner_data, const PoseStamped & pose) const
+double AvoidanceModule::calcCenterLineBackwardLength(
+  const std::shared_ptr<const PlannerData> & planner_data) const
 {
   const auto & p = planner_data->parameters;
-  const auto & route_handler = planner_data->route_handler;
-
-  PathWithLaneId centerline_path;
 
   // special for avoidance: take behind distance upt ot shift-start-point if it exist.
   const auto longest_dist_to_shift_point = [&]() {
@@ -1693,22 +1707,7 @@ PathWithLaneId AvoidanceModule::calcCenterLinePath(
     "p.backward_path_length = %f, longest_dist_to_shift_point = %f, backward_length = %f",
     p.backward_path_length, longest_dist_to_shift_point, backward_length);
 
-  const lanelet::ConstLanelets current_lanes =
-    calcLaneAroundPose(planner_data, pose.pose, backward_length);
-  centerline_path = util::getCenterLinePath(
-    *route_handler, current_lanes, pose.pose, backward_length, p.forward_path_length, p);
-
-  // for debug: check if the path backward distance is same as the desired length.
-  // {
-  //   const auto back_to_ego = autoware_utils::calcSignedArcLength(
-  //     centerline_path.points, centerline_path.points.front().point.pose.position,
-  //     getEgoPosition());
-  //   RCLCPP_INFO(getLogger(), "actual back_to_ego distance = %f", back_to_ego);
-  // }
-
-  centerline_path.header = route_handler->getRouteHeader();
-
-  return centerline_path;
+  return backward_length;
 }
 
 boost::optional<AvoidPoint> AvoidanceModule::calcIntersectionShiftPoint(
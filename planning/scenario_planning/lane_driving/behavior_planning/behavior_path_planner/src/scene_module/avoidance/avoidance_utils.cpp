@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #include "behavior_path_planner/path_utilities.hpp"
+#include "behavior_path_planner/planner_context.hpp"
 #include "behavior_path_planner/scene_module/avoidance/avoidance_module.hpp"
 #include "behavior_path_planner/utilities.hpp"
 
@@ -36,22 +37,8 @@ lanelet::ConstLanelets calcLaneAroundPose(
   const std::shared_ptr<const PlannerData> & planner_data, const geometry_msgs::msg::Pose & pose,
   const double backward_length)
 {
-  const auto & p = planner_data->parameters;
-  const auto & route_handler = planner_data->route_handler;
-
-  lanelet::ConstLanelet current_lane;
-  if (!route_handler->getClosestLaneletWithinRoute(pose, &current_lane)) {
-    RCLCPP_ERROR(
-      rclcpp::get_logger("behavior_path_planner").get_child("avoidance"),
-      "failed to find closest lanelet within route!!!");
-    return {};  // TODO(Horibe)
-  }
-
-  // For current_lanes with desired length
-  lanelet::ConstLanelets current_lanes =
-    route_handler->getLaneletSequence(current_lane, pose, backward_length, p.forward_path_length);
-
-  return current_lanes;
+  // the lanes are shared with the other modules in the same tick
+  return planner_data->context->getLanesAroundPose(pose, backward_length);
 }
 
 ShiftedPath toShiftedPath(const PathWithLaneId & path)
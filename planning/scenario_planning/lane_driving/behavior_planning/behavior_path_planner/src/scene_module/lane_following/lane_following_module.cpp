@@ -14,6 +14,7 @@
 
 #include "behavior_path_planner/scene_module/lane_following/lane_following_module.hpp"
 
+#include "behavior_path_planner/planner_context.hpp"
 #include "behavior_path_planner/utilities.hpp"
 
 #include <memory>
@@ -79,22 +80,15 @@ PathWithLaneId LaneFollowingModule::getReferencePath() const
   // Set header
   reference_path.header = route_handler->getRouteHeader();
 
-  lanelet::ConstLanelet current_lane;
-  if (!planner_data_->route_handler->getClosestLaneletWithinRoute(current_pose, &current_lane)) {
-    RCLCPP_ERROR(getLogger(), "failed to find closest lanelet within route!!!");
-    return reference_path;  // TODO(Horibe)
-  }
-
-  // For current_lanes with desired length
-  lanelet::ConstLanelets current_lanes = planner_data_->route_handler->getLaneletSequence(
-    current_lane, current_pose, p.backward_path_length, p.forward_path_length);
+  // For current_lanes with desired length, shared with the other modules in the same tick
+  auto & context = *planner_data_->context;
+  lanelet::ConstLanelets current_lanes = context.getCurrentLanes();
 
   if (current_lanes.empty()) {
     return reference_path;
   }
 
-  reference_path = util::getCenterLinePath(
-    *route_handler, current_lanes, current_pose, p.backward_path_length, p.forward_path_length, p);
+  reference_path = context.getCenterLinePath(current_pose, p.backward_path_length);
 
   {
     // buffer for min_lane_change_length
@@ -17,6 +17,7 @@
 #include "behavior_path_planner/behavior_path_planner_node.hpp"
 #include "behavior_path_planner/path_shifter/path_shifter.hpp"
 #include "behavior_path_planner/path_utilities.hpp"
+#include "behavior_path_planner/planner_context.hpp"
 #include "behavior_path_planner/scene_module/avoidance/debug.hpp"
 #include "behavior_path_planner/scene_module/pull_out/util.hpp"
 #include "behavior_path_planner/util/create_vehicle_footprint.hpp"
@@ -349,20 +350,8 @@ PathWithLaneId PullOutModule::getReferencePath() const
 
 lanelet::ConstLanelets PullOutModule::getCurrentLanes() const
 {
-  const auto & route_handler = planner_data_->route_handler;
-  const auto current_pose = planner_data_->self_pose->pose;
-  const auto common_parameters = planner_data_->parameters;
-
-  lanelet::ConstLanelet current_lane;
-  if (!route_handler->getClosestLaneletWithinRoute(current_pose, &current_lane)) {
-    RCLCPP_ERROR(getLogger(), "failed to find closest lanelet within route!!!");
-    return {};  // TODO(Horibe) what should be returned?
-  }
-
-  // For current_lanes with desired length
-  return route_handler->getLaneletSequence(
-    current_lane, current_pose, common_parameters.backward_path_length,
-    common_parameters.forward_path_length);
+  // For current_lanes with desired length, shared with the other modules in the same tick
+  return planner_data_->context->getCurrentLanes();
 }
 
 // getShoulderLanesOnCurrentPose?
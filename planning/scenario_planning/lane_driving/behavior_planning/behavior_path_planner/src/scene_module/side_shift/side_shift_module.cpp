@@ -15,6 +15,7 @@
 #include "behavior_path_planner/scene_module/side_shift/side_shift_module.hpp"
 
 #include "behavior_path_planner/path_utilities.hpp"
+#include "behavior_path_planner/planner_context.hpp"
 #include "behavior_path_planner/scene_module/side_shift/util.hpp"
 #include "behavior_path_planner/utilities.hpp"
 
@@ -27,28 +28,6 @@
 #include <memory>
 #include <string>
 
-namespace
-{
-lanelet::ConstLanelets calcLaneAroundPose(
-  const std::shared_ptr<const behavior_path_planner::PlannerData> & planner_data,
-  const geometry_msgs::msg::Pose & pose, const double backward_length)
-{
-  const auto & p = planner_data->parameters;
-  const auto & route_handler = planner_data->route_handler;
-
-  lanelet::ConstLanelet current_lane;
-  if (!route_handler->getClosestLaneletWithinRoute(pose, &current_lane)) {
-    return {};  // TODO(Horibe)
-  }
-
-  // For current_lanes with desired length
-  lanelet::ConstLanelets current_lanes =
-    route_handler->getLaneletSequence(current_lane, pose, backward_length, p.forward_path_length);
-
-  return current_lanes;
-}
-}  // namespace
-
 namespace behavior_path_planner
 {
 using geometry_msgs::msg::Point;
@@ -150,24 +129,19 @@ void SideShiftModule::updateData()
 {
   const auto reference_pose = prev_output_.shift_length.empty() ? *planner_data_->self_pose
                                                                 : getUnshiftedEgoPose(prev_output_);
-  const auto centerline_path = calcCenterLinePath(planner_data_, reference_pose);
+  // the center line path and the lanes are shared with the other modules in the same tick
+  auto & context = *planner_data_->context;
+  const auto backward_length = calcCenterLineBackwardLength(planner_data_);
 
   constexpr double resample_interval = 1.0;
-  *reference_path_ = util::resamplePathWithSpline(centerline_path, resample_interval);
+  *reference_path_ =
+    context.getResampledCenterLinePath(reference_pose.pose, backward_length, resample_interval);
 
   path_shifter_.setPath(*reference_path_);
 
-  const auto & route_handler = planner_data_->route_handler;
-  const auto & p = planner_data_->parameters;
-
-  lanelet::ConstLanelet current_lane;
-  if (!route_handler->getClosestLaneletWithinRoute(reference_pose.pose, &current_lane)) {
-    RCLCPP_ERROR(getLogger(), "failed to find closest lanelet within route!!!");
-  }
-
   // For current_lanes with desired length
-  current_lanelets_ = route_handler->getLaneletSequence(
-    current_lane, reference_pose.pose, p.backward_path_length, p.forward_path_length);
+  current_lanelets_ =
+    context.getLanesAroundPose(reference_pose.pose, planner_data_->parameters.backward_path_length);
 
   path_shifter_.removeBehindShiftPointAndSetBaseOffset(planner_data_->self_pose->pose.position);
 }
@@ -376,13 +350,10 @@ PoseStamped SideShiftModule::getUnshiftedEgoPose(const ShiftedPath & prev_path)
 }
 
 // NOTE: this function is ported from avoidance.
-PathWithLaneId SideShiftModule::calcCenterLinePath(
-  const std::shared_ptr<const PlannerData> & planner_data, const PoseStamped & pose) const
+double SideShiftModule::calcCenterLineBackwardLength(
+  const std::shared_ptr<const PlannerData> & planner_data) const
 {
   const auto & p = planner_data->parameters;
-  const auto & route_handler = planner_data->route_handler;
-
-  PathWithLaneId centerline_path;
 
   // special for avoidance: take behind distance upt ot shift-start-point if it exist.
   const auto longest_dist_to_shift_point = [&]() {
@@ -401,14 +372,7 @@ PathWithLaneId SideShiftModule::calcCenterLinePath(
     "p.backward_path_length = %f, longest_dist_to_shift_point = %f, backward_length = %f",
     p.backward_path_length, longest_dist_to_shift_point, backward_length);
 
-  const lanelet::ConstLanelets current_lanes =
-    calcLaneAroundPose(planner_data, pose.pose, backward_length);
-  centerline_path = util::getCenterLinePath(
-    *route_handler, current_lanes, pose.pose, backward_length, p.forward_path_length, p);
-
-  centerline_path.header = route_handler->getRouteHeader();
-
-  return centerline_path;
+  return backward_length;
 }
 
 }  // namespace behavior_path_planner
@@ -14,6 +14,8 @@
 
 #include "behavior_path_planner/utilities.hpp"
 
+#include "behavior_path_planner/planner_context.hpp"
+
 #include <autoware_utils/autoware_utils.hpp>
 #include <lanelet2_extension/utility/message_conversion.hpp>
 #include <lanelet2_extension/utility/query.hpp>
@@ -1364,22 +1366,14 @@ std::shared_ptr<PathWithLaneId> generateCenterLinePath(
   const auto & route_handler = planner_data->route_handler;
   const auto & pose = planner_data->self_pose;
 
-  lanelet::ConstLanelet current_lane;
-  if (!route_handler->getClosestLaneletWithinRoute(pose->pose, &current_lane)) {
-    RCLCPP_ERROR(
-      rclcpp::get_logger("behavior_path_planner").get_child("utilities"),
-      "failed to find closest lanelet within route!!!");
+  // For current_lanes with desired length, shared with the scene modules in the same tick
+  auto & context = *planner_data->context;
+  const auto & current_lanes = context.getCurrentLanes();
+  if (current_lanes.empty()) {
     return {};  // TODO(Horibe) What should be returned?
   }
 
-  // For current_lanes with desired length
-  lanelet::ConstLanelets current_lanes = route_handler->getLaneletSequence(
-    current_lane, pose->pose, p.backward_path_length, p.forward_path_length);
-
-  *centerline_path = getCenterLinePath(
-    *route_handler, current_lanes, pose->pose, p.backward_path_length, p.forward_path_length, p);
-
-  centerline_path->header = route_handler->getRouteHeader();
+  *centerline_path = context.getCenterLinePath(pose->pose, p.backward_path_length);
 
   centerline_path->drivable_area = util::generateDrivableArea(
     current_lanes, *pose, p.drivable_area_width, p.drivable_area_height, p.drivable_area_resolution,
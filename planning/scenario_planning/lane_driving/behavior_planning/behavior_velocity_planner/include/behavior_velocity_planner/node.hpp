@@ -33,6 +33,7 @@
 #include <tf2_ros/buffer.h>
 #include <tf2_ros/transform_listener.h>
 
+#include <deque>
 #include <memory>
 #include <string>
 
@@ -99,6 +100,8 @@ private:
 
   // member
   PlannerData planner_data_;
+  std::deque<geometry_msgs::msg::TwistStamped> velocity_buffer_;
+  VehicleStopHistory vehicle_stop_history_;
   BehaviorVelocityPlannerManager planner_manager_;
 
   // function
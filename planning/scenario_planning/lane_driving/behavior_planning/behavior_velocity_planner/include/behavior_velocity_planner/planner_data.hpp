@@ -15,6 +15,8 @@
 #ifndef BEHAVIOR_VELOCITY_PLANNER__PLANNER_DATA_HPP_
 #define BEHAVIOR_VELOCITY_PLANNER__PLANNER_DATA_HPP_
 
+#include <utilization/lazy_point_cloud.hpp>
+#include <utilization/predicted_object_index.hpp>
 #include <vehicle_info_util/vehicle_info_util.hpp>
 
 #include <autoware_api_msgs/msg/crosswalk_status.hpp>
@@ -49,6 +51,30 @@
 namespace behavior_velocity_planner
 {
 class BehaviorVelocityPlannerNode;
+
+/**
+ * @brief Run-length encoded history of the vehicle velocity, which tells whether each velocity
+ *        sample was below the stop velocity.
+ */
+struct VehicleStopHistory
+{
+  struct Run
+  {
+    rclcpp::Time newest_stamp;
+    rclcpp::Time oldest_stamp;
+    size_t num_samples;
+    bool is_stopped;
+  };
+
+  // newest run first
+  std::deque<Run> runs;
+};
+
+/**
+ * @brief Data used by scene modules. Every member which changes in callbacks is held by a shared
+ *        pointer to an immutable value and replaced as a whole, so a copy of PlannerData is a
+ *        cheap snapshot which does not copy the underlying data.
+ */
 struct PlannerData
 {
   explicit PlannerData(rclcpp::Node & node)
@@ -66,24 +92,29 @@ struct PlannerData
   geometry_msgs::msg::TwistStamped::ConstSharedPtr current_velocity;
   boost::optional<double> current_accel;
   static constexpr double velocity_buffer_time_sec = 10.0;
-  std::deque<geometry_msgs::msg::TwistStamped> velocity_buffer;
+  static constexpr double stop_velocity = 0.1;
+  std::shared_ptr<const VehicleStopHistory> vehicle_stop_history;
   autoware_auto_perception_msgs::msg::PredictedObjects::ConstSharedPtr predicted_objects;
-  pcl::PointCloud<pcl::PointXYZ>::ConstPtr no_ground_pointcloud;
+  // spatio-temporal index of predicted_objects, which is rebuilt in onTrigger when they change
+  std::shared_ptr<const PredictedObjectIndex> predicted_object_index;
+  // transformed into the map frame on the first access in the cycle
+  std::shared_ptr<const LazyPointCloud> no_ground_pointcloud;
   lanelet::LaneletMapPtr lanelet_map;
   // occupancy grid
   nav_msgs::msg::OccupancyGrid::ConstSharedPtr occupancy_grid;
 
   // other internal data
-  std::map<int, autoware_auto_perception_msgs::msg::TrafficSignalStamped> traffic_light_id_map;
+  std::shared_ptr<const std::map<int, autoware_auto_perception_msgs::msg::TrafficSignalStamped>>
+    traffic_light_id_map;
   lanelet::traffic_rules::TrafficRulesPtr traffic_rules;
   lanelet::routing::RoutingGraphPtr routing_graph;
   std::shared_ptr<const lanelet::routing::RoutingGraphContainer> overall_graphs;
 
   // external data
-  std::map<int, autoware_auto_perception_msgs::msg::TrafficSignalStamped>
+  std::shared_ptr<const std::map<int, autoware_auto_perception_msgs::msg::TrafficSignalStamped>>
     external_traffic_light_id_map;
-  boost::optional<autoware_api_msgs::msg::CrosswalkStatus> external_crosswalk_status_input;
-  boost::optional<autoware_api_msgs::msg::IntersectionStatus> external_intersection_status_input;
+  autoware_api_msgs::msg::CrosswalkStatus::ConstSharedPtr external_crosswalk_status_input;
+  autoware_api_msgs::msg::IntersectionStatus::ConstSharedPtr external_intersection_status_input;
   autoware_v2x_msgs::msg::VirtualTrafficLightStateArray::ConstSharedPtr
     virtual_traffic_light_states;
 
@@ -98,51 +129,44 @@ struct PlannerData
 
   bool isVehicleStopped(const double stop_duration = 0.0) const
   {
-    if (velocity_buffer.empty()) {
+    if (!vehicle_stop_history || vehicle_stop_history->runs.empty()) {
       return false;
     }
 
-    // Get velocities within stop_duration
+    // Check velocities within stop_duration, including the newest one older than stop_duration
     const auto now = rclcpp::Clock{RCL_ROS_TIME}.now();
-    std::vector<double> vs;
-    for (const auto & velocity : velocity_buffer) {
-      vs.push_back(velocity.twist.linear.x);
+    for (const auto & run : vehicle_stop_history->runs) {
+      if (!run.is_stopped) {
+        return false;
+      }
 
-      const auto time_diff = now - velocity.header.stamp;
+      const auto time_diff = now - run.oldest_stamp;
       if (time_diff.seconds() >= stop_duration) {
         break;
       }
     }
 
-    // Check all velocities
-    constexpr double stop_velocity = 0.1;
-    for (const auto & v : vs) {
-      if (v >= stop_velocity) {
-        return false;
-      }
-    }
-
     return true;
   }
 
   std::shared_ptr<autoware_auto_perception_msgs::msg::TrafficSignalStamped> getTrafficSignal(
     const int id) const
   {
-    if (traffic_light_id_map.count(id) == 0) {
+    if (!traffic_light_id_map || traffic_light_id_map->count(id) == 0) {
       return {};
     }
     return std::make_shared<autoware_auto_perception_msgs::msg::TrafficSignalStamped>(
-      traffic_light_id_map.at(id));
+      traffic_light_id_map->at(id));
   }
 
   std::shared_ptr<autoware_auto_perception_msgs::msg::TrafficSignalStamped>
   getExternalTrafficSignal(const int id) const
   {
-    if (external_traffic_light_id_map.count(id) == 0) {
+    if (!external_traffic_light_id_map || external_traffic_light_id_map->count(id) == 0) {
       return {};
     }
     return std::make_shared<autoware_auto_perception_msgs::msg::TrafficSignalStamped>(
-      external_traffic_light_id_map.at(id));
+      external_traffic_light_id_map->at(id));
   }
 
 private:
@@ -18,6 +18,7 @@
 #include <rclcpp/rclcpp.hpp>
 #include <scene_module/scene_module_interface.hpp>
 #include <utilization/boost_geometry_helper.hpp>
+#include <utilization/predicted_object_index.hpp>
 
 #include <autoware_auto_perception_msgs/msg/predicted_object.hpp>
 #include <autoware_auto_perception_msgs/msg/predicted_objects.hpp>
@@ -31,6 +32,7 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 namespace behavior_velocity_planner
 {
@@ -134,7 +136,7 @@ private:
    * Condition2: Object's predicted position is in narrow blind spot area.
    * If both conditions are met, return true
    * @param path path information associated with lane id
-   * @param objects_ptr dynamic objects
+   * @param object_index index of dynamic objects
    * @param closest_idx closest path point index from ego car in path points
    * @return true when an object is detected in blind spot
    */
@@ -142,8 +144,8 @@ private:
     lanelet::LaneletMapConstPtr lanelet_map_ptr,
     lanelet::routing::RoutingGraphPtr routing_graph_ptr,
     const autoware_auto_planning_msgs::msg::PathWithLaneId & path,
-    const autoware_auto_perception_msgs::msg::PredictedObjects::ConstSharedPtr objects_ptr,
-    const int closest_idx, const geometry_msgs::msg::Pose & stop_line_pose) const;
+    const PredictedObjectIndex & object_index, const int closest_idx,
+    const geometry_msgs::msg::Pose & stop_line_pose) const;
 
   /**
    * @brief Create half lanelet
@@ -184,14 +186,15 @@ private:
   bool isTargetObjectType(const autoware_auto_perception_msgs::msg::PredictedObject & object) const;
 
   /**
-   * @brief Check if at least one of object's predicted position is in area
-   * @param object Dynamic object
+   * @brief Get objects which have at least one predicted position in area
+   * @param object_index index of dynamic objects
    * @param area Area defined by polygon
-   * @return True when at least one of object's predicted position is in area
+   * @param time_thr predicted positions later than this time from now are ignored
+   * @return Sorted indices of the objects
    */
-  bool isPredictedPathInArea(
-    const autoware_auto_perception_msgs::msg::PredictedObject & object,
-    const lanelet::CompoundPolygon3d & area) const;
+  std::vector<size_t> getObjectIndicesWithPredictedPathInArea(
+    const PredictedObjectIndex & object_index, const lanelet::CompoundPolygon3d & area,
+    const double time_thr) const;
 
   /**
    * @brief Generate a stop line and insert it into the path.
@@ -242,15 +245,6 @@ private:
     lanelet::LaneletMapConstPtr lanelet_map_ptr,
     lanelet::routing::RoutingGraphPtr routing_graph_ptr, const int lane_id);
 
-  /**
-   * @brief Modify objects predicted path. remove path point if the time exceeds timer_thr.
-   * @param objects_ptr target objects
-   * @param time_thr    time threshold to cut path
-   */
-  void cutPredictPathWithDuration(
-    autoware_auto_perception_msgs::msg::PredictedObjects * objects_ptr,
-    const double time_thr) const;
-
   StateMachine state_machine_;  //! for state
 
   // Debug
@@ -70,14 +70,14 @@ private:
     const autoware_auto_planning_msgs::msg::PathWithLaneId & input,
     const boost::geometry::model::polygon<boost::geometry::model::d2::point_xy<double>> & polygon,
     const autoware_auto_perception_msgs::msg::PredictedObjects::ConstSharedPtr & objects_ptr,
-    const pcl::PointCloud<pcl::PointXYZ>::ConstPtr & no_ground_pointcloud_ptr,
+    const std::shared_ptr<const LazyPointCloud> & no_ground_pointcloud_ptr,
     autoware_auto_planning_msgs::msg::PathWithLaneId & output);
 
   bool checkStopArea(
     const autoware_auto_planning_msgs::msg::PathWithLaneId & input,
     const boost::geometry::model::polygon<boost::geometry::model::d2::point_xy<double>> & polygon,
     const autoware_auto_perception_msgs::msg::PredictedObjects::ConstSharedPtr & objects_ptr,
-    const pcl::PointCloud<pcl::PointXYZ>::ConstPtr & no_ground_pointcloud_ptr,
+    const std::shared_ptr<const LazyPointCloud> & no_ground_pointcloud_ptr,
     autoware_auto_planning_msgs::msg::PathWithLaneId & output, bool * insert_stop);
 
   bool createVehiclePathPolygonInCrosswalk(
@@ -19,6 +19,7 @@
 #include <rclcpp/rclcpp.hpp>
 #include <scene_module/scene_module_interface.hpp>
 #include <utilization/boost_geometry_helper.hpp>
+#include <utilization/predicted_object_index.hpp>
 
 #include <autoware_auto_perception_msgs/msg/predicted_object.hpp>
 #include <autoware_auto_perception_msgs/msg/predicted_objects.hpp>
@@ -151,7 +152,7 @@ private:
    * @param detection_areas  collision check is performed for vehicles that exist in this area
    * @param detection_area_lanelet_ids  angle check is performed for obstacles using this lanelet
    * ids
-   * @param objects_ptr      target objects
+   * @param object_index     index of target objects
    * @param closest_idx      ego-car position index on the lane
    * @return true if collision is detected
    */
@@ -159,8 +160,7 @@ private:
     lanelet::LaneletMapConstPtr lanelet_map_ptr,
     const autoware_auto_planning_msgs::msg::PathWithLaneId & path,
     const std::vector<lanelet::CompoundPolygon3d> & detection_areas,
-    const std::vector<int> & detection_area_lanelet_ids,
-    const autoware_auto_perception_msgs::msg::PredictedObjects::ConstSharedPtr objects_ptr,
+    const std::vector<int> & detection_area_lanelet_ids, const PredictedObjectIndex & object_index,
     const int closest_idx);
 
   /**
@@ -192,15 +192,6 @@ private:
     const autoware_auto_planning_msgs::msg::PathWithLaneId & path, const int closest_idx,
     const int start_idx, const double extra_dist, const double ignore_dist) const;
 
-  /**
-   * @brief Modify objects predicted path. remove path point if the time exceeds timer_thr.
-   * @param objects_ptr target objects
-   * @param time_thr    time threshold to cut path
-   */
-  void cutPredictPathWithDuration(
-    autoware_auto_perception_msgs::msg::PredictedObjects * objects_ptr,
-    const double time_thr) const;
-
   /**
    * @brief Calculate time that is needed for ego-vehicle to cross the intersection. (to be updated)
    * @param path              ego-car lane
@@ -72,6 +72,44 @@ void findOcclusionSpots(
 //!< @brief Return true if the path between the two given points is free of occupied cells
 bool isCollisionFree(
   const grid_map::GridMap & grid, const grid_map::Position & p1, const grid_map::Position & p2);
+/**
+ * @brief Precomputed tables of a grid for the occlusion spot search.
+ *
+ * The summed area tables of the UNKNOWN and OCCUPIED cells make every square test O(1), and the
+ * distance transform of the OCCUPIED cells lets a ray skip all cells closer to its current cell
+ * than the nearest occupied cell. The results are the same as the functions working on the grid
+ * directly. The tables are built once per grid, which must outlive this object.
+ */
+class OcclusionSpotGrid
+{
+public:
+  explicit OcclusionSpotGrid(const grid_map::GridMap & grid);
+  const grid_map::GridMap & getGrid() const { return grid_; }
+  //!< @brief same as isOcclusionSpotSquare() on the grid
+  bool isOcclusionSpotSquare(
+    OcclusionSpotSquare & occlusion_spot, const grid_map::Index & cell, const int side_size) const;
+  //!< @brief same as isCollisionFree() on the grid
+  bool isCollisionFree(const grid_map::Position & p1, const grid_map::Position & p2) const;
+
+private:
+  const grid_map::GridMap & grid_;
+  grid_map::Size size_;
+  cv::Mat unknown_sum_;        // CV_32S summed area table of the UNKNOWN cells
+  cv::Mat occupied_sum_;       // CV_32S summed area table of the OCCUPIED cells
+  cv::Mat occupied_distance_;  // CV_32F distance in cells to the nearest OCCUPIED cell
+
+  // number of cells in [min_x, max_x] x [min_y, max_y] counted in the summed area table
+  static int countCells(
+    const cv::Mat & sum, const int min_x, const int max_x, const int min_y, const int max_y);
+  // same start and end index as grid_map::LineIterator, false if the line is outside the grid
+  bool getIndexLimitedToMapRange(
+    const grid_map::Position & start, const grid_map::Position & end,
+    grid_map::Index & index) const;
+};
+//!< @brief Find all occlusion spots inside the given lanelet with the precomputed grid
+void findOcclusionSpots(
+  std::vector<grid_map::Position> & occlusion_spot_positions, const OcclusionSpotGrid & grid,
+  const lanelet::BasicPolygon2d & polygon, const double min_size);
 //!< @brief get the corner positions of the square described by the given anchor
 void getCornerPositions(
   std::vector<grid_map::Position> & corner_positions, const grid_map::GridMap & grid,
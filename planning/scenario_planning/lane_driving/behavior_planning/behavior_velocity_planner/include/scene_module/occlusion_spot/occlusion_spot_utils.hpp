@@ -154,13 +154,15 @@ void generatePossibleCollisions(
   const PlannerParam & param, std::vector<lanelet::BasicPolygon2d> & debug);
 //!< @brief convert a set of occlusion spots found on sidewalk slice
 void generateSidewalkPossibleCollisionFromOcclusionSpot(
-  std::vector<PossibleCollisionInfo> & possible_collisions, const grid_map::GridMap & grid,
+  std::vector<PossibleCollisionInfo> & possible_collisions,
+  const grid_utils::OcclusionSpotGrid & grid,
   const std::vector<grid_map::Position> & occlusion_spot_positions,
   const double offset_form_ego_to_target, const lanelet::ConstLanelet & path_lanelet,
   const PlannerParam & param);
 //!< @brief generate possible collisions coming from occlusion spots on the side of the path
 void generateSidewalkPossibleCollisions(
-  std::vector<PossibleCollisionInfo> & possible_collisions, const grid_map::GridMap & grid,
+  std::vector<PossibleCollisionInfo> & possible_collisions,
+  const grid_utils::OcclusionSpotGrid & grid,
   const double offset_from_ego_to_closest, const double offset_from_closest_to_target,
   const lanelet::ConstLanelet & path_lanelet, const PlannerParam & param,
   std::vector<lanelet::BasicPolygon2d> & debug);
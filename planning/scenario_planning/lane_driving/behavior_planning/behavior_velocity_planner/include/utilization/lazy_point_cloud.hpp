@@ -0,0 +1,53 @@
+// Copyright 2021 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef UTILIZATION__LAZY_POINT_CLOUD_HPP_
+#define UTILIZATION__LAZY_POINT_CLOUD_HPP_
+
+#include <geometry_msgs/msg/transform.hpp>
+#include <sensor_msgs/msg/point_cloud2.hpp>
+
+#include <pcl/point_cloud.h>
+#include <pcl/point_types.h>
+
+#include <mutex>
+
+namespace behavior_velocity_planner
+{
+/**
+ * @brief PointCloud2 message which is converted and transformed into the map frame on the first
+ *        call of get(). The result is shared by every later call, so a cloud is transformed at
+ *        most once no matter how many modules use it, and never if no module uses it.
+ */
+class LazyPointCloud
+{
+public:
+  LazyPointCloud(
+    const sensor_msgs::msg::PointCloud2::ConstSharedPtr & msg,
+    const geometry_msgs::msg::Transform & transform);
+
+  pcl::PointCloud<pcl::PointXYZ>::ConstPtr get() const;
+
+  const sensor_msgs::msg::PointCloud2::ConstSharedPtr & getMsg() const { return msg_; }
+
+private:
+  sensor_msgs::msg::PointCloud2::ConstSharedPtr msg_;
+  geometry_msgs::msg::Transform transform_;
+
+  mutable std::once_flag once_flag_;
+  mutable pcl::PointCloud<pcl::PointXYZ>::ConstPtr transformed_;
+};
+}  // namespace behavior_velocity_planner
+
+#endif  // UTILIZATION__LAZY_POINT_CLOUD_HPP_
@@ -0,0 +1,122 @@
+// Copyright 2021 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef UTILIZATION__PREDICTED_OBJECT_INDEX_HPP_
+#define UTILIZATION__PREDICTED_OBJECT_INDEX_HPP_
+
+#include <rclcpp/time.hpp>
+#include <utilization/boost_geometry_helper.hpp>
+
+#include <autoware_auto_perception_msgs/msg/predicted_objects.hpp>
+
+#include <boost/geometry/geometries/box.hpp>
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace behavior_velocity_planner
+{
+using Box2d = boost::geometry::model::box<Point2d>;
+
+/**
+ * @brief Spatio-temporal index of the predicted paths of PredictedObjects.
+ *
+ * Every pair of consecutive poses of a predicted path is stored as a segment, together with the
+ * times of its end points measured from the header stamp of the message. A path with a single pose
+ * is stored as a degenerate segment so that every predicted pose belongs to at least one segment.
+ * Segments are bucketed by the grid cells covered by their bounding box and by the time slices
+ * covered by their time span, so a query only visits the segments around the queried area and
+ * time range. The index is built once per planning cycle and shared by all scene modules.
+ */
+class PredictedObjectIndex
+{
+public:
+  static constexpr double kDefaultCellSize = 10.0;
+  static constexpr double kDefaultTimeSlice = 1.0;
+
+  struct Segment
+  {
+    size_t object_index;
+    size_t path_index;
+    size_t segment_index;  // index of the first pose in the predicted path
+    double start_time;     // [s] from the header stamp of the objects
+    double end_time;       // [s] from the header stamp of the objects
+    Point2d p0;
+    Point2d p1;
+  };
+
+  explicit PredictedObjectIndex(
+    const autoware_auto_perception_msgs::msg::PredictedObjects::ConstSharedPtr & objects_ptr,
+    const double cell_size = kDefaultCellSize, const double time_slice = kDefaultTimeSlice);
+
+  /**
+   * @brief ids of the segments whose bounding box intersects the box and whose time span
+   *        overlaps [t0, t1], in ascending order.
+   */
+  std::vector<size_t> querySegmentCandidates(
+    const Box2d & box, const double t0, const double t1) const;
+
+  /**
+   * @brief ids of the segments which intersect the polygon and whose time span overlaps [t0, t1],
+   *        in ascending order.
+   */
+  std::vector<size_t> querySegments(
+    const Polygon2d & polygon, const double t0, const double t1) const;
+
+  /**
+   * @brief indices of the objects which have a segment in querySegments(), in ascending order.
+   */
+  std::vector<size_t> queryObjects(
+    const Polygon2d & polygon, const double t0, const double t1) const;
+
+  const Segment & getSegment(const size_t segment_id) const { return segments_.at(segment_id); }
+  size_t getNumSegments() const { return segments_.size(); }
+
+  const autoware_auto_perception_msgs::msg::PredictedObjects::ConstSharedPtr & getObjects() const
+  {
+    return objects_ptr_;
+  }
+
+  /**
+   * @brief time in the index for the given time, i.e. seconds from the header stamp of the
+   *        objects.
+   */
+  double toIndexTime(const rclcpp::Time & time) const;
+
+private:
+  autoware_auto_perception_msgs::msg::PredictedObjects::ConstSharedPtr objects_ptr_;
+  double cell_size_;
+  double time_slice_;
+
+  std::vector<Segment> segments_;
+  std::unordered_map<uint64_t, std::vector<size_t>> buckets_;
+  // segments spanning too many buckets, which are checked by every query
+  std::vector<size_t> large_segment_ids_;
+  int64_t min_slice_ = 0;
+  int64_t max_slice_ = -1;
+
+  int64_t toCell(const double v) const;
+  int64_t toSlice(const double t) const;
+  double countBuckets(
+    const double x_min, const double x_max, const double y_min, const double y_max,
+    const double t_min, const double t_max) const;
+  static uint64_t toKey(const int64_t cx, const int64_t cy, const int64_t slice);
+  bool isCandidate(const Segment & segment, const Box2d & box, const double t0, const double t1)
+    const;
+};
+
+}  // namespace behavior_velocity_planner
+
+#endif  // UTILIZATION__PREDICTED_OBJECT_INDEX_HPP_
@@ -21,10 +21,9 @@
 #include <visualization_msgs/msg/marker_array.hpp>
 
 #include <lanelet2_routing/Route.h>
-#include <pcl/common/transforms.h>
-#include <tf2_eigen/tf2_eigen.h>
 
 #include <functional>
+#include <map>
 #include <memory>
 
 // Scene modules
@@ -54,6 +53,24 @@ geometry_msgs::msg::PoseStamped transform2pose(
   return pose;
 }
 
+using TrafficSignalMap = std::map<int, autoware_auto_perception_msgs::msg::TrafficSignalStamped>;
+
+// copy-on-write, so that snapshots of PlannerData taken before keep the previous map
+std::shared_ptr<const TrafficSignalMap> updateTrafficSignalMap(
+  const std::shared_ptr<const TrafficSignalMap> & prev_map,
+  const autoware_auto_perception_msgs::msg::TrafficSignalArray & msg)
+{
+  auto map = prev_map ? std::make_shared<TrafficSignalMap>(*prev_map)
+                      : std::make_shared<TrafficSignalMap>();
+  for (const auto & signal : msg.signals) {
+    autoware_auto_perception_msgs::msg::TrafficSignalStamped traffic_signal;
+    traffic_signal.header = msg.header;
+    traffic_signal.signal = signal;
+    (*map)[signal.map_primitive_id] = traffic_signal;
+  }
+  return map;
+}
+
 autoware_auto_planning_msgs::msg::Path to_path(
   const autoware_auto_planning_msgs::msg::PathWithLaneId & path_with_id)
 {
@@ -210,14 +227,9 @@ void BehaviorVelocityPlannerNode::onNoGroundPointCloud(
     return;
   }
 
-  pcl::PointCloud<pcl::PointXYZ> pc;
-  pcl::fromROSMsg(*msg, pc);
-
-  Eigen::Affine3f affine = tf2::transformToEigen(transform.transform).cast<float>();
-  pcl::PointCloud<pcl::PointXYZ>::Ptr pc_transformed(new pcl::PointCloud<pcl::PointXYZ>);
-  pcl::transformPointCloud(pc, *pc_transformed, affine);
-
-  planner_data_.no_ground_pointcloud = pc_transformed;
+  // the conversion is deferred until a module uses the pointcloud
+  planner_data_.no_ground_pointcloud =
+    std::make_shared<const LazyPointCloud>(msg, transform.transform);
 }
 
 void BehaviorVelocityPlannerNode::onVehicleVelocity(
@@ -231,11 +243,21 @@ void BehaviorVelocityPlannerNode::onVehicleVelocity(
   planner_data_.updateCurrentAcc();
 
   // Add velocity to buffer
-  planner_data_.velocity_buffer.push_front(*current_velocity);
+  velocity_buffer_.push_front(*current_velocity);
+  auto & runs = vehicle_stop_history_.runs;
+  const rclcpp::Time stamp = current_velocity->header.stamp;
+  const bool is_stopped = current_velocity->twist.linear.x < PlannerData::stop_velocity;
+  if (!runs.empty() && runs.front().is_stopped == is_stopped) {
+    runs.front().newest_stamp = stamp;
+    ++runs.front().num_samples;
+  } else {
+    runs.push_front({stamp, stamp, 1, is_stopped});
+  }
+
   const auto now = this->now();
-  while (true) {
+  while (!velocity_buffer_.empty()) {
     // Check oldest data time
-    const auto time_diff = now - planner_data_.velocity_buffer.back().header.stamp;
+    const auto time_diff = now - velocity_buffer_.back().header.stamp;
 
     // Finish when oldest data is newer than threshold
     if (time_diff.seconds() <= PlannerData::velocity_buffer_time_sec) {
@@ -243,8 +265,16 @@ void BehaviorVelocityPlannerNode::onVehicleVelocity(
     }
 
     // Remove old data
-    planner_data_.velocity_buffer.pop_back();
+    velocity_buffer_.pop_back();
+    if (--runs.back().num_samples == 0) {
+      runs.pop_back();
+    } else {
+      runs.back().oldest_stamp = velocity_buffer_.back().header.stamp;
+    }
   }
+
+  planner_data_.vehicle_stop_history =
+    std::make_shared<const VehicleStopHistory>(vehicle_stop_history_);
 }
 
 void BehaviorVelocityPlannerNode::onLaneletMap(
@@ -282,35 +312,27 @@ void BehaviorVelocityPlannerNode::onLaneletMap(
 void BehaviorVelocityPlannerNode::onTrafficSignals(
   const autoware_auto_perception_msgs::msg::TrafficSignalArray::ConstSharedPtr msg)
 {
-  for (const auto & signal : msg->signals) {
-    autoware_auto_perception_msgs::msg::TrafficSignalStamped traffic_signal;
-    traffic_signal.header = msg->header;
-    traffic_signal.signal = signal;
-    planner_data_.traffic_light_id_map[signal.map_primitive_id] = traffic_signal;
-  }
+  planner_data_.traffic_light_id_map =
+    updateTrafficSignalMap(planner_data_.traffic_light_id_map, *msg);
 }
 
 void BehaviorVelocityPlannerNode::onExternalCrosswalkStates(
   const autoware_api_msgs::msg::CrosswalkStatus::ConstSharedPtr msg)
 {
-  planner_data_.external_crosswalk_status_input = *msg;
+  planner_data_.external_crosswalk_status_input = msg;
 }
 
 void BehaviorVelocityPlannerNode::onExternalIntersectionStates(
   const autoware_api_msgs::msg::IntersectionStatus::ConstSharedPtr msg)
 {
-  planner_data_.external_intersection_status_input = *msg;
+  planner_data_.external_intersection_status_input = msg;
 }
 
 void BehaviorVelocityPlannerNode::onExternalTrafficSignals(
   const autoware_auto_perception_msgs::msg::TrafficSignalArray::ConstSharedPtr msg)
 {
-  for (const auto & signal : msg->signals) {
-    autoware_auto_perception_msgs::msg::TrafficSignalStamped traffic_signal;
-    traffic_signal.header = msg->header;
-    traffic_signal.signal = signal;
-    planner_data_.external_traffic_light_id_map[signal.map_primitive_id] = traffic_signal;
-  }
+  planner_data_.external_traffic_light_id_map =
+    updateTrafficSignalMap(planner_data_.external_traffic_light_id_map, *msg);
 }
 
 void BehaviorVelocityPlannerNode::onVirtualTrafficLightStates(
@@ -335,7 +357,16 @@ void BehaviorVelocityPlannerNode::onTrigger(
     return;
   }
 
-  // Plan path velocity
+  // Index predicted objects once for all scene modules
+  if (
+    !planner_data_.predicted_object_index ||
+    planner_data_.predicted_object_index->getObjects() != planner_data_.predicted_objects) {
+    planner_data_.predicted_object_index =
+      std::make_shared<const PredictedObjectIndex>(planner_data_.predicted_objects);
+  }
+
+  // Plan path velocity. PlannerData only holds shared pointers to the data updated in callbacks,
+  // so this snapshot does not copy them.
   const auto velocity_planned_path = planner_manager_.planPathVelocity(
     std::make_shared<const PlannerData>(planner_data_), *input_path_msg);
 
@@ -27,6 +27,7 @@
 #include <lanelet2_core/primitives/BasicRegulatoryElements.h>
 
 #include <algorithm>
+#include <limits>
 #include <memory>
 #include <string>
 #include <utility>
@@ -124,11 +125,11 @@ bool BlindSpotModule::modifyPathVelocity(
   }
 
   /* get dynamic object */
-  const auto objects_ptr = planner_data_->predicted_objects;
+  const auto & object_index = *planner_data_->predicted_object_index;
 
   /* calculate dynamic collision around detection area */
   bool has_obstacle = checkObstacleInBlindSpot(
-    lanelet_map_ptr, routing_graph_ptr, *path, objects_ptr, closest_idx, stop_line_pose);
+    lanelet_map_ptr, routing_graph_ptr, *path, object_index, closest_idx, stop_line_pose);
   state_machine_.setStateWithMarginTime(
     has_obstacle ? State::STOP : State::GO, logger_.get_child("state_machine"), *clock_);
 
@@ -259,29 +260,6 @@ bool BlindSpotModule::generateStopLine(
   return true;
 }
 
-void BlindSpotModule::cutPredictPathWithDuration(
-  autoware_auto_perception_msgs::msg::PredictedObjects * objects_ptr, const double time_thr) const
-{
-  const rclcpp::Time current_time = clock_->now();
-
-  for (auto & object : objects_ptr->objects) {                         // each objects
-    for (auto & predicted_path : object.kinematics.predicted_paths) {  // each predicted paths
-      const auto origin_path = predicted_path;
-      predicted_path.path.clear();
-
-      for (size_t k = 0; k < origin_path.path.size(); ++k) {  // each path points
-        const auto & predicted_pose = origin_path.path.at(k);
-        const auto predicted_time =
-          rclcpp::Time(objects_ptr->header.stamp) +
-          rclcpp::Duration(origin_path.time_step) * static_cast<double>(k);
-        if ((predicted_time - current_time).seconds() < time_thr) {
-          predicted_path.path.push_back(predicted_pose);
-        }
-      }
-    }
-  }
-}
-
 int BlindSpotModule::insertPoint(
   const int insert_idx_ip, const autoware_auto_planning_msgs::msg::PathWithLaneId path_ip,
   autoware_auto_planning_msgs::msg::PathWithLaneId * inout_path) const
@@ -316,8 +294,8 @@ int BlindSpotModule::insertPoint(
 bool BlindSpotModule::checkObstacleInBlindSpot(
   lanelet::LaneletMapConstPtr lanelet_map_ptr, lanelet::routing::RoutingGraphPtr routing_graph_ptr,
   const autoware_auto_planning_msgs::msg::PathWithLaneId & path,
-  const autoware_auto_perception_msgs::msg::PredictedObjects::ConstSharedPtr objects_ptr,
-  const int closest_idx, const geometry_msgs::msg::Pose & stop_line_pose) const
+  const PredictedObjectIndex & object_index, const int closest_idx,
+  const geometry_msgs::msg::Pose & stop_line_pose) const
 {
   /* get detection area */
   if (turn_direction_ == TurnDirection::INVALID) {
@@ -331,12 +309,14 @@ bool BlindSpotModule::checkObstacleInBlindSpot(
     debug_data_.detection_area_for_blind_spot = areas_opt.get().detection_area;
     debug_data_.conflict_area_for_blind_spot = areas_opt.get().conflict_area;
 
-    autoware_auto_perception_msgs::msg::PredictedObjects objects = *objects_ptr;
-    cutPredictPathWithDuration(&objects, planner_param_.max_future_movement_time);
+    const auto object_indices_in_conflict_area = getObjectIndicesWithPredictedPathInArea(
+      object_index, areas_opt.get().conflict_area, planner_param_.max_future_movement_time);
 
     // check objects in blind spot areas
     bool obstacle_detected = false;
-    for (const auto & object : objects.objects) {
+    const auto & objects = object_index.getObjects()->objects;
+    for (size_t i = 0; i < objects.size(); ++i) {
+      const auto & object = objects.at(i);
       if (!isTargetObjectType(object)) {
         continue;
       }
@@ -344,7 +324,8 @@ bool BlindSpotModule::checkObstacleInBlindSpot(
       bool exist_in_detection_area = bg::within(
         to_bg2d(object.kinematics.initial_pose_with_covariance.pose.position),
         lanelet::utils::to2D(areas_opt.get().detection_area));
-      bool exist_in_conflict_area = isPredictedPathInArea(object, areas_opt.get().conflict_area);
+      bool exist_in_conflict_area = std::binary_search(
+        object_indices_in_conflict_area.begin(), object_indices_in_conflict_area.end(), i);
       if (exist_in_detection_area && exist_in_conflict_area) {
         obstacle_detected = true;
         debug_data_.conflicting_targets.objects.push_back(object);
@@ -356,21 +337,33 @@ bool BlindSpotModule::checkObstacleInBlindSpot(
   }
 }
 
-bool BlindSpotModule::isPredictedPathInArea(
-  const autoware_auto_perception_msgs::msg::PredictedObject & object,
-  const lanelet::CompoundPolygon3d & area) const
+std::vector<size_t> BlindSpotModule::getObjectIndicesWithPredictedPathInArea(
+  const PredictedObjectIndex & object_index, const lanelet::CompoundPolygon3d & area,
+  const double time_thr) const
 {
-  bool exist_in_conflict_area = false;
-  for (const auto & predicted_path : object.kinematics.predicted_paths) {
-    for (const auto & predicted_point : predicted_path.path) {
-      exist_in_conflict_area =
-        bg::within(to_bg2d(predicted_point.position), lanelet::utils::to2D(area));
-      if (exist_in_conflict_area) {
-        return true;
-      }
+  const auto area_2d = lanelet::utils::to2D(area);
+  Box2d area_box;
+  bg::assign_inverse(area_box);
+  for (const auto & p : area_2d) {
+    bg::expand(area_box, Point2d(p.x(), p.y()));
+  }
+
+  // predicted points later than time_thr from now are ignored
+  const double max_time = object_index.toIndexTime(clock_->now()) + time_thr;
+  std::vector<size_t> object_indices;
+  for (const auto id : object_index.querySegmentCandidates(
+         area_box, -std::numeric_limits<double>::infinity(), max_time)) {
+    const auto & segment = object_index.getSegment(id);
+    if (
+      (segment.start_time < max_time && bg::within(segment.p0, area_2d)) ||
+      (segment.end_time < max_time && bg::within(segment.p1, area_2d))) {
+      object_indices.push_back(segment.object_index);
     }
   }
-  return false;
+  std::sort(object_indices.begin(), object_indices.end());
+  object_indices.erase(
+    std::unique(object_indices.begin(), object_indices.end()), object_indices.end());
+  return object_indices;
 }
 
 lanelet::ConstLanelet BlindSpotModule::generateHalfLanelet(
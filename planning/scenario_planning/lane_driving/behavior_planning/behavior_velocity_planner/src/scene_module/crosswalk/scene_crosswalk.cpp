@@ -99,7 +99,7 @@ bool CrosswalkModule::modifyPathVelocity(
 bool CrosswalkModule::checkStopArea(
   const autoware_auto_planning_msgs::msg::PathWithLaneId & input, const Polygon & crosswalk_polygon,
   const autoware_auto_perception_msgs::msg::PredictedObjects::ConstSharedPtr & objects_ptr,
-  [[maybe_unused]] const pcl::PointCloud<pcl::PointXYZ>::ConstPtr & no_ground_pointcloud_ptr,
+  [[maybe_unused]] const std::shared_ptr<const LazyPointCloud> & no_ground_pointcloud_ptr,
   autoware_auto_planning_msgs::msg::PathWithLaneId & output, bool * insert_stop)
 {
   output = input;
@@ -223,7 +223,7 @@ bool CrosswalkModule::checkStopArea(
 bool CrosswalkModule::checkSlowArea(
   const autoware_auto_planning_msgs::msg::PathWithLaneId & input, const Polygon & crosswalk_polygon,
   const autoware_auto_perception_msgs::msg::PredictedObjects::ConstSharedPtr & objects_ptr,
-  [[maybe_unused]] const pcl::PointCloud<pcl::PointXYZ>::ConstPtr & no_ground_pointcloud_ptr,
+  [[maybe_unused]] const std::shared_ptr<const LazyPointCloud> & no_ground_pointcloud_ptr,
   autoware_auto_planning_msgs::msg::PathWithLaneId & output)
 {
   output = input;
@@ -385,8 +385,8 @@ bool CrosswalkModule::isTargetType(const autoware_auto_perception_msgs::msg::Pre
 bool CrosswalkModule::isTargetExternalInputStatus(const int target_status)
 {
   return planner_data_->external_crosswalk_status_input &&
-         planner_data_->external_crosswalk_status_input.get().status == target_status &&
-         (clock_->now() - planner_data_->external_crosswalk_status_input.get().header.stamp)
+         planner_data_->external_crosswalk_status_input->status == target_status &&
+         (clock_->now() - planner_data_->external_crosswalk_status_input->header.stamp)
              .seconds() < planner_param_.external_input_timeout;
 }
 }  // namespace behavior_velocity_planner
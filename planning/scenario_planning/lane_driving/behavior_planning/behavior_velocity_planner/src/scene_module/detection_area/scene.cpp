@@ -385,7 +385,7 @@ std::vector<geometry_msgs::msg::Point> DetectionAreaModule::getObstaclePoints()
   std::vector<geometry_msgs::msg::Point> obstacle_points;
 
   const auto detection_areas = detection_area_reg_elem_.detectionAreas();
-  const auto & points = *(planner_data_->no_ground_pointcloud);
+  const auto & points = *(planner_data_->no_ground_pointcloud->get());
 
   for (const auto & detection_area : detection_areas) {
     for (const auto p : points) {
@@ -25,7 +25,10 @@
 #include <lanelet2_core/primitives/BasicRegulatoryElements.h>
 
 #include <algorithm>
+#include <limits>
+#include <map>
 #include <memory>
+#include <utility>
 #include <vector>
 
 namespace behavior_velocity_planner
@@ -154,7 +157,8 @@ bool IntersectionModule::modifyPathVelocity(
 
   /* calculate dynamic collision around detection area */
   bool has_collision = checkCollision(
-    lanelet_map_ptr, *path, detection_areas, detection_area_lanelet_ids, objects_ptr, closest_idx);
+    lanelet_map_ptr, *path, detection_areas, detection_area_lanelet_ids,
+    *planner_data_->predicted_object_index, closest_idx);
   bool is_stuck = checkStuckVehicleInIntersection(
     lanelet_map_ptr, *path, closest_idx, stop_line_idx, objects_ptr);
   bool is_entry_prohibited = (has_collision || is_stuck);
@@ -201,34 +205,11 @@ bool IntersectionModule::modifyPathVelocity(
   return true;
 }
 
-void IntersectionModule::cutPredictPathWithDuration(
-  autoware_auto_perception_msgs::msg::PredictedObjects * objects_ptr, const double time_thr) const
-{
-  const rclcpp::Time current_time = clock_->now();
-  for (auto & object : objects_ptr->objects) {                         // each objects
-    for (auto & predicted_path : object.kinematics.predicted_paths) {  // each predicted paths
-      const auto origin_path = predicted_path;
-      predicted_path.path.clear();
-
-      for (size_t k = 0; k < origin_path.path.size(); ++k) {  // each path points
-        const auto & predicted_pose = origin_path.path.at(k);
-        const auto predicted_time =
-          rclcpp::Time(objects_ptr->header.stamp) +
-          rclcpp::Duration(origin_path.time_step) * static_cast<double>(k);
-        if ((predicted_time - current_time).seconds() < time_thr) {
-          predicted_path.path.push_back(predicted_pose);
-        }
-      }
-    }
-  }
-}
-
 bool IntersectionModule::checkCollision(
   lanelet::LaneletMapConstPtr lanelet_map_ptr,
   const autoware_auto_planning_msgs::msg::PathWithLaneId & path,
   const std::vector<lanelet::CompoundPolygon3d> & detection_areas,
-  const std::vector<int> & detection_area_lanelet_ids,
-  const autoware_auto_perception_msgs::msg::PredictedObjects::ConstSharedPtr objects_ptr,
+  const std::vector<int> & detection_area_lanelet_ids, const PredictedObjectIndex & object_index,
   const int closest_idx)
 {
   using lanelet::utils::getArcCoordinates;
@@ -241,9 +222,10 @@ bool IntersectionModule::checkCollision(
   debug_data_.ego_lane_polygon = toGeomMsg(ego_poly);
 
   /* extract target objects */
-  autoware_auto_perception_msgs::msg::PredictedObjects target_objects;
-  target_objects.header = objects_ptr->header;
-  for (const auto & object : objects_ptr->objects) {
+  const auto & objects = object_index.getObjects()->objects;
+  std::vector<size_t> target_object_indices;
+  for (size_t i = 0; i < objects.size(); ++i) {
+    const auto & object = objects.at(i);
     // ignore non-vehicle type objects, such as pedestrian.
     if (!isTargetCollisionVehicleType(object)) {
       continue;
@@ -271,7 +253,7 @@ bool IntersectionModule::checkCollision(
       // check direction of objects
       const auto object_direction = getObjectPoseWithVelocityDirection(object.kinematics);
       if (checkAngleForTargetLanelets(object_direction, detection_area_lanelet_ids)) {
-        target_objects.objects.push_back(object);
+        target_object_indices.push_back(i);
         break;
       }
     }
@@ -279,10 +261,31 @@ bool IntersectionModule::checkCollision(
 
   /* check collision between target_objects predicted path and ego lane */
 
-  // cut the predicted path at passing_time
+  // the predicted path is cut at passing_time, and only the segments whose both ends are before
+  // passing_time are checked
   const auto time_distance_array = calcIntersectionPassingTime(path, closest_idx, lane_id_);
   const double passing_time = time_distance_array.back().first;
-  cutPredictPathWithDuration(&target_objects, passing_time);
+  const double cut_time = object_index.toIndexTime(clock_->now()) + passing_time;
+
+  // range of the segments intersecting the ego-lane for each (object, predicted path)
+  std::map<std::pair<size_t, size_t>, std::pair<size_t, size_t>> colliding_segment_ranges;
+  for (const auto id :
+       object_index.querySegments(ego_poly, -std::numeric_limits<double>::infinity(), cut_time)) {
+    const auto & segment = object_index.getSegment(id);
+    const auto & predicted_path =
+      objects.at(segment.object_index).kinematics.predicted_paths.at(segment.path_index);
+    if (!(segment.end_time < cut_time) || predicted_path.path.size() < 2) {
+      continue;
+    }
+    const auto key = std::make_pair(segment.object_index, segment.path_index);
+    const auto itr = colliding_segment_ranges.find(key);
+    if (itr == colliding_segment_ranges.end()) {
+      colliding_segment_ranges.emplace(
+        key, std::make_pair(segment.segment_index, segment.segment_index));
+    } else {
+      itr->second.second = segment.segment_index;
+    }
+  }
 
   lanelet::ConstLanelets ego_lane_with_next_lane = getEgoLaneWithNextLane(lanelet_map_ptr, path);
   const auto closest_arc_coords = getArcCoordinates(
@@ -293,30 +296,22 @@ bool IntersectionModule::checkCollision(
 
   // check collision between predicted_path and ego_area
   bool collision_detected = false;
-  for (const auto & object : target_objects.objects) {
-    bool has_collision = false;
-    for (const auto & predicted_path : object.kinematics.predicted_paths) {
+  for (const auto object_idx : target_object_indices) {
+    const auto & object = objects.at(object_idx);
+    const auto & predicted_paths = object.kinematics.predicted_paths;
+    for (size_t path_idx = 0; path_idx < predicted_paths.size(); ++path_idx) {
+      const auto & predicted_path = predicted_paths.at(path_idx);
       if (predicted_path.confidence < planner_param_.min_predicted_path_confidence) {
         // ignore the predicted path with too low confidence
         continue;
       }
 
-      std::vector<geometry_msgs::msg::Pose> predicted_poses;
-      for (const auto & pose : predicted_path.path) {
-        predicted_poses.push_back(pose);
-      }
-      has_collision = bg::intersects(ego_poly, to_bg2d(predicted_poses));
+      const auto range_itr = colliding_segment_ranges.find(std::make_pair(object_idx, path_idx));
+      const bool has_collision = range_itr != colliding_segment_ranges.end();
       if (has_collision) {
-        const auto first_itr = std::adjacent_find(
-          predicted_path.path.cbegin(), predicted_path.path.cend(),
-          [&ego_poly](const auto & a, const auto & b) {
-            return bg::intersects(ego_poly, LineString2d{to_bg2d(a), to_bg2d(b)});
-          });
-        const auto last_itr = std::adjacent_find(
-          predicted_path.path.crbegin(), predicted_path.path.crend(),
-          [&ego_poly](const auto & a, const auto & b) {
-            return bg::intersects(ego_poly, LineString2d{to_bg2d(a), to_bg2d(b)});
-          });
+        // from the first point of the first colliding segment to the last point of the last one
+        const auto first_itr = predicted_path.path.cbegin() + range_itr->second.first;
+        const auto last_itr = predicted_path.path.cbegin() + range_itr->second.second + 2;
         const double ref_object_enter_time =
           static_cast<double>(first_itr - predicted_path.path.begin()) *
           rclcpp::Duration(predicted_path.time_step).seconds();
@@ -331,7 +326,7 @@ bool IntersectionModule::checkCollision(
           }
         }
         const double ref_object_exit_time =
-          static_cast<double>(last_itr.base() - predicted_path.path.begin()) *
+          static_cast<double>(last_itr - predicted_path.path.begin()) *
           rclcpp::Duration(predicted_path.time_step).seconds();
         auto end_time_distance_itr = std::lower_bound(
           time_distance_array.begin(), time_distance_array.end(),
@@ -358,7 +353,7 @@ bool IntersectionModule::checkCollision(
 
         debug_data_.candidate_collision_ego_lane_polygon = toGeomMsg(polygon);
 
-        for (auto itr = first_itr; itr != last_itr.base(); ++itr) {
+        for (auto itr = first_itr; itr != last_itr; ++itr) {
           const auto footprint_polygon = toPredictedFootprintPolygon(object, *itr);
           debug_data_.candidate_collision_object_polygons.emplace_back(
             toGeomMsg(footprint_polygon));
@@ -595,8 +590,8 @@ IntersectionModule::State IntersectionModule::StateMachine::getState() { return
 bool IntersectionModule::isTargetExternalInputStatus(const int target_status)
 {
   return planner_data_->external_intersection_status_input &&
-         planner_data_->external_intersection_status_input.get().status == target_status &&
-         (clock_->now() - planner_data_->external_intersection_status_input.get().header.stamp)
+         planner_data_->external_intersection_status_input->status == target_status &&
+         (clock_->now() - planner_data_->external_intersection_status_input->header.stamp)
              .seconds() < planner_param_.external_input_timeout;
 }
 
@@ -16,6 +16,8 @@
 #include <scene_module/occlusion_spot/grid_utils.hpp>
 
 #include <algorithm>
+#include <cmath>
+#include <limits>
 #include <vector>
 
 namespace behavior_velocity_planner
@@ -107,6 +109,174 @@ bool isCollisionFree(
   return true;
 }
 
+OcclusionSpotGrid::OcclusionSpotGrid(const grid_map::GridMap & grid)
+: grid_(grid), size_(grid.getSize())
+{
+  const grid_map::Matrix & grid_data = grid["layer"];
+  cv::Mat unknown(size_.x(), size_.y(), CV_8UC1);
+  cv::Mat occupied(size_.x(), size_.y(), CV_8UC1);
+  // zero pixels are the targets of the distance transform
+  cv::Mat not_occupied(size_.x(), size_.y(), CV_8UC1);
+  for (int x = 0; x < size_.x(); ++x) {
+    for (int y = 0; y < size_.y(); ++y) {
+      const float value = grid_data(x, y);
+      const bool is_occupied = value == grid_utils::occlusion_cost_value::OCCUPIED;
+      unknown.at<unsigned char>(x, y) = value == grid_utils::occlusion_cost_value::UNKNOWN;
+      occupied.at<unsigned char>(x, y) = is_occupied;
+      not_occupied.at<unsigned char>(x, y) = is_occupied ? 0 : 1;
+    }
+  }
+  cv::integral(unknown, unknown_sum_, CV_32S);
+  cv::integral(occupied, occupied_sum_, CV_32S);
+  if (countCells(occupied_sum_, 0, size_.x() - 1, 0, size_.y() - 1) > 0) {
+    cv::distanceTransform(not_occupied, occupied_distance_, cv::DIST_L2, cv::DIST_MASK_PRECISE);
+  }
+}
+
+int OcclusionSpotGrid::countCells(
+  const cv::Mat & sum, const int min_x, const int max_x, const int min_y, const int max_y)
+{
+  return sum.at<int>(max_x + 1, max_y + 1) - sum.at<int>(min_x, max_y + 1) -
+         sum.at<int>(max_x + 1, min_y) + sum.at<int>(min_x, min_y);
+}
+
+bool OcclusionSpotGrid::isOcclusionSpotSquare(
+  OcclusionSpotSquare & occlusion_spot, const grid_map::Index & cell, const int side_size) const
+{
+  // No occlusion_spot with size 0
+  if (side_size == 0) {
+    return false;
+  }
+  // same window as isOcclusionSpotSquare() on the grid data
+  const int offset = side_size - 1;
+  const int min_x = std::max(0, cell.x());
+  const int max_x = std::min(size_.x() - 1, cell.x() + offset);
+  const int min_y = std::max(0, cell.y() - offset);
+  const int max_y = std::min(size_.y() - 1, cell.y());
+  if (min_x <= max_x && min_y <= max_y) {
+    const int num_cells = (max_x - min_x + 1) * (max_y - min_y + 1);
+    if (countCells(unknown_sum_, min_x, max_x, min_y, max_y) != num_cells) {
+      return false;
+    }
+  }
+  occlusion_spot.side_size = side_size;
+  occlusion_spot.index = cell;
+  return true;
+}
+
+bool OcclusionSpotGrid::getIndexLimitedToMapRange(
+  const grid_map::Position & start, const grid_map::Position & end, grid_map::Index & index) const
+{
+  const double step = grid_.getResolution() - std::numeric_limits<double>::epsilon();
+  grid_map::Position new_start = start;
+  const grid_map::Position direction = (end - start).normalized();
+  while (!grid_.getIndex(new_start, index)) {
+    new_start += step * direction;
+    if ((end - new_start).norm() < step) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool OcclusionSpotGrid::isCollisionFree(
+  const grid_map::Position & p1, const grid_map::Position & p2) const
+{
+  grid_map::Index start;
+  grid_map::Index end;
+  if (
+    !grid_.isDefaultStartIndex() || !getIndexLimitedToMapRange(p1, p2, start) ||
+    !getIndexLimitedToMapRange(p2, p1, end)) {
+    // circular buffer or line out of the grid: let the line iterator handle it
+    return grid_utils::isCollisionFree(grid_, p1, p2);
+  }
+  if (
+    occupied_distance_.empty() ||
+    countCells(
+      occupied_sum_, std::min(start.x(), end.x()), std::max(start.x(), end.x()),
+      std::min(start.y(), end.y()), std::max(start.y(), end.y())) == 0) {
+    return true;
+  }
+
+  // cells of grid_map::LineIterator in closed form: the major axis moves every step and the minor
+  // axis moves when the accumulated numerator exceeds the denominator
+  const grid_map::Index delta = (end - start).abs();
+  const int step_x = end.x() >= start.x() ? 1 : -1;
+  const int step_y = end.y() >= start.y() ? 1 : -1;
+  const bool is_x_major = delta.x() >= delta.y();
+  const int denominator = is_x_major ? delta.x() : delta.y();
+  const int numerator_add = is_x_major ? delta.y() : delta.x();
+  const int numerator = denominator / 2;
+  const int num_cells = denominator + 1;
+  const auto get_cell = [&](const int i) {
+    const int minor = denominator == 0 ? 0 : (numerator + i * numerator_add) / denominator;
+    return is_x_major ? grid_map::Index(start.x() + i * step_x, start.y() + minor * step_y)
+                      : grid_map::Index(start.x() + minor * step_x, start.y() + i * step_y);
+  };
+  constexpr double margin = 1e-3;
+
+  int i = 0;
+  while (i < num_cells) {
+    const grid_map::Index cell = get_cell(i);
+    const float distance = occupied_distance_.at<float>(cell.x(), cell.y());
+    if (distance <= 0.0f) {
+      return false;
+    }
+    // skip the following cells which are closer than the nearest occupied cell. The major axis
+    // moves one cell per step, so at most floor(free_radius) steps stay within the radius.
+    const double free_radius = static_cast<double>(distance) - margin;
+    int num_skip =
+      std::min(num_cells - 1 - i, static_cast<int>(std::floor(std::max(0.0, free_radius))));
+    while (num_skip > 0 &&
+           (get_cell(i + num_skip) - cell).cast<double>().matrix().norm() >= free_radius) {
+      --num_skip;
+    }
+    i += num_skip + 1;
+  }
+  return true;
+}
+
+void findOcclusionSpots(
+  std::vector<grid_map::Position> & occlusion_spot_positions, const OcclusionSpotGrid & grid,
+  const lanelet::BasicPolygon2d & polygon, const double min_size)
+{
+  const grid_map::GridMap & grid_map = grid.getGrid();
+  const int min_occlusion_spot_size =
+    std::max(0.0, std::floor(min_size / grid_map.getResolution()));
+  grid_map::Polygon grid_polygon;
+  for (const auto & point : polygon) {
+    grid_polygon.addVertex({point.x(), point.y()});
+  }
+  std::vector<grid_map::Index> cells;
+  for (grid_map::PolygonIterator iterator(grid_map, grid_polygon); !iterator.isPastEnd();
+       ++iterator) {
+    cells.push_back(*iterator);
+  }
+  std::vector<OcclusionSpotSquare> squares(cells.size());
+  std::vector<char> is_occlusion_spot(cells.size(), false);
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+  for (int i = 0; i < static_cast<int>(cells.size()); ++i) {
+    is_occlusion_spot[i] =
+      grid.isOcclusionSpotSquare(squares[i], cells[i], min_occlusion_spot_size);
+  }
+  // keep the order of the polygon iterator
+  for (size_t i = 0; i < cells.size(); ++i) {
+    OcclusionSpotSquare & occlusion_spot_square = squares[i];
+    if (
+      !is_occlusion_spot[i] ||
+      !grid_map.getPosition(occlusion_spot_square.index, occlusion_spot_square.position)) {
+      continue;
+    }
+    std::vector<grid_map::Position> corner_positions;
+    getCornerPositions(corner_positions, grid_map, occlusion_spot_square);
+    for (const grid_map::Position & corner : corner_positions) {
+      occlusion_spot_positions.emplace_back(corner);
+    }
+  }
+}
+
 void getCornerPositions(
   std::vector<grid_map::Position> & corner_positions, const grid_map::GridMap & grid,
   const OcclusionSpotSquare & occlusion_spot_square)
@@ -423,16 +423,19 @@ void generatePossibleCollisions(
   if (path_lanelet.centerline2d().empty()) {
     return;
   }
+  // the tables of the grid are shared by all sidewalk slices
+  const grid_utils::OcclusionSpotGrid occlusion_spot_grid(grid);
   // generate sidewalk possible collision
   generateSidewalkPossibleCollisions(
-    possible_collisions, grid, offset_from_ego_to_closest, offset_from_closest_to_target,
-    path_lanelet, param, debug);
+    possible_collisions, occlusion_spot_grid, offset_from_ego_to_closest,
+    offset_from_closest_to_target, path_lanelet, param, debug);
   possible_collisions.insert(
     possible_collisions.end(), possible_collisions.begin(), possible_collisions.end());
 }
 
 void generateSidewalkPossibleCollisions(
-  std::vector<PossibleCollisionInfo> & possible_collisions, const grid_map::GridMap & grid,
+  std::vector<PossibleCollisionInfo> & possible_collisions,
+  const grid_utils::OcclusionSpotGrid & grid,
   const double offset_from_ego_to_closest, const double offset_from_closest_to_target,
   const lanelet::ConstLanelet & path_lanelet, const PlannerParam & param,
   std::vector<lanelet::BasicPolygon2d> & debug)
@@ -480,7 +483,8 @@ void generateSidewalkPossibleCollisions(
 }
 
 void generateSidewalkPossibleCollisionFromOcclusionSpot(
-  std::vector<PossibleCollisionInfo> & possible_collisions, const grid_map::GridMap & grid,
+  std::vector<PossibleCollisionInfo> & possible_collisions,
+  const grid_utils::OcclusionSpotGrid & grid,
   const std::vector<grid_map::Position> & occlusion_spot_positions,
   const double offset_form_ego_to_target, const lanelet::ConstLanelet & path_lanelet,
   const PlannerParam & param)
@@ -492,8 +496,7 @@ void generateSidewalkPossibleCollisionFromOcclusionSpot(
       lanelet::geometry::toArcCoordinates(path_lanelet.centerline2d(), obstacle_point);
     lanelet::BasicPoint2d intersection_point = lanelet::geometry::fromArcCoordinates(
       path_lanelet.centerline2d(), {arc_lane_point_at_occlusion.length, 0.0});
-    bool collision_free =
-      grid_utils::isCollisionFree(grid, occlusion_spot_position, intersection_point);
+    bool collision_free = grid.isCollisionFree(occlusion_spot_position, intersection_point);
     if (collision_free) {
       PossibleCollisionInfo pc;
       calculateCollisionPathPointFromOcclusionSpot(
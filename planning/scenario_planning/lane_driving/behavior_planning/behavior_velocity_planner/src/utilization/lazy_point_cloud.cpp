@@ -0,0 +1,43 @@
+// Copyright 2021 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <utilization/lazy_point_cloud.hpp>
+
+#include <pcl/common/transforms.h>
+#include <pcl_conversions/pcl_conversions.h>
+#include <tf2_eigen/tf2_eigen.h>
+
+namespace behavior_velocity_planner
+{
+LazyPointCloud::LazyPointCloud(
+  const sensor_msgs::msg::PointCloud2::ConstSharedPtr & msg,
+  const geometry_msgs::msg::Transform & transform)
+: msg_(msg), transform_(transform)
+{
+}
+
+pcl::PointCloud<pcl::PointXYZ>::ConstPtr LazyPointCloud::get() const
+{
+  std::call_once(once_flag_, [this]() {
+    pcl::PointCloud<pcl::PointXYZ> pc;
+    pcl::fromROSMsg(*msg_, pc);
+
+    const Eigen::Affine3f affine = tf2::transformToEigen(transform_).cast<float>();
+    pcl::PointCloud<pcl::PointXYZ>::Ptr pc_transformed(new pcl::PointCloud<pcl::PointXYZ>);
+    pcl::transformPointCloud(pc, *pc_transformed, affine);
+    transformed_ = pc_transformed;
+  });
+  return transformed_;
+}
+}  // namespace behavior_velocity_planner
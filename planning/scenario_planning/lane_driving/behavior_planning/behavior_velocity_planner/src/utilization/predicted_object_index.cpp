@@ -0,0 +1,234 @@
+// Copyright 2021 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <utilization/predicted_object_index.hpp>
+
+#include <boost/geometry/algorithms/envelope.hpp>
+#include <boost/geometry/algorithms/intersects.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace behavior_velocity_planner
+{
+namespace
+{
+// a segment covering more buckets than this is not bucketed but checked by every query
+constexpr double max_buckets_per_segment = 64.0;
+
+void sortUnique(std::vector<size_t> & ids)
+{
+  std::sort(ids.begin(), ids.end());
+  ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
+}
+}  // namespace
+
+PredictedObjectIndex::PredictedObjectIndex(
+  const autoware_auto_perception_msgs::msg::PredictedObjects::ConstSharedPtr & objects_ptr,
+  const double cell_size, const double time_slice)
+: objects_ptr_(objects_ptr), cell_size_(cell_size), time_slice_(time_slice)
+{
+  if (!objects_ptr_) {
+    return;
+  }
+
+  const auto & objects = objects_ptr_->objects;
+  for (size_t i = 0; i < objects.size(); ++i) {
+    const auto & predicted_paths = objects.at(i).kinematics.predicted_paths;
+    for (size_t j = 0; j < predicted_paths.size(); ++j) {
+      const auto & path = predicted_paths.at(j).path;
+      const double dt = rclcpp::Duration(predicted_paths.at(j).time_step).seconds();
+      for (size_t k = 0; k < path.size(); ++k) {
+        if (k + 1 == path.size() && k != 0) {
+          break;
+        }
+        const size_t k_next = std::min(k + 1, path.size() - 1);
+        segments_.push_back(
+          {i, j, k, dt * static_cast<double>(k), dt * static_cast<double>(k_next),
+           to_bg2d(path.at(k).position), to_bg2d(path.at(k_next).position)});
+      }
+    }
+  }
+
+  for (size_t id = 0; id < segments_.size(); ++id) {
+    const auto & segment = segments_.at(id);
+    const double x_min = std::min(segment.p0.x(), segment.p1.x());
+    const double x_max = std::max(segment.p0.x(), segment.p1.x());
+    const double y_min = std::min(segment.p0.y(), segment.p1.y());
+    const double y_max = std::max(segment.p0.y(), segment.p1.y());
+    const double num_buckets = countBuckets(
+      x_min, x_max, y_min, y_max, segment.start_time, segment.end_time);
+    // also catches non-finite values, which cannot be converted to cells
+    if (!(num_buckets <= max_buckets_per_segment)) {
+      large_segment_ids_.push_back(id);
+      continue;
+    }
+
+    const auto slice_min = toSlice(segment.start_time);
+    const auto slice_max = toSlice(segment.end_time);
+    if (buckets_.empty()) {
+      min_slice_ = slice_min;
+      max_slice_ = slice_max;
+    }
+    min_slice_ = std::min(min_slice_, slice_min);
+    max_slice_ = std::max(max_slice_, slice_max);
+
+    for (auto slice = slice_min; slice <= slice_max; ++slice) {
+      for (auto cy = toCell(y_min); cy <= toCell(y_max); ++cy) {
+        for (auto cx = toCell(x_min); cx <= toCell(x_max); ++cx) {
+          buckets_[toKey(cx, cy, slice)].push_back(id);
+        }
+      }
+    }
+  }
+}
+
+int64_t PredictedObjectIndex::toCell(const double v) const
+{
+  return static_cast<int64_t>(std::floor(v / cell_size_));
+}
+
+int64_t PredictedObjectIndex::toSlice(const double t) const
+{
+  return static_cast<int64_t>(std::floor(t / time_slice_));
+}
+
+double PredictedObjectIndex::countBuckets(
+  const double x_min, const double x_max, const double y_min, const double y_max,
+  const double t_min, const double t_max) const
+{
+  return (std::floor(x_max / cell_size_) - std::floor(x_min / cell_size_) + 1.0) *
+         (std::floor(y_max / cell_size_) - std::floor(y_min / cell_size_) + 1.0) *
+         (std::floor(t_max / time_slice_) - std::floor(t_min / time_slice_) + 1.0);
+}
+
+uint64_t PredictedObjectIndex::toKey(const int64_t cx, const int64_t cy, const int64_t slice)
+{
+  // 21 bits for each axis. Wrapped keys only add candidates, which are filtered afterwards.
+  constexpr uint64_t mask = (uint64_t{1} << 21) - 1;
+  return ((static_cast<uint64_t>(cx) & mask) << 42) | ((static_cast<uint64_t>(cy) & mask) << 21) |
+         (static_cast<uint64_t>(slice) & mask);
+}
+
+bool PredictedObjectIndex::isCandidate(
+  const Segment & segment, const Box2d & box, const double t0, const double t1) const
+{
+  if (segment.end_time < t0 || t1 < segment.start_time) {
+    return false;
+  }
+  return std::max(segment.p0.x(), segment.p1.x()) >= box.min_corner().x() &&
+         std::min(segment.p0.x(), segment.p1.x()) <= box.max_corner().x() &&
+         std::max(segment.p0.y(), segment.p1.y()) >= box.min_corner().y() &&
+         std::min(segment.p0.y(), segment.p1.y()) <= box.max_corner().y();
+}
+
+std::vector<size_t> PredictedObjectIndex::querySegmentCandidates(
+  const Box2d & box, const double t0, const double t1) const
+{
+  std::vector<size_t> ids;
+  if (segments_.empty() || t1 < t0) {
+    return ids;
+  }
+
+  const auto add_large_segments = [&]() {
+    for (const auto id : large_segment_ids_) {
+      if (isCandidate(segments_.at(id), box, t0, t1)) {
+        ids.push_back(id);
+      }
+    }
+    sortUnique(ids);
+  };
+
+  // clamp the time range to the bucketed slices, which also handles infinite times
+  const double bucket_t_min = static_cast<double>(min_slice_) * time_slice_;
+  const double bucket_t_max = static_cast<double>(max_slice_ + 1) * time_slice_;
+  if (buckets_.empty() || t1 < bucket_t_min || bucket_t_max < t0) {
+    add_large_segments();
+    return ids;
+  }
+  const double t_min = std::max(t0, bucket_t_min);
+  const double t_max = std::min(t1, bucket_t_max);
+
+  const double num_buckets = countBuckets(
+    box.min_corner().x(), box.max_corner().x(), box.min_corner().y(), box.max_corner().y(), t_min,
+    t_max);
+  if (!(num_buckets <= static_cast<double>(segments_.size()))) {
+    // visiting the buckets costs more than checking every segment
+    for (size_t id = 0; id < segments_.size(); ++id) {
+      if (isCandidate(segments_.at(id), box, t0, t1)) {
+        ids.push_back(id);
+      }
+    }
+    return ids;
+  }
+
+  const auto slice_min = std::max(toSlice(t_min), min_slice_);
+  const auto slice_max = std::min(toSlice(t_max), max_slice_);
+  const auto cx_min = toCell(box.min_corner().x());
+  const auto cx_max = toCell(box.max_corner().x());
+  const auto cy_min = toCell(box.min_corner().y());
+  const auto cy_max = toCell(box.max_corner().y());
+  for (auto slice = slice_min; slice <= slice_max; ++slice) {
+    for (auto cy = cy_min; cy <= cy_max; ++cy) {
+      for (auto cx = cx_min; cx <= cx_max; ++cx) {
+        const auto itr = buckets_.find(toKey(cx, cy, slice));
+        if (itr == buckets_.end()) {
+          continue;
+        }
+        for (const auto id : itr->second) {
+          if (isCandidate(segments_.at(id), box, t0, t1)) {
+            ids.push_back(id);
+          }
+        }
+      }
+    }
+  }
+  add_large_segments();
+  return ids;
+}
+
+std::vector<size_t> PredictedObjectIndex::querySegments(
+  const Polygon2d & polygon, const double t0, const double t1) const
+{
+  Box2d box;
+  boost::geometry::envelope(polygon, box);
+
+  std::vector<size_t> ids;
+  for (const auto id : querySegmentCandidates(box, t0, t1)) {
+    const auto & segment = segments_.at(id);
+    if (boost::geometry::intersects(polygon, LineString2d{segment.p0, segment.p1})) {
+      ids.push_back(id);
+    }
+  }
+  return ids;
+}
+
+std::vector<size_t> PredictedObjectIndex::queryObjects(
+  const Polygon2d & polygon, const double t0, const double t1) const
+{
+  std::vector<size_t> object_indices;
+  for (const auto id : querySegments(polygon, t0, t1)) {
+    object_indices.push_back(segments_.at(id).object_index);
+  }
+  sortUnique(object_indices);
+  return object_indices;
+}
+
+double PredictedObjectIndex::toIndexTime(const rclcpp::Time & time) const
+{
+  return (time - rclcpp::Time(objects_ptr_->header.stamp)).seconds();
+}
+
+}  // namespace behavior_velocity_planner
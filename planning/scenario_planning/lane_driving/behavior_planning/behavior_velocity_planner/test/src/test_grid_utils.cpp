@@ -18,7 +18,9 @@
 
 #include <gtest/gtest.h>
 
+#include <random>
 #include <unordered_set>
+#include <vector>
 
 struct indexHash
 {
@@ -207,6 +209,67 @@ TEST(isOcclusionSpotSquare, many_cells_occlusion_spot)
   }
 }
 
+TEST(OcclusionSpotGrid, same_as_grid_functions)
+{
+  using behavior_velocity_planner::grid_utils::findOcclusionSpots;
+  using behavior_velocity_planner::grid_utils::isCollisionFree;
+  using behavior_velocity_planner::grid_utils::isOcclusionSpotSquare;
+  using behavior_velocity_planner::grid_utils::OcclusionSpotGrid;
+  using behavior_velocity_planner::grid_utils::OcclusionSpotSquare;
+  using behavior_velocity_planner::grid_utils::occlusion_cost_value::OCCUPIED;
+  using behavior_velocity_planner::grid_utils::occlusion_cost_value::UNKNOWN;
+
+  std::mt19937 engine(0);
+  std::uniform_real_distribution<double> ratio(0.0, 1.0);
+  std::uniform_real_distribution<double> position(-5.0, 35.0);
+  // unknown blobs with a few occupied cells
+  grid_map::GridMap grid = test::generateGrid(60, 60, 0.5);
+  for (int i = 0; i < 60; ++i) {
+    for (int j = 0; j < 60; ++j) {
+      const double r = ratio(engine);
+      if (((i / 7) + (j / 5)) % 2 == 0 && r < 0.97) {
+        grid.at("layer", grid_map::Index(i, j)) = UNKNOWN;
+      } else if (r < 0.05) {
+        grid.at("layer", grid_map::Index(i, j)) = OCCUPIED;
+      }
+    }
+  }
+
+  const OcclusionSpotGrid occlusion_spot_grid(grid);
+  for (int side_size = 0; side_size <= 4; ++side_size) {
+    for (int i = 0; i < 60; ++i) {
+      for (int j = 0; j < 60; ++j) {
+        OcclusionSpotSquare expected;
+        OcclusionSpotSquare actual;
+        ASSERT_EQ(
+          occlusion_spot_grid.isOcclusionSpotSquare(actual, {i, j}, side_size),
+          isOcclusionSpotSquare(expected, grid["layer"], {i, j}, side_size, grid.getSize()));
+      }
+    }
+  }
+
+  lanelet::BasicPolygon2d polygon;
+  polygon.emplace_back(2.0, 3.0);
+  polygon.emplace_back(25.0, 1.0);
+  polygon.emplace_back(28.0, 20.0);
+  polygon.emplace_back(5.0, 27.0);
+  std::vector<grid_map::Position> expected_positions;
+  std::vector<grid_map::Position> actual_positions;
+  findOcclusionSpots(expected_positions, grid, polygon, 1.0);
+  findOcclusionSpots(actual_positions, occlusion_spot_grid, polygon, 1.0);
+  ASSERT_EQ(actual_positions.size(), expected_positions.size());
+  for (size_t i = 0; i < actual_positions.size(); ++i) {
+    EXPECT_EQ(actual_positions[i], expected_positions[i]);
+  }
+
+  // rays inside and partially outside the grid
+  for (int i = 0; i < 1000; ++i) {
+    const grid_map::Position p1(position(engine), position(engine));
+    const grid_map::Position p2(position(engine), position(engine));
+    ASSERT_EQ(occlusion_spot_grid.isCollisionFree(p1, p2), isCollisionFree(grid, p1, p2));
+  }
+}
+
 TEST(buildSlices, test_buffer_offset)
 {
   using behavior_velocity_planner::geometry::buildSlices;
@@ -0,0 +1,146 @@
+// Copyright 2021 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <utilization/predicted_object_index.hpp>
+
+#include <gtest/gtest.h>
+
+#include <limits>
+#include <memory>
+#include <random>
+#include <utility>
+#include <vector>
+
+namespace
+{
+using autoware_auto_perception_msgs::msg::PredictedObject;
+using autoware_auto_perception_msgs::msg::PredictedObjects;
+using autoware_auto_perception_msgs::msg::PredictedPath;
+using behavior_velocity_planner::LineString2d;
+using behavior_velocity_planner::Polygon2d;
+using behavior_velocity_planner::PredictedObjectIndex;
+
+// straight predicted path from (x, y) with the velocity (vx, vy) and 0.5 s time step
+PredictedPath generateStraightPath(
+  const double x, const double y, const double vx, const double vy, const size_t num_points)
+{
+  PredictedPath path;
+  path.time_step.sec = 0;
+  path.time_step.nanosec = 500000000;
+  for (size_t i = 0; i < num_points; ++i) {
+    geometry_msgs::msg::Pose pose;
+    pose.position.x = x + vx * 0.5 * static_cast<double>(i);
+    pose.position.y = y + vy * 0.5 * static_cast<double>(i);
+    path.path.push_back(pose);
+  }
+  return path;
+}
+
+Polygon2d generateBox(
+  const double x_min, const double y_min, const double x_max, const double y_max)
+{
+  Polygon2d polygon;
+  polygon.outer() = {{x_min, y_min}, {x_max, y_min}, {x_max, y_max}, {x_min, y_max}};
+  return polygon;
+}
+}  // namespace
+
+TEST(predicted_object_index, segments)
+{
+  auto objects = std::make_shared<PredictedObjects>();
+  PredictedObject object;
+  object.kinematics.predicted_paths.push_back(generateStraightPath(0.0, 0.0, 1.0, 0.0, 5));
+  object.kinematics.predicted_paths.push_back(generateStraightPath(0.0, 0.0, 0.0, 1.0, 1));
+  objects->objects.push_back(object);
+
+  const PredictedObjectIndex index(objects);
+  // 4 segments of the first path and 1 degenerate segment of the single pose path
+  ASSERT_EQ(index.getNumSegments(), size_t{5});
+  const auto & segment = index.getSegment(2);
+  EXPECT_EQ(segment.path_index, size_t{0});
+  EXPECT_EQ(segment.segment_index, size_t{2});
+  EXPECT_DOUBLE_EQ(segment.start_time, 1.0);
+  EXPECT_DOUBLE_EQ(segment.end_time, 1.5);
+  EXPECT_DOUBLE_EQ(segment.p0.x(), 1.0);
+  EXPECT_DOUBLE_EQ(segment.p1.x(), 1.5);
+  const auto & degenerate_segment = index.getSegment(4);
+  EXPECT_EQ(degenerate_segment.path_index, size_t{1});
+  EXPECT_DOUBLE_EQ(degenerate_segment.start_time, degenerate_segment.end_time);
+}
+
+TEST(predicted_object_index, query_time_range)
+{
+  auto objects = std::make_shared<PredictedObjects>();
+  PredictedObject object;
+  // passes x = 10 at t = 1.0 [s]
+  object.kinematics.predicted_paths.push_back(generateStraightPath(0.0, 0.0, 10.0, 0.0, 11));
+  objects->objects.push_back(object);
+  // passes x = 10 at t = 4.0 [s]
+  object.kinematics.predicted_paths.front() = generateStraightPath(-30.0, 0.0, 10.0, 0.0, 11);
+  objects->objects.push_back(object);
+
+  const PredictedObjectIndex index(objects);
+  const auto polygon = generateBox(9.5, -1.0, 10.5, 1.0);
+  const auto inf = std::numeric_limits<double>::infinity();
+  EXPECT_EQ(index.queryObjects(polygon, -inf, inf), (std::vector<size_t>{0, 1}));
+  EXPECT_EQ(index.queryObjects(polygon, 0.0, 2.0), (std::vector<size_t>{0}));
+  EXPECT_EQ(index.queryObjects(polygon, 3.0, 5.0), (std::vector<size_t>{1}));
+  EXPECT_TRUE(index.queryObjects(polygon, 6.0, inf).empty());
+  EXPECT_TRUE(index.queryObjects(generateBox(100.0, 100.0, 101.0, 101.0), -inf, inf).empty());
+}
+
+TEST(predicted_object_index, same_as_brute_force)
+{
+  std::mt19937 engine(0);
+  std::uniform_real_distribution<double> position(-100.0, 100.0);
+  std::uniform_real_distribution<double> velocity(-15.0, 15.0);
+  std::uniform_real_distribution<double> size(0.1, 30.0);
+  std::uniform_real_distribution<double> time(-1.0, 12.0);
+
+  auto objects = std::make_shared<PredictedObjects>();
+  for (size_t i = 0; i < 50; ++i) {
+    PredictedObject object;
+    for (size_t j = 0; j < 3; ++j) {
+      object.kinematics.predicted_paths.push_back(generateStraightPath(
+        position(engine), position(engine), velocity(engine), velocity(engine), engine() % 20));
+    }
+    objects->objects.push_back(object);
+  }
+  // a long jump which is not bucketed
+  objects->objects.front().kinematics.predicted_paths.front() =
+    generateStraightPath(-500.0, -500.0, 2000.0, 2000.0, 2);
+
+  const PredictedObjectIndex index(objects);
+  for (size_t i = 0; i < 200; ++i) {
+    const double x = position(engine);
+    const double y = position(engine);
+    const auto polygon = generateBox(x, y, x + size(engine), y + size(engine));
+    double t0 = time(engine);
+    double t1 = time(engine);
+    if (t1 < t0) {
+      std::swap(t0, t1);
+    }
+
+    std::vector<size_t> expected;
+    for (size_t id = 0; id < index.getNumSegments(); ++id) {
+      const auto & segment = index.getSegment(id);
+      if (
+        t0 <= segment.end_time && segment.start_time <= t1 &&
+        boost::geometry::intersects(polygon, LineString2d{segment.p0, segment.p1})) {
+        expected.push_back(id);
+      }
+    }
+    EXPECT_EQ(index.querySegments(polygon, t0, t1), expected);
+  }
+}
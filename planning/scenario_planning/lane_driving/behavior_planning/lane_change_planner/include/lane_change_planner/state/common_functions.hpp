@@ -16,6 +16,7 @@
 #define LANE_CHANGE_PLANNER__STATE__COMMON_FUNCTIONS_HPP_
 
 #include "lane_change_planner/state/state_base_class.hpp"
+#include "lane_change_planner/utilities.hpp"
 
 #include <autoware_perception_msgs/msg/dynamic_object_array.hpp>
 #include <geometry_msgs/msg/pose_stamped.hpp>
@@ -24,6 +25,7 @@
 #include <lanelet2_core/primitives/Primitive.h>
 
 #include <memory>
+#include <unordered_map>
 #include <vector>
 
 namespace lane_change_planner
@@ -32,6 +34,32 @@ namespace state_machine
 {
 namespace common_functions
 {
+/**
+ * @brief Sample times of the collision check and the predicted paths of the objects sampled at
+ *        them. The objects are sampled on first use, and shared by all the lane change paths
+ *        checked against the same objects in a cycle.
+ */
+class PredictedPathSamples
+{
+public:
+  PredictedPathSamples(
+    const autoware_perception_msgs::msg::DynamicObjectArray::ConstSharedPtr & dynamic_objects,
+    const LaneChangerParameters & ros_parameters, const rclcpp::Clock::SharedPtr & clock);
+
+  // samples the ego path at the same times as the objects
+  util::TimeSampledPath sample(const autoware_perception_msgs::msg::PredictedPath & path) const;
+
+  // sampled predicted paths of the object, in the same order as its predicted_paths
+  const std::vector<util::TimeSampledPath> & getObjectPaths(const size_t object_index);
+
+private:
+  autoware_perception_msgs::msg::DynamicObjectArray::ConstSharedPtr dynamic_objects_;
+  rclcpp::Time start_time_;
+  double time_step_;
+  size_t num_samples_;
+  std::unordered_map<size_t, std::vector<util::TimeSampledPath>> object_paths_;
+};
+
 std::vector<LaneChangePath> selectValidPaths(
   const std::vector<LaneChangePath> & paths, const lanelet::ConstLanelets & current_lanes,
   const lanelet::ConstLanelets & target_lanes,
@@ -52,6 +80,14 @@ bool isLaneChangePathSafe(
   const geometry_msgs::msg::Pose & current_pose, const geometry_msgs::msg::Twist & current_twist,
   const LaneChangerParameters & ros_parameters, const bool use_buffer, const double acceleration,
   const rclcpp::Logger & logger, const rclcpp::Clock::SharedPtr & clock);
+bool isLaneChangePathSafe(
+  const autoware_planning_msgs::msg::PathWithLaneId & path,
+  const lanelet::ConstLanelets & current_lanes, const lanelet::ConstLanelets & target_lanes,
+  const autoware_perception_msgs::msg::DynamicObjectArray::ConstSharedPtr & dynamic_objects,
+  const geometry_msgs::msg::Pose & current_pose, const geometry_msgs::msg::Twist & current_twist,
+  const LaneChangerParameters & ros_parameters, const bool use_buffer, const double acceleration,
+  PredictedPathSamples * object_path_samples, const rclcpp::Logger & logger,
+  const rclcpp::Clock::SharedPtr & clock);
 bool hasEnoughDistance(
   const LaneChangePath & path, const lanelet::ConstLanelets & current_lanes,
   const lanelet::ConstLanelets & target_lanes, const geometry_msgs::msg::Pose & current_pose,
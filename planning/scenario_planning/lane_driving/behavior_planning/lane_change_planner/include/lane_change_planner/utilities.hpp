@@ -56,6 +56,20 @@ struct FrenetCoordinate3d
   FrenetCoordinate3d() : length(0), distance(0) {}
 };
 
+/**
+ * @brief positions of a predicted path at fixed time steps. The k-th sample is at
+ *        start_time + k * time_step, so paths sampled with the same times have aligned arrays.
+ */
+struct TimeSampledPath
+{
+  std::vector<double> x;
+  std::vector<double> y;
+  std::vector<double> z;
+  // samples in [valid_begin, valid_end) are within the time range of the predicted path
+  size_t valid_begin = 0;
+  size_t valid_end = 0;
+};
+
 double normalizeRadian(const double radian);
 double l2Norm(const geometry_msgs::msg::Vector3 vector);
 
@@ -89,17 +103,18 @@ bool lerpByTimeStamp(
   const rclcpp::Clock::SharedPtr & clock);
 
 double getDistance3d(const geometry_msgs::msg::Point & p1, const geometry_msgs::msg::Point & p2);
+size_t getNumTimeSamples(
+  const rclcpp::Time & start_time, const rclcpp::Time & end_time, const double time_step);
+TimeSampledPath sampleByTime(
+  const autoware_perception_msgs::msg::PredictedPath & path, const rclcpp::Time & start_time,
+  const double time_step, const size_t num_samples);
+
 double getDistanceBetweenPredictedPaths(
-  const autoware_perception_msgs::msg::PredictedPath & path1,
-  const autoware_perception_msgs::msg::PredictedPath & path2, const double start_time,
-  const double end_time, const double resolution, const rclcpp::Logger & logger,
-  const rclcpp::Clock::SharedPtr & clock);
+  const TimeSampledPath & path1, const TimeSampledPath & path2);
 
 double getDistanceBetweenPredictedPathAndObject(
-  const autoware_perception_msgs::msg::DynamicObject & object,
-  const autoware_perception_msgs::msg::PredictedPath & path, const double start_time,
-  const double end_time, const double resolution, const rclcpp::Logger & logger,
-  const rclcpp::Clock::SharedPtr & clock);
+  const autoware_perception_msgs::msg::DynamicObject & object, const TimeSampledPath & path,
+  const rclcpp::Logger & logger);
 
 std::vector<size_t> filterObjectsByLanelets(
   const autoware_perception_msgs::msg::DynamicObjectArray & objects,
@@ -19,6 +19,7 @@
 #include <lanelet2_extension/utility/utilities.hpp>
 
 #include <algorithm>
+#include <utility>
 #include <vector>
 
 namespace lane_change_planner
@@ -27,6 +28,47 @@ namespace state_machine
 {
 namespace common_functions
 {
+PredictedPathSamples::PredictedPathSamples(
+  const autoware_perception_msgs::msg::DynamicObjectArray::ConstSharedPtr & dynamic_objects,
+  const LaneChangerParameters & ros_parameters, const rclcpp::Clock::SharedPtr & clock)
+: dynamic_objects_(dynamic_objects), time_step_(ros_parameters.prediction_time_resolution)
+{
+  // objects in the current lanes and in the target lanes are checked in the same time range
+  const double check_start_time = ros_parameters.enable_collision_check_at_prepare_phase
+                                    ? 0.0
+                                    : ros_parameters.lane_change_prepare_duration;
+  const double check_end_time =
+    ros_parameters.lane_change_prepare_duration + ros_parameters.lane_changing_duration;
+
+  const rclcpp::Time now = clock->now();
+  start_time_ = now + rclcpp::Duration::from_seconds(check_start_time);
+  num_samples_ = util::getNumTimeSamples(
+    start_time_, now + rclcpp::Duration::from_seconds(check_end_time), time_step_);
+}
+
+util::TimeSampledPath PredictedPathSamples::sample(
+  const autoware_perception_msgs::msg::PredictedPath & path) const
+{
+  return util::sampleByTime(path, start_time_, time_step_, num_samples_);
+}
+
+const std::vector<util::TimeSampledPath> & PredictedPathSamples::getObjectPaths(
+  const size_t object_index)
+{
+  const auto itr = object_paths_.find(object_index);
+  if (itr != object_paths_.end()) {
+    return itr->second;
+  }
+
+  std::vector<util::TimeSampledPath> sampled_paths;
+  const auto & predicted_paths = dynamic_objects_->objects.at(object_index).state.predicted_paths;
+  sampled_paths.reserve(predicted_paths.size());
+  for (const auto & predicted_path : predicted_paths) {
+    sampled_paths.push_back(sample(predicted_path));
+  }
+  return object_paths_.emplace(object_index, std::move(sampled_paths)).first->second;
+}
+
 std::vector<LaneChangePath> selectValidPaths(
   const std::vector<LaneChangePath> & paths, const lanelet::ConstLanelets & current_lanes,
   const lanelet::ConstLanelets & target_lanes,
@@ -55,10 +97,12 @@ bool selectSafePath(
   const LaneChangerParameters & ros_parameters, LaneChangePath * selected_path,
   const rclcpp::Logger & logger, const rclcpp::Clock::SharedPtr & clock)
 {
+  // the predicted paths of the objects are sampled once for all the candidates
+  PredictedPathSamples object_path_samples(dynamic_objects, ros_parameters, clock);
   for (const auto & path : paths) {
     if (isLaneChangePathSafe(
           path.path, current_lanes, target_lanes, dynamic_objects, current_pose, current_twist,
-          ros_parameters, true, path.acceleration, logger, clock)) {
+          ros_parameters, true, path.acceleration, &object_path_samples, logger, clock)) {
       *selected_path = path;
       return true;
     }
@@ -114,6 +158,21 @@ bool isLaneChangePathSafe(
   const geometry_msgs::msg::Pose & current_pose, const geometry_msgs::msg::Twist & current_twist,
   const LaneChangerParameters & ros_parameters, const bool use_buffer, const double acceleration,
   const rclcpp::Logger & logger, const rclcpp::Clock::SharedPtr & clock)
+{
+  PredictedPathSamples object_path_samples(dynamic_objects, ros_parameters, clock);
+  return isLaneChangePathSafe(
+    path, current_lanes, target_lanes, dynamic_objects, current_pose, current_twist,
+    ros_parameters, use_buffer, acceleration, &object_path_samples, logger, clock);
+}
+
+bool isLaneChangePathSafe(
+  const autoware_planning_msgs::msg::PathWithLaneId & path,
+  const lanelet::ConstLanelets & current_lanes, const lanelet::ConstLanelets & target_lanes,
+  const autoware_perception_msgs::msg::DynamicObjectArray::ConstSharedPtr & dynamic_objects,
+  const geometry_msgs::msg::Pose & current_pose, const geometry_msgs::msg::Twist & current_twist,
+  const LaneChangerParameters & ros_parameters, const bool use_buffer, const double acceleration,
+  PredictedPathSamples * object_path_samples, const rclcpp::Logger & logger,
+  const rclcpp::Clock::SharedPtr & clock)
 {
   if (path.points.empty()) {
     return false;
@@ -141,16 +200,8 @@ bool isLaneChangePathSafe(
     buffer = 0.0;
     lateral_buffer = 0.0;
   }
-  double current_lane_check_start_time = 0.0;
-  const double current_lane_check_end_time =
-    ros_parameters.lane_change_prepare_duration + ros_parameters.lane_changing_duration;
-  double target_lane_check_start_time = 0.0;
-  const double target_lane_check_end_time =
+  const double check_end_time =
     ros_parameters.lane_change_prepare_duration + ros_parameters.lane_changing_duration;
-  if (!ros_parameters.enable_collision_check_at_prepare_phase) {
-    current_lane_check_start_time = ros_parameters.lane_change_prepare_duration;
-    target_lane_check_start_time = ros_parameters.lane_change_prepare_duration;
-  }
 
   // find obstacle in lane change target lanes
   // retrieve lanes that are merging target lanes as well
@@ -165,27 +216,35 @@ bool isLaneChangePathSafe(
     logger);
 
   const auto & vehicle_predicted_path = util::convertToPredictedPath(
-    path, current_twist, current_pose, target_lane_check_end_time, time_resolution, acceleration,
-    logger, clock);
+    path, current_twist, current_pose, check_end_time, time_resolution, acceleration, logger,
+    clock);
+  // sampled at the same times as the objects, so the distances are taken index by index
+  const auto vehicle_path_samples = object_path_samples->sample(vehicle_predicted_path);
+
+  // returns the sampled predicted paths of the object to be checked
+  const auto get_checked_paths = [&](const size_t object_index) {
+    const auto & obj = dynamic_objects->objects.at(object_index);
+    const auto & sampled_paths = object_path_samples->getObjectPaths(object_index);
+    std::vector<const util::TimeSampledPath *> checked_paths;
+    if (ros_parameters.use_all_predicted_path) {
+      for (const auto & sampled_path : sampled_paths) {
+        checked_paths.push_back(&sampled_path);
+      }
+    } else if (!obj.state.predicted_paths.empty()) {
+      const auto & predicted_paths = obj.state.predicted_paths;
+      const auto max_confidence_itr = std::max_element(
+        predicted_paths.begin(), predicted_paths.end(),
+        [](const auto & path1, const auto & path2) { return path1.confidence > path2.confidence; });
+      checked_paths.push_back(&sampled_paths.at(max_confidence_itr - predicted_paths.begin()));
+    }
+    return checked_paths;
+  };
 
   // Collision check for objects in current lane
   for (const auto & i : current_lane_object_indices) {
     const auto & obj = dynamic_objects->objects.at(i);
-    std::vector<autoware_perception_msgs::msg::PredictedPath> predicted_paths;
-    if (ros_parameters.use_all_predicted_path) {
-      predicted_paths = obj.state.predicted_paths;
-    } else {
-      auto & max_confidence_path = *(std::max_element(
-        obj.state.predicted_paths.begin(), obj.state.predicted_paths.end(),
-        [](const auto & path1, const auto & path2) {
-          return path1.confidence > path2.confidence;
-        }));
-      predicted_paths.push_back(max_confidence_path);
-    }
-    for (const auto & obj_path : predicted_paths) {
-      double distance = util::getDistanceBetweenPredictedPaths(
-        obj_path, vehicle_predicted_path, current_lane_check_start_time,
-        current_lane_check_end_time, time_resolution, logger, clock);
+    for (const auto * obj_path : get_checked_paths(i)) {
+      double distance = util::getDistanceBetweenPredictedPaths(*obj_path, vehicle_path_samples);
       double thresh;
       if (isObjectFront(current_pose, obj.state.pose_covariance.pose)) {
         thresh = util::l2Norm(current_twist.linear) * stop_time;
@@ -203,17 +262,6 @@ bool isLaneChangePathSafe(
   // Collision check for objects in lane change target lane
   for (const auto & i : target_lane_object_indices) {
     const auto & obj = dynamic_objects->objects.at(i);
-    std::vector<autoware_perception_msgs::msg::PredictedPath> predicted_paths;
-    if (ros_parameters.use_all_predicted_path) {
-      predicted_paths = obj.state.predicted_paths;
-    } else {
-      auto & max_confidence_path = *(std::max_element(
-        obj.state.predicted_paths.begin(), obj.state.predicted_paths.end(),
-        [](const auto & path1, const auto & path2) {
-          return path1.confidence > path2.confidence;
-        }));
-      predicted_paths.push_back(max_confidence_path);
-    }
 
     bool is_object_in_target = false;
     if (ros_parameters.use_predicted_path_outside_lanelet) {
@@ -227,10 +275,9 @@ bool isLaneChangePathSafe(
     }
 
     if (is_object_in_target) {
-      for (const auto & obj_path : predicted_paths) {
-        const double distance = util::getDistanceBetweenPredictedPaths(
-          obj_path, vehicle_predicted_path, target_lane_check_start_time,
-          target_lane_check_end_time, time_resolution, logger, clock);
+      for (const auto * obj_path : get_checked_paths(i)) {
+        const double distance =
+          util::getDistanceBetweenPredictedPaths(*obj_path, vehicle_path_samples);
         double thresh;
         if (isObjectFront(current_pose, obj.state.pose_covariance.pose)) {
           thresh = util::l2Norm(current_twist.linear) * stop_time;
@@ -244,9 +291,8 @@ bool isLaneChangePathSafe(
         }
       }
     } else {
-      const double distance = util::getDistanceBetweenPredictedPathAndObject(
-        obj, vehicle_predicted_path, target_lane_check_start_time, target_lane_check_end_time,
-        time_resolution, logger, clock);
+      const double distance =
+        util::getDistanceBetweenPredictedPathAndObject(obj, vehicle_path_samples, logger);
       double thresh = min_thresh;
       if (isObjectFront(current_pose, obj.state.pose_covariance.pose)) {
         thresh = std::max(thresh, util::l2Norm(current_twist.linear) * stop_time);
@@ -424,54 +424,108 @@ double getDistance3d(const geometry_msgs::msg::Point & p1, const geometry_msgs::
   return std::sqrt(std::pow(p1.x - p2.x, 2) + std::pow(p1.y - p2.y, 2) + std::pow(p1.z - p2.z, 2));
 }
 
-double getDistanceBetweenPredictedPaths(
-  const PredictedPath & object_path, const PredictedPath & ego_path, const double start_time,
-  const double end_time, const double resolution, const rclcpp::Logger & logger,
-  const rclcpp::Clock::SharedPtr & clock)
+size_t getNumTimeSamples(
+  const rclcpp::Time & start_time, const rclcpp::Time & end_time, const double time_step)
 {
-  rclcpp::Duration t_delta = rclcpp::Duration::from_seconds(resolution);
-  double min_distance = std::numeric_limits<double>::max();
-  rclcpp::Time ros_start_time = clock->now() + rclcpp::Duration::from_seconds(start_time);
-  rclcpp::Time ros_end_time = clock->now() + rclcpp::Duration::from_seconds(end_time);
-  const auto ego_path_point_array = convertToGeometryPointArray(ego_path);
-  for (auto t = ros_start_time; t < ros_end_time; t += t_delta) {
-    geometry_msgs::msg::Pose object_pose, ego_pose;
-    if (!lerpByTimeStamp(object_path, t, &object_pose, logger, clock)) {
-      continue;
+  // same number of steps as `for (t = start_time; t < end_time; t += time_step)`
+  const int64_t t_delta = rclcpp::Duration::from_seconds(time_step).nanoseconds();
+  const int64_t duration = end_time.nanoseconds() - start_time.nanoseconds();
+  if (t_delta <= 0 || duration <= 0) {
+    return 0;
+  }
+  return static_cast<size_t>((duration + t_delta - 1) / t_delta);
+}
+
+TimeSampledPath sampleByTime(
+  const PredictedPath & path, const rclcpp::Time & start_time, const double time_step,
+  const size_t num_samples)
+{
+  TimeSampledPath sampled_path;
+  sampled_path.x.resize(num_samples);
+  sampled_path.y.resize(num_samples);
+  sampled_path.z.resize(num_samples);
+  if (path.path.empty()) {
+    return sampled_path;
+  }
+
+  // the sample times only increase, so the segment containing them is searched forward once
+  const int64_t t_start = start_time.nanoseconds();
+  const int64_t t_delta = rclcpp::Duration::from_seconds(time_step).nanoseconds();
+  const auto stamp = [&path](const size_t i) {
+    return rclcpp::Time(path.path.at(i).header.stamp).nanoseconds();
+  };
+  const int64_t path_start_time = stamp(0);
+  const int64_t path_end_time = stamp(path.path.size() - 1);
+
+  const auto sample_time = [&](const size_t k) {
+    return t_start + static_cast<int64_t>(k) * t_delta;
+  };
+
+  size_t k = 0;
+  while (k < num_samples && sample_time(k) < path_start_time) {
+    ++k;
+  }
+  sampled_path.valid_begin = k;
+
+  size_t i = 0;  // end of the segment
+  for (; k < num_samples; ++k) {
+    const int64_t t = sample_time(k);
+    if (t > path_end_time) {
+      break;
     }
-    if (!lerpByTimeStamp(ego_path, t, &ego_pose, logger, clock)) {
-      continue;
+    while (stamp(i) < t) {
+      ++i;
     }
-    double distance = getDistance3d(object_pose.position, ego_pose.position);
-    if (distance < min_distance) {
-      min_distance = distance;
+    const auto & p = path.path.at(i).pose.pose.position;
+    if (i == 0 || stamp(i) == stamp(i - 1)) {
+      sampled_path.x[k] = p.x;
+      sampled_path.y[k] = p.y;
+      sampled_path.z[k] = p.z;
+      continue;
     }
+    const auto & prev_p = path.path.at(i - 1).pose.pose.position;
+    const double ratio =
+      static_cast<double>(t - stamp(i - 1)) / static_cast<double>(stamp(i) - stamp(i - 1));
+    sampled_path.x[k] = prev_p.x + (p.x - prev_p.x) * ratio;
+    sampled_path.y[k] = prev_p.y + (p.y - prev_p.y) * ratio;
+    sampled_path.z[k] = prev_p.z + (p.z - prev_p.z) * ratio;
   }
-  return min_distance;
+  sampled_path.valid_end = k;
+
+  return sampled_path;
+}
+
+double getDistanceBetweenPredictedPaths(
+  const TimeSampledPath & path1, const TimeSampledPath & path2)
+{
+  const size_t begin = std::max(path1.valid_begin, path2.valid_begin);
+  const size_t end = std::min(path1.valid_end, path2.valid_end);
+  if (begin >= end) {
+    return std::numeric_limits<double>::max();
+  }
+
+  double min_squared_distance = std::numeric_limits<double>::max();
+  for (size_t k = begin; k < end; ++k) {
+    const double dx = path1.x[k] - path2.x[k];
+    const double dy = path1.y[k] - path2.y[k];
+    const double dz = path1.z[k] - path2.z[k];
+    min_squared_distance = std::min(min_squared_distance, dx * dx + dy * dy + dz * dz);
+  }
+  return std::sqrt(min_squared_distance);
 }
 
 double getDistanceBetweenPredictedPathAndObject(
-  const autoware_perception_msgs::msg::DynamicObject & object, const PredictedPath & ego_path,
-  const double start_time, const double end_time, const double resolution,
-  const rclcpp::Logger & logger, const rclcpp::Clock::SharedPtr & clock)
+  const autoware_perception_msgs::msg::DynamicObject & object, const TimeSampledPath & path,
+  const rclcpp::Logger & logger)
 {
-  rclcpp::Duration t_delta = rclcpp::Duration::from_seconds(resolution);
   double min_distance = std::numeric_limits<double>::max();
-  rclcpp::Time ros_start_time = clock->now() + rclcpp::Duration::from_seconds(start_time);
-  rclcpp::Time ros_end_time = clock->now() + rclcpp::Duration::from_seconds(end_time);
-  const auto ego_path_point_array = convertToGeometryPointArray(ego_path);
   Polygon obj_polygon;
   if (!calcObjectPolygon(object, &obj_polygon, logger)) {
     return min_distance;
   }
-  for (auto t = ros_start_time; t < ros_end_time; t += t_delta) {
-    geometry_msgs::msg::Pose ego_pose;
-    if (!lerpByTimeStamp(ego_path, t, &ego_pose, logger, clock)) {
-      continue;
-    }
-    Point ego_point = boost::geometry::make<Point>(ego_pose.position.x, ego_pose.position.y);
-
-    double distance = boost::geometry::distance(obj_polygon, ego_point);
+  for (size_t k = path.valid_begin; k < path.valid_end; ++k) {
+    const Point ego_point = boost::geometry::make<Point>(path.x[k], path.y[k]);
+    const double distance = boost::geometry::distance(obj_polygon, ego_point);
     if (distance < min_distance) {
       min_distance = distance;
     }
@@ -642,17 +696,16 @@ std::vector<size_t> filterObjectsByPath(
   const rclcpp::Logger & logger)
 {
   std::vector<size_t> indices;
-  const auto ego_path_point_array = convertToGeometryPointArray(ego_path);
+  LineString ego_path_line;
+  for (const auto & point_with_id : ego_path.points) {
+    const auto & p = point_with_id.point.pose.position;
+    boost::geometry::append(ego_path_line, Point(p.x, p.y));
+  }
   for (const auto & i : object_indices) {
     Polygon obj_polygon;
     if (!calcObjectPolygon(objects.objects.at(i), &obj_polygon, logger)) {
       continue;
     }
-    LineString ego_path_line;
-    for (size_t j = 0; j < ego_path_point_array.size(); ++j) {
-      boost::geometry::append(
-        ego_path_line, Point(ego_path_point_array.at(j).x, ego_path_point_array.at(j).y));
-    }
     const double distance = boost::geometry::distance(obj_polygon, ego_path_line);
     if (distance < vehicle_width) {
       indices.push_back(i);
@@ -28,6 +28,7 @@
 #include <tf2_ros/transform_listener.h>
 
 #include <memory>
+#include <unordered_map>
 
 namespace turn_signal_decider
 {
@@ -50,8 +51,9 @@ private:
   lanelet::LaneletMapPtr lanelet_map_ptr_;
   lanelet::routing::RoutingGraphPtr routing_graph_ptr_;
   lanelet::traffic_rules::TrafficRulesPtr traffic_rules_ptr_;
-  lanelet::ConstLanelets path_lanes_;
+  std::unordered_map<lanelet::Id, lanelet::ConstLanelet> path_lanes_;
   geometry_msgs::msg::PoseStamped vehicle_pose_;
+  size_t path_update_count_;
 
   // condition checks
   bool isPathValid() const;
@@ -66,11 +68,13 @@ public:
   void onVehiclePoseUpdate();
 
   // getters
-  autoware_planning_msgs::msg::PathWithLaneId getPath() const;
+  const autoware_planning_msgs::msg::PathWithLaneId & getPath() const;
   lanelet::LaneletMapPtr getMapPtr() const;
   lanelet::ConstLanelet getLaneFromId(const lanelet::Id & id) const;
   lanelet::routing::RoutingGraphPtr getRoutingGraphPtr() const;
   geometry_msgs::msg::PoseStamped getVehiclePoseStamped() const;
+  // incremented whenever the path or the lanes on the path are updated
+  size_t getPathUpdateCount() const;
 
   // condition checks
   bool isDataReady() const;
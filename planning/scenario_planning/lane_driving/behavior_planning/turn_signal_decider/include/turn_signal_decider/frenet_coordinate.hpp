@@ -34,5 +34,15 @@ bool convertToFrenetCoordinate3d(
 bool convertToFrenetCoordinate3d(
   const std::vector<geometry_msgs::msg::Point> & linestring,
   const geometry_msgs::msg::Point & search_point_geom, FrenetCoordinate3d * frenet_coordinate);
+
+/**
+ * @brief same as above, but searches from linestring[start_index], whose arc length is
+ *        start_length. The end index of the segment the point is projected on is set to
+ *        segment_index.
+ */
+bool convertToFrenetCoordinate3d(
+  const std::vector<geometry_msgs::msg::Point> & linestring,
+  const geometry_msgs::msg::Point & search_point_geom, const std::size_t start_index,
+  const double start_length, FrenetCoordinate3d * frenet_coordinate, std::size_t * segment_index);
 }  // namespace turn_signal_decider
 #endif  // TURN_SIGNAL_DECIDER__FRENET_COORDINATE_HPP_
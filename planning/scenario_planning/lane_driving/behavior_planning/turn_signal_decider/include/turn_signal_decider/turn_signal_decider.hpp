@@ -22,7 +22,10 @@
 
 #include <autoware_vehicle_msgs/msg/turn_signal.hpp>
 
+#include <map>
 #include <string>
+#include <utility>
+#include <vector>
 
 namespace turn_signal_decider
 {
@@ -33,6 +36,21 @@ struct TurnSignalParameters
   double base_link2front;
 };
 
+/**
+ * @brief lane change or turn on the path, found by walking the lane ids of the path points in order
+ *        while skipping the repeated ones.
+ */
+struct TurnSignalEvent
+{
+  size_t point_index;
+  // whether the lane id is the first one of the point, in which case it is compared against
+  // another lane when the point is the first one ahead of the vehicle
+  bool is_first_lane_id;
+  uint8_t signal;  // TurnSignal::LEFT or TurnSignal::RIGHT
+  // the event is ignored when it is farther than this from the vehicle front
+  double max_distance;
+};
+
 class TurnSignalDecider : public std::enable_shared_from_this<TurnSignalDecider>,
                           public rclcpp::Node
 {
@@ -48,22 +66,46 @@ private:
   DataManager data_;
   TurnSignalParameters parameters_;
 
+  // events on the current path, rebuilt only when the path or the map is updated
+  size_t path_update_count_;
+  std::vector<geometry_msgs::msg::Point> path_points_;
+  std::vector<double> path_arc_lengths_;
+  std::vector<TurnSignalEvent> lane_change_events_;
+  std::vector<TurnSignalEvent> turn_events_;
+  size_t vehicle_segment_index_;  // start of the frenet projection in the next cycle
+
+  // routing relations between the lanes, kept until the map is updated
+  lanelet::routing::RoutingGraphPtr relation_routing_graph_ptr_;
+  std::map<std::pair<lanelet::Id, lanelet::Id>, lanelet::routing::RelationType> relations_;
+
   // callbacks
   void onTurnSignalTimer();
 
+  // path events
+  void updatePathEvents();
+  bool getVehicleFrenetCoordinate(FrenetCoordinate3d * vehicle_pose_frenet);
+
   // turn signal factors
   bool isChangingLane(
-    const autoware_planning_msgs::msg::PathWithLaneId & path,
     const FrenetCoordinate3d & vehicle_pose_frenet,
-    autoware_vehicle_msgs::msg::TurnSignal * signal_state_ptr, double * distance_ptr) const;
+    autoware_vehicle_msgs::msg::TurnSignal * signal_state_ptr, double * distance_ptr);
   bool isTurning(
-    const autoware_planning_msgs::msg::PathWithLaneId & path,
     const FrenetCoordinate3d & vehicle_pose_frenet,
     autoware_vehicle_msgs::msg::TurnSignal * signal_state_ptr, double * distance_ptr) const;
 
   // other
   lanelet::routing::RelationType getRelation(
     const lanelet::ConstLanelet & prev_lane, const lanelet::ConstLanelet & next_lane) const;
+  lanelet::routing::RelationType getRelation(
+    const lanelet::Id & prev_lane_id, const lanelet::Id & next_lane_id);
+  bool getTurnSignal(const lanelet::ConstLanelet & lane, uint8_t * signal) const;
+  size_t findFirstPointAhead(const FrenetCoordinate3d & vehicle_pose_frenet) const;
+  double getDistanceFromVehicleFront(
+    const size_t point_index, const FrenetCoordinate3d & vehicle_pose_frenet) const;
+  bool findNextEvent(
+    const std::vector<TurnSignalEvent> & events, const size_t first_index,
+    const FrenetCoordinate3d & vehicle_pose_frenet, const double search_distance,
+    autoware_vehicle_msgs::msg::TurnSignal * signal_state_ptr, double * distance_ptr) const;
 
 public:
   explicit TurnSignalDecider(const rclcpp::NodeOptions & node_options);
@@ -19,28 +19,20 @@
 
 #include <memory>
 #include <string>
+#include <unordered_map>
 
 using autoware_planning_msgs::msg::PathWithLaneId;
 
 namespace
 {
-bool exists(const lanelet::ConstLanelets & lanes, const lanelet::Id & id)
-{
-  for (const auto & lane : lanes) {
-    if (lane.id() == id) {
-      return true;
-    }
-  }
-  return false;
-}
-lanelet::ConstLanelets pathToLanes(
+std::unordered_map<lanelet::Id, lanelet::ConstLanelet> pathToLanes(
   const PathWithLaneId & path, const lanelet::LaneletMapPtr & lanelet_map_ptr)
 {
-  lanelet::ConstLanelets lanes;
+  std::unordered_map<lanelet::Id, lanelet::ConstLanelet> lanes;
   for (const auto & path_point : path.points) {
     for (const auto & id : path_point.lane_ids) {
-      if (!exists(lanes, id)) {
-        lanes.push_back(lanelet_map_ptr->laneletLayer.get(id));
+      if (lanes.count(id) == 0) {
+        lanes.emplace(id, lanelet_map_ptr->laneletLayer.get(id));
       }
     }
   }
@@ -51,7 +43,11 @@ lanelet::ConstLanelets pathToLanes(
 namespace turn_signal_decider
 {
 DataManager::DataManager(rclcpp::Node * node)
-: is_map_ready_(false), is_path_ready_(false), is_pose_ready_(false), node_(node)
+: is_map_ready_(false),
+  is_path_ready_(false),
+  is_pose_ready_(false),
+  node_(node),
+  path_update_count_(0)
 {
   if (node_ != nullptr) {
     tf_buffer_ = std::make_shared<tf2_ros::Buffer>(node_->get_clock());
@@ -68,6 +64,7 @@ void DataManager::onPathWithLaneId(PathWithLaneId::SharedPtr msg)
   if (is_map_ready_) {
     path_lanes_ = pathToLanes(path_, lanelet_map_ptr_);
   }
+  ++path_update_count_;
 }
 
 void DataManager::onLaneletMap(autoware_lanelet2_msgs::msg::MapBin::SharedPtr map_msg)
@@ -79,6 +76,7 @@ void DataManager::onLaneletMap(autoware_lanelet2_msgs::msg::MapBin::SharedPtr ma
 
   if (is_path_ready_) {
     path_lanes_ = pathToLanes(path_, lanelet_map_ptr_);
+    ++path_update_count_;
   }
 }
 
@@ -228,16 +226,18 @@ bool DataManager::isDataReady() const
   }
 }
 
-autoware_planning_msgs::msg::PathWithLaneId DataManager::getPath() const { return path_; }
+const autoware_planning_msgs::msg::PathWithLaneId & DataManager::getPath() const
+{
+  return path_;
+}
 
 lanelet::LaneletMapPtr DataManager::getMapPtr() const { return lanelet_map_ptr_; }
 
 lanelet::ConstLanelet DataManager::getLaneFromId(const lanelet::Id & id) const
 {
-  for (const auto & lane : path_lanes_) {
-    if (lane.id() == id) {
-      return lane;
-    }
+  const auto itr = path_lanes_.find(id);
+  if (itr != path_lanes_.end()) {
+    return itr->second;
   }
   return lanelet::Lanelet();
 }
@@ -248,4 +248,6 @@ lanelet::routing::RoutingGraphPtr DataManager::getRoutingGraphPtr() const
 }
 geometry_msgs::msg::PoseStamped DataManager::getVehiclePoseStamped() const { return vehicle_pose_; }
 
+size_t DataManager::getPathUpdateCount() const { return path_update_count_; }
+
 }  // namespace turn_signal_decider
@@ -52,7 +52,17 @@ bool convertToFrenetCoordinate3d(
   const std::vector<geometry_msgs::msg::Point> & linestring,
   const geometry_msgs::msg::Point & search_point_geom, FrenetCoordinate3d * frenet_coordinate)
 {
-  if (linestring.empty()) {
+  std::size_t segment_index;
+  return convertToFrenetCoordinate3d(
+    linestring, search_point_geom, 0, 0.0, frenet_coordinate, &segment_index);
+}
+
+bool convertToFrenetCoordinate3d(
+  const std::vector<geometry_msgs::msg::Point> & linestring,
+  const geometry_msgs::msg::Point & search_point_geom, const std::size_t start_index,
+  const double start_length, FrenetCoordinate3d * frenet_coordinate, std::size_t * segment_index)
+{
+  if (start_index >= linestring.size()) {
     return false;
   }
 
@@ -62,14 +72,14 @@ bool convertToFrenetCoordinate3d(
   // get frenet coordinate based on points
   // this is done because linestring is not differentiable at vertices
   {
-    double accumulated_length = 0;
+    double accumulated_length = start_length;
 
-    for (std::size_t i = 0; i < linestring.size(); i++) {
-      const auto geom_pt = linestring.at(i);
+    for (std::size_t i = start_index; i < linestring.size(); i++) {
+      const auto & geom_pt = linestring.at(i);
       const auto current_pt = convertToEigenPt(geom_pt);
       const auto current2search_pt = (search_pt - current_pt);
       // update accumulated length
-      if (i != 0) {
+      if (i != start_index) {
         const auto p1 = convertToEigenPt(linestring.at(i - 1));
         const auto p2 = current_pt;
         accumulated_length += (p2 - p1).norm();
@@ -90,9 +100,10 @@ bool convertToFrenetCoordinate3d(
   // get frenet coordinate based on lines
   bool found_on_line = false;
   {
-    auto prev_geom_pt = linestring.front();
-    double accumulated_length = 0;
-    for (const auto & geom_pt : linestring) {
+    auto prev_geom_pt = linestring.at(start_index);
+    double accumulated_length = start_length;
+    for (std::size_t i = start_index; i < linestring.size(); i++) {
+      const auto & geom_pt = linestring.at(i);
       const auto start_pt = convertToEigenPt(prev_geom_pt);
       const auto end_pt = convertToEigenPt(geom_pt);
 
@@ -109,6 +120,7 @@ bool convertToFrenetCoordinate3d(
           min_distance = tmp_distance;
           frenet_coordinate->distance = tmp_distance;
           frenet_coordinate->length = accumulated_length + tmp_length;
+          *segment_index = i;
 
           if (found_on_line) {
             break;
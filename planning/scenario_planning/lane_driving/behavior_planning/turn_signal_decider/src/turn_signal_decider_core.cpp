@@ -14,10 +14,12 @@
 
 #include "turn_signal_decider/turn_signal_decider.hpp"
 
+#include <algorithm>
 #include <limits>
 #include <memory>
 #include <string>
 #include <utility>
+#include <vector>
 
 using autoware_planning_msgs::msg::PathWithLaneId;
 using autoware_vehicle_msgs::msg::TurnSignal;
@@ -30,12 +32,27 @@ double getDistance3d(const geometry_msgs::msg::Point & p1, const geometry_msgs::
 {
   return std::sqrt(std::pow(p1.x - p2.x, 2) + std::pow(p1.y - p2.y, 2) + std::pow(p1.z - p2.z, 2));
 }
+
+// a turn is ignored farther than its turn_signal_distance when it is the last lane of a point
+// with several lanes
+double getMaxTurnDistance(
+  const lanelet::ConstLanelet & lane,
+  const autoware_planning_msgs::msg::PathPointWithLaneId & point, const lanelet::Id & lane_id)
+{
+  if (1 < point.lane_ids.size() && lane_id == point.lane_ids.back()) {
+    return lane.attributeOr("turn_signal_distance", std::numeric_limits<double>::max());
+  }
+  return std::numeric_limits<double>::max();
+}
 }  // namespace
 
 namespace turn_signal_decider
 {
 TurnSignalDecider::TurnSignalDecider(const rclcpp::NodeOptions & node_options)
-: rclcpp::Node("turn_signal_decider", node_options), data_(this)
+: rclcpp::Node("turn_signal_decider", node_options),
+  data_(this),
+  path_update_count_(0),
+  vehicle_segment_index_(0)
 {
   // setup data manager
   constexpr double vehicle_pose_update_period = 0.1;
@@ -88,10 +105,11 @@ void TurnSignalDecider::onTurnSignalTimer()
   }
 
   // setup
-  const auto path = data_.getPath();
+  if (path_update_count_ != data_.getPathUpdateCount()) {
+    updatePathEvents();
+  }
   FrenetCoordinate3d vehicle_pose_frenet;
-  if (!convertToFrenetCoordinate3d(
-        path, data_.getVehiclePoseStamped().pose.position, &vehicle_pose_frenet)) {
+  if (!getVehicleFrenetCoordinate(&vehicle_pose_frenet)) {
     RCLCPP_ERROR_THROTTLE(
       get_logger(), *get_clock(), std::chrono::milliseconds(5000).count(),
       "failed to convert vehicle pose into frenet coordinate");
@@ -102,13 +120,13 @@ void TurnSignalDecider::onTurnSignalTimer()
   TurnSignal turn_signal, lane_change_signal, intersection_signal;
   double distance_to_lane_change, distance_to_intersection;
   double min_distance = std::numeric_limits<double>::max();
-  if (isChangingLane(path, vehicle_pose_frenet, &lane_change_signal, &distance_to_lane_change)) {
+  if (isChangingLane(vehicle_pose_frenet, &lane_change_signal, &distance_to_lane_change)) {
     if (min_distance > distance_to_lane_change) {
       min_distance = distance_to_lane_change;
       turn_signal = lane_change_signal;
     }
   }
-  if (isTurning(path, vehicle_pose_frenet, &intersection_signal, &distance_to_intersection)) {
+  if (isTurning(vehicle_pose_frenet, &intersection_signal, &distance_to_intersection)) {
     if (min_distance > distance_to_intersection) {
       turn_signal = intersection_signal;
     }
@@ -119,6 +137,85 @@ void TurnSignalDecider::onTurnSignalTimer()
   turn_signal_publisher_->publish(turn_signal);
 }
 
+void TurnSignalDecider::updatePathEvents()
+{
+  const auto & path = data_.getPath();
+  path_update_count_ = data_.getPathUpdateCount();
+  vehicle_segment_index_ = 0;
+
+  if (relation_routing_graph_ptr_ != data_.getRoutingGraphPtr()) {
+    relations_.clear();
+    relation_routing_graph_ptr_ = data_.getRoutingGraphPtr();
+  }
+
+  path_points_.clear();
+  path_arc_lengths_.clear();
+  lane_change_events_.clear();
+  turn_events_.clear();
+
+  double accumulated_distance = 0;
+  auto prev_lane_id = lanelet::InvalId;
+  for (size_t i = 0; i < path.points.size(); ++i) {
+    const auto & path_point = path.points.at(i);
+    const auto & position = path_point.point.pose.position;
+    if (i != 0) {
+      accumulated_distance += getDistance3d(path_points_.back(), position);
+    }
+    path_points_.push_back(position);
+    path_arc_lengths_.push_back(accumulated_distance);
+
+    for (size_t j = 0; j < path_point.lane_ids.size(); ++j) {
+      const auto lane_id = path_point.lane_ids.at(j);
+      if (lane_id == prev_lane_id) {
+        continue;
+      }
+
+      // check lane change relation
+      if (prev_lane_id != lanelet::InvalId) {
+        const auto relation = getRelation(prev_lane_id, lane_id);
+        if (relation == lanelet::routing::RelationType::Left) {
+          lane_change_events_.push_back(
+            {i, j == 0, TurnSignal::LEFT, std::numeric_limits<double>::max()});
+        } else if (relation == lanelet::routing::RelationType::Right) {
+          lane_change_events_.push_back(
+            {i, j == 0, TurnSignal::RIGHT, std::numeric_limits<double>::max()});
+        }
+      }
+      prev_lane_id = lane_id;
+
+      // check turn direction
+      const auto & lane = data_.getLaneFromId(lane_id);
+      uint8_t signal;
+      if (getTurnSignal(lane, &signal)) {
+        turn_events_.push_back({i, j == 0, signal, getMaxTurnDistance(lane, path_point, lane_id)});
+      }
+    }
+  }
+}
+
+bool TurnSignalDecider::getVehicleFrenetCoordinate(FrenetCoordinate3d * vehicle_pose_frenet)
+{
+  if (path_points_.empty()) {
+    return false;
+  }
+
+  // start from the segment where the vehicle was in the previous cycle, and search the whole path
+  // only when the vehicle is not found ahead of it
+  const auto & position = data_.getVehiclePoseStamped().pose.position;
+  const size_t start_index = vehicle_segment_index_ == 0 ? 0 : vehicle_segment_index_ - 1;
+  size_t segment_index;
+  if (
+    convertToFrenetCoordinate3d(
+      path_points_, position, start_index, path_arc_lengths_.at(start_index), vehicle_pose_frenet,
+      &segment_index) ||
+    (start_index != 0 && convertToFrenetCoordinate3d(
+                           path_points_, position, 0, 0.0, vehicle_pose_frenet, &segment_index))) {
+    vehicle_segment_index_ = segment_index;
+    return true;
+  }
+  return false;
+}
+
 lanelet::routing::RelationType TurnSignalDecider::getRelation(
   const lanelet::ConstLanelet & prev_lane, const lanelet::ConstLanelet & next_lane) const
 {
@@ -155,64 +252,119 @@ lanelet::routing::RelationType TurnSignalDecider::getRelation(
   return lanelet::routing::RelationType::None;
 }
 
-bool TurnSignalDecider::isChangingLane(
-  const autoware_planning_msgs::msg::PathWithLaneId & path,
-  const FrenetCoordinate3d & vehicle_pose_frenet, TurnSignal * signal_state_ptr,
-  double * distance_ptr) const
+lanelet::routing::RelationType TurnSignalDecider::getRelation(
+  const lanelet::Id & prev_lane_id, const lanelet::Id & next_lane_id)
 {
-  if (signal_state_ptr == nullptr || distance_ptr == nullptr) {
-    RCLCPP_ERROR(this->get_logger(), "Given argument is nullptr.");
-    return false;
+  const auto key = std::make_pair(prev_lane_id, next_lane_id);
+  const auto itr = relations_.find(key);
+  if (itr != relations_.end()) {
+    return itr->second;
   }
-  if (path.points.empty()) {
-    return false;
+
+  const auto relation =
+    getRelation(data_.getLaneFromId(prev_lane_id), data_.getLaneFromId(next_lane_id));
+  relations_.emplace(key, relation);
+  return relation;
+}
+
+bool TurnSignalDecider::getTurnSignal(const lanelet::ConstLanelet & lane, uint8_t * signal) const
+{
+  const auto turn_direction = lane.attributeOr("turn_direction", std::string("none"));
+  if (turn_direction == "left") {
+    *signal = TurnSignal::LEFT;
+    return true;
   }
+  if (turn_direction == "right") {
+    *signal = TurnSignal::RIGHT;
+    return true;
+  }
+  return false;
+}
 
-  double accumulated_distance = 0;
+size_t TurnSignalDecider::findFirstPointAhead(const FrenetCoordinate3d & vehicle_pose_frenet) const
+{
+  const auto itr = std::partition_point(
+    path_arc_lengths_.begin(), path_arc_lengths_.end(), [&](const double arc_length) {
+      return arc_length - vehicle_pose_frenet.length - parameters_.base_link2front < 0.0;
+    });
+  return static_cast<size_t>(itr - path_arc_lengths_.begin());
+}
 
-  auto prev_point = path.points.front();
-  auto prev_lane_id = path.points.front().lane_ids.front();
-  for (const auto & path_point : path.points) {
-    accumulated_distance +=
-      getDistance3d(prev_point.point.pose.position, path_point.point.pose.position);
-    prev_point = path_point;
+double TurnSignalDecider::getDistanceFromVehicleFront(
+  const size_t point_index, const FrenetCoordinate3d & vehicle_pose_frenet) const
+{
+  return path_arc_lengths_.at(point_index) - vehicle_pose_frenet.length -
+         parameters_.base_link2front;
+}
+
+bool TurnSignalDecider::findNextEvent(
+  const std::vector<TurnSignalEvent> & events, const size_t first_index,
+  const FrenetCoordinate3d & vehicle_pose_frenet, const double search_distance,
+  TurnSignal * signal_state_ptr, double * distance_ptr) const
+{
+  auto itr = std::partition_point(events.begin(), events.end(), [&](const auto & event) {
+    return event.point_index < first_index;
+  });
+  for (; itr != events.end(); ++itr) {
+    // the first lane of the first point ahead is checked by the caller
+    if (itr->point_index == first_index && itr->is_first_lane_id) {
+      continue;
+    }
+    // the search ends after the first point farther than the search distance
+    if (
+      itr->point_index != first_index &&
+      getDistanceFromVehicleFront(itr->point_index - 1, vehicle_pose_frenet) > search_distance) {
+      return false;
+    }
     const double distance_from_vehicle_front =
-      accumulated_distance - vehicle_pose_frenet.length - parameters_.base_link2front;
-    if (distance_from_vehicle_front < 0.0) {
+      getDistanceFromVehicleFront(itr->point_index, vehicle_pose_frenet);
+    if (itr->max_distance < distance_from_vehicle_front) {
       continue;
     }
-    for (const auto & lane_id : path_point.lane_ids) {
-      if (lane_id == prev_lane_id) {
-        continue;
-      }
+    signal_state_ptr->data = itr->signal;
+    *distance_ptr = distance_from_vehicle_front;
+    return true;
+  }
+  return false;
+}
 
-      const auto & prev_lane = data_.getLaneFromId(prev_lane_id);
-      const auto & lane = data_.getLaneFromId(lane_id);
-      prev_lane_id = lane_id;
+bool TurnSignalDecider::isChangingLane(
+  const FrenetCoordinate3d & vehicle_pose_frenet, TurnSignal * signal_state_ptr,
+  double * distance_ptr)
+{
+  if (signal_state_ptr == nullptr || distance_ptr == nullptr) {
+    RCLCPP_ERROR(this->get_logger(), "Given argument is nullptr.");
+    return false;
+  }
+  const size_t first_index = findFirstPointAhead(vehicle_pose_frenet);
+  if (first_index >= path_points_.size()) {
+    return false;
+  }
 
-      // check lane change relation
-      const auto relation = getRelation(prev_lane, lane);
-      if (relation == lanelet::routing::RelationType::Left) {
-        signal_state_ptr->data = TurnSignal::LEFT;
-        *distance_ptr = distance_from_vehicle_front;
-        return true;
-      }
-      if (relation == lanelet::routing::RelationType::Right) {
-        signal_state_ptr->data = TurnSignal::RIGHT;
-        *distance_ptr = distance_from_vehicle_front;
-        return true;
-      }
+  // the first point ahead of the vehicle is compared against the first lane of the path
+  const auto & path = data_.getPath();
+  const auto front_lane_id = path.points.front().lane_ids.front();
+  const auto first_lane_id = path.points.at(first_index).lane_ids.front();
+  if (first_lane_id != front_lane_id) {
+    const auto relation = getRelation(front_lane_id, first_lane_id);
+    if (relation == lanelet::routing::RelationType::Left) {
+      signal_state_ptr->data = TurnSignal::LEFT;
+      *distance_ptr = getDistanceFromVehicleFront(first_index, vehicle_pose_frenet);
+      return true;
     }
-
-    if (distance_from_vehicle_front > parameters_.lane_change_search_distance) {
-      return false;
+    if (relation == lanelet::routing::RelationType::Right) {
+      signal_state_ptr->data = TurnSignal::RIGHT;
+      *distance_ptr = getDistanceFromVehicleFront(first_index, vehicle_pose_frenet);
+      return true;
     }
   }
-  return false;
+
+  return findNextEvent(
+    lane_change_events_, first_index, vehicle_pose_frenet, parameters_.lane_change_search_distance,
+    signal_state_ptr, distance_ptr);
 }
 
 bool TurnSignalDecider::isTurning(
-  const autoware_planning_msgs::msg::PathWithLaneId & path,
   const FrenetCoordinate3d & vehicle_pose_frenet, TurnSignal * signal_state_ptr,
   double * distance_ptr) const
 {
@@ -220,53 +372,29 @@ bool TurnSignalDecider::isTurning(
     RCLCPP_ERROR(this->get_logger(), "Given argument is nullptr.");
     return false;
   }
-  if (path.points.empty()) {
+  const size_t first_index = findFirstPointAhead(vehicle_pose_frenet);
+  if (first_index >= path_points_.size()) {
     return false;
   }
 
-  double accumulated_distance = 0;
-
-  auto prev_point = path.points.front();
-  auto prev_lane_id = lanelet::InvalId;
-  for (const auto & path_point : path.points) {
-    accumulated_distance +=
-      getDistance3d(prev_point.point.pose.position, path_point.point.pose.position);
-    prev_point = path_point;
-    const double distance_from_vehicle_front =
-      accumulated_distance - vehicle_pose_frenet.length - parameters_.base_link2front;
-    if (distance_from_vehicle_front < 0.0) {
-      continue;
-    }
-    for (const auto & lane_id : path_point.lane_ids) {
-      if (lane_id == prev_lane_id) {
-        continue;
-      }
-      prev_lane_id = lane_id;
-
-      const auto & lane = data_.getLaneFromId(lane_id);
-      if (
-        lane.attributeOr("turn_signal_distance", std::numeric_limits<double>::max()) <
-        distance_from_vehicle_front) {
-        if (1 < path_point.lane_ids.size() && lane_id == path_point.lane_ids.back()) {
-          continue;
-        }
-      }
-      if (lane.attributeOr("turn_direction", std::string("none")) == "left") {
-        signal_state_ptr->data = TurnSignal::LEFT;
-        *distance_ptr = distance_from_vehicle_front;
-        return true;
-      }
-      if (lane.attributeOr("turn_direction", std::string("none")) == "right") {
-        signal_state_ptr->data = TurnSignal::RIGHT;
-        *distance_ptr = distance_from_vehicle_front;
-        return true;
-      }
-    }
-    if (distance_from_vehicle_front > parameters_.intersection_search_distance) {
-      return false;
-    }
+  // the first lane of the first point ahead of the vehicle is always checked
+  const auto & first_point = data_.getPath().points.at(first_index);
+  const auto first_lane_id = first_point.lane_ids.front();
+  const auto & first_lane = data_.getLaneFromId(first_lane_id);
+  const double distance_from_vehicle_front =
+    getDistanceFromVehicleFront(first_index, vehicle_pose_frenet);
+  uint8_t signal;
+  if (
+    getTurnSignal(first_lane, &signal) &&
+    !(getMaxTurnDistance(first_lane, first_point, first_lane_id) < distance_from_vehicle_front)) {
+    signal_state_ptr->data = signal;
+    *distance_ptr = distance_from_vehicle_front;
+    return true;
   }
-  return false;
+
+  return findNextEvent(
+    turn_events_, first_index, vehicle_pose_frenet, parameters_.intersection_search_distance,
+    signal_state_ptr, distance_ptr);
 }
 
 }  // namespace turn_signal_decider
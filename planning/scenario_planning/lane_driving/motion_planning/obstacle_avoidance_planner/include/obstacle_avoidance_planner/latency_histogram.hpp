@@ -0,0 +1,71 @@
+// Copyright 2021 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef OBSTACLE_AVOIDANCE_PLANNER__LATENCY_HISTOGRAM_HPP_
+#define OBSTACLE_AVOIDANCE_PLANNER__LATENCY_HISTOGRAM_HPP_
+
+#include <algorithm>
+#include <iomanip>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Histogram of latencies since the node started. The bins are given by their upper bounds
+ *        in ms, and the latencies above the last bound are counted in the last "le_inf" bin.
+ */
+class LatencyHistogram
+{
+public:
+  explicit LatencyHistogram(
+    const std::vector<double> & upper_bounds_ms = {1, 2, 5, 10, 20, 50, 100, 200, 500, 1000})
+  : upper_bounds_ms_(upper_bounds_ms), counts_(upper_bounds_ms.size() + 1, 0)
+  {
+  }
+
+  void add(const double latency_ms)
+  {
+    const auto itr = std::lower_bound(upper_bounds_ms_.begin(), upper_bounds_ms_.end(), latency_ms);
+    counts_.at(itr - upper_bounds_ms_.begin())++;
+    total_count_++;
+    sum_ms_ += latency_ms;
+    max_ms_ = std::max(max_ms_, latency_ms);
+  }
+
+  // key-value pairs for autoware_utils::ProcessingTimePublisher
+  std::map<std::string, double> toMap() const
+  {
+    std::map<std::string, double> histogram_map;
+    for (size_t i = 0; i < upper_bounds_ms_.size(); ++i) {
+      std::ostringstream key;
+      key << "le_" << std::setw(4) << std::setfill('0') << upper_bounds_ms_.at(i) << "ms";
+      histogram_map[key.str()] = counts_.at(i);
+    }
+    histogram_map["le_inf"] = counts_.back();
+    histogram_map["count"] = total_count_;
+    histogram_map["max_ms"] = max_ms_;
+    histogram_map["mean_ms"] = total_count_ == 0 ? 0.0 : sum_ms_ / total_count_;
+    return histogram_map;
+  }
+
+private:
+  std::vector<double> upper_bounds_ms_;
+  std::vector<size_t> counts_;
+  size_t total_count_{0};
+  double sum_ms_{0.0};
+  double max_ms_{0.0};
+};
+
+#endif  // OBSTACLE_AVOIDANCE_PLANNER__LATENCY_HISTOGRAM_HPP_
@@ -0,0 +1,104 @@
+// Copyright 2021 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef OBSTACLE_AVOIDANCE_PLANNER__LATEST_REQUEST_WORKER_HPP_
+#define OBSTACLE_AVOIDANCE_PLANNER__LATEST_REQUEST_WORKER_HPP_
+
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+/**
+ * @brief Worker thread processing requests one by one. Only the latest request is kept, so the
+ *        requests made while the worker is busy are skipped except the last one. The result of
+ *        the last processed request is kept until the next one replaces it.
+ */
+template <class Request, class Result>
+class LatestRequestWorker
+{
+public:
+  explicit LatestRequestWorker(std::function<Result(const Request &)> process)
+  : process_(std::move(process)), thread_(&LatestRequestWorker::run, this)
+  {
+  }
+
+  ~LatestRequestWorker()
+  {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      is_stopping_ = true;
+    }
+    cv_.notify_one();
+    thread_.join();
+  }
+
+  LatestRequestWorker(const LatestRequestWorker &) = delete;
+  LatestRequestWorker & operator=(const LatestRequestWorker &) = delete;
+
+  // returns true if a request not taken by the worker yet is skipped
+  bool request(Request request)
+  {
+    bool is_skipping = false;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      is_skipping = static_cast<bool>(pending_request_ptr_);
+      pending_request_ptr_ = std::make_unique<Request>(std::move(request));
+    }
+    cv_.notify_one();
+    return is_skipping;
+  }
+
+  // nullptr until the first request is processed
+  std::shared_ptr<const Result> getLatestResult() const
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return latest_result_ptr_;
+  }
+
+private:
+  void run()
+  {
+    while (true) {
+      std::unique_ptr<Request> request_ptr;
+      {
+        std::unique_lock<std::mutex> lock(mutex_);
+        cv_.wait(lock, [this] { return pending_request_ptr_ || is_stopping_; });
+        if (is_stopping_) {
+          return;
+        }
+        request_ptr = std::move(pending_request_ptr_);
+      }
+
+      auto result_ptr = std::make_shared<const Result>(process_(*request_ptr));
+
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        latest_result_ptr_ = std::move(result_ptr);
+      }
+    }
+  }
+
+  std::function<Result(const Request &)> process_;
+  mutable std::mutex mutex_;  // guards the request, the result and the stop flag
+  std::condition_variable cv_;
+  std::unique_ptr<Request> pending_request_ptr_;
+  std::shared_ptr<const Result> latest_result_ptr_;
+  bool is_stopping_{false};
+  std::thread thread_;  // started last so that the members above are ready for it
+};
+
+#endif  // OBSTACLE_AVOIDANCE_PLANNER__LATEST_REQUEST_WORKER_HPP_
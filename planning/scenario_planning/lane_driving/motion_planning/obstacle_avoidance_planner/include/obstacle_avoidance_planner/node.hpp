@@ -14,6 +14,10 @@
 #ifndef OBSTACLE_AVOIDANCE_PLANNER__NODE_HPP_
 #define OBSTACLE_AVOIDANCE_PLANNER__NODE_HPP_
 
+#include "obstacle_avoidance_planner/latency_histogram.hpp"
+#include "obstacle_avoidance_planner/latest_request_worker.hpp"
+
+#include <autoware_utils/ros/processing_time_publisher.hpp>
 #include <rclcpp/rclcpp.hpp>
 
 #include <autoware_auto_perception_msgs/msg/predicted_objects.hpp>
@@ -34,6 +38,7 @@
 
 #include <boost/optional/optional_fwd.hpp>
 
+#include <atomic>
 #include <memory>
 #include <mutex>
 #include <vector>
@@ -74,9 +79,14 @@ private:
   bool is_showing_debug_info_;
   bool is_using_vehicle_config_;
   bool is_stopping_if_outside_drivable_area_;
-  bool enable_avoidance_;
+  bool is_optimizing_asynchronously_;
+  std::atomic<bool> enable_avoidance_;
   const int min_num_points_for_getting_yaw_;
+  // guards the optimization state below, which the worker thread owns in the asynchronous mode
   std::mutex mutex_;
+  // parameters set while optimizing, applied before the next optimization under mutex_
+  std::mutex param_mutex_;
+  std::vector<rclcpp::Parameter> pending_parameters_;
 
   // params outside logic
   double min_delta_dist_for_replan_;
@@ -99,7 +109,36 @@ private:
   std::unique_ptr<geometry_msgs::msg::Pose> prev_ego_pose_ptr_;
   std::unique_ptr<Trajectories> prev_trajectories_ptr_;
   std::unique_ptr<std::vector<autoware_auto_planning_msgs::msg::PathPoint>> prev_path_points_ptr_;
-  std::unique_ptr<autoware_auto_perception_msgs::msg::PredictedObjects> in_objects_ptr_;
+  std::shared_ptr<const autoware_auto_perception_msgs::msg::PredictedObjects> in_objects_ptr_;
+
+  // latest messages from the subscriptions, taken as the inputs of the optimization
+  std::unique_ptr<geometry_msgs::msg::TwistStamped> latest_twist_ptr_;
+  std::shared_ptr<const autoware_auto_perception_msgs::msg::PredictedObjects> latest_objects_ptr_;
+
+  // asynchronous optimization
+  struct OptimizationRequest
+  {
+    autoware_auto_planning_msgs::msg::Path::ConstSharedPtr path_ptr;
+    geometry_msgs::msg::Pose ego_pose;
+    geometry_msgs::msg::TwistStamped twist;
+    std::shared_ptr<const autoware_auto_perception_msgs::msg::PredictedObjects> objects_ptr;
+    rclcpp::Time received_time;
+  };
+  struct OptimizationResult
+  {
+    std::vector<autoware_auto_planning_msgs::msg::TrajectoryPoint> points;
+    // parameters the points are optimized with, read without mutex_ when publishing
+    std::shared_ptr<const TrajectoryParam> traj_param_ptr;
+    rclcpp::Time received_time;
+  };
+  std::unique_ptr<LatestRequestWorker<OptimizationRequest, OptimizationResult>>
+    optimization_worker_ptr_;
+
+  // latency from receiving a path to publishing the trajectory, and to finishing its optimization
+  LatencyHistogram publish_latency_histogram_;
+  LatencyHistogram optimization_latency_histogram_;
+  std::unique_ptr<autoware_utils::ProcessingTimePublisher> publish_latency_pub_;
+  std::unique_ptr<autoware_utils::ProcessingTimePublisher> optimization_latency_pub_;
 
   // TF
   std::unique_ptr<tf2_ros::Buffer> tf_buffer_ptr_;
@@ -131,6 +170,17 @@ private:
 
   void initialize();
 
+  OptimizationResult optimize(const OptimizationRequest & request);
+
+  void requestOptimization(
+    const autoware_auto_planning_msgs::msg::Path::ConstSharedPtr & path_ptr,
+    const geometry_msgs::msg::Pose & ego_pose);
+
+  // previous optimized trajectory cropped around ego, followed by the rest of the path
+  std::vector<autoware_auto_planning_msgs::msg::TrajectoryPoint> generateTrajectoryFromLatestResult(
+    const geometry_msgs::msg::Pose & ego_pose,
+    const std::vector<autoware_auto_planning_msgs::msg::PathPoint> & path_points);
+
   // generate fine trajectory
   std::vector<autoware_auto_planning_msgs::msg::TrajectoryPoint> generatePostProcessedTrajectory(
     const geometry_msgs::msg::Pose & ego_pose,
@@ -162,6 +212,9 @@ private:
   autoware_auto_planning_msgs::msg::Trajectory generateTrajectory(
     const autoware_auto_planning_msgs::msg::Path & in_path);
 
+  std::vector<autoware_auto_planning_msgs::msg::TrajectoryPoint> generateTrajectoryPoints(
+    const autoware_auto_planning_msgs::msg::Path & in_path);
+
   std::vector<autoware_auto_planning_msgs::msg::TrajectoryPoint> convertPointsToTrajectory(
     const std::vector<autoware_auto_planning_msgs::msg::PathPoint> & path_points,
     const std::vector<autoware_auto_planning_msgs::msg::TrajectoryPoint> & trajectory_points) const;
@@ -212,6 +265,9 @@ private:
   rcl_interfaces::msg::SetParametersResult paramCallback(
     const std::vector<rclcpp::Parameter> & parameters);
 
+  // must be called with mutex_ locked
+  void applyPendingParameters();
+
 public:
   explicit ObstacleAvoidancePlanner(const rclcpp::NodeOptions & node_options);
   ~ObstacleAvoidancePlanner();
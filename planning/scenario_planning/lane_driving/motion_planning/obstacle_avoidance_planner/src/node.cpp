@@ -46,6 +46,7 @@
 #include <limits>
 #include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 ObstacleAvoidancePlanner::ObstacleAvoidancePlanner(const rclcpp::NodeOptions & node_options)
@@ -96,6 +97,7 @@ ObstacleAvoidancePlanner::ObstacleAvoidancePlanner(const rclcpp::NodeOptions & n
   is_stopping_if_outside_drivable_area_ =
     declare_parameter("is_stopping_if_outside_drivable_area", true);
   enable_avoidance_ = declare_parameter("enable_avoidance", true);
+  is_optimizing_asynchronously_ = declare_parameter("is_optimizing_asynchronously", false);
 
   qp_param_ = std::make_unique<QPParam>();
   traj_param_ = std::make_unique<TrajectoryParam>();
@@ -235,20 +237,70 @@ ObstacleAvoidancePlanner::ObstacleAvoidancePlanner(const rclcpp::NodeOptions & n
   mpt_param_->mid_point_dist_from_base_link =
     (mpt_param_->base_point_dist_from_base_link + mpt_param_->top_point_dist_from_base_link) * 0.5;
 
-  in_objects_ptr_ = std::make_unique<autoware_auto_perception_msgs::msg::PredictedObjects>();
+  latest_objects_ptr_ = std::make_shared<autoware_auto_perception_msgs::msg::PredictedObjects>();
+
+  publish_latency_pub_ = std::make_unique<autoware_utils::ProcessingTimePublisher>(
+    this, "~/debug/publish_latency_histogram_ms");
+  optimization_latency_pub_ = std::make_unique<autoware_utils::ProcessingTimePublisher>(
+    this, "~/debug/optimization_latency_histogram_ms");
 
   // set parameter callback
   set_param_res_ = this->add_on_set_parameters_callback(
     std::bind(&ObstacleAvoidancePlanner::paramCallback, this, std::placeholders::_1));
 
   initialize();
+
+  if (is_optimizing_asynchronously_) {
+    optimization_worker_ptr_ =
+      std::make_unique<LatestRequestWorker<OptimizationRequest, OptimizationResult>>(
+        [this](const OptimizationRequest & request) { return optimize(request); });
+  }
 }
 
-ObstacleAvoidancePlanner::~ObstacleAvoidancePlanner() {}
+ObstacleAvoidancePlanner::~ObstacleAvoidancePlanner()
+{
+  // stop the worker before the members it optimizes with are destroyed
+  optimization_worker_ptr_.reset();
+}
 
 rcl_interfaces::msg::SetParametersResult ObstacleAvoidancePlanner::paramCallback(
   const std::vector<rclcpp::Parameter> & parameters)
 {
+  // mutex_ may be held by the worker for a whole optimization, so the parameters are only staged
+  // here and applied before the next optimization
+  {
+    std::lock_guard<std::mutex> lock(param_mutex_);
+    for (const auto & parameter : parameters) {
+      auto it = std::find_if(
+        pending_parameters_.begin(), pending_parameters_.end(),
+        [&parameter](const rclcpp::Parameter & pending) {
+          return pending.get_name() == parameter.get_name();
+        });
+      if (it != pending_parameters_.end()) {
+        *it = parameter;
+      } else {
+        pending_parameters_.push_back(parameter);
+      }
+    }
+  }
+
+  rcl_interfaces::msg::SetParametersResult result;
+  result.successful = true;
+  result.reason = "success";
+  return result;
+}
+
+void ObstacleAvoidancePlanner::applyPendingParameters()
+{
+  std::vector<rclcpp::Parameter> parameters;
+  {
+    std::lock_guard<std::mutex> lock(param_mutex_);
+    parameters.swap(pending_parameters_);
+  }
+  if (parameters.empty()) {
+    return;
+  }
+
   auto update_param = [&](const std::string & name, double & v) {
     auto it = std::find_if(
       parameters.cbegin(), parameters.cend(),
@@ -296,39 +348,50 @@ rcl_interfaces::msg::SetParametersResult ObstacleAvoidancePlanner::paramCallback
   update_param("steer_input_weight", mpt_param_->steer_input_weight);
   update_param("steer_rate_weight", mpt_param_->steer_rate_weight);
   update_param("steer_acc_weight", mpt_param_->steer_acc_weight);
-
-  rcl_interfaces::msg::SetParametersResult result;
-  result.successful = true;
-  result.reason = "success";
-  return result;
 }
 
 // ROS callback functions
 void ObstacleAvoidancePlanner::pathCallback(
   const autoware_auto_planning_msgs::msg::Path::SharedPtr msg)
 {
-  std::lock_guard<std::mutex> lock(mutex_);
-  current_ego_pose_ptr_ = getCurrentEgoPose();
+  const rclcpp::Time received_time = this->now();
+  const auto ego_pose_ptr = getCurrentEgoPose();
   if (
-    msg->points.empty() || msg->drivable_area.data.empty() || !current_ego_pose_ptr_ ||
-    !current_twist_ptr_) {
+    msg->points.empty() || msg->drivable_area.data.empty() || !ego_pose_ptr || !latest_twist_ptr_) {
     return;
   }
-  autoware_auto_planning_msgs::msg::Trajectory output_trajectory_msg = generateTrajectory(*msg);
-  trajectory_pub_->publish(output_trajectory_msg);
+
+  if (is_optimizing_asynchronously_) {
+    requestOptimization(msg, *ego_pose_ptr);
+    auto output_trajectory_msg = autoware_utils::convertToTrajectory(
+      generateTrajectoryFromLatestResult(*ego_pose_ptr, msg->points));
+    output_trajectory_msg.header = msg->header;
+    trajectory_pub_->publish(output_trajectory_msg);
+  } else {
+    std::lock_guard<std::mutex> lock(mutex_);
+    applyPendingParameters();
+    current_ego_pose_ptr_ = std::make_unique<geometry_msgs::msg::Pose>(*ego_pose_ptr);
+    current_twist_ptr_ = std::make_unique<geometry_msgs::msg::TwistStamped>(*latest_twist_ptr_);
+    in_objects_ptr_ = latest_objects_ptr_;
+    autoware_auto_planning_msgs::msg::Trajectory output_trajectory_msg = generateTrajectory(*msg);
+    trajectory_pub_->publish(output_trajectory_msg);
+  }
+
+  publish_latency_histogram_.add((this->now() - received_time).seconds() * 1000.0);
+  publish_latency_pub_->publish(publish_latency_histogram_.toMap());
 }
 
 void ObstacleAvoidancePlanner::odomCallback(const nav_msgs::msg::Odometry::SharedPtr msg)
 {
-  current_twist_ptr_ = std::make_unique<geometry_msgs::msg::TwistStamped>();
-  current_twist_ptr_->header = msg->header;
-  current_twist_ptr_->twist = msg->twist.twist;
+  latest_twist_ptr_ = std::make_unique<geometry_msgs::msg::TwistStamped>();
+  latest_twist_ptr_->header = msg->header;
+  latest_twist_ptr_->twist = msg->twist.twist;
 }
 
 void ObstacleAvoidancePlanner::objectsCallback(
   const autoware_auto_perception_msgs::msg::PredictedObjects::SharedPtr msg)
 {
-  in_objects_ptr_ = std::make_unique<autoware_auto_perception_msgs::msg::PredictedObjects>(*msg);
+  latest_objects_ptr_ = msg;
 }
 
 void ObstacleAvoidancePlanner::enableAvoidanceCallback(
@@ -338,8 +401,110 @@ void ObstacleAvoidancePlanner::enableAvoidanceCallback(
 }
 // End ROS callback functions
 
+ObstacleAvoidancePlanner::OptimizationResult ObstacleAvoidancePlanner::optimize(
+  const OptimizationRequest & request)
+{
+  OptimizationResult result;
+  result.received_time = request.received_time;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    applyPendingParameters();
+    current_ego_pose_ptr_ = std::make_unique<geometry_msgs::msg::Pose>(request.ego_pose);
+    current_twist_ptr_ = std::make_unique<geometry_msgs::msg::TwistStamped>(request.twist);
+    in_objects_ptr_ = request.objects_ptr;
+    result.points = generateTrajectoryPoints(*request.path_ptr);
+    result.traj_param_ptr = std::make_shared<const TrajectoryParam>(*traj_param_);
+  }
+
+  optimization_latency_histogram_.add((this->now() - request.received_time).seconds() * 1000.0);
+  optimization_latency_pub_->publish(optimization_latency_histogram_.toMap());
+  return result;
+}
+
+void ObstacleAvoidancePlanner::requestOptimization(
+  const autoware_auto_planning_msgs::msg::Path::ConstSharedPtr & path_ptr,
+  const geometry_msgs::msg::Pose & ego_pose)
+{
+  OptimizationRequest request;
+  request.path_ptr = path_ptr;
+  request.ego_pose = ego_pose;
+  request.twist = *latest_twist_ptr_;
+  request.objects_ptr = latest_objects_ptr_;
+  request.received_time = this->now();
+  if (optimization_worker_ptr_->request(std::move(request))) {
+    RCLCPP_INFO_EXPRESSION(
+      get_logger(), is_showing_debug_info_,
+      "Skipping the stale optimization request since the optimization is still running");
+  }
+}
+
+std::vector<autoware_auto_planning_msgs::msg::TrajectoryPoint>
+ObstacleAvoidancePlanner::generateTrajectoryFromLatestResult(
+  const geometry_msgs::msg::Pose & ego_pose,
+  const std::vector<autoware_auto_planning_msgs::msg::PathPoint> & path_points)
+{
+  const auto result_ptr = optimization_worker_ptr_->getLatestResult();
+  if (!result_ptr || result_ptr->points.empty()) {
+    return util::convertPathToTrajectory(path_points);
+  }
+  const auto & traj_param = *result_ptr->traj_param_ptr;
+
+  // crop the previous trajectory backward_fixing_distance behind ego
+  const auto & prev_points = result_ptr->points;
+  const int nearest_idx = util::getNearestIdx(
+    prev_points, ego_pose, 0, traj_param.delta_yaw_threshold_for_closest_point);
+  if (
+    util::calculate2DDistance(prev_points.at(nearest_idx).pose.position, ego_pose.position) >
+    traj_param.delta_dist_threshold_for_closest_point) {
+    return util::convertPathToTrajectory(path_points);
+  }
+  int begin_idx = nearest_idx;
+  double backward_length = 0.0;
+  while (begin_idx > 0 && backward_length < traj_param.backward_fixing_distance) {
+    backward_length += util::calculate2DDistance(
+      prev_points.at(begin_idx).pose.position, prev_points.at(begin_idx - 1).pose.position);
+    begin_idx--;
+  }
+  std::vector<autoware_auto_planning_msgs::msg::TrajectoryPoint> traj_points(
+    prev_points.begin() + begin_idx, prev_points.end());
+
+  // concatenate the path points ahead of the end of the previous trajectory
+  const auto end_pose = traj_points.back().pose;
+  const int nearest_path_idx = util::getNearestIdx(
+    path_points, end_pose, 0, traj_param.delta_yaw_threshold_for_closest_point);
+  for (size_t i = nearest_path_idx; i < path_points.size(); ++i) {
+    if (util::transformToRelativeCoordinate2D(path_points.at(i).pose.position, end_pose).x > 0) {
+      const auto path_tail = util::convertPathToTrajectory(
+        std::vector<autoware_auto_planning_msgs::msg::PathPoint>(
+          path_points.begin() + i, path_points.end()));
+      traj_points.insert(traj_points.end(), path_tail.begin(), path_tail.end());
+      break;
+    }
+  }
+
+  // the velocity follows the latest path, e.g. a stop point inserted after the optimization
+  std::vector<geometry_msgs::msg::Point> traj_positions;
+  for (const auto & p : traj_points) {
+    traj_positions.push_back(p.pose.position);
+  }
+  const int zero_velocity_idx = util::getZeroVelocityIdxFromPoints(
+    path_points, traj_positions, traj_positions.size() - 1, traj_param);
+  const int max_skip_comparison_idx_for_path_points = -1;
+  return util::alignVelocityWithPoints(
+    traj_points, path_points, zero_velocity_idx, max_skip_comparison_idx_for_path_points);
+}
+
 autoware_auto_planning_msgs::msg::Trajectory ObstacleAvoidancePlanner::generateTrajectory(
   const autoware_auto_planning_msgs::msg::Path & path)
+{
+  auto output = autoware_utils::convertToTrajectory(generateTrajectoryPoints(path));
+  output.header = path.header;
+  return output;
+}
+
+std::vector<autoware_auto_planning_msgs::msg::TrajectoryPoint>
+ObstacleAvoidancePlanner::generateTrajectoryPoints(
+  const autoware_auto_planning_msgs::msg::Path & path)
 {
   auto t_start = std::chrono::high_resolution_clock::now();
 
@@ -348,9 +513,6 @@ autoware_auto_planning_msgs::msg::Trajectory ObstacleAvoidancePlanner::generateT
   const auto post_processed_traj =
     generatePostProcessedTrajectory(*current_ego_pose_ptr_, path.points, traj_points);
 
-  auto output = autoware_utils::convertToTrajectory(post_processed_traj);
-  output.header = path.header;
-
   prev_path_points_ptr_ =
     std::make_unique<std::vector<autoware_auto_planning_msgs::msg::PathPoint>>(path.points);
 
@@ -359,7 +521,7 @@ autoware_auto_planning_msgs::msg::Trajectory ObstacleAvoidancePlanner::generateT
   RCLCPP_INFO_EXPRESSION(
     get_logger(), is_showing_debug_info_,
     "Total time: = %f [ms]\n==========================", elapsed_ms);
-  return output;
+  return post_processed_traj;
 }
 
 std::vector<autoware_auto_planning_msgs::msg::TrajectoryPoint>
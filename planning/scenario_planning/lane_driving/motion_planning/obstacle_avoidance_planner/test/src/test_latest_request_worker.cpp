@@ -0,0 +1,137 @@
+// Copyright 2020 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "obstacle_avoidance_planner/latest_request_worker.hpp"
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace
+{
+// blocks the worker inside the process function until it is opened
+class Gate
+{
+public:
+  void open()
+  {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      is_open_ = true;
+    }
+    cv_.notify_all();
+  }
+
+  void pass()
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    cv_.wait(lock, [this] { return is_open_; });
+  }
+
+private:
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  bool is_open_{false};
+};
+
+struct ProcessLog
+{
+  std::mutex mutex;
+  std::condition_variable cv;
+  std::vector<int> processed;
+
+  bool waitFor(const size_t num)
+  {
+    std::unique_lock<std::mutex> lock(mutex);
+    return cv.wait_for(
+      lock, std::chrono::seconds(5), [this, num] { return processed.size() >= num; });
+  }
+};
+
+// the result is stored after the process function returns, so poll it
+bool waitForResult(const LatestRequestWorker<int, int> & worker, const int expected)
+{
+  const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+  while (std::chrono::steady_clock::now() < deadline) {
+    const auto result_ptr = worker.getLatestResult();
+    if (result_ptr && *result_ptr == expected) {
+      return true;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  return false;
+}
+}  // namespace
+
+TEST(LatestRequestWorker, NoResultBeforeRequest)
+{
+  LatestRequestWorker<int, int> worker([](const int & request) { return request; });
+  EXPECT_EQ(worker.getLatestResult(), nullptr);
+}
+
+TEST(LatestRequestWorker, ProcessRequest)
+{
+  ProcessLog log;
+  LatestRequestWorker<int, int> worker([&log](const int & request) {
+    std::lock_guard<std::mutex> lock(log.mutex);
+    log.processed.push_back(request);
+    log.cv.notify_all();
+    return request * 10;
+  });
+
+  EXPECT_FALSE(worker.request(1));
+  EXPECT_TRUE(waitForResult(worker, 10));
+}
+
+TEST(LatestRequestWorker, SkipStaleRequests)
+{
+  Gate gate;
+  ProcessLog log;
+  LatestRequestWorker<int, int> worker([&gate, &log](const int & request) {
+    {
+      std::lock_guard<std::mutex> lock(log.mutex);
+      log.processed.push_back(request);
+      log.cv.notify_all();
+    }
+    gate.pass();
+    return request * 10;
+  });
+
+  EXPECT_FALSE(worker.request(1));
+  ASSERT_TRUE(log.waitFor(1));
+
+  // the worker is busy with the first request, so only the last of these is processed
+  EXPECT_FALSE(worker.request(2));
+  EXPECT_TRUE(worker.request(3));
+  EXPECT_TRUE(worker.request(4));
+  // the result of the busy request is not published yet
+  EXPECT_EQ(worker.getLatestResult(), nullptr);
+
+  gate.open();
+  EXPECT_TRUE(waitForResult(worker, 40));
+
+  std::lock_guard<std::mutex> lock(log.mutex);
+  EXPECT_EQ(log.processed, (std::vector<int>{1, 4}));
+}
+
+TEST(LatestRequestWorker, StopWhileIdle)
+{
+  // the destructor returns even though nothing was requested
+  LatestRequestWorker<int, int> worker([](const int & request) { return request; });
+  SUCCEED();
+}
@@ -17,6 +17,7 @@
 
 #include "autoware_utils/trajectory/tmp_conversion.hpp"
 #include "surround_obstacle_checker/debug_marker.hpp"
+#include "surround_obstacle_checker/point_cloud_distance.hpp"
 
 #include <rclcpp/rclcpp.hpp>
 #include <vehicle_info_util/vehicle_info_util.hpp>
@@ -36,7 +37,6 @@
 #include <boost/geometry/geometries/linestring.hpp>
 #include <boost/geometry/geometries/point_xy.hpp>
 
-#include <pcl_conversions/pcl_conversions.h>
 #include <tf2/utils.h>
 #include <tf2_ros/buffer.h>
 #include <tf2_ros/transform_listener.h>
@@ -45,9 +45,6 @@
 #include <string>
 #include <vector>
 
-using Point2d = boost::geometry::model::d2::point_xy<double>;
-using Polygon2d =
-  boost::geometry::model::polygon<Point2d, false, false>;  // counter-clockwise, open
 using autoware_auto_planning_msgs::msg::Trajectory;
 using autoware_auto_planning_msgs::msg::TrajectoryPoint;
 using TrajectoryPoints = std::vector<TrajectoryPoint>;
@@ -66,9 +63,9 @@ private:
     const autoware_auto_perception_msgs::msg::PredictedObjects::ConstSharedPtr input_msg);
   void currentVelocityCallback(const nav_msgs::msg::Odometry::ConstSharedPtr input_msg);
   void insertStopVelocity(const size_t closest_idx, TrajectoryPoints * traj);
-  bool convertPose(
-    const geometry_msgs::msg::Pose & pose, const std::string & source, const std::string & target,
-    const rclcpp::Time & time, geometry_msgs::msg::Pose & conv_pose);
+  bool getTransform(
+    const std::string & source, const std::string & target, const rclcpp::Time & time,
+    tf2::Transform & src2tgt);
   bool getPose(
     const std::string & source, const std::string & target, geometry_msgs::msg::Pose & pose);
   void getNearestObstacle(double * min_dist_to_obj, geometry_msgs::msg::Point * nearest_obj_point);
@@ -110,6 +107,9 @@ private:
   autoware_auto_perception_msgs::msg::PredictedObjects::ConstSharedPtr object_ptr_;
   vehicle_info_util::VehicleInfo vehicle_info_;
   Polygon2d self_poly_;
+  // circle enclosing self_poly_
+  Point2d self_poly_center_;
+  double self_poly_radius_;
   bool use_pointcloud_;
   bool use_dynamic_object_;
   double surround_check_distance_;
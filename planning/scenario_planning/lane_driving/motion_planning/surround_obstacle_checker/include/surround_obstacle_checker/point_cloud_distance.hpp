@@ -0,0 +1,42 @@
+// Copyright 2020 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef SURROUND_OBSTACLE_CHECKER__POINT_CLOUD_DISTANCE_HPP_
+#define SURROUND_OBSTACLE_CHECKER__POINT_CLOUD_DISTANCE_HPP_
+
+#include <geometry_msgs/msg/point.hpp>
+#include <sensor_msgs/msg/point_cloud2.hpp>
+
+#include <boost/geometry.hpp>
+#include <boost/geometry/geometries/point_xy.hpp>
+
+#include <tf2/LinearMath/Transform.h>
+
+using Point2d = boost::geometry::model::d2::point_xy<double>;
+using Polygon2d =
+  boost::geometry::model::polygon<Point2d, false, false>;  // counter-clockwise, open
+
+/**
+ * @brief update min_dist and nearest_point with the point of the cloud nearest to the polygon.
+ *        Points farther than crop_radius from crop_center are skipped without computing the
+ *        distance to the polygon.
+ * @param cloud2polygon transform from the frame of the cloud to the frame of the polygon
+ * @return false if the cloud does not have float32 x, y and z fields
+ */
+bool updateNearestPointInCloud(
+  const sensor_msgs::msg::PointCloud2 & cloud, const tf2::Transform & cloud2polygon,
+  const Polygon2d & polygon, const Point2d & crop_center, const double crop_radius,
+  double * min_dist, geometry_msgs::msg::Point * nearest_point);
+
+#endif  // SURROUND_OBSTACLE_CHECKER__POINT_CLOUD_DISTANCE_HPP_
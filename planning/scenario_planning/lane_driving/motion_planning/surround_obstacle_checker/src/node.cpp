@@ -14,22 +14,15 @@
 
 #include "surround_obstacle_checker/node.hpp"
 
-#include <pcl/common/transforms.h>
-#include <pcl/point_cloud.h>
-#include <pcl/point_types.h>
-#include <pcl_conversions/pcl_conversions.h>
-#include <tf2_eigen/tf2_eigen.h>
+#include <tf2_geometry_msgs/tf2_geometry_msgs.h>
 
 #include <algorithm>
+#include <cmath>
 #include <functional>
 #include <limits>
 #include <memory>
 #include <string>
 
-#define EIGEN_MPL2_ONLY
-#include <Eigen/Core>
-#include <Eigen/Geometry>
-
 SurroundObstacleCheckerNode::SurroundObstacleCheckerNode(const rclcpp::NodeOptions & node_options)
 : Node("surround_obstacle_checker_node", node_options),
   tf_buffer_(this->get_clock()),
@@ -47,6 +40,12 @@ SurroundObstacleCheckerNode::SurroundObstacleCheckerNode(const rclcpp::NodeOptio
   debug_ptr_ = std::make_shared<SurroundObstacleCheckerDebugNode>(
     vehicle_info_.max_longitudinal_offset_m, this->get_clock(), *this);
   self_poly_ = createSelfPolygon();
+  boost::geometry::centroid(self_poly_, self_poly_center_);
+  self_poly_radius_ = 0.0;
+  for (const auto & p : self_poly_.outer()) {
+    self_poly_radius_ =
+      std::max(self_poly_radius_, boost::geometry::distance(self_poly_center_, p));
+  }
 
   // Publishers
   path_pub_ =
@@ -194,11 +193,10 @@ bool SurroundObstacleCheckerNode::getPose(
   return true;
 }
 
-bool SurroundObstacleCheckerNode::convertPose(
-  const geometry_msgs::msg::Pose & pose, const std::string & source, const std::string & target,
-  const rclcpp::Time & time, geometry_msgs::msg::Pose & conv_pose)
+bool SurroundObstacleCheckerNode::getTransform(
+  const std::string & source, const std::string & target, const rclcpp::Time & time,
+  tf2::Transform & src2tgt)
 {
-  tf2::Transform src2tgt;
   try {
     // get transform from source to target
     geometry_msgs::msg::TransformStamped ros_src2tgt =
@@ -210,11 +208,6 @@ bool SurroundObstacleCheckerNode::convertPose(
       "cannot get tf from " << source << " to " << target);
     return false;
   }
-
-  tf2::Transform src2obj;
-  tf2::fromMsg(pose, src2obj);
-  tf2::Transform tgt2obj = src2tgt.inverse() * src2obj;
-  tf2::toMsg(tgt2obj, conv_pose);
   return true;
 }
 
@@ -263,40 +256,45 @@ void SurroundObstacleCheckerNode::getNearestObstacleByPointCloud(
     return;
   }
 
-  Eigen::Affine3f isometry = tf2::transformToEigen(transform_stamped.transform).cast<float>();
-  pcl::PointCloud<pcl::PointXYZ> pcl;
-  pcl::fromROSMsg(*pointcloud_ptr_, pcl);
-  pcl::transformPointCloud(pcl, pcl, isometry);
-  for (const auto & p : pcl) {
-    // create boost point
-    Point2d boost_p(p.x, p.y);
+  tf2::Transform base_link2cloud;
+  tf2::fromMsg(transform_stamped.transform, base_link2cloud);
 
-    // calc distance
-    const double dist_to_obj = boost::geometry::distance(self_poly_, boost_p);
+  // Points farther than this from the center of the self polygon are farther from the polygon
+  // than both of the distances which isObstacleFound() compares with
+  const double max_dist_from_center =
+    self_poly_radius_ + std::max(surround_check_distance_, surround_check_recover_distance_);
 
-    // get minimum distance to obj
-    if (dist_to_obj < *min_dist_to_obj) {
-      *min_dist_to_obj = dist_to_obj;
-      nearest_obj_point->x = p.x;
-      nearest_obj_point->y = p.y;
-      nearest_obj_point->z = p.z;
-    }
+  if (!updateNearestPointInCloud(
+        *pointcloud_ptr_, base_link2cloud, self_poly_, self_poly_center_, max_dist_from_center,
+        min_dist_to_obj, nearest_obj_point)) {
+    RCLCPP_WARN_THROTTLE(
+      get_logger(), *this->get_clock(), 500 /* ms */,
+      "pointcloud does not have float32 x, y and z fields.");
   }
 }
 
 void SurroundObstacleCheckerNode::getNearestObstacleByDynamicObject(
   double * min_dist_to_obj, geometry_msgs::msg::Point * nearest_obj_point)
 {
+  if (object_ptr_->objects.empty()) {
+    return;
+  }
+
+  // all the objects are in the same frame at the same time
   const auto obj_frame = object_ptr_->header.frame_id;
   const auto obj_time = object_ptr_->header.stamp;
+  tf2::Transform src2tgt;
+  if (!getTransform(obj_frame, "base_link", obj_time, src2tgt)) {
+    return;
+  }
+  const tf2::Transform tgt2src = src2tgt.inverse();
+
   for (const auto & obj : object_ptr_->objects) {
     // change frame of obj_pose to base_link
+    tf2::Transform src2obj;
+    tf2::fromMsg(obj.kinematics.initial_pose_with_covariance.pose, src2obj);
     geometry_msgs::msg::Pose pose_baselink;
-    if (!convertPose(
-          obj.kinematics.initial_pose_with_covariance.pose, obj_frame, "base_link", obj_time,
-          pose_baselink)) {
-      return;
-    }
+    tf2::toMsg(tgt2src * src2obj, pose_baselink);
 
     // create obj polygon
     Polygon2d obj_poly;
@@ -0,0 +1,72 @@
+// Copyright 2020 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "surround_obstacle_checker/point_cloud_distance.hpp"
+
+#include <sensor_msgs/point_cloud2_iterator.hpp>
+
+#include <algorithm>
+#include <string>
+
+namespace
+{
+bool hasFloatField(const sensor_msgs::msg::PointCloud2 & cloud, const std::string & name)
+{
+  return std::any_of(cloud.fields.begin(), cloud.fields.end(), [&name](const auto & field) {
+    return field.name == name && field.datatype == sensor_msgs::msg::PointField::FLOAT32;
+  });
+}
+}  // namespace
+
+bool updateNearestPointInCloud(
+  const sensor_msgs::msg::PointCloud2 & cloud, const tf2::Transform & cloud2polygon,
+  const Polygon2d & polygon, const Point2d & crop_center, const double crop_radius,
+  double * min_dist, geometry_msgs::msg::Point * nearest_point)
+{
+  // PointCloud2ConstIterator throws for a missing field and reads out of the buffer for no points
+  if (!hasFloatField(cloud, "x") || !hasFloatField(cloud, "y") || !hasFloatField(cloud, "z")) {
+    return false;
+  }
+  if (cloud.data.empty() || cloud.width * cloud.height == 0) {
+    return true;
+  }
+
+  const auto & rotation = cloud2polygon.getBasis();
+  const auto & translation = cloud2polygon.getOrigin();
+  const double squared_crop_radius = crop_radius * crop_radius;
+
+  using sensor_msgs::PointCloud2ConstIterator;
+  for (PointCloud2ConstIterator<float> iter_x(cloud, "x"), iter_y(cloud, "y"), iter_z(cloud, "z");
+       iter_x != iter_x.end(); ++iter_x, ++iter_y, ++iter_z) {
+    // transform only x and y until the point turns out to be the nearest
+    const tf2::Vector3 p(*iter_x, *iter_y, *iter_z);
+    const double x = rotation[0].dot(p) + translation.x();
+    const double y = rotation[1].dot(p) + translation.y();
+
+    const double dx = x - crop_center.x();
+    const double dy = y - crop_center.y();
+    if (dx * dx + dy * dy > squared_crop_radius) {
+      continue;
+    }
+
+    const double dist = boost::geometry::distance(polygon, Point2d(x, y));
+    if (dist < *min_dist) {
+      *min_dist = dist;
+      nearest_point->x = x;
+      nearest_point->y = y;
+      nearest_point->z = rotation[2].dot(p) + translation.z();
+    }
+  }
+  return true;
+}
@@ -0,0 +1,200 @@
+// Copyright 2020 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "surround_obstacle_checker/point_cloud_distance.hpp"
+
+#include <boost/assign/list_of.hpp>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+constexpr double max_double = std::numeric_limits<double>::max();
+
+sensor_msgs::msg::PointCloud2 createPointCloud(
+  const std::vector<tf2::Vector3> & points,
+  const std::vector<std::string> & field_names = {"x", "y", "z"})
+{
+  sensor_msgs::msg::PointCloud2 cloud;
+  for (const auto & name : field_names) {
+    sensor_msgs::msg::PointField field;
+    field.name = name;
+    field.offset = static_cast<uint32_t>(cloud.fields.size() * sizeof(float));
+    field.datatype = sensor_msgs::msg::PointField::FLOAT32;
+    field.count = 1;
+    cloud.fields.push_back(field);
+  }
+  cloud.height = 1;
+  cloud.width = static_cast<uint32_t>(points.size());
+  cloud.point_step = static_cast<uint32_t>(field_names.size() * sizeof(float));
+  cloud.row_step = cloud.point_step * cloud.width;
+  cloud.data.resize(cloud.row_step);
+  for (size_t i = 0; i < points.size(); ++i) {
+    const double values[] = {points.at(i).x(), points.at(i).y(), points.at(i).z()};
+    for (size_t j = 0; j < field_names.size(); ++j) {
+      const auto value = static_cast<float>(values[j]);
+      std::memcpy(&cloud.data.at(i * cloud.point_step + j * sizeof(float)), &value, sizeof(float));
+    }
+  }
+  return cloud;
+}
+
+// footprint of a vehicle with the same layout as createSelfPolygon()
+Polygon2d createSelfPolygon()
+{
+  Polygon2d polygon;
+  boost::geometry::exterior_ring(polygon) =
+    boost::assign::list_of<Point2d>(3.9, 0.9)(3.9, -0.9)(-1.0, -0.9)(-1.0, 0.9)(3.9, 0.9);
+  return polygon;
+}
+
+tf2::Transform createTransform(
+  const double x, const double y, const double z, const double roll, const double pitch,
+  const double yaw)
+{
+  tf2::Quaternion quaternion;
+  quaternion.setRPY(roll, pitch, yaw);
+  return tf2::Transform(quaternion, tf2::Vector3(x, y, z));
+}
+}  // namespace
+
+TEST(PointCloudDistance, NearestPoint)
+{
+  const auto polygon = createSelfPolygon();
+  const auto cloud = createPointCloud(
+    {tf2::Vector3(10.0, 0.0, 1.0), tf2::Vector3(5.0, 0.5, 2.0), tf2::Vector3(0.0, -3.0, 3.0)});
+
+  double min_dist = max_double;
+  geometry_msgs::msg::Point nearest_point;
+  ASSERT_TRUE(updateNearestPointInCloud(
+    cloud, tf2::Transform(), polygon, Point2d(1.45, 0.0), max_double, &min_dist,
+    &nearest_point));
+  EXPECT_NEAR(min_dist, 1.1, 1e-6);
+  EXPECT_NEAR(nearest_point.x, 5.0, 1e-6);
+  EXPECT_NEAR(nearest_point.y, 0.5, 1e-6);
+  EXPECT_NEAR(nearest_point.z, 2.0, 1e-6);
+
+  // the nearer point given in advance is kept
+  min_dist = 0.5;
+  nearest_point = geometry_msgs::msg::Point();
+  ASSERT_TRUE(updateNearestPointInCloud(
+    cloud, tf2::Transform(), polygon, Point2d(1.45, 0.0), max_double, &min_dist,
+    &nearest_point));
+  EXPECT_EQ(min_dist, 0.5);
+  EXPECT_EQ(nearest_point.x, 0.0);
+}
+
+TEST(PointCloudDistance, InvalidPointCloud)
+{
+  const auto polygon = createSelfPolygon();
+  double min_dist = max_double;
+  geometry_msgs::msg::Point nearest_point;
+
+  // no points
+  EXPECT_TRUE(updateNearestPointInCloud(
+    createPointCloud({}), tf2::Transform(), polygon, Point2d(1.45, 0.0), max_double, &min_dist,
+    &nearest_point));
+  EXPECT_EQ(min_dist, max_double);
+
+  // no fields
+  EXPECT_FALSE(updateNearestPointInCloud(
+    sensor_msgs::msg::PointCloud2(), tf2::Transform(), polygon, Point2d(1.45, 0.0), max_double,
+    &min_dist, &nearest_point));
+
+  // no z field
+  EXPECT_FALSE(updateNearestPointInCloud(
+    createPointCloud({tf2::Vector3(5.0, 0.5, 2.0)}, {"x", "y"}), tf2::Transform(), polygon,
+    Point2d(1.45, 0.0), max_double, &min_dist, &nearest_point));
+
+  // double fields
+  auto double_cloud = createPointCloud({tf2::Vector3(5.0, 0.5, 2.0)});
+  for (auto & field : double_cloud.fields) {
+    field.datatype = sensor_msgs::msg::PointField::FLOAT64;
+  }
+  EXPECT_FALSE(updateNearestPointInCloud(
+    double_cloud, tf2::Transform(), polygon, Point2d(1.45, 0.0), max_double, &min_dist,
+    &nearest_point));
+  EXPECT_EQ(min_dist, max_double);
+}
+
+TEST(PointCloudDistance, CropByRadius)
+{
+  const auto polygon = createSelfPolygon();
+  Point2d center;
+  boost::geometry::centroid(polygon, center);
+  double radius = 0.0;
+  for (const auto & p : polygon.outer()) {
+    radius = std::max(radius, boost::geometry::distance(center, p));
+  }
+  constexpr double check_distance = 2.5;
+
+  std::mt19937 engine(0);
+  std::uniform_real_distribution<double> position_dist(-10.0, 10.0);
+  std::uniform_real_distribution<double> angle_dist(-0.3, 0.3);
+  for (int i = 0; i < 200; ++i) {
+    // tilted sensor
+    const auto base_link2cloud = createTransform(
+      position_dist(engine) * 0.1, position_dist(engine) * 0.1, 2.0, angle_dist(engine),
+      angle_dist(engine), angle_dist(engine) * 10.0);
+    std::vector<tf2::Vector3> points;
+    for (int j = 0; j < 100; ++j) {
+      const double x = position_dist(engine);
+      const double y = position_dist(engine);
+      points.emplace_back(x, y, position_dist(engine) * 0.2);
+    }
+    const auto cloud = createPointCloud(points);
+
+    double min_dist = max_double;
+    geometry_msgs::msg::Point nearest_point;
+    ASSERT_TRUE(updateNearestPointInCloud(
+      cloud, base_link2cloud, polygon, center, radius + check_distance, &min_dist,
+      &nearest_point));
+
+    // without cropping
+    double expected_min_dist = max_double;
+    geometry_msgs::msg::Point expected_nearest_point;
+    ASSERT_TRUE(updateNearestPointInCloud(
+      cloud, base_link2cloud, polygon, center, max_double, &expected_min_dist,
+      &expected_nearest_point));
+
+    // the result is the same as long as the nearest point is within check_distance
+    if (expected_min_dist <= check_distance) {
+      EXPECT_EQ(min_dist, expected_min_dist);
+      EXPECT_EQ(nearest_point.x, expected_nearest_point.x);
+      EXPECT_EQ(nearest_point.y, expected_nearest_point.y);
+      EXPECT_EQ(nearest_point.z, expected_nearest_point.z);
+    } else {
+      EXPECT_GT(min_dist, check_distance);
+    }
+
+    // brute force in base_link
+    double brute_force_min_dist = max_double;
+    for (const auto & p : points) {
+      const auto p_float = tf2::Vector3(
+        static_cast<float>(p.x()), static_cast<float>(p.y()), static_cast<float>(p.z()));
+      const auto transformed = base_link2cloud(p_float);
+      brute_force_min_dist = std::min(
+        brute_force_min_dist,
+        boost::geometry::distance(polygon, Point2d(transformed.x(), transformed.y())));
+    }
+    EXPECT_NEAR(expected_min_dist, brute_force_min_dist, 1e-9);
+  }
+}
@@ -120,6 +120,7 @@ private:
 
   HADMapRoute::ConstSharedPtr route_;
   OccupancyGrid::ConstSharedPtr occupancy_grid_;
+  bool is_new_occupancy_grid_ = false;
   Scenario::ConstSharedPtr scenario_;
   Odometry::ConstSharedPtr odom_;
 
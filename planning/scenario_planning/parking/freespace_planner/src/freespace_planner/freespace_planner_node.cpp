@@ -227,6 +227,7 @@ FreespacePlannerNode::FreespacePlannerNode(const rclcpp::NodeOptions & node_opti
   // Planning
   getPlanningCommonParam();
   getAstarParam();
+  initializePlanningAlgorithm();
 
   // Subscribers
   {
@@ -317,6 +318,7 @@ void FreespacePlannerNode::onRoute(const HADMapRoute::ConstSharedPtr msg)
 void FreespacePlannerNode::onOccupancyGrid(const OccupancyGrid::ConstSharedPtr msg)
 {
   occupancy_grid_ = msg;
+  is_new_occupancy_grid_ = true;
 }
 
 void FreespacePlannerNode::onScenario(const Scenario::ConstSharedPtr msg) { scenario_ = msg; }
@@ -347,8 +349,6 @@ bool FreespacePlannerNode::isPlanRequired()
   }
 
   if (node_param_.replan_when_obstacle_found) {
-    algo_->setMap(*occupancy_grid_);
-
     const size_t nearest_index_partial =
       autoware_utils::findNearestIndex(partial_trajectory_.points, current_pose_.pose.position);
     const size_t end_index_partial = partial_trajectory_.points.size() - 1;
@@ -426,7 +426,12 @@ void FreespacePlannerNode::onTimer()
     return;
   }
 
-  initializePlanningAlgorithm();
+  // The planning algorithm keeps the map until a new costmap arrives
+  if (is_new_occupancy_grid_) {
+    algo_->setMap(*occupancy_grid_);
+    is_new_occupancy_grid_ = false;
+  }
+
   if (isPlanRequired()) {
     reset();
 
@@ -465,9 +470,8 @@ void FreespacePlannerNode::planTrajectory()
   extended_vehicle_shape.width += margin;
   extended_vehicle_shape.base2back += margin / 2;
 
-  // Provide robot shape and map for the planner
+  // Provide robot shape for the planner, the map is already set in onTimer()
   algo_->setVehicleShape(extended_vehicle_shape);
-  algo_->setMap(*occupancy_grid_);
 
   // Calculate poses in costmap frame
   const auto current_pose_in_costmap_frame = transformPose(
@@ -484,6 +488,9 @@ void FreespacePlannerNode::planTrajectory()
 
   RCLCPP_INFO(get_logger(), "Freespace planning: %f [s]", (end - start).seconds());
 
+  // Check obstacles on the trajectory with the robot shape without margin
+  algo_->setVehicleShape(planner_common_param_.vehicle_shape);
+
   if (result) {
     RCLCPP_INFO(get_logger(), "Found goal!");
     trajectory_ =
@@ -128,19 +128,20 @@ public:
   : planner_common_param_(planner_common_param)
   {
   }
+  // NOTE: call only when a new costmap arrives, since the obstacle table is rebuilt from the whole
+  // costmap. The collision indexes are rebuilt only when the resolution changes.
   virtual void setMap(const nav_msgs::msg::OccupancyGrid & costmap);
   virtual bool makePlan(
     const geometry_msgs::msg::Pose & start_pose, const geometry_msgs::msg::Pose & goal_pose) = 0;
   virtual bool hasFeasibleSolution() = 0;  // currently used only in testing
-  void setVehicleShape(const VehicleShape & vehicle_shape)
-  {
-    planner_common_param_.vehicle_shape = vehicle_shape;
-  }
+  void setVehicleShape(const VehicleShape & vehicle_shape);
+  // checks only the footprint cells of each pose, so the cost is independent of the costmap size
   bool hasObstacleOnTrajectory(const geometry_msgs::msg::PoseArray & trajectory);
   const PlannerWaypoints & getWaypoints() const { return waypoints_; }
   virtual ~AbstractPlanningAlgorithm() {}
 
 protected:
+  void updateCollisionIndexesTable();
   void computeCollisionIndexes(int theta_index, std::vector<IndexXY> & indexes);
   bool detectCollision(const IndexXYT & base_index);
   inline bool isOutOfRange(const IndexXYT & index)
@@ -166,7 +167,7 @@ protected:
   // costmap as occupancy grid
   nav_msgs::msg::OccupancyGrid costmap_;
 
-  // collision indexes cache
+  // collision indexes cache, footprint cells relative to the base cell for each theta index
   std::vector<std::vector<IndexXY>> coll_indexes_table_;
 
   // is_obstacle's table
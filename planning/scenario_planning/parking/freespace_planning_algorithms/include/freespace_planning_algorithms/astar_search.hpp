@@ -107,7 +107,6 @@ public:
 
   AstarSearch(const PlannerCommonParam & planner_common_param, const AstarParam & astar_param);
 
-  void setMap(const nav_msgs::msg::OccupancyGrid & costmap) override;
   bool makePlan(
     const geometry_msgs::msg::Pose & start_pose,
     const geometry_msgs::msg::Pose & goal_pose) override;
@@ -116,6 +115,7 @@ public:
   const PlannerWaypoints & getWaypoints() const { return waypoints_; }
 
 private:
+  void initializeNodes();
   bool search();
   void setPath(const AstarNode & goal);
   bool setStartNode();
@@ -89,30 +89,50 @@ geometry_msgs::msg::Pose local2global(
 
 void AbstractPlanningAlgorithm::setMap(const nav_msgs::msg::OccupancyGrid & costmap)
 {
+  // collision indexes depend only on the resolution and the vehicle shape
+  const bool is_resolution_changed =
+    coll_indexes_table_.empty() || costmap.info.resolution != costmap_.info.resolution;
+
   costmap_ = costmap;
   const auto height = costmap_.info.height;
   const auto width = costmap_.info.width;
 
   // Initialize status
-  std::vector<std::vector<bool>> is_obstacle_table;
-  is_obstacle_table.resize(height);
+  is_obstacle_table_.resize(height);
   for (uint32_t i = 0; i < height; i++) {
-    is_obstacle_table.at(i).resize(width);
+    auto & is_obstacle_row = is_obstacle_table_[i];
+    is_obstacle_row.assign(width, false);
     for (uint32_t j = 0; j < width; j++) {
       const int cost = costmap_.data[i * width + j];
 
       if (cost < 0 || planner_common_param_.obstacle_threshold <= cost) {
-        is_obstacle_table[i][j] = true;
+        is_obstacle_row[j] = true;
       }
     }
   }
-  is_obstacle_table_ = is_obstacle_table;
 
+  if (is_resolution_changed) {
+    updateCollisionIndexesTable();
+  }
+}
+
+void AbstractPlanningAlgorithm::setVehicleShape(const VehicleShape & vehicle_shape)
+{
+  planner_common_param_.vehicle_shape = vehicle_shape;
+
+  // before the first costmap, the table is built in setMap()
+  if (!coll_indexes_table_.empty()) {
+    updateCollisionIndexesTable();
+  }
+}
+
+void AbstractPlanningAlgorithm::updateCollisionIndexesTable()
+{
   // construct collision indexes table
+  coll_indexes_table_.clear();
+  coll_indexes_table_.resize(planner_common_param_.theta_size);
   for (int i = 0; i < planner_common_param_.theta_size; i++) {
-    std::vector<IndexXY> indexes_2d;
-    computeCollisionIndexes(i, indexes_2d);
-    coll_indexes_table_.push_back(indexes_2d);
+    computeCollisionIndexes(i, coll_indexes_table_[i]);
   }
 }
 
@@ -169,10 +189,23 @@ bool AbstractPlanningAlgorithm::detectCollision(const IndexXYT & base_index)
 bool AbstractPlanningAlgorithm::hasObstacleOnTrajectory(
   const geometry_msgs::msg::PoseArray & trajectory)
 {
+  // same as global2local(), with the transform computed once for all poses
+  tf2::Transform tf_origin;
+  tf2::convert(costmap_.info.origin, tf_origin);
+  geometry_msgs::msg::TransformStamped transform;
+  transform.transform = tf2::toMsg(tf_origin.inverse());
+
+  IndexXYT prev_index{0, 0, -1};
   for (const auto & pose : trajectory.poses) {
-    const auto pose_local = global2local(costmap_, pose);
+    const auto pose_local = transformPose(pose, transform);
     const auto index = pose2index(costmap_, pose_local, planner_common_param_.theta_size);
 
+    // dense trajectories have consecutive poses in the same cell and heading
+    if (index.x == prev_index.x && index.y == prev_index.y && index.theta == prev_index.theta) {
+      continue;
+    }
+    prev_index = index;
+
     if (detectCollision(index)) {
       return true;
     }
@@ -126,30 +126,14 @@ AstarSearch::AstarSearch(
     astar_param_.use_back);
 }
 
-void AstarSearch::setMap(const nav_msgs::msg::OccupancyGrid & costmap)
-{
-  AbstractPlanningAlgorithm::setMap(costmap);
-
-  const auto height = costmap_.info.height;
-  const auto width = costmap_.info.width;
-
-  // Initialize nodes
-  nodes_.clear();
-  nodes_.resize(height);
-  for (uint32_t i = 0; i < height; i++) {
-    nodes_[i].resize(width);
-    for (uint32_t j = 0; j < width; j++) {
-      nodes_[i][j].resize(planner_common_param_.theta_size);
-    }
-  }
-}
-
 bool AstarSearch::makePlan(
   const geometry_msgs::msg::Pose & start_pose, const geometry_msgs::msg::Pose & goal_pose)
 {
   start_pose_ = global2local(costmap_, start_pose);
   goal_pose_ = global2local(costmap_, goal_pose);
 
+  initializeNodes();
+
   if (!setStartNode()) {
     return false;
   }
@@ -161,6 +145,28 @@ bool AstarSearch::makePlan(
   return search();
 }
 
+void AstarSearch::initializeNodes()
+{
+  const auto height = costmap_.info.height;
+  const auto width = costmap_.info.width;
+
+  // Initialize nodes, which are sized to the costmap set last
+  nodes_.clear();
+  nodes_.resize(height);
+  for (uint32_t i = 0; i < height; i++) {
+    nodes_[i].resize(width);
+    for (uint32_t j = 0; j < width; j++) {
+      nodes_[i][j].resize(planner_common_param_.theta_size);
+    }
+  }
+
+  // Clear the result of the previous search
+  while (!openlist_.empty()) {
+    openlist_.pop();
+  }
+  goal_node_ = nullptr;
+}
+
 bool AstarSearch::setStartNode()
 {
   const auto index = pose2index(costmap_, start_pose_, planner_common_param_.theta_size);
@@ -74,8 +74,7 @@ nav_msgs::msg::OccupancyGrid construct_cost_map(
   return costmap_msg;
 }
 
-bool test_astar(
-  std::array<double, 3> start, std::array<double, 3> goal, std::string file_name,
+fpa::PlannerCommonParam construct_planner_common_param(
   double maximum_turning_radius = 9.0, int turning_radius_size = 1)
 {
   // set problem configuration
@@ -93,7 +92,7 @@ bool test_astar(
   double angle_goal_range = 6.0;
   int obstacle_threshold = 100;
 
-  fpa::PlannerCommonParam planner_common_param{
+  return fpa::PlannerCommonParam{
     time_limit,
     shape,
     minimum_turning_radius,
@@ -106,11 +105,23 @@ bool test_astar(
     longitudinal_goal_range,
     angle_goal_range,
     obstacle_threshold};
+}
 
+fpa::AstarParam construct_astar_param()
+{
   bool only_behind_solutions = false;
   bool use_back = true;
   double distance_heuristic_weight = 1.0;
-  fpa::AstarParam astar_param{only_behind_solutions, use_back, distance_heuristic_weight};
+  return fpa::AstarParam{only_behind_solutions, use_back, distance_heuristic_weight};
+}
+
+bool test_astar(
+  std::array<double, 3> start, std::array<double, 3> goal, std::string file_name,
+  double maximum_turning_radius = 9.0, int turning_radius_size = 1)
+{
+  const auto planner_common_param =
+    construct_planner_common_param(maximum_turning_radius, turning_radius_size);
+  const auto astar_param = construct_astar_param();
 
   auto astar = fpa::AstarSearch(planner_common_param, astar_param);
 
@@ -169,6 +180,42 @@ TEST(AstarSearchTestSuite, MultiCurvature)
   }
 }
 
+TEST(AstarSearchTestSuite, ReuseMap)
+{
+  auto astar = fpa::AstarSearch(construct_planner_common_param(), construct_astar_param());
+  const auto costmap_msg = construct_cost_map(150, 150, 0.2, 10);
+  astar.setMap(costmap_msg);
+
+  // plan twice with the same map
+  const std::array<double, 3> start{6., 4., 0.5 * 3.1415};
+  for (const double goal_x : {12., 8.}) {
+    const std::array<double, 3> goal{goal_x, 4., 0.5 * 3.1415};
+    EXPECT_TRUE(astar.makePlan(construct_pose_msg(start), construct_pose_msg(goal)));
+    EXPECT_TRUE(astar.hasFeasibleSolution());
+  }
+
+  geometry_msgs::msg::PoseArray trajectory;
+  for (const auto & waypoint : astar.getWaypoints().waypoints) {
+    trajectory.poses.push_back(waypoint.pose.pose);
+  }
+  EXPECT_FALSE(astar.hasObstacleOnTrajectory(trajectory));
+
+  // the vehicle doesn't fit in the free space any more
+  fpa::VehicleShape wide_shape{5.5, 30.0, 1.5};
+  astar.setVehicleShape(wide_shape);
+  EXPECT_TRUE(astar.hasObstacleOnTrajectory(trajectory));
+  astar.setVehicleShape(construct_planner_common_param().vehicle_shape);
+  EXPECT_FALSE(astar.hasObstacleOnTrajectory(trajectory));
+
+  // a new costmap with a wall at the goal, x = 7 to 9 [m], y = 4 [m]
+  auto costmap_with_obstacle = costmap_msg;
+  for (int i = 35; i <= 45; i++) {
+    costmap_with_obstacle.data[20 * 150 + i] = 100;
+  }
+  astar.setMap(costmap_with_obstacle);
+  EXPECT_TRUE(astar.hasObstacleOnTrajectory(trajectory));
+}
+
 int main(int argc, char ** argv)
 {
   testing::InitGoogleTest(&argc, argv);
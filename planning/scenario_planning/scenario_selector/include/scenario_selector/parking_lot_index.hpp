@@ -0,0 +1,42 @@
+// Copyright 2020 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef SCENARIO_SELECTOR__PARKING_LOT_INDEX_HPP_
+#define SCENARIO_SELECTOR__PARKING_LOT_INDEX_HPP_
+
+#include <geometry_msgs/msg/pose.hpp>
+
+#include <lanelet2_core/LaneletMap.h>
+
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+// Parking lots in the map and the parking lot linked to each lanelet, which are looked up every
+// timer tick
+struct ParkingLotIndex
+{
+  std::vector<lanelet::BasicPolygon3d> polygons;
+  std::vector<lanelet::BoundingBox2d> bounding_boxes;
+  std::unordered_map<lanelet::Id, size_t> lanelet_to_parking_lot;  // index of polygons
+};
+
+ParkingLotIndex createParkingLotIndex(const std::shared_ptr<lanelet::LaneletMap> & lanelet_map_ptr);
+
+// whether the pose is inside the parking lot linked to the nearest lanelet
+bool isInParkingLot(
+  const std::shared_ptr<lanelet::LaneletMap> & lanelet_map_ptr,
+  const ParkingLotIndex & parking_lot_index, const geometry_msgs::msg::Pose & current_pose);
+
+#endif  // SCENARIO_SELECTOR__PARKING_LOT_INDEX_HPP_
@@ -15,6 +15,8 @@
 #ifndef SCENARIO_SELECTOR__SCENARIO_SELECTOR_NODE_HPP_
 #define SCENARIO_SELECTOR__SCENARIO_SELECTOR_NODE_HPP_
 
+#include "scenario_selector/parking_lot_index.hpp"
+
 #include <rclcpp/rclcpp.hpp>
 
 #include <autoware_auto_mapping_msgs/msg/had_map_bin.hpp>
@@ -31,6 +33,8 @@
 #include <tf2_ros/buffer.h>
 #include <tf2_ros/transform_listener.h>
 
+#include <boost/optional.hpp>
+
 #include <deque>
 #include <memory>
 #include <string>
@@ -83,6 +87,10 @@ private:
   std::shared_ptr<lanelet::LaneletMap> lanelet_map_ptr_;
   std::shared_ptr<lanelet::routing::RoutingGraph> routing_graph_ptr_;
   std::shared_ptr<lanelet::traffic_rules::TrafficRules> traffic_rules_ptr_;
+  ParkingLotIndex parking_lot_index_;
+
+  // cached until the route or the map is updated
+  boost::optional<bool> is_goal_in_lane_;
 
   // Parameters
   double update_rate_;
@@ -0,0 +1,97 @@
+// Copyright 2020 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "scenario_selector/parking_lot_index.hpp"
+
+#include <lanelet2_extension/utility/query.hpp>
+
+#include <lanelet2_core/geometry/BoundingBox.h>
+#include <lanelet2_core/geometry/Lanelet.h>
+#include <lanelet2_core/geometry/Polygon.h>
+
+#include <limits>
+#include <memory>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+ParkingLotIndex createParkingLotIndex(const std::shared_ptr<lanelet::LaneletMap> & lanelet_map_ptr)
+{
+  ParkingLotIndex index;
+
+  const auto all_parking_lots = lanelet::utils::query::getAllParkingLots(lanelet_map_ptr);
+  std::unordered_map<lanelet::Id, size_t> parking_lot_id_to_index;
+  for (const auto & parking_lot : all_parking_lots) {
+    parking_lot_id_to_index.emplace(parking_lot.id(), index.polygons.size());
+    index.polygons.push_back(parking_lot.basicPolygon());
+    index.bounding_boxes.push_back(lanelet::geometry::boundingBox2d(parking_lot));
+  }
+
+  // Only the parking lots whose bounding boxes touch the one of the lanelet can be linked to it.
+  // They are passed to getLinkedParkingLot() in the original order so that it returns the same
+  // parking lot as with all of them.
+  lanelet::ConstPolygons3d candidate_parking_lots;
+  for (const auto & lanelet : lanelet_map_ptr->laneletLayer) {
+    const auto lanelet_bounding_box = lanelet::geometry::boundingBox2d(lanelet);
+    candidate_parking_lots.clear();
+    for (size_t i = 0; i < all_parking_lots.size(); ++i) {
+      if (
+        lanelet_bounding_box.exteriorDistance(index.bounding_boxes.at(i)) <
+        std::numeric_limits<double>::epsilon()) {
+        candidate_parking_lots.push_back(all_parking_lots.at(i));
+      }
+    }
+    if (candidate_parking_lots.empty()) {
+      continue;
+    }
+
+    lanelet::ConstPolygon3d linked_parking_lot;
+    if (lanelet::utils::query::getLinkedParkingLot(
+          lanelet, candidate_parking_lots, &linked_parking_lot)) {
+      index.lanelet_to_parking_lot.emplace(
+        lanelet.id(), parking_lot_id_to_index.at(linked_parking_lot.id()));
+    }
+  }
+
+  return index;
+}
+
+bool isInParkingLot(
+  const std::shared_ptr<lanelet::LaneletMap> & lanelet_map_ptr,
+  const ParkingLotIndex & parking_lot_index, const geometry_msgs::msg::Pose & current_pose)
+{
+  const auto & p = current_pose.position;
+  const lanelet::BasicPoint2d search_point_2d(p.x, p.y);
+
+  // the parking lot linked to the nearest lanelet
+  std::vector<std::pair<double, lanelet::Lanelet>> nearest_lanelets =
+    lanelet::geometry::findNearest(lanelet_map_ptr->laneletLayer, search_point_2d, 1);
+
+  if (nearest_lanelets.empty()) {
+    return false;
+  }
+
+  const auto itr =
+    parking_lot_index.lanelet_to_parking_lot.find(nearest_lanelets.front().second.id());
+  if (itr == parking_lot_index.lanelet_to_parking_lot.end()) {
+    return false;
+  }
+
+  if (!parking_lot_index.bounding_boxes.at(itr->second).contains(search_point_2d)) {
+    return false;
+  }
+
+  const lanelet::BasicPoint3d search_point(p.x, p.y, p.z);
+  return lanelet::geometry::within(search_point, parking_lot_index.polygons.at(itr->second));
+}
@@ -37,31 +37,6 @@ void onData(const T & data, T * buffer)
   *buffer = data;
 }
 
-std::shared_ptr<lanelet::ConstPolygon3d> findNearestParkinglot(
-  const std::shared_ptr<lanelet::LaneletMap> & lanelet_map_ptr,
-  const lanelet::BasicPoint2d & search_point)
-{
-  std::vector<std::pair<double, lanelet::Lanelet>> nearest_lanelets =
-    lanelet::geometry::findNearest(lanelet_map_ptr->laneletLayer, search_point, 1);
-
-  if (nearest_lanelets.empty()) {
-    return {};
-  }
-
-  const auto nearest_lanelet = nearest_lanelets.front().second;
-  const auto all_parking_lots = lanelet::utils::query::getAllParkingLots(lanelet_map_ptr);
-
-  const auto linked_parking_lot = std::make_shared<lanelet::ConstPolygon3d>();
-  const auto result = lanelet::utils::query::getLinkedParkingLot(
-    nearest_lanelet, all_parking_lots, linked_parking_lot.get());
-
-  if (result) {
-    return linked_parking_lot;
-  } else {
-    return {};
-  }
-}
-
 geometry_msgs::msg::PoseStamped::ConstSharedPtr getCurrentPose(
   const tf2_ros::Buffer & tf_buffer, const rclcpp::Logger & logger)
 {
@@ -103,23 +78,6 @@ bool isInLane(
   return lanelet::geometry::within(search_point, nearest_lanelet.polygon3d());
 }
 
-bool isInParkingLot(
-  const std::shared_ptr<lanelet::LaneletMap> & lanelet_map_ptr,
-  const geometry_msgs::msg::Pose & current_pose)
-{
-  const auto & p = current_pose.position;
-  const lanelet::Point3d search_point(lanelet::InvalId, p.x, p.y, p.z);
-
-  const auto nearest_parking_lot =
-    findNearestParkinglot(lanelet_map_ptr, search_point.basicPoint2d());
-
-  if (!nearest_parking_lot) {
-    return false;
-  }
-
-  return lanelet::geometry::within(search_point, nearest_parking_lot->basicPolygon());
-}
-
 bool isNearTrajectoryEnd(
   const autoware_auto_planning_msgs::msg::Trajectory::ConstSharedPtr trajectory,
   const geometry_msgs::msg::Pose & current_pose, const double th_dist)
@@ -166,8 +124,12 @@ ScenarioSelectorNode::getScenarioTrajectory(const std::string & scenario)
 std::string ScenarioSelectorNode::selectScenarioByPosition()
 {
   const auto is_in_lane = isInLane(lanelet_map_ptr_, current_pose_->pose.position);
-  const auto is_goal_in_lane = isInLane(lanelet_map_ptr_, route_->goal_pose.position);
-  const auto is_in_parking_lot = isInParkingLot(lanelet_map_ptr_, current_pose_->pose);
+  if (!is_goal_in_lane_) {
+    is_goal_in_lane_ = isInLane(lanelet_map_ptr_, route_->goal_pose.position);
+  }
+  const auto is_goal_in_lane = *is_goal_in_lane_;
+  const auto is_in_parking_lot =
+    isInParkingLot(lanelet_map_ptr_, parking_lot_index_, current_pose_->pose);
 
   if (current_scenario_ == autoware_planning_msgs::msg::Scenario::EMPTY) {
     if (is_in_lane && is_goal_in_lane) {
@@ -223,12 +185,15 @@ void ScenarioSelectorNode::onMap(
   lanelet_map_ptr_ = std::make_shared<lanelet::LaneletMap>();
   lanelet::utils::conversion::fromBinMsg(
     *msg, lanelet_map_ptr_, &traffic_rules_ptr_, &routing_graph_ptr_);
+  parking_lot_index_ = createParkingLotIndex(lanelet_map_ptr_);
+  is_goal_in_lane_ = boost::none;
 }
 
 void ScenarioSelectorNode::onRoute(
   const autoware_auto_planning_msgs::msg::HADMapRoute::ConstSharedPtr msg)
 {
   route_ = msg;
+  is_goal_in_lane_ = boost::none;
   current_scenario_ = autoware_planning_msgs::msg::Scenario::EMPTY;
 }
 
@@ -0,0 +1,171 @@
+// Copyright 2020 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "scenario_selector/parking_lot_index.hpp"
+
+#include <gtest/gtest.h>
+#include <lanelet2_core/LaneletMap.h>
+#include <lanelet2_core/utility/Utilities.h>
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+using lanelet::Lanelet;
+using lanelet::LineString3d;
+using lanelet::Point3d;
+using lanelet::Points3d;
+using lanelet::Polygon3d;
+using lanelet::utils::getId;
+
+namespace
+{
+Lanelet createLanelet(
+  const double min_x, const double min_y, const double max_x, const double max_y)
+{
+  const LineString3d left_bound(
+    getId(), {Point3d(getId(), min_x, max_y, 0.0), Point3d(getId(), max_x, max_y, 0.0)});
+  const LineString3d right_bound(
+    getId(), {Point3d(getId(), min_x, min_y, 0.0), Point3d(getId(), max_x, min_y, 0.0)});
+  Lanelet lanelet(getId(), left_bound, right_bound);
+  lanelet.attributes()[lanelet::AttributeName::Subtype] = lanelet::AttributeValueString::Road;
+  return lanelet;
+}
+
+Polygon3d createParkingLot(const std::vector<std::pair<double, double>> & vertices)
+{
+  Points3d points;
+  for (const auto & vertex : vertices) {
+    points.push_back(Point3d(getId(), vertex.first, vertex.second, 0.0));
+  }
+  Polygon3d parking_lot(getId(), points);
+  parking_lot.attributes()[lanelet::AttributeName::Type] = "parking_lot";
+  return parking_lot;
+}
+
+geometry_msgs::msg::Pose createPose(const double x, const double y)
+{
+  geometry_msgs::msg::Pose pose;
+  pose.position.x = x;
+  pose.position.y = y;
+  pose.orientation.w = 1.0;
+  return pose;
+}
+}  // namespace
+
+class ParkingLotIndexTest : public ::testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    // L-shaped parking lot, so that the notch is inside its bounding box but outside the polygon
+    //   (10, 0) - (30, 10) and (10, 10) - (20, 30)
+    parking_lot_ = createParkingLot({{10, 0}, {30, 0}, {30, 10}, {20, 10}, {20, 30}, {10, 30}});
+    far_parking_lot_ = createParkingLot({{200, 200}, {220, 200}, {220, 220}, {200, 220}});
+
+    entrance_lanelet_ = createLanelet(0, 0, 10, 4);  // touches the parking lot at x = 10
+    inner_lanelet_ = createLanelet(12, 2, 28, 6);
+    notch_lanelet_ = createLanelet(25, 18, 29, 22);  // only the bounding boxes overlap
+    road_lanelet_ = createLanelet(100, 0, 120, 4);
+
+    map_ptr_ = std::make_shared<lanelet::LaneletMap>();
+    map_ptr_->add(parking_lot_);
+    map_ptr_->add(far_parking_lot_);
+    map_ptr_->add(entrance_lanelet_);
+    map_ptr_->add(inner_lanelet_);
+    map_ptr_->add(notch_lanelet_);
+    map_ptr_->add(road_lanelet_);
+
+    index_ = createParkingLotIndex(map_ptr_);
+  }
+
+  bool isInParkingLot(const double x, const double y) const
+  {
+    return ::isInParkingLot(map_ptr_, index_, createPose(x, y));
+  }
+
+  Polygon3d parking_lot_;
+  Polygon3d far_parking_lot_;
+  Lanelet entrance_lanelet_;
+  Lanelet inner_lanelet_;
+  Lanelet notch_lanelet_;
+  Lanelet road_lanelet_;
+  std::shared_ptr<lanelet::LaneletMap> map_ptr_;
+  ParkingLotIndex index_;
+};
+
+TEST_F(ParkingLotIndexTest, CreateParkingLotIndex)
+{
+  ASSERT_EQ(index_.polygons.size(), 2U);
+  ASSERT_EQ(index_.bounding_boxes.size(), 2U);
+
+  // the lanelets touching the parking lot are linked to it
+  ASSERT_EQ(index_.lanelet_to_parking_lot.size(), 2U);
+  ASSERT_EQ(index_.lanelet_to_parking_lot.count(entrance_lanelet_.id()), 1U);
+  ASSERT_EQ(index_.lanelet_to_parking_lot.count(inner_lanelet_.id()), 1U);
+  const size_t parking_lot_idx = index_.lanelet_to_parking_lot.at(entrance_lanelet_.id());
+  EXPECT_EQ(index_.lanelet_to_parking_lot.at(inner_lanelet_.id()), parking_lot_idx);
+  EXPECT_EQ(index_.polygons.at(parking_lot_idx).size(), parking_lot_.size());
+
+  const auto & bounding_box = index_.bounding_boxes.at(parking_lot_idx);
+  EXPECT_DOUBLE_EQ(bounding_box.min().x(), 10.0);
+  EXPECT_DOUBLE_EQ(bounding_box.min().y(), 0.0);
+  EXPECT_DOUBLE_EQ(bounding_box.max().x(), 30.0);
+  EXPECT_DOUBLE_EQ(bounding_box.max().y(), 30.0);
+
+  // the notch lanelet is a bounding box candidate, but does not touch the polygon
+  EXPECT_EQ(index_.lanelet_to_parking_lot.count(notch_lanelet_.id()), 0U);
+  EXPECT_EQ(index_.lanelet_to_parking_lot.count(road_lanelet_.id()), 0U);
+}
+
+TEST_F(ParkingLotIndexTest, EmptyMap)
+{
+  const auto empty_map_ptr = std::make_shared<lanelet::LaneletMap>();
+  const auto empty_index = createParkingLotIndex(empty_map_ptr);
+  EXPECT_TRUE(empty_index.polygons.empty());
+  EXPECT_TRUE(empty_index.bounding_boxes.empty());
+  EXPECT_TRUE(empty_index.lanelet_to_parking_lot.empty());
+  EXPECT_FALSE(::isInParkingLot(empty_map_ptr, empty_index, createPose(15, 8)));
+}
+
+TEST_F(ParkingLotIndexTest, InsideParkingLot)
+{
+  // nearest to the inner lanelet
+  EXPECT_TRUE(isInParkingLot(15, 8));
+  EXPECT_TRUE(isInParkingLot(12, 14));
+}
+
+TEST_F(ParkingLotIndexTest, InsideBoundingBoxOutsidePolygon)
+{
+  // in the notch of the parking lot, nearest to the inner lanelet linked to it
+  const size_t parking_lot_idx = index_.lanelet_to_parking_lot.at(inner_lanelet_.id());
+  EXPECT_TRUE(index_.bounding_boxes.at(parking_lot_idx).contains(lanelet::BasicPoint2d(25, 11)));
+  EXPECT_FALSE(isInParkingLot(25, 11));
+}
+
+TEST_F(ParkingLotIndexTest, OutsideBoundingBox)
+{
+  // nearest to the entrance lanelet linked to the parking lot
+  EXPECT_FALSE(isInParkingLot(2, 2));
+  EXPECT_FALSE(isInParkingLot(5, -3));
+}
+
+TEST_F(ParkingLotIndexTest, NoLinkedParkingLot)
+{
+  EXPECT_FALSE(isInParkingLot(110, 2));
+  // inside the far parking lot, but the nearest lanelet is not linked to it
+  EXPECT_FALSE(isInParkingLot(210, 210));
+  // inside the bounding box of the parking lot, nearest to the notch lanelet
+  EXPECT_FALSE(isInParkingLot(27, 20));
+}
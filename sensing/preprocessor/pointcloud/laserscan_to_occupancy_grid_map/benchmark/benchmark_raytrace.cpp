@@ -0,0 +1,143 @@
+// Copyright 2021 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "laserscan_to_occupancy_grid_map/occupancy_grid_map.hpp"
+#include "laserscan_to_occupancy_grid_map/updater/occupancy_grid_map_binary_bayes_filter_updater.hpp"
+
+#include <benchmark/benchmark.h>
+#include <sensor_msgs/point_cloud2_iterator.hpp>
+
+#include <cmath>
+#include <random>
+
+namespace
+{
+using costmap_2d::OccupancyGridMap;
+using costmap_2d::OccupancyGridMapBBFUpdater;
+using geometry_msgs::msg::Pose;
+using sensor_msgs::msg::PointCloud2;
+
+constexpr double map_length = 100.0;
+constexpr double map_resolution = 0.5;
+constexpr double scan_angle_increment = 0.00436332222;  // 0.25 deg
+
+PointCloud2 createScan(const Pose & pose)
+{
+  const int num_points = static_cast<int>(2.0 * M_PI / scan_angle_increment);
+  PointCloud2 pointcloud;
+  sensor_msgs::PointCloud2Modifier modifier(pointcloud);
+  modifier.setPointCloud2FieldsByString(1, "xyz");
+  modifier.resize(num_points);
+
+  std::mt19937 engine(0);
+  std::uniform_real_distribution<double> range_distribution(2.0, map_length * 0.5);
+  sensor_msgs::PointCloud2Iterator<float> iter_x(pointcloud, "x");
+  sensor_msgs::PointCloud2Iterator<float> iter_y(pointcloud, "y");
+  sensor_msgs::PointCloud2Iterator<float> iter_z(pointcloud, "z");
+  for (int i = 0; i < num_points; ++i, ++iter_x, ++iter_y, ++iter_z) {
+    const double angle = -M_PI + i * scan_angle_increment;
+    const double range = range_distribution(engine);
+    *iter_x = pose.position.x + range * std::cos(angle);
+    *iter_y = pose.position.y + range * std::sin(angle);
+    *iter_z = 0.0;
+  }
+  return pointcloud;
+}
+
+void raytraceOneshotMap(
+  const PointCloud2 & scan, const Pose & pose, const double angle_resolution,
+  OccupancyGridMap & map)
+{
+  map.updateOrigin(
+    pose.position.x - map.getSizeInMetersX() / 2, pose.position.y - map.getSizeInMetersY() / 2);
+  map.setRaytraceAngleResolution(angle_resolution);
+  map.raytrace2D(scan, pose);
+}
+
+struct Inputs
+{
+  Pose pose;
+  PointCloud2 scan;
+
+  Inputs()
+  {
+    pose.position.x = 1000.0;
+    pose.position.y = 2000.0;
+    pose.orientation.w = 1.0;
+    scan = createScan(pose);
+  }
+};
+
+const Inputs & getInputs()
+{
+  static const Inputs inputs;
+  return inputs;
+}
+
+OccupancyGridMap createMap()
+{
+  return OccupancyGridMap(
+    map_length / map_resolution, map_length / map_resolution, map_resolution);
+}
+}  // namespace
+
+static void RaytraceSerial(benchmark::State & state)
+{
+  const auto & in = getInputs();
+  for (auto _ : state) {
+    auto map = createMap();
+    raytraceOneshotMap(in.scan, in.pose, 0.0, map);
+    benchmark::DoNotOptimize(map.getCharMap());
+  }
+}
+BENCHMARK(RaytraceSerial)->Unit(benchmark::kMillisecond);
+
+static void RaytraceSector(benchmark::State & state)
+{
+  const auto & in = getInputs();
+  for (auto _ : state) {
+    auto map = createMap();
+    raytraceOneshotMap(in.scan, in.pose, scan_angle_increment, map);
+    benchmark::DoNotOptimize(map.getCharMap());
+  }
+
+  // compare the resulting map with the serial raytrace
+  auto serial_map = createMap();
+  auto sector_map = createMap();
+  raytraceOneshotMap(in.scan, in.pose, 0.0, serial_map);
+  raytraceOneshotMap(in.scan, in.pose, scan_angle_increment, sector_map);
+  size_t num_different_cells = 0;
+  for (unsigned int x = 0; x < serial_map.getSizeInCellsX(); ++x) {
+    for (unsigned int y = 0; y < serial_map.getSizeInCellsY(); ++y) {
+      num_different_cells += serial_map.getCost(x, y) != sector_map.getCost(x, y);
+    }
+  }
+  state.counters["different_cells"] = static_cast<double>(num_different_cells);
+}
+BENCHMARK(RaytraceSector)->Unit(benchmark::kMillisecond);
+
+// fusion with the binary bayes filter
+static void BayesUpdate(benchmark::State & state)
+{
+  const auto & in = getInputs();
+  auto map = createMap();
+  raytraceOneshotMap(in.scan, in.pose, scan_angle_increment, map);
+  OccupancyGridMapBBFUpdater updater(
+    map_length / map_resolution, map_length / map_resolution, map_resolution);
+  for (auto _ : state) {
+    updater.update(map);
+    benchmark::DoNotOptimize(updater.getCharMap());
+  }
+}
+BENCHMARK(BayesUpdate)->Unit(benchmark::kMillisecond);
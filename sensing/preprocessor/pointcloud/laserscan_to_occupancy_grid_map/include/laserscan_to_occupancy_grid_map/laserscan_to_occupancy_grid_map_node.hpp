@@ -93,6 +93,7 @@ private:
   std::string map_frame_;
   std::string base_link_frame_;
   bool use_height_filter_;
+  double raytrace_angle_resolution_;
 };
 
 }  // namespace occupancy_grid_map
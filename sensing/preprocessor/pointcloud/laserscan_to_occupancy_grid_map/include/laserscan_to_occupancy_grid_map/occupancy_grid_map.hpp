@@ -72,6 +72,15 @@ public:
 
   void raytrace2D(const PointCloud2 & pointcloud, const Pose & robot_pose);
 
+  /**
+   * @brief bin the rays into angular sectors that keep only the nearest return, and raytrace
+   *        the sectors in parallel. A non-positive resolution selects the serial raytracing.
+   */
+  void setRaytraceAngleResolution(const double angle_resolution)
+  {
+    raytrace_angle_resolution_ = angle_resolution;
+  }
+
   void updateFreespaceCells(const PointCloud2 & pointcloud);
 
   void updateOccupiedCells(const PointCloud2 & pointcloud);
@@ -81,10 +90,18 @@ public:
 private:
   void raytraceFreespace(const PointCloud2 & pointcloud, const Pose & robot_pose);
 
+  void raytraceFreespaceBySectors(const PointCloud2 & pointcloud, const Pose & robot_pose);
+
+  bool clipRayEndpoint(
+    const double ox, const double oy, double wx, double wy, unsigned int & mx,
+    unsigned int & my) const;
+
   void updateCellsByPointCloud(const PointCloud2 & pointcloud, const unsigned char cost);
 
   bool worldToMap(double wx, double wy, unsigned int & mx, unsigned int & my) const;
 
+  double raytrace_angle_resolution_{0.0};
+
   rclcpp::Logger logger_{rclcpp::get_logger("occupancy_grid_map")};
   rclcpp::Clock clock_{RCL_ROS_TIME};
 };
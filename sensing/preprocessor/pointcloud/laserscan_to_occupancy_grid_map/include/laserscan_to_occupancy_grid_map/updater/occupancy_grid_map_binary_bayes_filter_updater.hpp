@@ -22,6 +22,8 @@
 #include <eigen3/Eigen/Core>
 #include <eigen3/Eigen/Geometry>
 
+#include <array>
+
 namespace costmap_2d
 {
 class OccupancyGridMapBBFUpdater : public OccupancyGridMapUpdaterInterface
@@ -37,12 +39,19 @@ public:
       1.0 - probability_matrix_(OCCUPIED, OCCUPIED);
     probability_matrix_(Index::FREE, Index::FREE) = 0.8;
     probability_matrix_(Index::OCCUPIED, Index::FREE) = 1.0 - probability_matrix_(FREE, FREE);
+    initializeFusionTable();
   }
   bool update(const Costmap2D & oneshot_occupancy_grid_map) override;
 
 private:
+  // measurement classes that share the same update rule
+  enum Measurement : size_t { LETHAL = 0U, FREE_SPACE = 1U, NO_INFORMATION = 2U, OTHER = 3U };
   inline unsigned char applyBBF(const unsigned char & z, const unsigned char & o);
+  void initializeFusionTable();
   Eigen::Matrix2f probability_matrix_;
+  // the result only depends on the measurement class and the previous cost, so it is tabulated
+  std::array<unsigned char, 256> measurement_classes_;
+  std::array<unsigned char, 4 * 256> fusion_table_;
 };
 
 }  // namespace costmap_2d
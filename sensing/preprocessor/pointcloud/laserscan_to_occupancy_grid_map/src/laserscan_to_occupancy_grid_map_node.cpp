@@ -119,6 +119,7 @@ OccupancyGridMapNode::OccupancyGridMapNode(const rclcpp::NodeOptions & node_opti
   map_frame_ = declare_parameter("map_frame", "map");
   base_link_frame_ = declare_parameter("base_link_frame", "base_link");
   use_height_filter_ = declare_parameter("use_height_filter", true);
+  raytrace_angle_resolution_ = declare_parameter("raytrace_angle_resolution", 0.00436332222);
   const double map_length{declare_parameter("map_length", 100.0)};
   const double map_resolution{declare_parameter("map_resolution", 0.5)};
   const bool input_obstacle_pointcloud{declare_parameter("input_obstacle_pointcloud", true)};
@@ -229,6 +230,7 @@ void OccupancyGridMapNode::onLaserscanPointCloud2WithObstacleAndRaw(
   oneshot_occupancy_grid_map.updateOrigin(
     pose.position.x - oneshot_occupancy_grid_map.getSizeInMetersX() / 2,
     pose.position.y - oneshot_occupancy_grid_map.getSizeInMetersY() / 2);
+  oneshot_occupancy_grid_map.setRaytraceAngleResolution(raytrace_angle_resolution_);
   oneshot_occupancy_grid_map.updateFreespaceCells(trans_raw_pc);
   oneshot_occupancy_grid_map.raytrace2D(trans_laserscan_pc, pose);
   oneshot_occupancy_grid_map.updateOccupiedCells(trans_obstacle_pc);
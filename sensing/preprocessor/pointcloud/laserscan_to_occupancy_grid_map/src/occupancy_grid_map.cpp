@@ -55,7 +55,15 @@
 
 #include <sensor_msgs/point_cloud2_iterator.hpp>
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 #include <algorithm>
+#include <cmath>
+#include <limits>
+#include <utility>
+#include <vector>
 
 namespace costmap_2d
 {
@@ -137,7 +145,11 @@ void OccupancyGridMap::updateOrigin(double new_origin_x, double new_origin_y)
 void OccupancyGridMap::raytrace2D(const PointCloud2 & pointcloud, const Pose & robot_pose)
 {
   // freespace
-  raytraceFreespace(pointcloud, robot_pose);
+  if (0.0 < raytrace_angle_resolution_) {
+    raytraceFreespaceBySectors(pointcloud, robot_pose);
+  } else {
+    raytraceFreespace(pointcloud, robot_pose);
+  }
 
   // occupied
   MarkCell marker(costmap_, occupancy_cost_value::LETHAL_OBSTACLE);
@@ -195,58 +207,142 @@ void OccupancyGridMap::raytraceFreespace(const PointCloud2 & pointcloud, const P
     return;
   }
 
-  // we can pre-compute the endpoints of the map outside of the inner loop... we'll need these later
-  const double origin_x = origin_x_, origin_y = origin_y_;
-  const double map_end_x = origin_x + size_x_ * resolution_;
-  const double map_end_y = origin_y + size_y_ * resolution_;
-
   for (PointCloud2ConstIterator<float> iter_x(pointcloud, "x"), iter_y(pointcloud, "y");
        iter_x != iter_x.end(); ++iter_x, ++iter_y) {
-    double wx = *iter_x;
-    double wy = *iter_y;
-
-    // now we also need to make sure that the endpoint we're ray-tracing
-    // to isn't off the costmap and scale if necessary
-    const double a = wx - ox;
-    const double b = wy - oy;
-
-    // the minimum value to raytrace from is the origin
-    if (wx < origin_x) {
-      const double t = (origin_x - ox) / a;
-      wx = origin_x;
-      wy = oy + b * t;
-    }
-    if (wy < origin_y) {
-      const double t = (origin_y - oy) / b;
-      wx = ox + a * t;
-      wy = origin_y;
+    unsigned int x1{};
+    unsigned int y1{};
+    if (!clipRayEndpoint(ox, oy, *iter_x, *iter_y, x1, y1)) {
+      continue;
     }
 
-    // the maximum value to raytrace to is the end of the map
-    if (wx > map_end_x) {
-      const double t = (map_end_x - ox) / a;
-      wx = map_end_x - .001;
-      wy = oy + b * t;
-    }
-    if (wy > map_end_y) {
-      const double t = (map_end_y - oy) / b;
-      wx = ox + a * t;
-      wy = map_end_y - .001;
+    constexpr unsigned int cell_raytrace_range = 10000;  // large number to ignore range threshold
+    MarkCell marker(costmap_, occupancy_cost_value::FREE_SPACE);
+    raytraceLine(marker, x0, y0, x1, y1, cell_raytrace_range);
+  }
+}
+
+void OccupancyGridMap::raytraceFreespaceBySectors(
+  const PointCloud2 & pointcloud, const Pose & robot_pose)
+{
+  unsigned int x0{};
+  unsigned int y0{};
+  const double ox{robot_pose.position.x};
+  const double oy{robot_pose.position.y};
+  if (!worldToMap(robot_pose.position.x, robot_pose.position.y, x0, y0)) {
+    RCLCPP_WARN_THROTTLE(
+      logger_, clock_, 1000,
+      "The origin for the sensor at (%.2f, %.2f) is out of map bounds. So, the costmap cannot "
+      "raytrace for it.",
+      ox, oy);
+    return;
+  }
+
+  // keep only the nearest return of each angular sector
+  const int num_sectors =
+    std::max(1, static_cast<int>(std::ceil(2.0 * M_PI / raytrace_angle_resolution_)));
+  std::vector<double> sector_squared_ranges(num_sectors, std::numeric_limits<double>::max());
+  std::vector<std::pair<double, double>> sector_endpoints(num_sectors);
+  for (PointCloud2ConstIterator<float> iter_x(pointcloud, "x"), iter_y(pointcloud, "y");
+       iter_x != iter_x.end(); ++iter_x, ++iter_y) {
+    const double dx = *iter_x - ox;
+    const double dy = *iter_y - oy;
+    const double squared_range = dx * dx + dy * dy;
+    const int sector = std::min(
+      num_sectors - 1,
+      static_cast<int>((std::atan2(dy, dx) + M_PI) / raytrace_angle_resolution_));
+    if (squared_range < sector_squared_ranges.at(sector)) {
+      sector_squared_ranges.at(sector) = squared_range;
+      sector_endpoints.at(sector) = std::make_pair(*iter_x, *iter_y);
     }
+  }
 
-    // now that the vector is scaled correctly... we'll get the map coordinates of its endpoint
+  std::vector<std::pair<unsigned int, unsigned int>> ray_endpoints;
+  ray_endpoints.reserve(num_sectors);
+  for (int sector = 0; sector < num_sectors; ++sector) {
     unsigned int x1{};
     unsigned int y1{};
-
-    // check for legality just in case
-    if (!worldToMap(wx, wy, x1, y1)) {
-      continue;
+    if (
+      sector_squared_ranges.at(sector) < std::numeric_limits<double>::max() &&
+      clipRayEndpoint(
+        ox, oy, sector_endpoints.at(sector).first, sector_endpoints.at(sector).second, x1, y1)) {
+      ray_endpoints.emplace_back(x1, y1);
     }
+  }
 
+  // raytrace into thread private masks so that rays sharing cells never write concurrently
+  int num_threads = 1;
+#ifdef _OPENMP
+  num_threads = omp_get_max_threads();
+#endif
+  const size_t num_cells = static_cast<size_t>(size_x_) * size_y_;
+  std::vector<unsigned char> free_masks(num_threads * num_cells, 0);
+  const int num_rays = static_cast<int>(ray_endpoints.size());
+
+#pragma omp parallel for schedule(dynamic, 16)
+  for (int i = 0; i < num_rays; ++i) {
+    int thread_id = 0;
+#ifdef _OPENMP
+    thread_id = omp_get_thread_num();
+#endif
     constexpr unsigned int cell_raytrace_range = 10000;  // large number to ignore range threshold
-    MarkCell marker(costmap_, occupancy_cost_value::FREE_SPACE);
-    raytraceLine(marker, x0, y0, x1, y1, cell_raytrace_range);
+    MarkCell marker(free_masks.data() + thread_id * num_cells, 1);
+    raytraceLine(
+      marker, x0, y0, ray_endpoints[i].first, ray_endpoints[i].second, cell_raytrace_range);
   }
+
+  const int num_cells_int = static_cast<int>(num_cells);
+#pragma omp parallel for
+  for (int cell = 0; cell < num_cells_int; ++cell) {
+    for (int thread_id = 0; thread_id < num_threads; ++thread_id) {
+      if (free_masks[thread_id * num_cells + cell]) {
+        costmap_[cell] = occupancy_cost_value::FREE_SPACE;
+        break;
+      }
+    }
+  }
+}
+
+bool OccupancyGridMap::clipRayEndpoint(
+  const double ox, const double oy, double wx, double wy, unsigned int & mx,
+  unsigned int & my) const
+{
+  // we can pre-compute the endpoints of the map outside of the inner loop... we'll need these later
+  const double origin_x = origin_x_, origin_y = origin_y_;
+  const double map_end_x = origin_x + size_x_ * resolution_;
+  const double map_end_y = origin_y + size_y_ * resolution_;
+
+  // now we also need to make sure that the endpoint we're ray-tracing
+  // to isn't off the costmap and scale if necessary
+  const double a = wx - ox;
+  const double b = wy - oy;
+
+  // the minimum value to raytrace from is the origin
+  if (wx < origin_x) {
+    const double t = (origin_x - ox) / a;
+    wx = origin_x;
+    wy = oy + b * t;
+  }
+  if (wy < origin_y) {
+    const double t = (origin_y - oy) / b;
+    wx = ox + a * t;
+    wy = origin_y;
+  }
+
+  // the maximum value to raytrace to is the end of the map
+  if (wx > map_end_x) {
+    const double t = (map_end_x - ox) / a;
+    wx = map_end_x - .001;
+    wy = oy + b * t;
+  }
+  if (wy > map_end_y) {
+    const double t = (map_end_y - oy) / b;
+    wx = ox + a * t;
+    wy = map_end_y - .001;
+  }
+
+  // now that the vector is scaled correctly... we'll get the map coordinates of its endpoint
+  // and check for legality just in case
+  return worldToMap(wx, wy, mx, my);
 }
 
 }  // namespace costmap_2d
@@ -45,14 +45,34 @@ inline unsigned char OccupancyGridMapBBFUpdater::applyBBF(
     static_cast<unsigned char>(254));
 }
 
+void OccupancyGridMapBBFUpdater::initializeFusionTable()
+{
+  measurement_classes_.fill(Measurement::OTHER);
+  measurement_classes_[occupancy_cost_value::LETHAL_OBSTACLE] = Measurement::LETHAL;
+  measurement_classes_[occupancy_cost_value::FREE_SPACE] = Measurement::FREE_SPACE;
+  measurement_classes_[occupancy_cost_value::NO_INFORMATION] = Measurement::NO_INFORMATION;
+
+  // representative measurement of each class
+  constexpr unsigned char other_measurement = 1;
+  const std::array<unsigned char, 4> measurements{
+    occupancy_cost_value::LETHAL_OBSTACLE, occupancy_cost_value::FREE_SPACE,
+    occupancy_cost_value::NO_INFORMATION, other_measurement};
+  for (size_t m = 0; m < measurements.size(); ++m) {
+    for (size_t o = 0; o < 256; ++o) {
+      fusion_table_[m * 256 + o] = applyBBF(measurements[m], static_cast<unsigned char>(o));
+    }
+  }
+}
+
 bool OccupancyGridMapBBFUpdater::update(const Costmap2D & oneshot_occupancy_grid_map)
 {
   updateOrigin(oneshot_occupancy_grid_map.getOriginX(), oneshot_occupancy_grid_map.getOriginY());
-  for (unsigned int x = 0; x < getSizeInCellsX(); x++) {
-    for (unsigned int y = 0; y < getSizeInCellsY(); y++) {
-      unsigned int index = getIndex(x, y);
-      costmap_[index] = applyBBF(oneshot_occupancy_grid_map.getCost(x, y), costmap_[index]);
-    }
+  // both maps share the same size and origin here, so fuse them in one pass over contiguous cells
+  const unsigned char * oneshot_costmap = oneshot_occupancy_grid_map.getCharMap();
+  const size_t num_cells = static_cast<size_t>(getSizeInCellsX()) * getSizeInCellsY();
+  for (size_t index = 0; index < num_cells; ++index) {
+    const size_t measurement = measurement_classes_[oneshot_costmap[index]];
+    costmap_[index] = fusion_table_[measurement * 256 + costmap_[index]];
   }
   return true;
 }
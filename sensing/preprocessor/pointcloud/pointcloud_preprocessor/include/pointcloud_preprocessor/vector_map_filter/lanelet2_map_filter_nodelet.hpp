@@ -15,6 +15,8 @@
 #ifndef POINTCLOUD_PREPROCESSOR__VECTOR_MAP_FILTER__LANELET2_MAP_FILTER_NODELET_HPP_
 #define POINTCLOUD_PREPROCESSOR__VECTOR_MAP_FILTER__LANELET2_MAP_FILTER_NODELET_HPP_
 
+#include "pointcloud_preprocessor/vector_map_filter/road_mask.hpp"
+
 #include <autoware_utils/geometry/boost_geometry.hpp>
 #include <lanelet2_extension/utility/message_conversion.hpp>
 #include <lanelet2_extension/utility/query.hpp>
@@ -58,14 +60,21 @@ private:
 
   lanelet::LaneletMapPtr lanelet_map_ptr_;
   lanelet::ConstLanelets road_lanelets_;
+  std::shared_ptr<const RoadMask> road_mask_;
 
   float voxel_size_x_;
   float voxel_size_y_;
+  bool use_road_mask_;
+  double road_mask_resolution_;
+  bool road_mask_exact_boundary_;
 
   void pointcloudCallback(const PointCloud2ConstPtr msg);
 
   void mapCallback(const autoware_auto_mapping_msgs::msg::HADMapBin::ConstSharedPtr msg);
 
+  // rebuild road_mask_ from road_lanelets_ with the current road mask parameters
+  void buildRoadMask();
+
   bool transformPointCloud(
     const std::string & in_target_frame, const PointCloud2ConstPtr & in_cloud_ptr,
     PointCloud2 * out_cloud_ptr);
@@ -81,6 +90,9 @@ private:
 
   bool pointWithinLanelets(const Point2d & point, const lanelet::ConstLanelets & joint_lanelets);
 
+  pcl::PointCloud<pcl::PointXYZ> getRoadMaskFilteredPointCloud(
+    const RoadMask & road_mask, const pcl::PointCloud<pcl::PointXYZ>::Ptr & cloud);
+
   /** \brief Parameter service callback result : needed to be hold */
   OnSetParametersCallbackHandle::SharedPtr set_param_res_;
 
@@ -0,0 +1,90 @@
+// Copyright 2021 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef POINTCLOUD_PREPROCESSOR__VECTOR_MAP_FILTER__ROAD_MASK_HPP_
+#define POINTCLOUD_PREPROCESSOR__VECTOR_MAP_FILTER__ROAD_MASK_HPP_
+
+#include <autoware_utils/geometry/boost_geometry.hpp>
+
+#include <boost/geometry/index/rtree.hpp>
+
+#include <array>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace pointcloud_preprocessor
+{
+/**
+ * @brief Rasterized bitmask of the road area of a vector map.
+ *
+ * The map bounding box is split into tiles of kTileSize x kTileSize cells. Only tiles touched by
+ * a road polygon are allocated, and each tile stores one 64 bit word per cell row for the road
+ * layer and the boundary layer. A cell is marked as road when its center lies inside a road
+ * polygon, and as boundary when a polygon edge passes through it. Boundary cells can optionally
+ * be resolved by an exact point-in-polygon test.
+ */
+class RoadMask
+{
+public:
+  static constexpr int kTileSize = 64;
+
+  RoadMask() = default;
+  RoadMask(
+    const std::vector<autoware_utils::Polygon2d> & road_polygons, const double resolution,
+    const bool use_exact_boundary);
+
+  bool isOnRoad(const double x, const double y) const;
+
+  bool empty() const { return tiles_.empty(); }
+  double getResolution() const { return resolution_; }
+  size_t getNumTiles() const { return tiles_.size(); }
+
+private:
+  using BoxIndex = std::pair<autoware_utils::Box2d, size_t>;
+  using RTree = boost::geometry::index::rtree<BoxIndex, boost::geometry::index::rstar<16>>;
+
+  struct Tile
+  {
+    std::array<uint64_t, kTileSize> road{};
+    std::array<uint64_t, kTileSize> boundary{};
+  };
+
+  double resolution_ = 0.0;
+  double inv_resolution_ = 0.0;
+  double origin_x_ = 0.0;
+  double origin_y_ = 0.0;
+  int64_t width_ = 0;
+  int64_t height_ = 0;
+  int64_t tiles_x_ = 0;
+  int64_t tiles_y_ = 0;
+  bool use_exact_boundary_ = false;
+
+  std::vector<int32_t> tile_indices_;
+  std::vector<Tile> tiles_;
+
+  std::vector<autoware_utils::Polygon2d> polygons_;
+  RTree rtree_;
+
+  Tile & getOrCreateTile(const int64_t cx, const int64_t cy);
+  void setRoadSpan(const int64_t cx_begin, const int64_t cx_end, const int64_t cy);
+  void setBoundary(const int64_t cx, const int64_t cy);
+  void rasterizeEdges(const autoware_utils::LinearRing2d & ring);
+  void rasterizeInterior(const autoware_utils::Polygon2d & polygon);
+  bool isWithinPolygons(const double x, const double y) const;
+};
+
+}  // namespace pointcloud_preprocessor
+
+#endif  // POINTCLOUD_PREPROCESSOR__VECTOR_MAP_FILTER__ROAD_MASK_HPP_
@@ -19,6 +19,7 @@
 #include <pcl_ros/transforms.hpp>
 
 #include <boost/geometry/algorithms/convex_hull.hpp>
+#include <boost/geometry/algorithms/correct.hpp>
 #include <boost/geometry/algorithms/intersects.hpp>
 
 #include <lanelet2_core/geometry/Polygon.h>
@@ -41,6 +42,15 @@ Lanelet2MapFilterComponent::Lanelet2MapFilterComponent(const rclcpp::NodeOptions
   {
     voxel_size_x_ = declare_parameter("voxel_size_x", 0.04);
     voxel_size_y_ = declare_parameter("voxel_size_y", 0.04);
+    use_road_mask_ = declare_parameter("use_road_mask", true);
+    road_mask_resolution_ = declare_parameter("road_mask_resolution", 0.2);
+    road_mask_exact_boundary_ = declare_parameter("road_mask_exact_boundary", true);
+    if (use_road_mask_ && road_mask_resolution_ <= 0.0) {
+      RCLCPP_ERROR(
+        get_logger(), "road_mask_resolution must be positive: %f. The road mask is disabled.",
+        road_mask_resolution_);
+      use_road_mask_ = false;
+    }
   }
 
   // Set publisher
@@ -79,6 +89,15 @@ Lanelet2MapFilterComponent::Lanelet2MapFilterComponent(const rclcpp::NodeOptions
 rcl_interfaces::msg::SetParametersResult Lanelet2MapFilterComponent::paramCallback(
   const std::vector<rclcpp::Parameter> & p)
 {
+  rcl_interfaces::msg::SetParametersResult result;
+
+  double road_mask_resolution = road_mask_resolution_;
+  if (get_param(p, "road_mask_resolution", road_mask_resolution) && road_mask_resolution <= 0.0) {
+    result.successful = false;
+    result.reason = "road_mask_resolution must be positive";
+    return result;
+  }
+
   if (get_param(p, "voxel_size_x", voxel_size_x_)) {
     RCLCPP_DEBUG(get_logger(), "Setting voxel_size_x to: %f.", voxel_size_x_);
   }
@@ -87,7 +106,23 @@ rcl_interfaces::msg::SetParametersResult Lanelet2MapFilterComponent::paramCallba
     RCLCPP_DEBUG(get_logger(), "Setting voxel_size_y to: %f.", voxel_size_y_);
   }
 
-  rcl_interfaces::msg::SetParametersResult result;
+  if (get_param(p, "use_road_mask", use_road_mask_)) {
+    RCLCPP_DEBUG(get_logger(), "Setting use_road_mask to: %d.", use_road_mask_);
+  }
+
+  bool road_mask_exact_boundary = road_mask_exact_boundary_;
+  get_param(p, "road_mask_exact_boundary", road_mask_exact_boundary);
+  if (
+    road_mask_resolution != road_mask_resolution_ ||
+    road_mask_exact_boundary != road_mask_exact_boundary_) {
+    road_mask_resolution_ = road_mask_resolution;
+    road_mask_exact_boundary_ = road_mask_exact_boundary;
+    RCLCPP_DEBUG(
+      get_logger(), "Setting road_mask_resolution to: %f, road_mask_exact_boundary to: %d.",
+      road_mask_resolution_, road_mask_exact_boundary_);
+    buildRoadMask();
+  }
+
   result.successful = true;
   result.reason = "success";
 
@@ -216,11 +251,44 @@ pcl::PointCloud<pcl::PointXYZ> Lanelet2MapFilterComponent::getLaneFilteredPointC
   return filtered_cloud;
 }
 
+pcl::PointCloud<pcl::PointXYZ> Lanelet2MapFilterComponent::getRoadMaskFilteredPointCloud(
+  const RoadMask & road_mask, const pcl::PointCloud<pcl::PointXYZ>::Ptr & cloud)
+{
+  const int num_points = static_cast<int>(cloud->points.size());
+  std::vector<uint8_t> is_on_road(num_points);
+
+#pragma omp parallel for
+  for (int i = 0; i < num_points; ++i) {
+    const auto & p = cloud->points[i];
+    is_on_road[i] = road_mask.isOnRoad(p.x, p.y);
+  }
+
+  pcl::PointCloud<pcl::PointXYZ> filtered_cloud;
+  filtered_cloud.header = cloud->header;
+  filtered_cloud.points.reserve(num_points);
+  for (int i = 0; i < num_points; ++i) {
+    if (is_on_road[i]) {
+      filtered_cloud.points.push_back(cloud->points[i]);
+    }
+  }
+  filtered_cloud.width = filtered_cloud.points.size();
+  filtered_cloud.height = 1;
+  return filtered_cloud;
+}
+
 void Lanelet2MapFilterComponent::pointcloudCallback(const PointCloud2ConstPtr cloud_msg)
 {
   if (!lanelet_map_ptr_) {
     return;
   }
+  const auto road_mask = road_mask_;
+  if (use_road_mask_ && road_mask && road_mask->empty()) {
+    // no road area to filter with, pass the input through instead of dropping every point
+    RCLCPP_WARN_THROTTLE(
+      get_logger(), *get_clock(), 10000, "The road mask is empty. Points are not filtered.");
+    filtered_pointcloud_pub_->publish(*cloud_msg);
+    return;
+  }
   // transform pointcloud to map frame
   PointCloud2Ptr input_transformed_cloud_ptr(new sensor_msgs::msg::PointCloud2);
   if (!transformPointCloud("map", cloud_msg, input_transformed_cloud_ptr.get())) {
@@ -236,12 +304,19 @@ void Lanelet2MapFilterComponent::pointcloudCallback(const PointCloud2ConstPtr cl
   if (cloud->points.empty()) {
     return;
   }
-  // calculate convex hull
-  const auto convex_hull = getConvexHull(cloud);
-  // get intersected lanelets
-  lanelet::ConstLanelets intersected_lanelets = getIntersectedLanelets(convex_hull, road_lanelets_);
-  // filter pointcloud by lanelet
-  const auto filtered_cloud = getLaneFilteredPointCloud(intersected_lanelets, cloud);
+  pcl::PointCloud<pcl::PointXYZ> filtered_cloud;
+  if (use_road_mask_ && road_mask) {
+    // filter pointcloud by the precomputed road mask
+    filtered_cloud = getRoadMaskFilteredPointCloud(*road_mask, cloud);
+  } else {
+    // calculate convex hull
+    const auto convex_hull = getConvexHull(cloud);
+    // get intersected lanelets
+    lanelet::ConstLanelets intersected_lanelets =
+      getIntersectedLanelets(convex_hull, road_lanelets_);
+    // filter pointcloud by lanelet
+    filtered_cloud = getLaneFilteredPointCloud(intersected_lanelets, cloud);
+  }
   // transform pointcloud to input frame
   PointCloud2Ptr output_cloud_ptr(new sensor_msgs::msg::PointCloud2);
   pcl::toROSMsg(filtered_cloud, *output_cloud_ptr);
@@ -265,6 +340,35 @@ void Lanelet2MapFilterComponent::mapCallback(
   lanelet::utils::conversion::fromBinMsg(*map_msg, lanelet_map_ptr_);
   const lanelet::ConstLanelets all_lanelets = lanelet::utils::query::laneletLayer(lanelet_map_ptr_);
   road_lanelets_ = lanelet::utils::query::roadLanelets(all_lanelets);
+  buildRoadMask();
+}
+
+void Lanelet2MapFilterComponent::buildRoadMask()
+{
+  if (!lanelet_map_ptr_) {
+    return;
+  }
+
+  // rasterize road area once per map
+  std::vector<autoware_utils::Polygon2d> road_polygons;
+  road_polygons.reserve(road_lanelets_.size());
+  for (const auto & road_lanelet : road_lanelets_) {
+    autoware_utils::Polygon2d polygon;
+    for (const auto & p : road_lanelet.polygon2d().basicPolygon()) {
+      polygon.outer().emplace_back(p.x(), p.y());
+    }
+    boost::geometry::correct(polygon);
+    road_polygons.push_back(polygon);
+  }
+  road_mask_ = std::make_shared<const RoadMask>(
+    road_polygons, road_mask_resolution_, road_mask_exact_boundary_);
+  if (road_mask_->empty()) {
+    RCLCPP_WARN(get_logger(), "Built an empty road mask from %zu lanelets", road_polygons.size());
+    return;
+  }
+  RCLCPP_INFO(
+    get_logger(), "Built road mask: %zu tiles at %.2f m resolution", road_mask_->getNumTiles(),
+    road_mask_resolution_);
 }
 
 }  // namespace pointcloud_preprocessor
@@ -0,0 +1,202 @@
+// Copyright 2021 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "pointcloud_preprocessor/vector_map_filter/road_mask.hpp"
+
+#include <boost/geometry/algorithms/envelope.hpp>
+#include <boost/geometry/algorithms/expand.hpp>
+#include <boost/geometry/algorithms/within.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+namespace pointcloud_preprocessor
+{
+using autoware_utils::Box2d;
+using autoware_utils::LinearRing2d;
+using autoware_utils::Point2d;
+using autoware_utils::Polygon2d;
+
+RoadMask::RoadMask(
+  const std::vector<Polygon2d> & road_polygons, const double resolution,
+  const bool use_exact_boundary)
+: resolution_(resolution), use_exact_boundary_(use_exact_boundary)
+{
+  if (road_polygons.empty() || resolution <= 0.0) {
+    return;
+  }
+  inv_resolution_ = 1.0 / resolution_;
+
+  Box2d map_box;
+  boost::geometry::assign_inverse(map_box);
+  std::vector<BoxIndex> boxes;
+  boxes.reserve(road_polygons.size());
+  for (size_t i = 0; i < road_polygons.size(); ++i) {
+    Box2d box;
+    boost::geometry::envelope(road_polygons.at(i), box);
+    boost::geometry::expand(map_box, box);
+    boxes.emplace_back(box, i);
+  }
+
+  // leave a margin of one cell around the map so that edge cells never fall outside the grid
+  origin_x_ = map_box.min_corner().x() - resolution_;
+  origin_y_ = map_box.min_corner().y() - resolution_;
+  width_ = static_cast<int64_t>(
+             std::ceil((map_box.max_corner().x() - map_box.min_corner().x()) * inv_resolution_)) +
+           3;
+  height_ = static_cast<int64_t>(
+              std::ceil((map_box.max_corner().y() - map_box.min_corner().y()) * inv_resolution_)) +
+            3;
+  tiles_x_ = (width_ + kTileSize - 1) / kTileSize;
+  tiles_y_ = (height_ + kTileSize - 1) / kTileSize;
+  tile_indices_.assign(tiles_x_ * tiles_y_, -1);
+
+  for (const auto & polygon : road_polygons) {
+    rasterizeInterior(polygon);
+    rasterizeEdges(polygon.outer());
+    for (const auto & inner : polygon.inners()) {
+      rasterizeEdges(inner);
+    }
+  }
+
+  if (use_exact_boundary_) {
+    polygons_ = road_polygons;
+    rtree_ = RTree(boxes.begin(), boxes.end());
+  }
+}
+
+RoadMask::Tile & RoadMask::getOrCreateTile(const int64_t cx, const int64_t cy)
+{
+  auto & tile_index = tile_indices_.at((cy / kTileSize) * tiles_x_ + cx / kTileSize);
+  if (tile_index < 0) {
+    tile_index = static_cast<int32_t>(tiles_.size());
+    tiles_.emplace_back();
+  }
+  return tiles_.at(tile_index);
+}
+
+void RoadMask::setRoadSpan(const int64_t cx_begin, const int64_t cx_end, const int64_t cy)
+{
+  for (int64_t cx = std::max<int64_t>(cx_begin, 0); cx <= std::min(cx_end, width_ - 1); ++cx) {
+    getOrCreateTile(cx, cy).road.at(cy % kTileSize) |= uint64_t{1} << (cx % kTileSize);
+  }
+}
+
+void RoadMask::setBoundary(const int64_t cx, const int64_t cy)
+{
+  if (cx < 0 || cy < 0 || cx >= width_ || cy >= height_) {
+    return;
+  }
+  getOrCreateTile(cx, cy).boundary.at(cy % kTileSize) |= uint64_t{1} << (cx % kTileSize);
+}
+
+void RoadMask::rasterizeEdges(const LinearRing2d & ring)
+{
+  // sample each edge densely enough that no crossed cell is skipped
+  const double step = 0.25 * resolution_;
+  for (size_t i = 0; i < ring.size(); ++i) {
+    const auto & p0 = ring.at(i);
+    const auto & p1 = ring.at((i + 1) % ring.size());
+    const double length = std::hypot(p1.x() - p0.x(), p1.y() - p0.y());
+    const int num_samples = std::max(1, static_cast<int>(std::ceil(length / step)));
+    for (int j = 0; j <= num_samples; ++j) {
+      const double t = static_cast<double>(j) / num_samples;
+      const double x = p0.x() + t * (p1.x() - p0.x());
+      const double y = p0.y() + t * (p1.y() - p0.y());
+      setBoundary(
+        static_cast<int64_t>(std::floor((x - origin_x_) * inv_resolution_)),
+        static_cast<int64_t>(std::floor((y - origin_y_) * inv_resolution_)));
+    }
+  }
+}
+
+void RoadMask::rasterizeInterior(const Polygon2d & polygon)
+{
+  Box2d box;
+  boost::geometry::envelope(polygon, box);
+  const auto cy_begin =
+    static_cast<int64_t>(std::floor((box.min_corner().y() - origin_y_) * inv_resolution_));
+  const auto cy_end =
+    static_cast<int64_t>(std::floor((box.max_corner().y() - origin_y_) * inv_resolution_));
+
+  // scanline fill at cell center height with even-odd rule, which also handles inner rings
+  std::vector<double> crossings;
+  const auto collect_crossings = [&crossings](const LinearRing2d & ring, const double y) {
+    for (size_t i = 0; i < ring.size(); ++i) {
+      const auto & a = ring.at(i);
+      const auto & b = ring.at((i + 1) % ring.size());
+      if ((a.y() > y) != (b.y() > y)) {
+        crossings.push_back(a.x() + (y - a.y()) * (b.x() - a.x()) / (b.y() - a.y()));
+      }
+    }
+  };
+
+  for (int64_t cy = std::max<int64_t>(cy_begin, 0); cy <= std::min(cy_end, height_ - 1); ++cy) {
+    const double y = origin_y_ + (static_cast<double>(cy) + 0.5) * resolution_;
+    crossings.clear();
+    collect_crossings(polygon.outer(), y);
+    for (const auto & inner : polygon.inners()) {
+      collect_crossings(inner, y);
+    }
+    std::sort(crossings.begin(), crossings.end());
+    for (size_t i = 0; i + 1 < crossings.size(); i += 2) {
+      const auto cx_begin = static_cast<int64_t>(
+        std::ceil((crossings.at(i) - origin_x_) * inv_resolution_ - 0.5));
+      const auto cx_end = static_cast<int64_t>(
+        std::floor((crossings.at(i + 1) - origin_x_) * inv_resolution_ - 0.5));
+      setRoadSpan(cx_begin, cx_end, cy);
+    }
+  }
+}
+
+bool RoadMask::isWithinPolygons(const double x, const double y) const
+{
+  const Point2d point(x, y);
+  for (auto itr = rtree_.qbegin(boost::geometry::index::intersects(point)); itr != rtree_.qend();
+       ++itr) {
+    if (boost::geometry::within(point, polygons_.at(itr->second))) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool RoadMask::isOnRoad(const double x, const double y) const
+{
+  const double fx = (x - origin_x_) * inv_resolution_;
+  const double fy = (y - origin_y_) * inv_resolution_;
+  // also rejects NaN
+  if (!(fx >= 0.0 && fy >= 0.0 && fx < static_cast<double>(width_) &&
+        fy < static_cast<double>(height_))) {
+    return false;
+  }
+  const auto cx = static_cast<int64_t>(fx);
+  const auto cy = static_cast<int64_t>(fy);
+
+  const int32_t tile_index = tile_indices_[(cy / kTileSize) * tiles_x_ + cx / kTileSize];
+  if (tile_index < 0) {
+    return false;
+  }
+  const auto & tile = tiles_[tile_index];
+  const uint64_t bit = uint64_t{1} << (cx % kTileSize);
+  const auto row = cy % kTileSize;
+  if (use_exact_boundary_ && (tile.boundary[row] & bit)) {
+    return isWithinPolygons(x, y);
+  }
+  return tile.road[row] & bit;
+}
+
+}  // namespace pointcloud_preprocessor
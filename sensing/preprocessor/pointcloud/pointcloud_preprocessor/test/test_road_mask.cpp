@@ -0,0 +1,167 @@
+// Copyright 2021 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "pointcloud_preprocessor/vector_map_filter/road_mask.hpp"
+
+#include <boost/geometry/algorithms/correct.hpp>
+#include <boost/geometry/algorithms/within.hpp>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <vector>
+
+using autoware_utils::LinearRing2d;
+using autoware_utils::Point2d;
+using autoware_utils::Polygon2d;
+using pointcloud_preprocessor::RoadMask;
+
+namespace
+{
+Polygon2d createPolygon(const std::vector<Point2d> & outer, const std::vector<Point2d> & inner = {})
+{
+  Polygon2d polygon;
+  polygon.outer().assign(outer.begin(), outer.end());
+  if (!inner.empty()) {
+    polygon.inners().emplace_back(inner.begin(), inner.end());
+  }
+  boost::geometry::correct(polygon);
+  return polygon;
+}
+
+// rectangle, rotated rectangle, triangle and rectangle with a hole spread over several tiles
+std::vector<Polygon2d> createRoadPolygons()
+{
+  return {
+    createPolygon({{0.0, 0.0}, {30.0, 0.0}, {30.0, 3.5}, {0.0, 3.5}}),
+    createPolygon({{30.0, 0.0}, {45.0, 15.0}, {42.5, 17.5}, {27.5, 2.5}}),
+    createPolygon({{-20.0, -5.0}, {-2.0, -1.0}, {-15.0, 12.3}}),
+    createPolygon(
+      {{50.0, 30.0}, {70.0, 30.0}, {70.0, 45.0}, {50.0, 45.0}},
+      {{55.0, 35.0}, {65.0, 35.0}, {65.0, 40.0}, {55.0, 40.0}}),
+  };
+}
+
+bool isWithinPolygons(const std::vector<Polygon2d> & polygons, const Point2d & point)
+{
+  for (const auto & polygon : polygons) {
+    if (boost::geometry::within(point, polygon)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+double getDistanceToSegment(const Point2d & p, const Point2d & a, const Point2d & b)
+{
+  const double dx = b.x() - a.x();
+  const double dy = b.y() - a.y();
+  const double t = std::max(
+    0.0, std::min(1.0, ((p.x() - a.x()) * dx + (p.y() - a.y()) * dy) / (dx * dx + dy * dy)));
+  return std::hypot(a.x() + t * dx - p.x(), a.y() + t * dy - p.y());
+}
+
+double getDistanceToBoundary(const std::vector<Polygon2d> & polygons, const Point2d & point)
+{
+  double min_distance = std::numeric_limits<double>::max();
+  const auto update = [&](const LinearRing2d & ring) {
+    for (size_t i = 0; i + 1 < ring.size(); ++i) {
+      const double distance = getDistanceToSegment(point, ring.at(i), ring.at(i + 1));
+      min_distance = std::min(min_distance, distance);
+    }
+  };
+  for (const auto & polygon : polygons) {
+    update(polygon.outer());
+    for (const auto & inner : polygon.inners()) {
+      update(inner);
+    }
+  }
+  return min_distance;
+}
+
+std::vector<Point2d> createRandomPoints(const size_t num)
+{
+  std::mt19937 engine(0);
+  std::uniform_real_distribution<double> x_dist(-30.0, 80.0);
+  std::uniform_real_distribution<double> y_dist(-15.0, 55.0);
+  std::vector<Point2d> points;
+  for (size_t i = 0; i < num; ++i) {
+    points.emplace_back(x_dist(engine), y_dist(engine));
+  }
+  return points;
+}
+}  // namespace
+
+TEST(RoadMask, InvalidInput)
+{
+  const auto polygons = createRoadPolygons();
+  for (const double resolution : {0.0, -0.2}) {
+    const RoadMask road_mask(polygons, resolution, true);
+    EXPECT_TRUE(road_mask.empty());
+    EXPECT_FALSE(road_mask.isOnRoad(10.0, 1.0));
+  }
+
+  const RoadMask no_road_mask({}, 0.2, true);
+  EXPECT_TRUE(no_road_mask.empty());
+  EXPECT_FALSE(no_road_mask.isOnRoad(10.0, 1.0));
+
+  const RoadMask default_road_mask;
+  EXPECT_TRUE(default_road_mask.empty());
+  EXPECT_FALSE(default_road_mask.isOnRoad(10.0, 1.0));
+}
+
+TEST(RoadMask, OutsideOfMap)
+{
+  const RoadMask road_mask(createRoadPolygons(), 0.2, true);
+  ASSERT_FALSE(road_mask.empty());
+  EXPECT_TRUE(road_mask.isOnRoad(10.0, 1.0));
+  EXPECT_FALSE(road_mask.isOnRoad(-1000.0, 1.0));
+  EXPECT_FALSE(road_mask.isOnRoad(1000.0, 1.0));
+  EXPECT_FALSE(road_mask.isOnRoad(10.0, 1000.0));
+  EXPECT_FALSE(road_mask.isOnRoad(std::numeric_limits<double>::quiet_NaN(), 1.0));
+  // inside of the hole
+  EXPECT_FALSE(road_mask.isOnRoad(60.0, 37.5));
+}
+
+TEST(RoadMask, ExactBoundary)
+{
+  const auto polygons = createRoadPolygons();
+  for (const double resolution : {0.1, 0.2, 1.0, 3.0}) {
+    const RoadMask road_mask(polygons, resolution, true);
+    ASSERT_FALSE(road_mask.empty());
+    for (const auto & p : createRandomPoints(100000)) {
+      ASSERT_EQ(road_mask.isOnRoad(p.x(), p.y()), isWithinPolygons(polygons, p))
+        << "resolution: " << resolution << ", point: (" << p.x() << ", " << p.y() << ")";
+    }
+  }
+}
+
+TEST(RoadMask, ApproximateBoundary)
+{
+  const auto polygons = createRoadPolygons();
+  for (const double resolution : {0.1, 0.2, 1.0}) {
+    const RoadMask road_mask(polygons, resolution, false);
+    ASSERT_FALSE(road_mask.empty());
+    // only the points within a cell from the boundary may be misclassified
+    for (const auto & p : createRandomPoints(100000)) {
+      if (road_mask.isOnRoad(p.x(), p.y()) != isWithinPolygons(polygons, p)) {
+        ASSERT_LE(getDistanceToBoundary(polygons, p), std::sqrt(2.0) * resolution)
+          << "resolution: " << resolution << ", point: (" << p.x() << ", " << p.y() << ")";
+      }
+    }
+  }
+}
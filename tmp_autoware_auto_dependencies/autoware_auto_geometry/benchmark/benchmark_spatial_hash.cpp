@@ -0,0 +1,165 @@
+// Copyright 2021 the Autoware Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Co-developed by Tier IV, Inc. and Apex.AI, Inc.
+
+#include <benchmark/benchmark.h>
+#include <geometry/spatial_hash.hpp>
+#include <geometry/spatial_hash_flat.hpp>
+#include <geometry_msgs/msg/point32.hpp>
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+namespace
+{
+using autoware::common::geometry::spatial_hash::Config2d;
+using autoware::common::geometry::spatial_hash::Config3d;
+using autoware::common::geometry::spatial_hash::FlatSpatialHash;
+using autoware::common::geometry::spatial_hash::SpatialHash;
+using PointT = geometry_msgs::msg::Point32;
+
+constexpr size_t num_points = 30000;
+constexpr float radius = 0.7F;
+
+// points on rings around the origin like a LiDAR scan, with some clutter on the ground
+std::vector<PointT> generate_points()
+{
+  std::mt19937 engine(0);
+  std::uniform_real_distribution<float> angle(-3.14159F, 3.14159F);
+  std::uniform_real_distribution<float> range(2.0F, 60.0F);
+  std::uniform_real_distribution<float> noise(-0.05F, 0.05F);
+  std::vector<PointT> points;
+  for (size_t i = 0; i < num_points; ++i) {
+    const float r = (i % 2 == 0) ? std::floor(range(engine)) : range(engine);
+    const float th = angle(engine);
+    PointT pt;
+    pt.x = r * std::cos(th) + noise(engine);
+    pt.y = r * std::sin(th) + noise(engine);
+    pt.z = 2.0F * noise(engine);
+    points.push_back(pt);
+  }
+  return points;
+}
+
+const std::vector<PointT> & get_points()
+{
+  static const std::vector<PointT> points = generate_points();
+  return points;
+}
+
+template<class ConfigT>
+ConfigT make_config();
+
+template<>
+Config2d make_config<Config2d>()
+{
+  return Config2d{-70.0F, 70.0F, -70.0F, 70.0F, radius, num_points};
+}
+
+template<>
+Config3d make_config<Config3d>()
+{
+  return Config3d{-70.0F, 70.0F, -70.0F, 70.0F, -3.0F, 3.0F, radius, num_points};
+}
+}  // namespace
+
+template<class ConfigT>
+static void SpatialHashInsert(benchmark::State & state)
+{
+  const auto & points = get_points();
+  SpatialHash<PointT, ConfigT> hash{make_config<ConfigT>()};
+  for (auto _ : state) {
+    hash.clear();
+    hash.insert(points.begin(), points.end());
+    benchmark::ClobberMemory();
+  }
+}
+BENCHMARK_TEMPLATE(SpatialHashInsert, Config2d)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(SpatialHashInsert, Config3d)->Unit(benchmark::kMillisecond);
+
+template<class ConfigT>
+static void SpatialHashNear(benchmark::State & state)
+{
+  const auto & points = get_points();
+  SpatialHash<PointT, ConfigT> hash{make_config<ConfigT>()};
+  hash.insert(points.begin(), points.end());
+  for (auto _ : state) {
+    for (const auto & pt : points) {
+      benchmark::DoNotOptimize(hash.near(pt, radius).size());
+    }
+  }
+  state.counters["neighbors_per_query"] = static_cast<double>(hash.neighbors_found()) /
+    static_cast<double>(static_cast<size_t>(state.iterations()) * points.size());
+}
+BENCHMARK_TEMPLATE(SpatialHashNear, Config2d)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(SpatialHashNear, Config3d)->Unit(benchmark::kMillisecond);
+
+template<class ConfigT>
+static void FlatSpatialHashBuild(benchmark::State & state)
+{
+  const auto & points = get_points();
+  FlatSpatialHash<PointT, ConfigT> flat_hash{make_config<ConfigT>()};
+  for (auto _ : state) {
+    flat_hash.build(points.begin(), points.end());
+    benchmark::ClobberMemory();
+  }
+}
+BENCHMARK_TEMPLATE(FlatSpatialHashBuild, Config2d)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(FlatSpatialHashBuild, Config3d)->Unit(benchmark::kMillisecond);
+
+template<class ConfigT>
+static void FlatSpatialHashNear(benchmark::State & state)
+{
+  const auto & points = get_points();
+  FlatSpatialHash<PointT, ConfigT> flat_hash{make_config<ConfigT>()};
+  flat_hash.build(points.begin(), points.end());
+  for (auto _ : state) {
+    for (const auto & pt : points) {
+      benchmark::DoNotOptimize(flat_hash.near(pt, radius).size());
+    }
+  }
+}
+BENCHMARK_TEMPLATE(FlatSpatialHashNear, Config2d)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(FlatSpatialHashNear, Config3d)->Unit(benchmark::kMillisecond);
+
+template<class ConfigT>
+static void FlatSpatialHashBatchNear(benchmark::State & state)
+{
+  const auto & points = get_points();
+  FlatSpatialHash<PointT, ConfigT> flat_hash{make_config<ConfigT>()};
+  flat_hash.build(points.begin(), points.end());
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+      flat_hash.near(points.begin(), points.end(), radius).neighbors().size());
+  }
+}
+BENCHMARK_TEMPLATE(FlatSpatialHashBatchNear, Config2d)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(FlatSpatialHashBatchNear, Config3d)->Unit(benchmark::kMillisecond);
+
+// all stored points against each other, in the order they are stored
+template<class ConfigT>
+static void FlatSpatialHashBatchNearInBinOrder(benchmark::State & state)
+{
+  const auto & points = get_points();
+  FlatSpatialHash<PointT, ConfigT> flat_hash{make_config<ConfigT>()};
+  flat_hash.build(points.begin(), points.end());
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+      flat_hash.near(flat_hash.begin(), flat_hash.end(), radius).neighbors().size());
+  }
+}
+BENCHMARK_TEMPLATE(FlatSpatialHashBatchNearInBinOrder, Config2d)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(FlatSpatialHashBatchNearInBinOrder, Config3d)->Unit(benchmark::kMillisecond);
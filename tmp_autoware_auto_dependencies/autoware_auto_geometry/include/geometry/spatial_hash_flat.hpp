@@ -0,0 +1,582 @@
+// Copyright 2021 the Autoware Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Co-developed by Tier IV, Inc. and Apex.AI, Inc.
+/// \file
+/// \brief This file implements a bulk-built spatial hash with flat storage for efficient
+///        fixed-radius near neighbor queries in 2D and 3D
+
+#ifndef GEOMETRY__SPATIAL_HASH_FLAT_HPP_
+#define GEOMETRY__SPATIAL_HASH_FLAT_HPP_
+
+#include <common/types.hpp>
+#include <geometry/spatial_hash_config.hpp>
+#include <geometry/visibility_control.hpp>
+
+#include <cmath>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+using autoware::common::types::float32_t;
+using autoware::common::types::bool8_t;
+
+namespace autoware
+{
+namespace common
+{
+namespace geometry
+{
+/// \brief All objects related to the spatial hash data structure for efficient near neighbor lookup
+namespace spatial_hash
+{
+
+/// \brief A spatial hash which is built from a whole range of points at once, for the case where
+///        the points are replaced every frame (e.g. a LiDAR scan)
+/// \tparam PointT The point type stored in this data structure. Must have float members x, y, and z
+///
+/// The points are sorted by bin with a counting sort into one contiguous array, and each occupied
+/// bin is mapped to its slice of that array by an open-addressing table. Compared to SpatialHash
+/// there is no allocation per point, and a query reads each candidate bin as a contiguous block
+/// instead of walking the buckets of a multimap. The bin layout, the candidate bins and the
+/// statistics are the same as in SpatialHash for the same configuration.
+template<typename PointT, typename ConfigT>
+class GEOMETRY_PUBLIC FlatSpatialHashBase
+{
+  using Index3 = details::Index3;
+  //lint -e{9131} NOLINT There's no other way to make this work in a static assert
+  static_assert(
+    std::is_same<ConfigT, Config2d>::value || std::is_same<ConfigT, Config3d>::value,
+    "FlatSpatialHash only works with Config2d or Config3d");
+
+public:
+  using IT = typename std::vector<PointT>::const_iterator;
+  /// \brief Wrapper around a stored point and a distance (from some query point)
+  class Output
+  {
+public:
+    /// \brief Constructor
+    /// \param[in] point A pointer to the stored point
+    /// \param[in] id The position of the point in the range the data structure was built from
+    /// \param[in] distance The euclidean distance (2d or 3d) to a reference point
+    Output(const PointT * const point, const Index id, const float32_t distance)
+    : m_point(point),
+      m_id(id),
+      m_distance(distance)
+    {
+    }
+    /// \brief Get stored point
+    /// \return A const reference to the stored point
+    const PointT & get_point() const
+    {
+      return *m_point;
+    }
+    /// \brief Get the position of the point in the range passed to build()
+    /// \return The index of the point in the input range
+    Index get_id() const
+    {
+      return m_id;
+    }
+    /// \brief Convert to underlying point
+    /// \return A reference to the underlying point
+    operator const PointT &() const
+    {
+      return get_point();
+    }
+    /// \brief Get distance to reference point
+    /// \return The distance
+    float32_t get_distance() const
+    {
+      return m_distance;
+    }
+
+private:
+    const PointT * m_point;
+    Index m_id;
+    float32_t m_distance;
+  };  // class Output
+  using OutputVector = typename std::vector<Output>;
+
+  /// \brief Near neighbors of a batch of query points. The neighbors of all queries are stored
+  ///        back to back in one vector.
+  class BatchOutput
+  {
+public:
+    using OutputIT = typename OutputVector::const_iterator;
+    /// \brief Get number of query points
+    /// \return The number of query points in the batch
+    Index size() const
+    {
+      return m_offsets.empty() ? 0U : (m_offsets.size() - 1U);
+    }
+    /// \brief Get the first neighbor of a query point
+    /// \param[in] query The position of the query point in the batch
+    /// \return Iterator to the first neighbor of the query point
+    OutputIT begin(const Index query) const
+    {
+      return m_neighbors.cbegin() + static_cast<std::ptrdiff_t>(m_offsets[query]);
+    }
+    /// \brief Get the end of the neighbors of a query point
+    /// \param[in] query The position of the query point in the batch
+    /// \return Iterator past the last neighbor of the query point
+    OutputIT end(const Index query) const
+    {
+      return m_neighbors.cbegin() + static_cast<std::ptrdiff_t>(m_offsets[query + 1U]);
+    }
+    /// \brief Get number of neighbors of a query point
+    /// \param[in] query The position of the query point in the batch
+    /// \return The number of neighbors of the query point
+    Index count(const Index query) const
+    {
+      return m_offsets[query + 1U] - m_offsets[query];
+    }
+    /// \brief Get the neighbors of all query points
+    /// \return A const reference to the neighbors, ordered by query point
+    const OutputVector & neighbors() const
+    {
+      return m_neighbors;
+    }
+
+private:
+    friend class FlatSpatialHashBase;
+    OutputVector m_neighbors;
+    std::vector<Index> m_offsets;
+  };  // class BatchOutput
+
+  /// \brief Constructor
+  /// \param[in] cfg The configuration object for this class
+  explicit FlatSpatialHashBase(const ConfigT & cfg)
+  : m_config{cfg},
+    m_points{},
+    m_ids{},
+    m_bin_offsets{},
+    m_table{},
+    m_table_shift{},
+    m_point_slots{},
+    m_neighbors{},
+    m_batch{},
+    m_bins_hit{},  // zero initialization (and below)
+    m_neighbors_found{}
+  {
+    m_points.reserve(capacity());
+    m_ids.reserve(capacity());
+    m_bin_offsets.reserve(capacity() + 1U);
+    m_point_slots.reserve(capacity());
+  }
+
+  /// \brief Replaces the stored points with a range of points
+  /// \param[in] begin The start of the range of points to store
+  /// \param[in] end The end of the range of points to store
+  /// \tparam IteratorT A forward iterator type
+  /// \throw std::length_error If the range of points exceeds the data structure's capacity
+  ///
+  /// The data structure is left unchanged if an exception is thrown.
+  template<typename IteratorT>
+  void build(IteratorT begin, IteratorT end)
+  {
+    const auto num_points = std::distance(begin, end);
+    if ((num_points < 0) || (static_cast<Index>(num_points) > capacity())) {
+      throw std::length_error{"FlatSpatialHash: Cannot build past capacity"};
+    }
+    const Index n = static_cast<Index>(num_points);
+    clear();
+    reset_table(n);
+
+    // Count the points in each occupied bin. Bins get slots in the order they are first seen.
+    m_point_slots.resize(n);
+    m_bin_offsets.push_back(0U);
+    Index pdx = 0U;
+    for (IteratorT it = begin; it != end; ++it) {
+      const PointT & pt = *it;
+      const Index bin =
+        m_config.bin(point_adapter::x_(pt), point_adapter::y_(pt), point_adapter::z_(pt));
+      const Index slot = find_or_insert_slot(bin);
+      ++m_bin_offsets[slot + 1U];
+      m_point_slots[pdx] = slot;
+      ++pdx;
+    }
+    // Exclusive prefix sum: the slice of a slot is [m_bin_offsets[slot], m_bin_offsets[slot + 1])
+    for (Index slot = 1U; slot < m_bin_offsets.size(); ++slot) {
+      m_bin_offsets[slot] += m_bin_offsets[slot - 1U];
+    }
+    // Scatter the points to their slices, using the start of each slice as the write cursor
+    m_points.resize(n);
+    m_ids.resize(n);
+    pdx = 0U;
+    for (IteratorT it = begin; it != end; ++it) {
+      const Index dst = m_bin_offsets[m_point_slots[pdx]]++;
+      m_points[dst] = *it;
+      m_ids[dst] = pdx;
+      ++pdx;
+    }
+    // The cursors now point to the end of each slice, shift them back by one slot
+    for (Index slot = m_bin_offsets.size() - 1U; slot > 0U; --slot) {
+      m_bin_offsets[slot] = m_bin_offsets[slot - 1U];
+    }
+    m_bin_offsets[0U] = 0U;
+  }
+
+  /// \brief Reset the state of the data structure
+  void clear()
+  {
+    m_points.clear();
+    m_ids.clear();
+    m_bin_offsets.clear();
+    m_point_slots.clear();
+  }
+  /// \brief Get current number of element stored in this data structure
+  /// \return Number of stored elements
+  Index size() const
+  {
+    return m_points.size();
+  }
+  /// \brief Get the maximum capacity of the data structure
+  /// \return The capacity of the data structure
+  Index capacity() const
+  {
+    return m_config.get_capacity();
+  }
+  /// \brief Whether the hash is empty
+  /// \return True if data structure is empty
+  bool8_t empty() const
+  {
+    return m_points.empty();
+  }
+  /// \brief Get iterator to beginning of data structure. The points are ordered by bin.
+  /// \return Iterator
+  IT begin() const
+  {
+    return m_points.cbegin();
+  }
+  /// \brief Get iterator to end of data structure
+  /// \return Iterator
+  IT end() const
+  {
+    return m_points.cend();
+  }
+  /// \brief Get iterator to beginning of data structure
+  /// \return Iterator
+  IT cbegin() const
+  {
+    return begin();
+  }
+  /// \brief Get iterator to end of data structure
+  /// \return Iterator
+  IT cend() const
+  {
+    return end();
+  }
+
+  /// \brief Get the number of bins touched during the lifetime of this object, for debugging and
+  ///        size tuning
+  /// \return The total number of bins touched during near() queries
+  Index bins_hit() const
+  {
+    return m_bins_hit;
+  }
+
+  /// \brief Get number of near neighbors found during the lifetime of this object, for debugging
+  ///        and size tuning
+  /// \return The total number of neighbors found during near() queries
+  Index neighbors_found() const
+  {
+    return m_neighbors_found;
+  }
+
+protected:
+  /// \brief Finds all points within a fixed radius of a reference point
+  /// \param[in] x The x component of the reference point
+  /// \param[in] y The y component of the reference point
+  /// \param[in] z The z component of the reference point, respected only if the spatial hash is not
+  ///              2D.
+  /// \param[in] radius The radius within which to find all near points
+  /// \return A const reference to a vector containing all points within the radius, and the
+  ///         actual distance to the reference point
+  const OutputVector & near_impl(
+    const float32_t x,
+    const float32_t y,
+    const float32_t z,
+    const float32_t radius)
+  {
+    m_neighbors.clear();
+    append_near(x, y, z, radius, m_neighbors);
+    return m_neighbors;
+  }
+
+  /// \brief Finds all points within a fixed radius of each point of a range of reference points
+  /// \param[in] begin The start of the range of reference points
+  /// \param[in] end The end of the range of reference points
+  /// \param[in] radius The radius within which to find all near points
+  /// \tparam IteratorT The iterator type. z of the reference points is respected only if the
+  ///                   spatial hash is not 2D.
+  /// \return A const reference to the near points of all reference points
+  ///
+  /// Reference points close to each other share their candidate bins in the cache, so querying
+  /// all stored points in their stored order (begin() to end()) is faster than in input order.
+  template<typename IteratorT>
+  const BatchOutput & near_batch_impl(IteratorT begin, IteratorT end, const float32_t radius)
+  {
+    m_batch.m_neighbors.clear();
+    m_batch.m_offsets.clear();
+    m_batch.m_offsets.push_back(0U);
+    for (IteratorT it = begin; it != end; ++it) {
+      append_near(
+        point_adapter::x_(*it), point_adapter::y_(*it), point_adapter::z_(*it), radius,
+        m_batch.m_neighbors);
+      m_batch.m_offsets.push_back(m_batch.m_neighbors.size());
+    }
+    return m_batch;
+  }
+
+private:
+  /// \brief Entry of the open-addressing table from a bin index to its slot
+  struct BinSlot
+  {
+    Index bin;
+    Index slot;
+  };
+  static constexpr Index EMPTY_BIN = std::numeric_limits<Index>::max();
+
+  /// \brief Size the table to at most half load for the given number of points, and empty it
+  GEOMETRY_LOCAL void reset_table(const Index num_points)
+  {
+    Index shift = 60U;
+    Index size = 16U;
+    while (size < (2U * num_points)) {
+      size *= 2U;
+      --shift;
+    }
+    m_table_shift = shift;
+    m_table.assign(size, BinSlot{EMPTY_BIN, 0U});
+  }
+
+  /// \brief Fibonacci hashing of a bin index to its first probe in the table
+  GEOMETRY_LOCAL Index probe_start(const Index bin) const
+  {
+    return static_cast<Index>(
+      (static_cast<std::uint64_t>(bin) * 0x9E3779B97F4A7C15ULL) >> m_table_shift);
+  }
+
+  /// \brief Get the slot of a bin, adding a new empty slot if the bin has none
+  GEOMETRY_LOCAL Index find_or_insert_slot(const Index bin)
+  {
+    const Index mask = m_table.size() - 1U;
+    for (Index tdx = probe_start(bin); ; tdx = (tdx + 1U) & mask) {
+      BinSlot & entry = m_table[tdx];
+      if (entry.bin == bin) {
+        return entry.slot;
+      }
+      if (entry.bin == EMPTY_BIN) {
+        entry.bin = bin;
+        entry.slot = m_bin_offsets.size() - 1U;
+        m_bin_offsets.push_back(0U);
+        return entry.slot;
+      }
+    }
+  }
+
+  /// \brief Get the slot of a bin
+  /// \return The slot, or EMPTY_BIN if there is no point in the bin
+  GEOMETRY_LOCAL Index find_slot(const Index bin) const
+  {
+    const Index mask = m_table.size() - 1U;
+    for (Index tdx = probe_start(bin); ; tdx = (tdx + 1U) & mask) {
+      const BinSlot & entry = m_table[tdx];
+      if (entry.bin == bin) {
+        return entry.slot;
+      }
+      if (entry.bin == EMPTY_BIN) {
+        return EMPTY_BIN;
+      }
+    }
+  }
+
+  /// \brief Append all points within a fixed radius of a reference point to the output
+  GEOMETRY_LOCAL void append_near(
+    const float32_t x,
+    const float32_t y,
+    const float32_t z,
+    const float32_t radius,
+    OutputVector & neighbors)
+  {
+    const Index num_found = neighbors.size();
+    // Compute bin, bin range
+    const Index3 ref_idx = m_config.index3(x, y, z);
+    const float32_t radius2 = radius * radius;
+    const details::BinRange idx_range = m_config.bin_range(ref_idx, radius);
+    Index3 idx = idx_range.first;
+    // For bins in radius
+    do {  // guaranteed to have at least the bin ref_idx is in
+      // update book-keeping
+      ++m_bins_hit;
+      // Iterating in a square/cube pattern is easier than constructing sphere pattern
+      if (empty() || !m_config.is_candidate_bin(ref_idx, idx, radius2)) {
+        continue;
+      }
+      const Index slot = find_slot(m_config.index(idx));
+      if (EMPTY_BIN == slot) {
+        continue;
+      }
+      // For point in bin
+      const Index last = m_bin_offsets[slot + 1U];
+      for (Index pdx = m_bin_offsets[slot]; pdx < last; ++pdx) {
+        const PointT & pt = m_points[pdx];
+        const float32_t dist2 = m_config.distance_squared(x, y, z, pt);
+        if (dist2 <= radius2) {
+          // Only compute true distance if necessary
+          neighbors.emplace_back(&pt, m_ids[pdx], sqrtf(dist2));
+        }
+      }
+    } while (m_config.next_bin(idx_range, idx));
+    // update book-keeping
+    m_neighbors_found += neighbors.size() - num_found;
+  }
+
+  const ConfigT m_config;
+  std::vector<PointT> m_points;
+  std::vector<Index> m_ids;
+  std::vector<Index> m_bin_offsets;
+  std::vector<BinSlot> m_table;
+  Index m_table_shift;
+  std::vector<Index> m_point_slots;
+  OutputVector m_neighbors;
+  BatchOutput m_batch;
+  Index m_bins_hit;
+  Index m_neighbors_found;
+};  // class FlatSpatialHashBase
+
+/// \brief The class to be used for specializing on FlatSpatialHashBase to provide different
+///        function signatures on 2D and 3D configurations
+/// \tparam PointT The point type stored in this data structure. Must have float members x, y and z
+template<typename PointT, typename ConfigT>
+class GEOMETRY_PUBLIC FlatSpatialHash;
+
+/// \brief Explicit specialization of FlatSpatialHash for 2D configuration
+/// \tparam PointT The point type stored in this data structure.
+template<typename PointT>
+class GEOMETRY_PUBLIC FlatSpatialHash<PointT, Config2d>
+  : public FlatSpatialHashBase<PointT, Config2d>
+{
+public:
+  using OutputVector = typename FlatSpatialHashBase<PointT, Config2d>::OutputVector;
+  using BatchOutput = typename FlatSpatialHashBase<PointT, Config2d>::BatchOutput;
+
+  explicit FlatSpatialHash(const Config2d & cfg)
+  : FlatSpatialHashBase<PointT, Config2d>(cfg) {}
+
+  /// \brief Finds all points within a fixed radius of a reference point
+  /// \param[in] x The x component of the reference point
+  /// \param[in] y The y component of the reference point
+  /// \param[in] radius The radius within which to find all near points
+  /// \return A const reference to a vector containing all points within the radius, and the
+  ///         actual distance to the reference point
+  const OutputVector & near(
+    const float32_t x,
+    const float32_t y,
+    const float32_t radius)
+  {
+    return this->near_impl(x, y, 0.0F, radius);
+  }
+
+  /// \brief Finds all points within a fixed radius of a reference point
+  /// \param[in] pt The reference point. Only the x and y members are respected.
+  /// \param[in] radius The radius within which to find all near points
+  /// \return A const reference to a vector containing all points within the radius, and the
+  ///         actual distance to the reference point
+  const OutputVector & near(const PointT & pt, const float32_t radius)
+  {
+    return near(point_adapter::x_(pt), point_adapter::y_(pt), radius);
+  }
+
+  /// \brief Finds all points within a fixed radius of each point of a range of reference points
+  /// \param[in] begin The start of the range of reference points
+  /// \param[in] end The end of the range of reference points. Only the x and y members of the
+  ///                reference points are respected.
+  /// \param[in] radius The radius within which to find all near points
+  /// \return A const reference to the near points of all reference points
+  template<typename IteratorT,
+    typename = typename std::iterator_traits<IteratorT>::iterator_category>
+  const BatchOutput & near(IteratorT begin, IteratorT end, const float32_t radius)
+  {
+    return this->near_batch_impl(begin, end, radius);
+  }
+};
+
+/// \brief Explicit specialization of FlatSpatialHash for 3D configuration
+/// \tparam PointT The point type stored in this data structure. Must have float members x, y and z
+template<typename PointT>
+class GEOMETRY_PUBLIC FlatSpatialHash<PointT, Config3d>
+  : public FlatSpatialHashBase<PointT, Config3d>
+{
+public:
+  using OutputVector = typename FlatSpatialHashBase<PointT, Config3d>::OutputVector;
+  using BatchOutput = typename FlatSpatialHashBase<PointT, Config3d>::BatchOutput;
+
+  explicit FlatSpatialHash(const Config3d & cfg)
+  : FlatSpatialHashBase<PointT, Config3d>(cfg) {}
+
+  /// \brief Finds all points within a fixed radius of a reference point
+  /// \param[in] x The x component of the reference point
+  /// \param[in] y The y component of the reference point
+  /// \param[in] z The z component of the reference point
+  /// \param[in] radius The radius within which to find all near points
+  /// \return A const reference to a vector containing all points within the radius, and the
+  ///         actual distance to the reference point
+  const OutputVector & near(
+    const float32_t x,
+    const float32_t y,
+    const float32_t z,
+    const float32_t radius)
+  {
+    return this->near_impl(x, y, z, radius);
+  }
+
+  /// \brief Finds all points within a fixed radius of a reference point
+  /// \param[in] pt The reference point.
+  /// \param[in] radius The radius within which to find all near points
+  /// \return A const reference to a vector containing all points within the radius, and the
+  ///         actual distance to the reference point
+  const OutputVector & near(const PointT & pt, const float32_t radius)
+  {
+    return near(
+      point_adapter::x_(pt), point_adapter::y_(pt), point_adapter::z_(pt),
+      radius);
+  }
+
+  /// \brief Finds all points within a fixed radius of each point of a range of reference points
+  /// \param[in] begin The start of the range of reference points
+  /// \param[in] end The end of the range of reference points
+  /// \param[in] radius The radius within which to find all near points
+  /// \return A const reference to the near points of all reference points
+  template<typename IteratorT,
+    typename = typename std::iterator_traits<IteratorT>::iterator_category>
+  const BatchOutput & near(IteratorT begin, IteratorT end, const float32_t radius)
+  {
+    return this->near_batch_impl(begin, end, radius);
+  }
+};
+
+template<typename T>
+using FlatSpatialHash2d = FlatSpatialHash<T, Config2d>;
+template<typename T>
+using FlatSpatialHash3d = FlatSpatialHash<T, Config3d>;
+}  // namespace spatial_hash
+}  // namespace geometry
+}  // namespace common
+}  // namespace autoware
+
+#endif  // GEOMETRY__SPATIAL_HASH_FLAT_HPP_
@@ -18,9 +18,11 @@
 #define TEST_SPATIAL_HASH_HPP_
 
 #include <geometry_msgs/msg/point32.hpp>
+#include <algorithm>
 #include <vector>
 #include <limits>
 #include "geometry/spatial_hash.hpp"
+#include "geometry/spatial_hash_flat.hpp"
 
 using autoware::common::types::float32_t;
 using autoware::common::types::float64_t;
@@ -30,6 +32,8 @@ using autoware::common::geometry::spatial_hash::Config3d;
 using autoware::common::geometry::spatial_hash::SpatialHash;
 using autoware::common::geometry::spatial_hash::SpatialHash2d;
 using autoware::common::geometry::spatial_hash::SpatialHash3d;
+using autoware::common::geometry::spatial_hash::FlatSpatialHash2d;
+using autoware::common::geometry::spatial_hash::FlatSpatialHash3d;
 
 template<typename PointT>
 class TypedSpatialHashTest : public ::testing::Test
@@ -230,6 +234,108 @@ TYPED_TEST(TypedSpatialHashTest, 3d)
   EXPECT_EQ(count, 0U);
 }
 
+// flat storage gives the same neighbors and statistics as the multimap
+TYPED_TEST(TypedSpatialHashTest, Flat2d)
+{
+  using PointT = TypeParam;
+  Config2d cfg{-10.0F, 10.0F, -10.0F, 10.0F, 1.0F, 1024U};
+  SpatialHash2d<PointT> hash{cfg};
+  FlatSpatialHash2d<PointT> flat_hash{cfg};
+  EXPECT_TRUE(flat_hash.empty());
+
+  // build concentric rings around (0.5, 0.5), partly out of bounds
+  const uint32_t PTS_PER_RING = 16U;
+  const uint32_t NUM_RINGS = 12U;
+  this->add_points(hash, PTS_PER_RING, NUM_RINGS, 1.0F, 0.5F, 0.5F);
+  std::vector<PointT> pts{};
+  for (const auto & bin_and_point : hash) {
+    pts.push_back(bin_and_point.second);
+  }
+  flat_hash.build(pts.begin(), pts.end());
+  EXPECT_EQ(flat_hash.size(), hash.size());
+  const auto num_flat_points = std::distance(flat_hash.cbegin(), flat_hash.cend());
+  EXPECT_EQ(static_cast<uint32_t>(num_flat_points), hash.size());
+
+  for (const float32_t r : {0.5F, 1.5F, 4.0F}) {
+    for (const auto & query : pts) {
+      std::vector<float32_t> dists{};
+      for (const auto & itd : hash.near(query, r)) {
+        dists.push_back(itd.get_distance());
+      }
+      std::vector<float32_t> flat_dists{};
+      for (const auto & itd : flat_hash.near(query, r)) {
+        const PointT & pt = itd;
+        // the id refers to the point in the range the hash was built from
+        ASSERT_FLOAT_EQ(pts[itd.get_id()].x, pt.x);
+        ASSERT_FLOAT_EQ(pts[itd.get_id()].y, pt.y);
+        flat_dists.push_back(itd.get_distance());
+      }
+      std::sort(dists.begin(), dists.end());
+      std::sort(flat_dists.begin(), flat_dists.end());
+      ASSERT_EQ(dists, flat_dists);
+    }
+    EXPECT_EQ(hash.bins_hit(), flat_hash.bins_hit());
+    EXPECT_EQ(hash.neighbors_found(), flat_hash.neighbors_found());
+  }
+
+  // rebuild replaces the points
+  flat_hash.build(pts.begin(), pts.begin() + PTS_PER_RING);
+  EXPECT_EQ(flat_hash.size(), PTS_PER_RING);
+  EXPECT_EQ(flat_hash.near(0.5F, 0.5F, 30.0F).size(), PTS_PER_RING);
+  flat_hash.clear();
+  EXPECT_EQ(flat_hash.size(), 0U);
+  EXPECT_TRUE(flat_hash.empty());
+  EXPECT_TRUE(flat_hash.near(0.5F, 0.5F, 30.0F).empty());
+
+  // capacity
+  const std::vector<PointT> too_many(1025U, this->ref);
+  EXPECT_THROW(flat_hash.build(too_many.begin(), too_many.end()), std::length_error);
+}
+
+TYPED_TEST(TypedSpatialHashTest, FlatBatch3d)
+{
+  using PointT = TypeParam;
+  Config3d cfg{-10.0F, 10.0F, -10.0F, 10.0F, -2.0F, 2.0F, 1.0F, 4096U};
+  FlatSpatialHash3d<PointT> flat_hash{cfg};
+
+  // lattice with 0.5 spacing
+  std::vector<PointT> pts{};
+  for (float32_t x = -5.0F; x <= 5.0F; x += 0.5F) {
+    for (float32_t y = -5.0F; y <= 5.0F; y += 0.5F) {
+      for (float32_t z = -1.0F; z <= 1.0F; z += 0.5F) {
+        PointT pt;
+        pt.x = x;
+        pt.y = y;
+        pt.z = z;
+        pts.push_back(pt);
+      }
+    }
+  }
+  flat_hash.build(pts.begin(), pts.end());
+
+  const float32_t r = 0.5F + this->EPS;
+  const auto & batch = flat_hash.near(pts.begin(), pts.end(), r);
+  ASSERT_EQ(batch.size(), pts.size());
+  uint32_t total = 0U;
+  for (uint32_t idx = 0U; idx < pts.size(); ++idx) {
+    // the same neighbors as a single query
+    std::vector<uint32_t> ids{};
+    for (auto it = batch.begin(idx); it != batch.end(idx); ++it) {
+      ids.push_back(static_cast<uint32_t>(it->get_id()));
+    }
+    std::vector<uint32_t> single_ids{};
+    for (const auto & itd : flat_hash.near(pts[idx], r)) {
+      single_ids.push_back(static_cast<uint32_t>(itd.get_id()));
+    }
+    ASSERT_EQ(ids, single_ids);
+    // itself and up to 6 neighbors on the lattice
+    ASSERT_GE(batch.count(idx), 4U);
+    ASSERT_LE(batch.count(idx), 7U);
+    total += batch.count(idx);
+  }
+  EXPECT_EQ(total, batch.neighbors().size());
+}
+
 /// edge cases
 TEST(SpatialHashConfig, BadCases)
 {
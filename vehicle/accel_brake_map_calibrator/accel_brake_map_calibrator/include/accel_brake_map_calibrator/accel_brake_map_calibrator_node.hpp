@@ -17,11 +17,11 @@
 #ifndef ACCEL_BRAKE_MAP_CALIBRATOR__ACCEL_BRAKE_MAP_CALIBRATOR_NODE_HPP_
 #define ACCEL_BRAKE_MAP_CALIBRATOR__ACCEL_BRAKE_MAP_CALIBRATOR_NODE_HPP_
 
+#include "accel_brake_map_calibrator/accel_brake_map_estimator.hpp"
+#include "accel_brake_map_calibrator/data_buffer.hpp"
 #include "autoware_utils/planning/planning_marker_helper.hpp"
 #include "autoware_utils/ros/transform_listener.hpp"
 #include "diagnostic_updater/diagnostic_updater.hpp"
-#include "raw_vehicle_cmd_converter/accel_map.hpp"
-#include "raw_vehicle_cmd_converter/brake_map.hpp"
 #include "rclcpp/rclcpp.hpp"
 #include "tf2/utils.h"
 
@@ -45,8 +45,6 @@
 #include <string>
 #include <vector>
 
-using raw_vehicle_cmd_converter::AccelMap;
-using raw_vehicle_cmd_converter::BrakeMap;
 struct DataStamped
 {
   DataStamped(const double _data, const rclcpp::Time & _data_time)
@@ -93,9 +91,6 @@ private:
   void initOutputCSVTimer(double period_s);
 
   geometry_msgs::msg::TwistStamped::ConstSharedPtr twist_ptr_;
-  std::vector<std::shared_ptr<geometry_msgs::msg::TwistStamped>> twist_vec_;
-  std::vector<DataStampedPtr> accel_pedal_vec_;  // for delayed pedal
-  std::vector<DataStampedPtr> brake_pedal_vec_;  // for delayed pedal
   autoware_auto_vehicle_msgs::msg::SteeringReport::ConstSharedPtr steer_ptr_;
   DataStampedPtr accel_pedal_ptr_;
   DataStampedPtr brake_pedal_ptr_;
@@ -106,7 +101,6 @@ private:
   std::shared_ptr<diagnostic_updater::Updater> updater_ptr_;
 
   int get_pitch_method_;
-  int update_method_;
   double acceleration_ = 0.0;
   double acceleration_time_;
   double pre_acceleration_ = 0.0;
@@ -116,13 +110,6 @@ private:
   double brake_pedal_speed_ = 0.0;
   double pitch_ = 0.0;
   double update_hz_;
-  double velocity_min_threshold_;
-  double velocity_diff_threshold_;
-  double pedal_diff_threshold_;
-  double max_steer_threshold_;
-  double max_pitch_threshold_;
-  double max_jerk_threshold_;
-  double pedal_velocity_thresh_;
   double map_update_gain_;
   double max_accel_;
   double min_accel_;
@@ -136,6 +123,9 @@ private:
   const double dif_pedal_time_ = 0.16;  // 160ms
   const std::size_t twist_vec_max_size_ = 100;
   const std::size_t pedal_vec_max_size_ = 100;
+  StampedDataBuffer velocity_buffer_{twist_vec_max_size_};
+  StampedDataBuffer accel_pedal_buffer_{pedal_vec_max_size_};  // for delayed pedal
+  StampedDataBuffer brake_pedal_buffer_{pedal_vec_max_size_};  // for delayed pedal
   const double timeout_sec_ = 0.1;
   int max_data_count_;
   const int max_data_save_num_ = 10000;
@@ -145,51 +135,13 @@ private:
   bool progress_file_output_ = false;
 
   // Algorithm
-  AccelMap accel_map_;
-  BrakeMap brake_map_;
-
-  // for evaluation
-  AccelMap new_accel_map_;
-  BrakeMap new_brake_map_;
-  std::vector<double> part_original_accel_mse_que_;
-  std::vector<double> full_original_accel_mse_que_;
-  std::vector<double> new_accel_mse_que_;
-  std::size_t full_mse_que_size_ = 100000;
-  std::size_t part_mse_que_size_ = 3000;
-  double full_original_accel_rmse_ = 0.0;
-  double part_original_accel_rmse_ = 0.0;
-  double new_accel_rmse_ = 0.0;
+  std::unique_ptr<AccelBrakeMapEstimator> estimator_;
+  AccelBrakeMapEstimator::Param estimator_param_;
   double update_suggest_thresh_;
-
-  // Accel / Brake Map update
-  std::vector<std::vector<double>> accel_map_value_;
-  std::vector<std::vector<double>> brake_map_value_;
-  std::vector<std::vector<double>> update_accel_map_value_;
-  std::vector<std::vector<double>> update_brake_map_value_;
-  std::vector<std::vector<std::vector<double>>> map_value_data_;
-  std::vector<double> accel_vel_index_;
-  std::vector<double> brake_vel_index_;
-  std::vector<double> accel_pedal_index_;
-  std::vector<double> brake_pedal_index_;
   bool update_success_;
-  int update_success_count_ = 0;
   int update_count_ = 0;
   int lack_of_data_count_ = 0;
   int failed_to_get_pitch_count_ = 0;
-  int too_large_pitch_count_ = 0;
-  int too_low_speed_count_ = 0;
-  int too_large_steer_count_ = 0;
-  int too_large_jerk_count_ = 0;
-  int invalid_acc_brake_count_ = 0;
-  int too_large_pedal_spd_count_ = 0;
-  int update_fail_count_ = 0;
-
-  // for map update
-  double map_offset_ = 0.0;
-  double map_coef_ = 1.0;
-  double covariance_;
-  const double forgetting_factor_ = 0.999;
-  const double coef_update_skip_thresh_ = 0.1;
 
   // output log
   std::ofstream output_log_;
@@ -197,14 +149,6 @@ private:
   bool getCurrentPitchFromTF(double * pitch);
   void timerCallback();
   void timerCallbackOutputCSV();
-  void executeUpdate(
-    const bool accel_mode, const int accel_pedal_index, const int accel_vel_index,
-    const int brake_pedal_index, const int brake_vel_index);
-  bool updateEachValOffset(
-    const bool accel_mode, const int accel_pedal_index, const int accel_vel_index,
-    const int brake_pedal_index, const int brake_vel_index, const double measured_acc,
-    const double map_acc);
-  void updateTotalMapOffset(const double measured_acc, const double map_acc);
   void callbackActuationStatus(
     const autoware_vehicle_msgs::msg::ActuationStatusStamped::ConstSharedPtr msg);
   void callbackVelocity(const autoware_auto_vehicle_msgs::msg::VelocityReport::ConstSharedPtr msg);
@@ -216,46 +160,25 @@ private:
   bool getAccFromMap(const double velocity, const double pedal);
   double lowpass(const double original, const double current, const double gain = 0.8);
   double getPedalSpeed(
-    const DataStampedPtr & prev_pedal, const DataStampedPtr & current_pedal,
+    const StampedValue & prev_pedal, const StampedValue & current_pedal,
     const double prev_pedal_speed);
-  double getAccel(
-    const geometry_msgs::msg::TwistStamped::ConstSharedPtr & prev_twist,
-    const geometry_msgs::msg::TwistStamped::ConstSharedPtr & current_twist);
+  double getAccel(const StampedValue & prev_velocity, const StampedValue & current_velocity);
   double getJerk();
-  bool indexValueSearch(
-    const std::vector<double> value_index, const double value, const double value_thresh,
-    int * searched_index);
   int nearestValueSearch(const std::vector<double> value_index, const double value);
   int nearestPedalSearch();
   int nearestVelSearch();
-  void takeConsistencyOfAccelMap();
-  void takeConsistencyOfBrakeMap();
-  bool updateAccelBrakeMap();
   void publishFloat32(const std::string publish_type, const double val);
   void publishUpdateSuggestFlag();
   double getPitchCompensatedAcceleration();
-  void executeEvaluation();
-  double calculateEstimatedAcc(
-    const double throttle, const double brake, const double vel, AccelMap & accel_map,
-    BrakeMap & brake_map);
-  double calculateAccelSquaredError(
-    const double throttle, const double brake, const double vel, AccelMap & accel_map,
-    BrakeMap & brake_map);
   std::vector<double> getMapColumnFromUnifiedIndex(
     const std::vector<std::vector<double>> & accel_map_value,
     const std::vector<std::vector<double>> & brake_map_value, const std::size_t index);
   double getPedalValueFromUnifiedIndex(const std::size_t index);
-  int getUnifiedIndexFromAccelBrakeIndex(const bool accel_map, const std::size_t index);
   void pushDataToQue(
     const geometry_msgs::msg::TwistStamped::ConstSharedPtr & data, const std::size_t max_size,
     std::queue<geometry_msgs::msg::TwistStamped::ConstSharedPtr> * que);
-  template <class T>
-  void pushDataToVec(const T data, const std::size_t max_size, std::vector<T> * vec);
-  template <class T>
-  T getNearestTimeDataFromVec(
-    const T base_data, const double back_time, const std::vector<T> & vec);
-  DataStampedPtr getNearestTimeDataFromVec(
-    DataStampedPtr base_data, const double back_time, const std::vector<DataStampedPtr> & vec);
+  DataStampedPtr getDelayedPedal(
+    const StampedDataBuffer & pedal_buffer, const DataStampedPtr & current_pedal) const;
   double getAverage(const std::vector<double> & vec);
   double getStandardDeviation(const std::vector<double> & vec);
   bool isTimeout(const builtin_interfaces::msg::Time & stamp, const double timeout_sec);
@@ -275,8 +198,8 @@ private:
   void publishCountMap();
   void publishIndex();
   bool writeMapToCSV(
-    std::vector<double> vel_index, std::vector<double> pedal_index,
-    std::vector<std::vector<double>> value_map, std::string filename);
+    const std::vector<double> & vel_index, const std::vector<double> & pedal_index,
+    const std::vector<std::vector<double>> & value_map, const std::string & filename);
   void addIndexToCSV(std::ofstream * csv_file);
   void addLogToCSV(
     std::ofstream * csv_file, const double & timestamp, const double velocity, const double accel,
@@ -306,11 +229,6 @@ private:
 
   enum GET_PITCH_METHOD { TF = 0, FILE = 1, NONE = 2 };
 
-  enum UPDATE_METHOD {
-    UPDATE_OFFSET_EACH_CELL = 0,
-    UPDATE_OFFSET_TOTAL = 1,
-  };
-
 public:
   explicit AccelBrakeMapCalibrator(const rclcpp::NodeOptions & node_options);
 };
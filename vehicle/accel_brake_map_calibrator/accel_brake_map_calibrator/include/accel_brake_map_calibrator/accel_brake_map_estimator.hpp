@@ -0,0 +1,201 @@
+//
+// Copyright 2021 Tier IV, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#ifndef ACCEL_BRAKE_MAP_CALIBRATOR__ACCEL_BRAKE_MAP_ESTIMATOR_HPP_
+#define ACCEL_BRAKE_MAP_CALIBRATOR__ACCEL_BRAKE_MAP_ESTIMATOR_HPP_
+
+#include "accel_brake_map_calibrator/data_buffer.hpp"
+#include "raw_vehicle_cmd_converter/accel_map.hpp"
+#include "raw_vehicle_cmd_converter/brake_map.hpp"
+
+#include <string>
+#include <vector>
+
+using raw_vehicle_cmd_converter::AccelMap;
+using raw_vehicle_cmd_converter::BrakeMap;
+
+/**
+ * @brief a sample of the calibration, which the node makes every timer tick and the calibration
+ *        log (pedal_accel_graph_output) records in a row
+ */
+struct CalibrationSample
+{
+  double velocity;           // [m/s]
+  double measured_acc;       // pitch compensated acceleration [m/s^2]
+  double accel_pedal;        // accel pedal delayed by pedal_to_accel_delay
+  double brake_pedal;        // brake pedal delayed by pedal_to_accel_delay
+  double accel_pedal_speed;  // [1/s]
+  double brake_pedal_speed;  // [1/s]
+  double pitch;              // [rad]
+  double steer;              // [rad]
+  double jerk;               // [m/s^3]
+};
+
+/**
+ * @brief estimation core of the calibrator, which updates the offsets of the accel / brake map by
+ *        recursive least squares and evaluates the original and the new maps. It does not depend
+ *        on the node, so that the calibration can be replayed from a log.
+ */
+class AccelBrakeMapEstimator
+{
+public:
+  enum UPDATE_METHOD {
+    UPDATE_OFFSET_EACH_CELL = 0,
+    UPDATE_OFFSET_TOTAL = 1,
+  };
+
+  struct Param
+  {
+    int update_method = UPDATE_OFFSET_EACH_CELL;
+    double initial_covariance = 0.05;
+    double velocity_min_threshold = 0.1;
+    double velocity_diff_threshold = 0.556;
+    double pedal_diff_threshold = 0.03;
+    double max_steer_threshold = 0.2;
+    double max_pitch_threshold = 0.02;
+    double max_jerk_threshold = 0.7;
+    double pedal_velocity_thresh = 0.15;
+    double forgetting_factor = 0.999;
+    std::size_t full_mse_que_size = 100000;
+    std::size_t part_mse_que_size = 3000;
+  };
+
+  struct Counts
+  {
+    int update_success = 0;
+    int update_fail = 0;
+    int too_low_speed = 0;
+    int too_large_pitch = 0;
+    int too_large_steer = 0;
+    int too_large_jerk = 0;
+    int invalid_acc_brake = 0;
+    int too_large_pedal_spd = 0;
+  };
+
+  explicit AccelBrakeMapEstimator(const Param & param);
+
+  /**
+   * @brief set the original maps and restart the calibration from them. The original maps are
+   *        evaluated as the new maps until setNewMap() is called.
+   */
+  void setMap(AccelMap accel_map, BrakeMap brake_map);
+
+  /**
+   * @brief set the maps evaluated as the new ones, e.g. the calibrated maps written to the files
+   */
+  void setNewMap(AccelMap accel_map, BrakeMap brake_map);
+
+  /**
+   * @brief discard the offsets, the covariances and the data, and restart from the original maps
+   */
+  void reset();
+
+  /**
+   * @brief evaluate the maps with the sample and update the map when the sample is valid for it
+   * @return true if the map is updated
+   */
+  bool update(const CalibrationSample & sample);
+
+  const std::vector<std::vector<double>> & getAccelMapValue() const { return accel_map_value_; }
+  const std::vector<std::vector<double>> & getBrakeMapValue() const { return brake_map_value_; }
+  const std::vector<std::vector<double>> & getUpdateAccelMapValue() const
+  {
+    return update_accel_map_value_;
+  }
+  const std::vector<std::vector<double>> & getUpdateBrakeMapValue() const
+  {
+    return update_brake_map_value_;
+  }
+  // measured accelerations in each cell of the map with the unified pedal index
+  const std::vector<std::vector<std::vector<double>>> & getMapValueData() const
+  {
+    return map_value_data_;
+  }
+  const std::vector<double> & getAccelVelIndex() const { return accel_vel_index_; }
+  const std::vector<double> & getBrakeVelIndex() const { return brake_vel_index_; }
+  const std::vector<double> & getAccelPedalIndex() const { return accel_pedal_index_; }
+  const std::vector<double> & getBrakePedalIndex() const { return brake_pedal_index_; }
+  const Counts & getCounts() const { return counts_; }
+
+  // mean squared errors of the accelerations estimated by the maps
+  double getFullOriginalAccelMSE() const { return full_original_accel_mse_que_.average(); }
+  double getPartOriginalAccelMSE() const { return part_original_accel_mse_que_.average(); }
+  double getNewAccelMSE() const { return new_accel_mse_que_.average(); }
+  std::size_t getNewAccelMSESize() const { return new_accel_mse_que_.size(); }
+
+  // unified pedal index: the brake map from the max brake, then the accel map from 0 pedal
+  int getUnifiedIndexFromAccelBrakeIndex(const bool accel_map, const std::size_t index) const;
+
+  static bool writeMapToCSV(
+    const std::vector<double> & vel_index, const std::vector<double> & pedal_index,
+    const std::vector<std::vector<double>> & value_map, const std::string & filename);
+
+private:
+  Param param_;
+  Counts counts_;
+
+  // original map
+  AccelMap accel_map_;
+  BrakeMap brake_map_;
+  std::vector<std::vector<double>> accel_map_value_;
+  std::vector<std::vector<double>> brake_map_value_;
+  std::vector<double> accel_vel_index_;
+  std::vector<double> brake_vel_index_;
+  std::vector<double> accel_pedal_index_;
+  std::vector<double> brake_pedal_index_;
+
+  // for evaluation
+  AccelMap new_accel_map_;
+  BrakeMap new_brake_map_;
+  bool has_new_map_ = false;
+  MovingAverage full_original_accel_mse_que_;
+  MovingAverage part_original_accel_mse_que_;
+  MovingAverage new_accel_mse_que_;
+
+  // updated map
+  std::vector<std::vector<double>> update_accel_map_value_;
+  std::vector<std::vector<double>> update_brake_map_value_;
+  std::vector<std::vector<std::vector<double>>> map_value_data_;
+
+  // recursive least squares (map_offset_ and covariance_ for UPDATE_OFFSET_TOTAL)
+  std::vector<std::vector<double>> map_offset_vec_;
+  std::vector<std::vector<double>> covariance_vec_;
+  double map_offset_ = 0.0;
+  double covariance_;
+
+  void executeEvaluation(const CalibrationSample & sample);
+  double calculateEstimatedAcc(
+    const double throttle, const double brake, const double vel, AccelMap & accel_map,
+    BrakeMap & brake_map);
+  double calculateAccelSquaredError(
+    const CalibrationSample & sample, AccelMap & accel_map, BrakeMap & brake_map);
+  bool updateAccelBrakeMap(const CalibrationSample & sample);
+  void executeUpdate(
+    const bool accel_mode, const int accel_pedal_index, const int accel_vel_index,
+    const int brake_pedal_index, const int brake_vel_index, const double measured_acc);
+  void updateEachValOffset(
+    const bool accel_mode, const int accel_pedal_index, const int accel_vel_index,
+    const int brake_pedal_index, const int brake_vel_index, const double measured_acc,
+    const double map_acc);
+  void updateTotalMapOffset(const double measured_acc, const double map_acc);
+  void takeConsistencyOfAccelMap();
+  void takeConsistencyOfBrakeMap();
+  bool indexValueSearch(
+    const std::vector<double> & value_index, const double value, const double value_thresh,
+    int * searched_index) const;
+};
+
+#endif  // ACCEL_BRAKE_MAP_CALIBRATOR__ACCEL_BRAKE_MAP_ESTIMATOR_HPP_
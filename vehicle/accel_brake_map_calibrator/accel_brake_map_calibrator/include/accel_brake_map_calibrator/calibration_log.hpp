@@ -0,0 +1,31 @@
+//
+// Copyright 2021 Tier IV, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef ACCEL_BRAKE_MAP_CALIBRATOR__CALIBRATION_LOG_HPP_
+#define ACCEL_BRAKE_MAP_CALIBRATOR__CALIBRATION_LOG_HPP_
+
+#include "accel_brake_map_calibrator/accel_brake_map_estimator.hpp"
+
+#include <string>
+#include <vector>
+
+/**
+ * @brief read the samples from the calibration log of accel_brake_map_calibrator (output_log_file
+ *        with pedal_accel_graph_output)
+ * @return false if the log cannot be opened or has a row with too few columns
+ */
+bool readCalibrationLog(const std::string & csv_path, std::vector<CalibrationSample> * samples);
+
+#endif  // ACCEL_BRAKE_MAP_CALIBRATOR__CALIBRATION_LOG_HPP_
@@ -0,0 +1,169 @@
+//
+// Copyright 2021 Tier IV, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#ifndef ACCEL_BRAKE_MAP_CALIBRATOR__DATA_BUFFER_HPP_
+#define ACCEL_BRAKE_MAP_CALIBRATOR__DATA_BUFFER_HPP_
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+/**
+ * @brief fixed capacity buffer which overwrites the oldest element when it is full.
+ *        The elements are indexed from the oldest one.
+ */
+template <class T>
+class RingBuffer
+{
+public:
+  explicit RingBuffer(const std::size_t capacity) : data_(capacity) {}
+
+  void push(const T & value)
+  {
+    if (data_.empty()) {
+      return;
+    }
+    if (size_ < data_.size()) {
+      data_[(begin_ + size_) % data_.size()] = value;
+      ++size_;
+      return;
+    }
+    data_[begin_] = value;
+    begin_ = (begin_ + 1) % data_.size();
+  }
+
+  void clear()
+  {
+    begin_ = 0;
+    size_ = 0;
+  }
+
+  std::size_t capacity() const { return data_.size(); }
+  std::size_t size() const { return size_; }
+  bool empty() const { return size_ == 0; }
+  bool full() const { return size_ == data_.size(); }
+
+  const T & operator[](const std::size_t i) const { return data_[(begin_ + i) % data_.size()]; }
+  const T & front() const { return (*this)[0]; }
+  const T & back() const { return (*this)[size_ - 1]; }
+
+private:
+  std::vector<T> data_;
+  std::size_t begin_ = 0;
+  std::size_t size_ = 0;
+};
+
+struct StampedValue
+{
+  double time;  // [s]
+  double value;
+};
+
+/**
+ * @brief history of a signal whose sample nearest to a time is found by binary search.
+ *        The samples are expected in time order. When the time goes back (e.g. a rosbag is played
+ *        again), the older samples are dropped.
+ */
+class StampedDataBuffer
+{
+public:
+  explicit StampedDataBuffer(const std::size_t capacity) : buffer_(capacity) {}
+
+  void push(const double time, const double value)
+  {
+    if (!buffer_.empty() && time < buffer_.back().time) {
+      buffer_.clear();
+    }
+    buffer_.push(StampedValue{time, value});
+  }
+
+  std::size_t size() const { return buffer_.size(); }
+  bool empty() const { return buffer_.empty(); }
+  const StampedValue & back() const { return buffer_.back(); }
+
+  // the buffer must not be empty. The oldest one is returned when some samples are equally near
+  // to the time.
+  const StampedValue & getNearest(const double target_time) const
+  {
+    // first sample at or after the target time
+    std::size_t lower = 0;
+    std::size_t upper = buffer_.size();
+    while (lower < upper) {
+      const std::size_t mid = (lower + upper) / 2;
+      if (buffer_[mid].time < target_time) {
+        lower = mid + 1;
+      } else {
+        upper = mid;
+      }
+    }
+
+    std::size_t nearest = lower;
+    if (lower == buffer_.size()) {
+      nearest = lower - 1;
+    } else if (
+      lower > 0 && target_time - buffer_[lower - 1].time <= buffer_[lower].time - target_time) {
+      nearest = lower - 1;
+    }
+    while (nearest > 0 && buffer_[nearest - 1].time == buffer_[nearest].time) {
+      --nearest;
+    }
+    return buffer_[nearest];
+  }
+
+private:
+  RingBuffer<StampedValue> buffer_;
+};
+
+/**
+ * @brief average of the latest values. The sum is updated with each value and recomputed once per
+ *        capacity values so that the rounding errors do not accumulate. A zero capacity is treated
+ *        as one, i.e. the average is the latest value.
+ */
+class MovingAverage
+{
+public:
+  explicit MovingAverage(const std::size_t capacity)
+  : buffer_(std::max(capacity, static_cast<std::size_t>(1)))
+  {
+  }
+
+  void push(const double value)
+  {
+    if (buffer_.full()) {
+      sum_ -= buffer_.front();
+    }
+    buffer_.push(value);
+    sum_ += value;
+
+    if (++num_pushed_since_sum_ >= buffer_.capacity()) {
+      sum_ = 0.0;
+      for (std::size_t i = 0; i < buffer_.size(); ++i) {
+        sum_ += buffer_[i];
+      }
+      num_pushed_since_sum_ = 0;
+    }
+  }
+
+  std::size_t size() const { return buffer_.size(); }
+  double average() const { return buffer_.empty() ? 0.0 : sum_ / buffer_.size(); }
+
+private:
+  RingBuffer<double> buffer_;
+  double sum_ = 0.0;
+  std::size_t num_pushed_since_sum_ = 0;
+};
+
+#endif  // ACCEL_BRAKE_MAP_CALIBRATOR__DATA_BUFFER_HPP_
@@ -19,6 +19,7 @@
 #include "rclcpp/logging.hpp"
 
 #include <algorithm>
+#include <cmath>
 #include <limits>
 #include <memory>
 #include <queue>
@@ -32,14 +33,15 @@ AccelBrakeMapCalibrator::AccelBrakeMapCalibrator(const rclcpp::NodeOptions & nod
   transform_listener_ = std::make_shared<autoware_utils::TransformListener>(this);
   // get parameter
   update_hz_ = this->declare_parameter<double>("update_hz", 10.0);
-  covariance_ = this->declare_parameter<double>("initial_covariance", 0.05);
-  velocity_min_threshold_ = this->declare_parameter<double>("velocity_min_threshold", 0.1);
-  velocity_diff_threshold_ = this->declare_parameter<double>("velocity_diff_threshold", 0.556);
-  pedal_diff_threshold_ = this->declare_parameter<double>("pedal_diff_threshold", 0.03);
-  max_steer_threshold_ = this->declare_parameter<double>("max_steer_threshold", 0.2);
-  max_pitch_threshold_ = this->declare_parameter<double>("max_pitch_threshold", 0.02);
-  max_jerk_threshold_ = this->declare_parameter<double>("max_jerk_threshold", 0.7);
-  pedal_velocity_thresh_ = this->declare_parameter<double>("pedal_velocity_thresh", 0.15);
+  auto & p = estimator_param_;
+  p.initial_covariance = this->declare_parameter<double>("initial_covariance", 0.05);
+  p.velocity_min_threshold = this->declare_parameter<double>("velocity_min_threshold", 0.1);
+  p.velocity_diff_threshold = this->declare_parameter<double>("velocity_diff_threshold", 0.556);
+  p.pedal_diff_threshold = this->declare_parameter<double>("pedal_diff_threshold", 0.03);
+  p.max_steer_threshold = this->declare_parameter<double>("max_steer_threshold", 0.2);
+  p.max_pitch_threshold = this->declare_parameter<double>("max_pitch_threshold", 0.02);
+  p.max_jerk_threshold = this->declare_parameter<double>("max_jerk_threshold", 0.7);
+  p.pedal_velocity_thresh = this->declare_parameter<double>("pedal_velocity_thresh", 0.15);
   map_update_gain_ = this->declare_parameter<double>("map_update_gain", 0.02);
   max_accel_ = this->declare_parameter<double>("max_accel", 5.0);
   min_accel_ = this->declare_parameter<double>("min_accel", -5.0);
@@ -68,9 +70,9 @@ AccelBrakeMapCalibrator::AccelBrakeMapCalibrator(const rclcpp::NodeOptions & nod
   const std::string update_method_str =
     this->declare_parameter<std::string>("update_method", std::string("update_offset_each_cell"));
   if (update_method_str == std::string("update_offset_each_cell")) {
-    update_method_ = UPDATE_METHOD::UPDATE_OFFSET_EACH_CELL;
+    p.update_method = AccelBrakeMapEstimator::UPDATE_METHOD::UPDATE_OFFSET_EACH_CELL;
   } else if (update_method_str == std::string("update_offset_total")) {
-    update_method_ = UPDATE_METHOD::UPDATE_OFFSET_TOTAL;
+    p.update_method = AccelBrakeMapEstimator::UPDATE_METHOD::UPDATE_OFFSET_TOTAL;
   } else {
     RCLCPP_ERROR_STREAM(
       rclcpp::get_logger("accel_brake_map_calibrator"),
@@ -93,22 +95,22 @@ AccelBrakeMapCalibrator::AccelBrakeMapCalibrator(const rclcpp::NodeOptions & nod
 
     std::string csv_path_accel_map = csv_default_map_dir_ + "/accel_map.csv";
     std::string csv_path_brake_map = csv_default_map_dir_ + "/brake_map.csv";
-    if (
-      !accel_map_.readAccelMapFromCSV(csv_path_accel_map) ||
-      !new_accel_map_.readAccelMapFromCSV(csv_path_accel_map)) {
+    AccelMap accel_map;
+    BrakeMap brake_map;
+    if (!accel_map.readAccelMapFromCSV(csv_path_accel_map)) {
       RCLCPP_ERROR_STREAM(
         rclcpp::get_logger("accel_brake_map_calibrator"),
         "Cannot read accelmap. csv path = " << csv_path_accel_map.c_str() << ". stop calculation.");
       return;
     }
-    if (
-      !brake_map_.readBrakeMapFromCSV(csv_path_brake_map) ||
-      !new_brake_map_.readBrakeMapFromCSV(csv_path_brake_map)) {
+    if (!brake_map.readBrakeMapFromCSV(csv_path_brake_map)) {
       RCLCPP_ERROR_STREAM(
         rclcpp::get_logger("accel_brake_map_calibrator"),
         "Cannot read brakemap. csv path = " << csv_path_brake_map.c_str() << ". stop calculation.");
       return;
     }
+    estimator_ = std::make_unique<AccelBrakeMapEstimator>(estimator_param_);
+    estimator_->setMap(std::move(accel_map), std::move(brake_map));
   }
 
   std::string output_log_file =
@@ -118,29 +120,6 @@ AccelBrakeMapCalibrator::AccelBrakeMapCalibrator(const rclcpp::NodeOptions & nod
 
   debug_values_.data.resize(num_debug_values_);
 
-  // input map info
-  accel_map_value_ = accel_map_.getAccelMap();
-  brake_map_value_ = brake_map_.getBrakeMap();
-  accel_vel_index_ = accel_map_.getVelIdx();
-  brake_vel_index_ = brake_map_.getVelIdx();
-  accel_pedal_index_ = accel_map_.getThrottleIdx();
-  brake_pedal_index_ = brake_map_.getBrakeIdx();
-  update_accel_map_value_.resize((accel_map_value_.size()));
-  update_brake_map_value_.resize((brake_map_value_.size()));
-  for (auto & m : update_accel_map_value_) {
-    m.resize(accel_map_value_.at(0).size());
-  }
-  for (auto & m : update_brake_map_value_) {
-    m.resize(brake_map_value_.at(0).size());
-  }
-  map_value_data_.resize(accel_map_value_.size() + brake_map_value_.size() - 1);
-  for (auto & m : map_value_data_) {
-    m.resize(accel_map_value_.at(0).size());
-  }
-
-  std::copy(accel_map_value_.begin(), accel_map_value_.end(), update_accel_map_value_.begin());
-  std::copy(brake_map_value_.begin(), brake_map_value_.end(), update_brake_map_value_.begin());
-
   // QoS setup
   static constexpr std::size_t queue_size = 1;
   rclcpp::QoS durable_qos(queue_size);
@@ -253,21 +232,23 @@ bool AccelBrakeMapCalibrator::getCurrentPitchFromTF(double * pitch)
 void AccelBrakeMapCalibrator::timerCallback()
 {
   update_count_++;
+  const auto & counts = estimator_->getCounts();
   auto & clk = *this->get_clock();
   RCLCPP_DEBUG_STREAM_THROTTLE(
     rclcpp::get_logger("accel_brake_map_calibrator"), clk, 5000,
-    "map updating... count: " << update_success_count_ << " / " << update_count_ << "\n\t"
+    "map updating... count: " << counts.update_success << " / " << update_count_ << "\n\t"
                               << "lack_of_data_count: " << lack_of_data_count_ << "\n\t"
                               << " failed_to_get_pitch_count: " << failed_to_get_pitch_count_
                               << "\n\t"
-                              << "too_large_pitch_count: " << too_large_pitch_count_ << "\n\t"
-                              << " too_low_speed_count: " << too_low_speed_count_ << "\n\t"
-                              << "too_large_steer_count: " << too_large_steer_count_ << "\n\t"
-                              << "too_large_jerk_count: " << too_large_jerk_count_ << "\n\t"
-                              << "invalid_acc_brake_count: " << invalid_acc_brake_count_ << "\n\t"
-                              << "too_large_pedal_spd_count: " << too_large_pedal_spd_count_
+                              << "too_large_pitch_count: " << counts.too_large_pitch << "\n\t"
+                              << " too_low_speed_count: " << counts.too_low_speed << "\n\t"
+                              << "too_large_steer_count: " << counts.too_large_steer << "\n\t"
+                              << "too_large_jerk_count: " << counts.too_large_jerk << "\n\t"
+                              << "invalid_acc_brake_count: " << counts.invalid_acc_brake
+                              << "\n\t"
+                              << "too_large_pedal_spd_count: " << counts.too_large_pedal_spd
                               << "\n\t"
-                              << "update_fail_count_: " << update_fail_count_ << "\n");
+                              << "update_fail_count_: " << counts.update_fail << "\n");
 
   /* valid check */
 
@@ -307,28 +288,33 @@ void AccelBrakeMapCalibrator::timerCallback()
     return;
   }
 
+  const double full_original_accel_rmse = estimator_->getFullOriginalAccelMSE();
+  const double part_original_accel_rmse = estimator_->getPartOriginalAccelMSE();
+  const double new_accel_rmse = estimator_->getNewAccelMSE();
+
   /* write data to log */
   if (pedal_accel_graph_output_) {
     addLogToCSV(
       &output_log_, rclcpp::Time(twist_ptr_->header.stamp).seconds(), twist_ptr_->twist.linear.x,
       acceleration_, getPitchCompensatedAcceleration(), delayed_accel_pedal_ptr_->data,
       delayed_brake_pedal_ptr_->data, accel_pedal_speed_, brake_pedal_speed_, pitch_,
-      steer_ptr_->steering_tire_angle, jerk_, full_original_accel_rmse_, part_original_accel_rmse_,
-      new_accel_rmse_);
+      steer_ptr_->steering_tire_angle, jerk_, full_original_accel_rmse, part_original_accel_rmse,
+      new_accel_rmse);
   }
 
   /* publish map  & debug_values*/
-  publishMap(accel_map_value_, brake_map_value_, "original");
-  publishMap(update_accel_map_value_, update_brake_map_value_, "update");
+  publishMap(estimator_->getAccelMapValue(), estimator_->getBrakeMapValue(), "original");
+  publishMap(
+    estimator_->getUpdateAccelMapValue(), estimator_->getUpdateBrakeMapValue(), "update");
   publishCountMap();
   publishIndex();
   publishUpdateSuggestFlag();
   debug_pub_->publish(debug_values_);
-  publishFloat32("current_map_error", part_original_accel_rmse_);
-  publishFloat32("updated_map_error", new_accel_rmse_);
+  publishFloat32("current_map_error", part_original_accel_rmse);
+  publishFloat32("updated_map_error", new_accel_rmse);
   publishFloat32(
     "map_error_ratio",
-    part_original_accel_rmse_ != 0.0 ? new_accel_rmse_ / part_original_accel_rmse_ : 1.0);
+    part_original_accel_rmse != 0.0 ? new_accel_rmse / part_original_accel_rmse : 1.0);
 
   // -- processing start --
 
@@ -336,65 +322,21 @@ void AccelBrakeMapCalibrator::timerCallback()
   debug_values_.data.at(SUCCESS_TO_UPDATE) = false;
   update_success_ = false;
 
-  // twist check
-  if (twist_ptr_->twist.linear.x < velocity_min_threshold_) {
-    // too low speed ( or backward velocity)
-    too_low_speed_count_++;
-    return;
-  }
-
-  // accel / brake map evaluation (do not evaluate when the car stops)
-  executeEvaluation();
-
-  // pitch check
-  if (std::fabs(pitch_) > max_pitch_threshold_) {
-    // too large pitch
-    too_large_pitch_count_++;
-    return;
-  }
-
-  // steer check
-  if (std::fabs(steer_ptr_->steering_tire_angle) > max_steer_threshold_) {
-    // too large steer
-    too_large_steer_count_++;
-    return;
-  }
-
-  // jerk check
-  if (std::fabs(jerk_) > max_jerk_threshold_) {
-    // too large jerk
-    too_large_jerk_count_++;
-    return;
-  }
-  // pedal check
-  if (
-    delayed_accel_pedal_ptr_->data > std::numeric_limits<double>::epsilon() &&
-    delayed_brake_pedal_ptr_->data > std::numeric_limits<double>::epsilon()) {
-    // both (accel/brake) output
-    auto & clk = *this->get_clock();
-    RCLCPP_DEBUG_STREAM_THROTTLE(
-      rclcpp::get_logger("accel_brake_map_calibrator"), clk, 5000,
-      "invalid pedal value (Both of accel output and brake output area not zero. )");
-    invalid_acc_brake_count_++;
-    return;
-  }
-
-  // pedal speed check
-  if (
-    std::fabs(accel_pedal_speed_) > pedal_velocity_thresh_ ||
-    std::fabs(brake_pedal_speed_) > pedal_velocity_thresh_) {
-    // too large pedal speed
-    too_large_pedal_spd_count_++;
-    return;
-  }
+  CalibrationSample sample;
+  sample.velocity = twist_ptr_->twist.linear.x;
+  sample.measured_acc = acceleration_ - getPitchCompensatedAcceleration();
+  sample.accel_pedal = delayed_accel_pedal_ptr_->data;
+  sample.brake_pedal = delayed_brake_pedal_ptr_->data;
+  sample.accel_pedal_speed = accel_pedal_speed_;
+  sample.brake_pedal_speed = brake_pedal_speed_;
+  sample.pitch = pitch_;
+  sample.steer = steer_ptr_->steering_tire_angle;
+  sample.jerk = jerk_;
 
   /* update map */
-  if (updateAccelBrakeMap()) {
-    update_success_count_++;
+  if (estimator_->update(sample)) {
     debug_values_.data.at(SUCCESS_TO_UPDATE) = true;
     update_success_ = true;
-  } else {
-    update_fail_count_++;
   }
 }
 
@@ -402,19 +344,24 @@ void AccelBrakeMapCalibrator::timerCallbackOutputCSV()
 {
   // write accel/ brake map to file
   const auto ros_time = std::to_string(this->now().seconds());
-  writeMapToCSV(accel_vel_index_, accel_pedal_index_, update_accel_map_value_, output_accel_file_);
-  writeMapToCSV(brake_vel_index_, brake_pedal_index_, update_brake_map_value_, output_brake_file_);
+  const auto & e = *estimator_;
+  writeMapToCSV(
+    e.getAccelVelIndex(), e.getAccelPedalIndex(), e.getUpdateAccelMapValue(), output_accel_file_);
+  writeMapToCSV(
+    e.getBrakeVelIndex(), e.getBrakePedalIndex(), e.getUpdateBrakeMapValue(), output_brake_file_);
   if (progress_file_output_) {
     writeMapToCSV(
-      accel_vel_index_, accel_pedal_index_, update_accel_map_value_,
+      e.getAccelVelIndex(), e.getAccelPedalIndex(), e.getUpdateAccelMapValue(),
       output_accel_file_ + "_" + ros_time);
     writeMapToCSV(
-      brake_vel_index_, brake_pedal_index_, update_brake_map_value_,
+      e.getBrakeVelIndex(), e.getBrakePedalIndex(), e.getUpdateBrakeMapValue(),
       output_brake_file_ + "_" + ros_time);
     writeMapToCSV(
-      accel_vel_index_, accel_pedal_index_, accel_map_value_, output_accel_file_ + "_original");
+      e.getAccelVelIndex(), e.getAccelPedalIndex(), e.getAccelMapValue(),
+      output_accel_file_ + "_original");
     writeMapToCSV(
-      brake_vel_index_, brake_pedal_index_, brake_map_value_, output_brake_file_ + "_original");
+      e.getBrakeVelIndex(), e.getBrakePedalIndex(), e.getBrakeMapValue(),
+      output_brake_file_ + "_original");
   }
 
   // update newest accel / brake map
@@ -427,18 +374,21 @@ void AccelBrakeMapCalibrator::timerCallbackOutputCSV()
     return;
   }
 
-  new_accel_map_ = AccelMap();
-  if (!new_accel_map_.readAccelMapFromCSV(output_accel_file_)) {
+  AccelMap new_accel_map;
+  if (!new_accel_map.readAccelMapFromCSV(output_accel_file_)) {
     RCLCPP_WARN(
       rclcpp::get_logger("accel_brake_map_calibrator"), "Cannot read accelmap. csv path = %s. ",
       output_accel_file_.c_str());
+    return;
   }
-  new_brake_map_ = BrakeMap();
-  if (!new_brake_map_.readBrakeMapFromCSV(output_brake_file_)) {
+  BrakeMap new_brake_map;
+  if (!new_brake_map.readBrakeMapFromCSV(output_brake_file_)) {
     RCLCPP_WARN(
       rclcpp::get_logger("accel_brake_map_calibrator"), "Cannot read brakemap. csv path = %s. ",
       output_brake_file_.c_str());
+    return;
   }
+  estimator_->setNewMap(std::move(new_accel_map), std::move(new_brake_map));
 }
 
 void AccelBrakeMapCalibrator::callbackVelocity(
@@ -451,9 +401,11 @@ void AccelBrakeMapCalibrator::callbackVelocity(
   twist_msg->twist.linear.y = msg->lateral_velocity;
   twist_msg->twist.angular.z = msg->heading_rate;
 
-  if (!twist_vec_.empty()) {
-    const auto past_msg = getNearestTimeDataFromVec(twist_msg, dif_twist_time_, twist_vec_);
-    const double raw_acceleration = getAccel(past_msg, twist_msg);
+  const StampedValue velocity{
+    rclcpp::Time(msg->header.stamp).seconds(), static_cast<double>(msg->longitudinal_velocity)};
+  if (!velocity_buffer_.empty()) {
+    const auto & past_velocity = velocity_buffer_.getNearest(velocity.time - dif_twist_time_);
+    const double raw_acceleration = getAccel(past_velocity, velocity);
     acceleration_ = lowpass(acceleration_, raw_acceleration, 0.25);
     acceleration_time_ = rclcpp::Time(msg->header.stamp).seconds();
     debug_values_.data.at(CURRENT_RAW_ACCEL) = raw_acceleration;
@@ -479,7 +431,7 @@ void AccelBrakeMapCalibrator::callbackVelocity(
 
   debug_values_.data.at(CURRENT_SPEED) = twist_msg->twist.linear.x;
   twist_ptr_ = twist_msg;
-  pushDataToVec(twist_msg, twist_vec_max_size_, &twist_vec_);
+  velocity_buffer_.push(velocity.time, velocity.value);
 }
 
 void AccelBrakeMapCalibrator::callbackSteer(
@@ -495,36 +447,36 @@ void AccelBrakeMapCalibrator::callbackActuationStatus(
   // get accel data
   accel_pedal_ptr_ =
     std::make_shared<DataStamped>(msg->status.accel_status, rclcpp::Time(msg->header.stamp));
-  if (!accel_pedal_vec_.empty()) {
-    const auto past_accel_ptr =
-      getNearestTimeDataFromVec(accel_pedal_ptr_, dif_pedal_time_, accel_pedal_vec_);
+  const StampedValue accel_pedal{accel_pedal_ptr_->data_time.seconds(), accel_pedal_ptr_->data};
+  if (!accel_pedal_buffer_.empty()) {
+    const auto & past_accel_pedal =
+      accel_pedal_buffer_.getNearest(accel_pedal.time - dif_pedal_time_);
     const double raw_accel_pedal_speed =
-      getPedalSpeed(past_accel_ptr, accel_pedal_ptr_, accel_pedal_speed_);
+      getPedalSpeed(past_accel_pedal, accel_pedal, accel_pedal_speed_);
     accel_pedal_speed_ = lowpass(accel_pedal_speed_, raw_accel_pedal_speed, 0.5);
     debug_values_.data.at(CURRENT_RAW_ACCEL_SPEED) = raw_accel_pedal_speed;
     debug_values_.data.at(CURRENT_ACCEL_SPEED) = accel_pedal_speed_;
   }
   debug_values_.data.at(CURRENT_ACCEL_PEDAL) = accel_pedal_ptr_->data;
-  pushDataToVec(accel_pedal_ptr_, pedal_vec_max_size_, &accel_pedal_vec_);
-  delayed_accel_pedal_ptr_ =
-    getNearestTimeDataFromVec(accel_pedal_ptr_, pedal_to_accel_delay_, accel_pedal_vec_);
+  accel_pedal_buffer_.push(accel_pedal.time, accel_pedal.value);
+  delayed_accel_pedal_ptr_ = getDelayedPedal(accel_pedal_buffer_, accel_pedal_ptr_);
 
   // get brake data
   brake_pedal_ptr_ =
     std::make_shared<DataStamped>(msg->status.brake_status, rclcpp::Time(msg->header.stamp));
-  if (!brake_pedal_vec_.empty()) {
-    const auto past_brake_ptr =
-      getNearestTimeDataFromVec(brake_pedal_ptr_, dif_pedal_time_, brake_pedal_vec_);
+  const StampedValue brake_pedal{brake_pedal_ptr_->data_time.seconds(), brake_pedal_ptr_->data};
+  if (!brake_pedal_buffer_.empty()) {
+    const auto & past_brake_pedal =
+      brake_pedal_buffer_.getNearest(brake_pedal.time - dif_pedal_time_);
     const double raw_brake_pedal_speed =
-      getPedalSpeed(past_brake_ptr, brake_pedal_ptr_, brake_pedal_speed_);
+      getPedalSpeed(past_brake_pedal, brake_pedal, brake_pedal_speed_);
     brake_pedal_speed_ = lowpass(brake_pedal_speed_, raw_brake_pedal_speed, 0.5);
     debug_values_.data.at(CURRENT_RAW_BRAKE_SPEED) = raw_brake_pedal_speed;
     debug_values_.data.at(CURRENT_BRAKE_SPEED) = brake_pedal_speed_;
   }
   debug_values_.data.at(CURRENT_BRAKE_PEDAL) = brake_pedal_ptr_->data;
-  pushDataToVec(brake_pedal_ptr_, pedal_vec_max_size_, &brake_pedal_vec_);
-  delayed_brake_pedal_ptr_ =
-    getNearestTimeDataFromVec(brake_pedal_ptr_, pedal_to_accel_delay_, brake_pedal_vec_);
+  brake_pedal_buffer_.push(brake_pedal.time, brake_pedal.value);
+  delayed_brake_pedal_ptr_ = getDelayedPedal(brake_pedal_buffer_, brake_pedal_ptr_);
 }
 
 bool AccelBrakeMapCalibrator::callbackUpdateMapService(
@@ -540,9 +492,12 @@ bool AccelBrakeMapCalibrator::callbackUpdateMapService(
     "update accel/brake map. directory: " << update_map_dir);
   const auto accel_map_file = update_map_dir + "/accel_map.csv";
   const auto brake_map_file = update_map_dir + "/brake_map.csv";
+  const auto & e = *estimator_;
   if (
-    writeMapToCSV(accel_vel_index_, accel_pedal_index_, update_accel_map_value_, accel_map_file) &&
-    writeMapToCSV(brake_vel_index_, brake_pedal_index_, update_brake_map_value_, brake_map_file)) {
+    writeMapToCSV(
+      e.getAccelVelIndex(), e.getAccelPedalIndex(), e.getUpdateAccelMapValue(), accel_map_file) &&
+    writeMapToCSV(
+      e.getBrakeVelIndex(), e.getBrakePedalIndex(), e.getUpdateBrakeMapValue(), brake_map_file)) {
     res->success = true;
     res->message =
       "Data has been successfully saved on " + update_map_dir + "/(accel/brake)_map.csv";
@@ -560,30 +515,28 @@ double AccelBrakeMapCalibrator::lowpass(
 }
 
 double AccelBrakeMapCalibrator::getPedalSpeed(
-  const DataStampedPtr & prev_pedal, const DataStampedPtr & current_pedal,
+  const StampedValue & prev_pedal, const StampedValue & current_pedal,
   const double prev_pedal_speed)
 {
-  const double dt = (current_pedal->data_time - prev_pedal->data_time).seconds();
+  const double dt = current_pedal.time - prev_pedal.time;
   if (dt < 1e-03) {
     // invalid pedal info. return prev pedal speed
     return prev_pedal_speed;
   }
 
-  const double d_pedal = current_pedal->data - prev_pedal->data;
+  const double d_pedal = current_pedal.value - prev_pedal.value;
   return d_pedal / dt;
 }
 
 double AccelBrakeMapCalibrator::getAccel(
-  const geometry_msgs::msg::TwistStamped::ConstSharedPtr & prev_twist,
-  const geometry_msgs::msg::TwistStamped::ConstSharedPtr & current_twist)
+  const StampedValue & prev_velocity, const StampedValue & current_velocity)
 {
-  const double dt =
-    (rclcpp::Time(current_twist->header.stamp) - rclcpp::Time(prev_twist->header.stamp)).seconds();
+  const double dt = current_velocity.time - prev_velocity.time;
   if (dt < 1e-03) {
     // invalid twist. return prev acceleration
     return acceleration_;
   }
-  const double dv = current_twist->twist.linear.x - prev_twist->twist.linear.x;
+  const double dv = current_velocity.value - prev_velocity.value;
   return std::min(std::max(min_accel_, dv / dt), max_accel_);
 }
 
@@ -594,20 +547,6 @@ double AccelBrakeMapCalibrator::getJerk()
   return std::min(std::max(-max_jerk_, jerk), max_jerk_);
 }
 
-bool AccelBrakeMapCalibrator::indexValueSearch(
-  const std::vector<double> value_index, const double value, const double value_thresh,
-  int * searched_index)
-{
-  for (std::size_t i = 0; i < value_index.size(); i++) {
-    const double diff_value = std::fabs(value_index.at(i) - value);
-    if (diff_value <= value_thresh) {
-      *searched_index = i;
-      return true;
-    }
-  }
-  return false;
-}
-
 int AccelBrakeMapCalibrator::nearestValueSearch(
   const std::vector<double> value_index, const double value)
 {
@@ -636,240 +575,20 @@ int AccelBrakeMapCalibrator::nearestPedalSearch()
 
   int nearest_idx;
   if (accel_mode) {
-    nearest_idx = nearestValueSearch(accel_pedal_index_, delayed_accel_pedal_ptr_->data);
+    nearest_idx =
+      nearestValueSearch(estimator_->getAccelPedalIndex(), delayed_accel_pedal_ptr_->data);
   } else {
-    nearest_idx = nearestValueSearch(brake_pedal_index_, delayed_brake_pedal_ptr_->data);
+    nearest_idx =
+      nearestValueSearch(estimator_->getBrakePedalIndex(), delayed_brake_pedal_ptr_->data);
   }
 
-  return getUnifiedIndexFromAccelBrakeIndex(accel_mode, nearest_idx);
+  return estimator_->getUnifiedIndexFromAccelBrakeIndex(accel_mode, nearest_idx);
 }
 
 int AccelBrakeMapCalibrator::nearestVelSearch()
 {
   const double current_vel = twist_ptr_->twist.linear.x;
-  return nearestValueSearch(accel_vel_index_, current_vel);
-}
-
-void AccelBrakeMapCalibrator::takeConsistencyOfAccelMap()
-{
-  const double bit = 1e-03;
-  for (std::size_t ped_idx = 0; ped_idx < update_accel_map_value_.size() - 1; ped_idx++) {
-    for (std::size_t vel_idx = 0; vel_idx < update_accel_map_value_.at(0).size() - 1; vel_idx++) {
-      const double current_acc = update_accel_map_value_.at(ped_idx).at(vel_idx);
-      const double next_ped_acc = update_accel_map_value_.at(ped_idx + 1).at(vel_idx);
-      const double next_vel_acc = update_accel_map_value_.at(ped_idx).at(vel_idx + 1);
-
-      if (current_acc <= next_vel_acc) {
-        // the higher the velocity, the lower the acceleration
-        update_accel_map_value_.at(ped_idx).at(vel_idx + 1) = current_acc - bit;
-      }
-
-      if (current_acc >= next_ped_acc) {
-        // the higher the accel pedal, the higher the acceleration
-        update_accel_map_value_.at(ped_idx + 1).at(vel_idx) = current_acc + bit;
-      }
-    }
-  }
-}
-
-void AccelBrakeMapCalibrator::takeConsistencyOfBrakeMap()
-{
-  const double bit = 1e-03;
-  for (std::size_t ped_idx = 0; ped_idx < update_brake_map_value_.size() - 1; ped_idx++) {
-    for (std::size_t vel_idx = 0; vel_idx < update_brake_map_value_.at(0).size() - 1; vel_idx++) {
-      const double current_acc = update_brake_map_value_.at(ped_idx).at(vel_idx);
-      const double next_ped_acc = update_brake_map_value_.at(ped_idx + 1).at(vel_idx);
-      const double next_vel_acc = update_brake_map_value_.at(ped_idx).at(vel_idx + 1);
-
-      if (current_acc <= next_vel_acc) {
-        // the higher the velocity, the lower the acceleration
-        update_brake_map_value_.at(ped_idx).at(vel_idx + 1) = current_acc - bit;
-      }
-
-      if (current_acc <= next_ped_acc) {
-        // the higher the brake pedal, the lower the acceleration
-        update_brake_map_value_.at(ped_idx + 1).at(vel_idx) = current_acc - bit;
-      }
-    }
-  }
-}
-
-bool AccelBrakeMapCalibrator::updateAccelBrakeMap()
-{
-  // get pedal index
-  bool accel_mode = false;
-  int accel_pedal_index = 0;
-  int brake_pedal_index = 0;
-  int accel_vel_index = 0;
-  int brake_vel_index = 0;
-
-  if (delayed_accel_pedal_ptr_->data > std::numeric_limits<double>::epsilon()) {
-    accel_mode = true;
-  } else {
-    accel_mode = false;
-  }
-
-  if (
-    accel_mode && !indexValueSearch(
-                    accel_pedal_index_, delayed_accel_pedal_ptr_->data, pedal_diff_threshold_,
-                    &accel_pedal_index)) {
-    // not match accel pedal output to pedal value in index
-    return false;
-  }
-
-  if (
-    !accel_mode && !indexValueSearch(
-                     brake_pedal_index_, delayed_brake_pedal_ptr_->data, pedal_diff_threshold_,
-                     &brake_pedal_index)) {
-    // not match accel pedal output to pedal value in index
-    return false;
-  }
-
-  if (
-    accel_mode &&
-    !indexValueSearch(
-      accel_vel_index_, twist_ptr_->twist.linear.x, velocity_diff_threshold_, &accel_vel_index)) {
-    // not match current velocity to velocity value in index
-    return false;
-  }
-
-  if (
-    !accel_mode &&
-    !indexValueSearch(
-      brake_vel_index_, twist_ptr_->twist.linear.x, velocity_diff_threshold_, &brake_vel_index)) {
-    // not match current velocity to velocity value in index
-    return false;
-  }
-
-  // update map
-  executeUpdate(accel_mode, accel_pedal_index, accel_vel_index, brake_pedal_index, brake_vel_index);
-
-  // when update 0 pedal index, update another map
-  if (accel_mode && accel_pedal_index == 0) {
-    // copy accel map value to brake map value
-    update_brake_map_value_.at(accel_pedal_index).at(accel_vel_index) =
-      update_accel_map_value_.at(accel_pedal_index).at(accel_vel_index);
-  } else if (!accel_mode && brake_pedal_index == 0) {
-    // copy brake map value to accel map value
-    update_accel_map_value_.at(brake_pedal_index).at(brake_vel_index) =
-      update_brake_map_value_.at(brake_pedal_index).at(brake_vel_index);
-  }
-
-  // take consistency of map
-  takeConsistencyOfAccelMap();
-  takeConsistencyOfBrakeMap();
-
-  return true;
-}
-
-void AccelBrakeMapCalibrator::executeUpdate(
-  const bool accel_mode, const int accel_pedal_index, const int accel_vel_index,
-  const int brake_pedal_index, const int brake_vel_index)
-{
-  const double measured_acc = acceleration_ - getPitchCompensatedAcceleration();
-  const double map_acc = accel_mode
-                           ? update_accel_map_value_.at(accel_pedal_index).at(accel_vel_index)
-                           : update_brake_map_value_.at(brake_pedal_index).at(brake_vel_index);
-  RCLCPP_DEBUG_STREAM(
-    rclcpp::get_logger("accel_brake_map_calibrator"),
-    "measured_acc: " << measured_acc << ", map_acc: " << map_acc);
-
-  if (update_method_ == UPDATE_METHOD::UPDATE_OFFSET_EACH_CELL) {
-    updateEachValOffset(
-      accel_mode, accel_pedal_index, accel_vel_index, brake_pedal_index, brake_vel_index,
-      measured_acc, map_acc);
-  } else if (update_method_ == UPDATE_METHOD::UPDATE_OFFSET_TOTAL) {
-    updateTotalMapOffset(measured_acc, map_acc);
-  }
-
-  // add accel data to map
-  accel_mode ? map_value_data_.at(getUnifiedIndexFromAccelBrakeIndex(true, accel_pedal_index))
-                 .at(accel_vel_index)
-                 .emplace_back(measured_acc)
-             : map_value_data_.at(getUnifiedIndexFromAccelBrakeIndex(false, brake_pedal_index))
-                 .at(brake_vel_index)
-                 .emplace_back(measured_acc);
-}
-
-bool AccelBrakeMapCalibrator::updateEachValOffset(
-  const bool accel_mode, const int accel_pedal_index, const int accel_vel_index,
-  const int brake_pedal_index, const int brake_vel_index, const double measured_acc,
-  const double map_acc)
-{
-  // pre-defined
-  static std::vector<std::vector<double>> map_offset_vec_(
-    accel_map_value_.size() + brake_map_value_.size() - 1,
-    std::vector<double>(accel_map_value_.at(0).size(), map_offset_));
-  static std::vector<std::vector<double>> covariance_vec_(
-    accel_map_value_.size() + brake_map_value_.size() - 1,
-    std::vector<double>(accel_map_value_.at(0).size(), covariance_));
-
-  const int vel_idx = accel_mode ? accel_vel_index : brake_vel_index;
-  int ped_idx = accel_mode ? accel_pedal_index : brake_pedal_index;
-  ped_idx = getUnifiedIndexFromAccelBrakeIndex(accel_mode, ped_idx);
-  double map_offset = map_offset_vec_.at(ped_idx).at(vel_idx);
-  double covariance = covariance_vec_.at(ped_idx).at(vel_idx);
-
-  /* calculate adaptive map offset */
-  const double phi = 1.0;
-  covariance = (covariance - (covariance * phi * phi * covariance) /
-                               (forgetting_factor_ + phi * covariance * phi)) /
-               forgetting_factor_;
-
-  const double coef = (covariance * phi) / (forgetting_factor_ + phi * covariance * phi);
-
-  const double error_map_offset = measured_acc - map_acc;
-  map_offset = map_offset + coef * error_map_offset;
-
-  RCLCPP_DEBUG_STREAM(
-    rclcpp::get_logger("accel_brake_map_calibrator"),
-    "index: " << ped_idx << ", " << vel_idx << ": map_offset_ = "
-              << map_offset_vec_.at(ped_idx).at(vel_idx) << " -> " << map_offset << "\t"
-              << " covariance = " << covariance);
-
-  /* input calculated result and update map */
-  map_offset_vec_.at(ped_idx).at(vel_idx) = map_offset;
-  covariance_vec_.at(ped_idx).at(vel_idx) = covariance;
-  if (accel_mode) {
-    update_accel_map_value_.at(accel_pedal_index).at(accel_vel_index) =
-      accel_map_value_.at(accel_pedal_index).at(accel_vel_index) + map_offset;
-  } else {
-    update_brake_map_value_.at(brake_pedal_index).at(brake_vel_index) =
-      brake_map_value_.at(brake_pedal_index).at(brake_vel_index) + map_offset;
-  }
-  return true;
-}
-
-void AccelBrakeMapCalibrator::updateTotalMapOffset(const double measured_acc, const double map_acc)
-{
-  /* calculate adaptive map offset */
-  const double phi = 1.0;
-  covariance_ = (covariance_ - (covariance_ * phi * phi * covariance_) /
-                                 (forgetting_factor_ + phi * covariance_ * phi)) /
-                forgetting_factor_;
-
-  const double coef = (covariance_ * phi) / (forgetting_factor_ + phi * covariance_ * phi);
-  const double error_map_offset = measured_acc - map_acc;
-  map_offset_ = map_offset_ + coef * error_map_offset;
-
-  RCLCPP_DEBUG_STREAM(
-    rclcpp::get_logger("accel_brake_map_calibrator"),
-    "map_offset_ = " << map_offset_ << "\t"
-                     << "covariance = " << covariance_);
-
-  /* update map */
-  for (std::size_t ped_idx = 0; ped_idx < update_accel_map_value_.size() - 1; ped_idx++) {
-    for (std::size_t vel_idx = 0; vel_idx < update_accel_map_value_.at(0).size() - 1; vel_idx++) {
-      update_accel_map_value_.at(ped_idx).at(vel_idx) =
-        accel_map_value_.at(ped_idx).at(vel_idx) + map_offset_;
-    }
-  }
-  for (std::size_t ped_idx = 0; ped_idx < update_brake_map_value_.size() - 1; ped_idx++) {
-    for (std::size_t vel_idx = 0; vel_idx < update_brake_map_value_.at(0).size() - 1; vel_idx++) {
-      update_brake_map_value_.at(ped_idx).at(vel_idx) =
-        brake_map_value_.at(ped_idx).at(vel_idx) + map_offset_;
-    }
-  }
+  return nearestValueSearch(estimator_->getAccelVelIndex(), current_vel);
 }
 
 std::vector<double> AccelBrakeMapCalibrator::getMapColumnFromUnifiedIndex(
@@ -887,25 +606,14 @@ std::vector<double> AccelBrakeMapCalibrator::getMapColumnFromUnifiedIndex(
 
 double AccelBrakeMapCalibrator::getPedalValueFromUnifiedIndex(const std::size_t index)
 {
-  if (index < brake_pedal_index_.size()) {
+  const auto & accel_pedal_index = estimator_->getAccelPedalIndex();
+  const auto & brake_pedal_index = estimator_->getBrakePedalIndex();
+  if (index < brake_pedal_index.size()) {
     // brake index ( minus )
-    return -brake_pedal_index_.at(brake_pedal_index_.size() - index - 1);
+    return -brake_pedal_index.at(brake_pedal_index.size() - index - 1);
   } else {
     // input accel map value
-    return accel_pedal_index_.at(index - brake_pedal_index_.size() + 1);
-  }
-}
-
-int AccelBrakeMapCalibrator::getUnifiedIndexFromAccelBrakeIndex(
-  const bool accel_map, const std::size_t index)
-{
-  // accel_map=true: accel_map; accel_map=false: brake_map
-  if (accel_map) {
-    // accel map
-    return index + brake_map_value_.size() - 1;
-  } else {
-    // brake map
-    return brake_map_value_.size() - index - 1;
+    return accel_pedal_index.at(index - brake_pedal_index.size() + 1);
   }
 }
 
@@ -916,53 +624,6 @@ double AccelBrakeMapCalibrator::getPitchCompensatedAcceleration()
   return gravity * std::sin(pitch_);
 }
 
-void AccelBrakeMapCalibrator::executeEvaluation()
-{
-  const double full_orig_accel_sq_error = calculateAccelSquaredError(
-    delayed_accel_pedal_ptr_->data, delayed_brake_pedal_ptr_->data, twist_ptr_->twist.linear.x,
-    accel_map_, brake_map_);
-  pushDataToVec(full_orig_accel_sq_error, full_mse_que_size_, &full_original_accel_mse_que_);
-  full_original_accel_rmse_ = getAverage(full_original_accel_mse_que_);
-
-  const double part_orig_accel_sq_error = calculateAccelSquaredError(
-    delayed_accel_pedal_ptr_->data, delayed_brake_pedal_ptr_->data, twist_ptr_->twist.linear.x,
-    accel_map_, brake_map_);
-  pushDataToVec(part_orig_accel_sq_error, part_mse_que_size_, &part_original_accel_mse_que_);
-  part_original_accel_rmse_ = getAverage(part_original_accel_mse_que_);
-
-  const double new_accel_sq_error = calculateAccelSquaredError(
-    delayed_accel_pedal_ptr_->data, delayed_brake_pedal_ptr_->data, twist_ptr_->twist.linear.x,
-    new_accel_map_, new_brake_map_);
-  pushDataToVec(new_accel_sq_error, part_mse_que_size_, &new_accel_mse_que_);
-  new_accel_rmse_ = getAverage(new_accel_mse_que_);
-}
-
-double AccelBrakeMapCalibrator::calculateEstimatedAcc(
-  const double throttle, const double brake, const double vel, AccelMap & accel_map,
-  BrakeMap & brake_map)
-{
-  const double pedal = throttle - brake;
-
-  double estimated_acc = 0.0;
-  if (pedal > 0.0) {
-    accel_map.getAcceleration(pedal, vel, estimated_acc);
-  } else {
-    brake_map.getAcceleration(-pedal, vel, estimated_acc);
-  }
-
-  return estimated_acc;
-}
-
-double AccelBrakeMapCalibrator::calculateAccelSquaredError(
-  const double throttle, const double brake, const double vel, AccelMap & accel_map,
-  BrakeMap & brake_map)
-{
-  const double estimated_acc = calculateEstimatedAcc(throttle, brake, vel, accel_map, brake_map);
-  const double measured_acc = acceleration_ - getPitchCompensatedAcceleration();
-  const double dif_acc = measured_acc - estimated_acc;
-  return dif_acc * dif_acc;
-}
-
 void AccelBrakeMapCalibrator::pushDataToQue(
   const geometry_msgs::msg::TwistStamped::ConstSharedPtr & data, const std::size_t max_size,
   std::queue<geometry_msgs::msg::TwistStamped::ConstSharedPtr> * que)
@@ -973,49 +634,16 @@ void AccelBrakeMapCalibrator::pushDataToQue(
   }
 }
 
-template <class T>
-void AccelBrakeMapCalibrator::pushDataToVec(
-  const T data, const std::size_t max_size, std::vector<T> * vec)
-{
-  vec->emplace_back(data);
-  while (vec->size() > max_size) {
-    vec->erase(vec->begin());
-  }
-}
-
-template <class T>
-T AccelBrakeMapCalibrator::getNearestTimeDataFromVec(
-  const T base_data, const double back_time, const std::vector<T> & vec)
-{
-  double nearest_time = std::numeric_limits<double>::max();
-  const double target_time = rclcpp::Time(base_data->header.stamp).seconds() - back_time;
-  T nearest_time_data;
-  for (const auto data : vec) {
-    const double data_time = rclcpp::Time(data->header.stamp).seconds();
-    const auto delta_time = std::abs(target_time - data_time);
-    if (nearest_time > delta_time) {
-      nearest_time_data = data;
-      nearest_time = delta_time;
-    }
-  }
-  return nearest_time_data;
-}
-
-DataStampedPtr AccelBrakeMapCalibrator::getNearestTimeDataFromVec(
-  DataStampedPtr base_data, const double back_time, const std::vector<DataStampedPtr> & vec)
+DataStampedPtr AccelBrakeMapCalibrator::getDelayedPedal(
+  const StampedDataBuffer & pedal_buffer, const DataStampedPtr & current_pedal) const
 {
-  double nearest_time = std::numeric_limits<double>::max();
-  const double target_time = base_data->data_time.seconds() - back_time;
-  DataStampedPtr nearest_time_data;
-  for (const auto data : vec) {
-    const double data_time = data->data_time.seconds();
-    const auto delta_time = std::abs(target_time - data_time);
-    if (nearest_time > delta_time) {
-      nearest_time_data = data;
-      nearest_time = delta_time;
-    }
-  }
-  return nearest_time_data;
+  const auto & delayed_pedal =
+    pedal_buffer.getNearest(current_pedal->data_time.seconds() - pedal_to_accel_delay_);
+  return std::make_shared<DataStamped>(
+    delayed_pedal.value,
+    rclcpp::Time(
+      static_cast<int64_t>(std::round(delayed_pedal.time * 1e9)),
+      current_pedal->data_time.get_clock_type()));
 }
 
 double AccelBrakeMapCalibrator::getAverage(const std::vector<double> & vec)
@@ -1089,14 +717,14 @@ void AccelBrakeMapCalibrator::checkUpdateSuggest(diagnostic_updater::DiagnosticS
   int8_t level = DiagStatus::OK;
   std::string msg = "OK";
 
-  if (new_accel_mse_que_.size() < part_mse_que_size_ / 2) {
+  if (!estimator_ || estimator_->getNewAccelMSESize() < estimator_param_.part_mse_que_size / 2) {
     // lack of data
     stat.summary(level, msg);
 
     return;
   }
 
-  const double rmse_rate = new_accel_rmse_ / part_original_accel_rmse_;
+  const double rmse_rate = estimator_->getNewAccelMSE() / estimator_->getPartOriginalAccelMSE();
   if (rmse_rate < update_suggest_thresh_) {
     // The accuracy of original accel/brake map is low.
     // Suggest to update accel brake map
@@ -1130,7 +758,7 @@ void AccelBrakeMapCalibrator::publishMap(
   for (int i = 0; i < h; i++) {
     for (int j = 0; j < w; j++) {
       const double value =
-        getMapColumnFromUnifiedIndex(accel_map_value_, brake_map_value_, i).at(j);
+        getMapColumnFromUnifiedIndex(accel_map_value, brake_map_value, i).at(j);
       // convert acc to 0~100 int value
       int8_t int_value =
         static_cast<uint8_t>(MAX_OCC_VALUE * ((value - min_accel_) / (max_accel_ - min_accel_)));
@@ -1160,7 +788,7 @@ void AccelBrakeMapCalibrator::publishMap(
   for (int i = 0; i < h; i++) {
     for (int j = 0; j < w; j++) {
       vec[i * w + j] = static_cast<float>(
-        getMapColumnFromUnifiedIndex(accel_map_value_, brake_map_value_, i).at(j));
+        getMapColumnFromUnifiedIndex(accel_map_value, brake_map_value, i).at(j));
     }
   }
   float_map.data = vec;
@@ -1187,15 +815,17 @@ void AccelBrakeMapCalibrator::publishFloat32(const std::string publish_type, con
 
 void AccelBrakeMapCalibrator::publishCountMap()
 {
-  if (accel_map_value_.at(0).size() != brake_map_value_.at(0).size()) {
+  const auto & accel_map_value = estimator_->getAccelMapValue();
+  const auto & brake_map_value = estimator_->getBrakeMapValue();
+  if (accel_map_value.at(0).size() != brake_map_value.at(0).size()) {
     RCLCPP_ERROR_STREAM(
       rclcpp::get_logger("accel_brake_map_calibrator"),
       "Invalid map. The number of velocity index of accel map and brake map is different.");
     return;
   }
-  const double h = accel_map_value_.size() + brake_map_value_.size() -
+  const double h = accel_map_value.size() + brake_map_value.size() -
                    1;  // pedal (accel_map_value(0) and brake_map_value(0) is same.)
-  const double w = accel_map_value_.at(0).size();  // velocity
+  const double w = accel_map_value.at(0).size();  // velocity
   const int8_t MAX_OCC_VALUE = 100;
 
   std::vector<int8_t> count_map, ave_map, std_map;
@@ -1205,7 +835,7 @@ void AccelBrakeMapCalibrator::publishCountMap()
 
   for (int i = 0; i < h; i++) {
     for (int j = 0; j < w; j++) {
-      const auto data_vec = map_value_data_.at(i).at(j);
+      const auto data_vec = estimator_->getMapValueData().at(i).at(j);
       if (data_vec.empty()) {
         // input *UNKNOWN* value
         count_map.at(i * w + j) = -1;
@@ -1254,9 +884,11 @@ void AccelBrakeMapCalibrator::publishCountMap()
 void AccelBrakeMapCalibrator::publishIndex()
 {
   visualization_msgs::msg::MarkerArray markers;
-  const double h = accel_map_value_.size() + brake_map_value_.size() -
+  const auto & accel_map_value = estimator_->getAccelMapValue();
+  const auto & brake_map_value = estimator_->getBrakeMapValue();
+  const double h = accel_map_value.size() + brake_map_value.size() -
                    1;  // pedal (accel_map_value(0) and brake_map_value(0) is same.)
-  const double w = accel_map_value_.at(0).size();  // velocity
+  const double w = accel_map_value.at(0).size();  // velocity
 
   visualization_msgs::msg::Marker marker;
   marker.header.frame_id = "base_link";
@@ -1301,7 +933,7 @@ void AccelBrakeMapCalibrator::publishIndex()
 
   // velocity value
   for (int vel_idx = 0; vel_idx < w; vel_idx++) {
-    const double vel_value = accel_vel_index_.at(vel_idx);
+    const double vel_value = estimator_->getAccelVelIndex().at(vel_idx);
     marker.ns = "occ_vel_index";
     marker.id = vel_idx;
     marker.pose.position.x = map_resolution_ * (0.5 + vel_idx);
@@ -1329,11 +961,11 @@ void AccelBrakeMapCalibrator::publishUpdateSuggestFlag()
 {
   std_msgs::msg::Bool update_suggest;
 
-  if (new_accel_mse_que_.size() < part_mse_que_size_ / 2) {
+  if (estimator_->getNewAccelMSESize() < estimator_param_.part_mse_que_size / 2) {
     // lack of data
     update_suggest.data = false;
   } else {
-    const double rmse_rate = new_accel_rmse_ / part_original_accel_rmse_;
+    const double rmse_rate = estimator_->getNewAccelMSE() / estimator_->getPartOriginalAccelMSE();
     update_suggest.data = (rmse_rate < update_suggest_thresh_);
     if (update_suggest.data) {
       auto & clk = *this->get_clock();
@@ -1347,45 +979,13 @@ void AccelBrakeMapCalibrator::publishUpdateSuggestFlag()
 }
 
 bool AccelBrakeMapCalibrator::writeMapToCSV(
-  std::vector<double> vel_index, std::vector<double> pedal_index,
-  std::vector<std::vector<double>> value_map, std::string filename)
+  const std::vector<double> & vel_index, const std::vector<double> & pedal_index,
+  const std::vector<std::vector<double>> & value_map, const std::string & filename)
 {
-  if (update_success_count_ == 0) {
-    return false;
-  }
-
-  std::ofstream csv_file(filename);
-
-  if (!csv_file.is_open()) {
-    RCLCPP_WARN(
-      rclcpp::get_logger("accel_brake_map_calibrator"), "Failed to open csv file : %s",
-      filename.c_str());
+  if (estimator_->getCounts().update_success == 0) {
     return false;
   }
-
-  csv_file << "default,";
-  for (std::size_t v = 0; v < vel_index.size(); v++) {
-    csv_file << vel_index.at(v);
-    if (v != vel_index.size() - 1) {
-      csv_file << ",";
-    }
-  }
-  csv_file << "\n";
-
-  for (std::size_t p = 0; p < pedal_index.size(); p++) {
-    csv_file << pedal_index.at(p) << ",";
-    for (std::size_t v = 0; v < vel_index.size(); v++) {
-      csv_file << std::setprecision(3) << value_map.at(p).at(v);
-      if (v != vel_index.size() - 1) {
-        csv_file << ",";
-      }
-    }
-    csv_file << "\n";
-  }
-  csv_file.close();
-  RCLCPP_DEBUG_STREAM(
-    rclcpp::get_logger("accel_brake_map_calibrator"), "output map to " << filename);
-  return true;
+  return AccelBrakeMapEstimator::writeMapToCSV(vel_index, pedal_index, value_map, filename);
 }
 
 void AccelBrakeMapCalibrator::addIndexToCSV(std::ofstream * csv_file)
@@ -0,0 +1,453 @@
+//
+// Copyright 2021 Tier IV, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include "accel_brake_map_calibrator/accel_brake_map_estimator.hpp"
+
+#include "rclcpp/logging.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <limits>
+#include <string>
+#include <utility>
+#include <vector>
+
+AccelBrakeMapEstimator::AccelBrakeMapEstimator(const Param & param)
+: param_(param),
+  full_original_accel_mse_que_(param.full_mse_que_size),
+  part_original_accel_mse_que_(param.part_mse_que_size),
+  new_accel_mse_que_(param.part_mse_que_size),
+  covariance_(param.initial_covariance)
+{
+}
+
+void AccelBrakeMapEstimator::setMap(AccelMap accel_map, BrakeMap brake_map)
+{
+  accel_map_value_ = accel_map.getAccelMap();
+  brake_map_value_ = brake_map.getBrakeMap();
+  accel_vel_index_ = accel_map.getVelIdx();
+  brake_vel_index_ = brake_map.getVelIdx();
+  accel_pedal_index_ = accel_map.getThrottleIdx();
+  brake_pedal_index_ = brake_map.getBrakeIdx();
+
+  accel_map_ = std::move(accel_map);
+  brake_map_ = std::move(brake_map);
+  has_new_map_ = false;
+
+  reset();
+}
+
+void AccelBrakeMapEstimator::setNewMap(AccelMap accel_map, BrakeMap brake_map)
+{
+  new_accel_map_ = std::move(accel_map);
+  new_brake_map_ = std::move(brake_map);
+  has_new_map_ = true;
+}
+
+void AccelBrakeMapEstimator::reset()
+{
+  counts_ = Counts();
+  update_accel_map_value_ = accel_map_value_;
+  update_brake_map_value_ = brake_map_value_;
+
+  // pedal (accel_map_value(0) and brake_map_value(0) is same.)
+  const std::size_t h = accel_map_value_.size() + brake_map_value_.size() - 1;
+  const std::size_t w = accel_map_value_.at(0).size();
+  map_value_data_.assign(h, std::vector<std::vector<double>>(w));
+  map_offset_vec_.assign(h, std::vector<double>(w, 0.0));
+  covariance_vec_.assign(h, std::vector<double>(w, param_.initial_covariance));
+  map_offset_ = 0.0;
+  covariance_ = param_.initial_covariance;
+}
+
+bool AccelBrakeMapEstimator::update(const CalibrationSample & sample)
+{
+  // twist check
+  if (sample.velocity < param_.velocity_min_threshold) {
+    // too low speed ( or backward velocity)
+    counts_.too_low_speed++;
+    return false;
+  }
+
+  // accel / brake map evaluation (do not evaluate when the car stops)
+  executeEvaluation(sample);
+
+  // pitch check
+  if (std::fabs(sample.pitch) > param_.max_pitch_threshold) {
+    // too large pitch
+    counts_.too_large_pitch++;
+    return false;
+  }
+
+  // steer check
+  if (std::fabs(sample.steer) > param_.max_steer_threshold) {
+    // too large steer
+    counts_.too_large_steer++;
+    return false;
+  }
+
+  // jerk check
+  if (std::fabs(sample.jerk) > param_.max_jerk_threshold) {
+    // too large jerk
+    counts_.too_large_jerk++;
+    return false;
+  }
+
+  // pedal check
+  if (
+    sample.accel_pedal > std::numeric_limits<double>::epsilon() &&
+    sample.brake_pedal > std::numeric_limits<double>::epsilon()) {
+    // both (accel/brake) output
+    RCLCPP_DEBUG_STREAM(
+      rclcpp::get_logger("accel_brake_map_calibrator"),
+      "invalid pedal value (Both of accel output and brake output area not zero. )");
+    counts_.invalid_acc_brake++;
+    return false;
+  }
+
+  // pedal speed check
+  if (
+    std::fabs(sample.accel_pedal_speed) > param_.pedal_velocity_thresh ||
+    std::fabs(sample.brake_pedal_speed) > param_.pedal_velocity_thresh) {
+    // too large pedal speed
+    counts_.too_large_pedal_spd++;
+    return false;
+  }
+
+  /* update map */
+  if (!updateAccelBrakeMap(sample)) {
+    counts_.update_fail++;
+    return false;
+  }
+  counts_.update_success++;
+  return true;
+}
+
+void AccelBrakeMapEstimator::executeEvaluation(const CalibrationSample & sample)
+{
+  const double original_accel_sq_error =
+    calculateAccelSquaredError(sample, accel_map_, brake_map_);
+  full_original_accel_mse_que_.push(original_accel_sq_error);
+  part_original_accel_mse_que_.push(original_accel_sq_error);
+
+  const double new_accel_sq_error =
+    has_new_map_ ? calculateAccelSquaredError(sample, new_accel_map_, new_brake_map_)
+                 : original_accel_sq_error;
+  new_accel_mse_que_.push(new_accel_sq_error);
+}
+
+double AccelBrakeMapEstimator::calculateEstimatedAcc(
+  const double throttle, const double brake, const double vel, AccelMap & accel_map,
+  BrakeMap & brake_map)
+{
+  const double pedal = throttle - brake;
+
+  double estimated_acc = 0.0;
+  if (pedal > 0.0) {
+    accel_map.getAcceleration(pedal, vel, estimated_acc);
+  } else {
+    brake_map.getAcceleration(-pedal, vel, estimated_acc);
+  }
+
+  return estimated_acc;
+}
+
+double AccelBrakeMapEstimator::calculateAccelSquaredError(
+  const CalibrationSample & sample, AccelMap & accel_map, BrakeMap & brake_map)
+{
+  const double estimated_acc = calculateEstimatedAcc(
+    sample.accel_pedal, sample.brake_pedal, sample.velocity, accel_map, brake_map);
+  const double dif_acc = sample.measured_acc - estimated_acc;
+  return dif_acc * dif_acc;
+}
+
+bool AccelBrakeMapEstimator::updateAccelBrakeMap(const CalibrationSample & sample)
+{
+  // get pedal index
+  int accel_pedal_index = 0;
+  int brake_pedal_index = 0;
+  int accel_vel_index = 0;
+  int brake_vel_index = 0;
+
+  const bool accel_mode = sample.accel_pedal > std::numeric_limits<double>::epsilon();
+
+  if (
+    accel_mode && !indexValueSearch(
+                    accel_pedal_index_, sample.accel_pedal, param_.pedal_diff_threshold,
+                    &accel_pedal_index)) {
+    // not match accel pedal output to pedal value in index
+    return false;
+  }
+
+  if (
+    !accel_mode && !indexValueSearch(
+                     brake_pedal_index_, sample.brake_pedal, param_.pedal_diff_threshold,
+                     &brake_pedal_index)) {
+    // not match accel pedal output to pedal value in index
+    return false;
+  }
+
+  if (
+    accel_mode && !indexValueSearch(
+                    accel_vel_index_, sample.velocity, param_.velocity_diff_threshold,
+                    &accel_vel_index)) {
+    // not match current velocity to velocity value in index
+    return false;
+  }
+
+  if (
+    !accel_mode && !indexValueSearch(
+                     brake_vel_index_, sample.velocity, param_.velocity_diff_threshold,
+                     &brake_vel_index)) {
+    // not match current velocity to velocity value in index
+    return false;
+  }
+
+  // update map
+  executeUpdate(
+    accel_mode, accel_pedal_index, accel_vel_index, brake_pedal_index, brake_vel_index,
+    sample.measured_acc);
+
+  // when update 0 pedal index, update another map
+  if (accel_mode && accel_pedal_index == 0) {
+    // copy accel map value to brake map value
+    update_brake_map_value_.at(accel_pedal_index).at(accel_vel_index) =
+      update_accel_map_value_.at(accel_pedal_index).at(accel_vel_index);
+  } else if (!accel_mode && brake_pedal_index == 0) {
+    // copy brake map value to accel map value
+    update_accel_map_value_.at(brake_pedal_index).at(brake_vel_index) =
+      update_brake_map_value_.at(brake_pedal_index).at(brake_vel_index);
+  }
+
+  // take consistency of map
+  takeConsistencyOfAccelMap();
+  takeConsistencyOfBrakeMap();
+
+  return true;
+}
+
+void AccelBrakeMapEstimator::executeUpdate(
+  const bool accel_mode, const int accel_pedal_index, const int accel_vel_index,
+  const int brake_pedal_index, const int brake_vel_index, const double measured_acc)
+{
+  const double map_acc = accel_mode
+                           ? update_accel_map_value_.at(accel_pedal_index).at(accel_vel_index)
+                           : update_brake_map_value_.at(brake_pedal_index).at(brake_vel_index);
+  RCLCPP_DEBUG_STREAM(
+    rclcpp::get_logger("accel_brake_map_calibrator"),
+    "measured_acc: " << measured_acc << ", map_acc: " << map_acc);
+
+  if (param_.update_method == UPDATE_METHOD::UPDATE_OFFSET_EACH_CELL) {
+    updateEachValOffset(
+      accel_mode, accel_pedal_index, accel_vel_index, brake_pedal_index, brake_vel_index,
+      measured_acc, map_acc);
+  } else if (param_.update_method == UPDATE_METHOD::UPDATE_OFFSET_TOTAL) {
+    updateTotalMapOffset(measured_acc, map_acc);
+  }
+
+  // add accel data to map
+  accel_mode ? map_value_data_.at(getUnifiedIndexFromAccelBrakeIndex(true, accel_pedal_index))
+                 .at(accel_vel_index)
+                 .emplace_back(measured_acc)
+             : map_value_data_.at(getUnifiedIndexFromAccelBrakeIndex(false, brake_pedal_index))
+                 .at(brake_vel_index)
+                 .emplace_back(measured_acc);
+}
+
+void AccelBrakeMapEstimator::updateEachValOffset(
+  const bool accel_mode, const int accel_pedal_index, const int accel_vel_index,
+  const int brake_pedal_index, const int brake_vel_index, const double measured_acc,
+  const double map_acc)
+{
+  const int vel_idx = accel_mode ? accel_vel_index : brake_vel_index;
+  int ped_idx = accel_mode ? accel_pedal_index : brake_pedal_index;
+  ped_idx = getUnifiedIndexFromAccelBrakeIndex(accel_mode, ped_idx);
+  double map_offset = map_offset_vec_.at(ped_idx).at(vel_idx);
+  double covariance = covariance_vec_.at(ped_idx).at(vel_idx);
+
+  /* calculate adaptive map offset */
+  const double phi = 1.0;
+  const double forgetting_factor = param_.forgetting_factor;
+  covariance = (covariance - (covariance * phi * phi * covariance) /
+                               (forgetting_factor + phi * covariance * phi)) /
+               forgetting_factor;
+
+  const double coef = (covariance * phi) / (forgetting_factor + phi * covariance * phi);
+
+  const double error_map_offset = measured_acc - map_acc;
+  map_offset = map_offset + coef * error_map_offset;
+
+  RCLCPP_DEBUG_STREAM(
+    rclcpp::get_logger("accel_brake_map_calibrator"),
+    "index: " << ped_idx << ", " << vel_idx << ": map_offset_ = "
+              << map_offset_vec_.at(ped_idx).at(vel_idx) << " -> " << map_offset << "\t"
+              << " covariance = " << covariance);
+
+  /* input calculated result and update map */
+  map_offset_vec_.at(ped_idx).at(vel_idx) = map_offset;
+  covariance_vec_.at(ped_idx).at(vel_idx) = covariance;
+  if (accel_mode) {
+    update_accel_map_value_.at(accel_pedal_index).at(accel_vel_index) =
+      accel_map_value_.at(accel_pedal_index).at(accel_vel_index) + map_offset;
+  } else {
+    update_brake_map_value_.at(brake_pedal_index).at(brake_vel_index) =
+      brake_map_value_.at(brake_pedal_index).at(brake_vel_index) + map_offset;
+  }
+}
+
+void AccelBrakeMapEstimator::updateTotalMapOffset(const double measured_acc, const double map_acc)
+{
+  /* calculate adaptive map offset */
+  const double phi = 1.0;
+  const double forgetting_factor = param_.forgetting_factor;
+  covariance_ = (covariance_ - (covariance_ * phi * phi * covariance_) /
+                                 (forgetting_factor + phi * covariance_ * phi)) /
+                forgetting_factor;
+
+  const double coef = (covariance_ * phi) / (forgetting_factor + phi * covariance_ * phi);
+  const double error_map_offset = measured_acc - map_acc;
+  map_offset_ = map_offset_ + coef * error_map_offset;
+
+  RCLCPP_DEBUG_STREAM(
+    rclcpp::get_logger("accel_brake_map_calibrator"),
+    "map_offset_ = " << map_offset_ << "\t"
+                     << "covariance = " << covariance_);
+
+  /* update map */
+  for (std::size_t ped_idx = 0; ped_idx < update_accel_map_value_.size() - 1; ped_idx++) {
+    for (std::size_t vel_idx = 0; vel_idx < update_accel_map_value_.at(0).size() - 1; vel_idx++) {
+      update_accel_map_value_.at(ped_idx).at(vel_idx) =
+        accel_map_value_.at(ped_idx).at(vel_idx) + map_offset_;
+    }
+  }
+  for (std::size_t ped_idx = 0; ped_idx < update_brake_map_value_.size() - 1; ped_idx++) {
+    for (std::size_t vel_idx = 0; vel_idx < update_brake_map_value_.at(0).size() - 1; vel_idx++) {
+      update_brake_map_value_.at(ped_idx).at(vel_idx) =
+        brake_map_value_.at(ped_idx).at(vel_idx) + map_offset_;
+    }
+  }
+}
+
+void AccelBrakeMapEstimator::takeConsistencyOfAccelMap()
+{
+  const double bit = 1e-03;
+  for (std::size_t ped_idx = 0; ped_idx < update_accel_map_value_.size() - 1; ped_idx++) {
+    for (std::size_t vel_idx = 0; vel_idx < update_accel_map_value_.at(0).size() - 1; vel_idx++) {
+      const double current_acc = update_accel_map_value_.at(ped_idx).at(vel_idx);
+      const double next_ped_acc = update_accel_map_value_.at(ped_idx + 1).at(vel_idx);
+      const double next_vel_acc = update_accel_map_value_.at(ped_idx).at(vel_idx + 1);
+
+      if (current_acc <= next_vel_acc) {
+        // the higher the velocity, the lower the acceleration
+        update_accel_map_value_.at(ped_idx).at(vel_idx + 1) = current_acc - bit;
+      }
+
+      if (current_acc >= next_ped_acc) {
+        // the higher the accel pedal, the higher the acceleration
+        update_accel_map_value_.at(ped_idx + 1).at(vel_idx) = current_acc + bit;
+      }
+    }
+  }
+}
+
+void AccelBrakeMapEstimator::takeConsistencyOfBrakeMap()
+{
+  const double bit = 1e-03;
+  for (std::size_t ped_idx = 0; ped_idx < update_brake_map_value_.size() - 1; ped_idx++) {
+    for (std::size_t vel_idx = 0; vel_idx < update_brake_map_value_.at(0).size() - 1; vel_idx++) {
+      const double current_acc = update_brake_map_value_.at(ped_idx).at(vel_idx);
+      const double next_ped_acc = update_brake_map_value_.at(ped_idx + 1).at(vel_idx);
+      const double next_vel_acc = update_brake_map_value_.at(ped_idx).at(vel_idx + 1);
+
+      if (current_acc <= next_vel_acc) {
+        // the higher the velocity, the lower the acceleration
+        update_brake_map_value_.at(ped_idx).at(vel_idx + 1) = current_acc - bit;
+      }
+
+      if (current_acc <= next_ped_acc) {
+        // the higher the brake pedal, the lower the acceleration
+        update_brake_map_value_.at(ped_idx + 1).at(vel_idx) = current_acc - bit;
+      }
+    }
+  }
+}
+
+bool AccelBrakeMapEstimator::indexValueSearch(
+  const std::vector<double> & value_index, const double value, const double value_thresh,
+  int * searched_index) const
+{
+  for (std::size_t i = 0; i < value_index.size(); i++) {
+    const double diff_value = std::fabs(value_index.at(i) - value);
+    if (diff_value <= value_thresh) {
+      *searched_index = i;
+      return true;
+    }
+  }
+  return false;
+}
+
+int AccelBrakeMapEstimator::getUnifiedIndexFromAccelBrakeIndex(
+  const bool accel_map, const std::size_t index) const
+{
+  // accel_map=true: accel_map; accel_map=false: brake_map
+  if (accel_map) {
+    // accel map
+    return index + brake_map_value_.size() - 1;
+  } else {
+    // brake map
+    return brake_map_value_.size() - index - 1;
+  }
+}
+
+bool AccelBrakeMapEstimator::writeMapToCSV(
+  const std::vector<double> & vel_index, const std::vector<double> & pedal_index,
+  const std::vector<std::vector<double>> & value_map, const std::string & filename)
+{
+  std::ofstream csv_file(filename);
+
+  if (!csv_file.is_open()) {
+    RCLCPP_WARN(
+      rclcpp::get_logger("accel_brake_map_calibrator"), "Failed to open csv file : %s",
+      filename.c_str());
+    return false;
+  }
+
+  csv_file << "default,";
+  for (std::size_t v = 0; v < vel_index.size(); v++) {
+    csv_file << vel_index.at(v);
+    if (v != vel_index.size() - 1) {
+      csv_file << ",";
+    }
+  }
+  csv_file << "\n";
+
+  for (std::size_t p = 0; p < pedal_index.size(); p++) {
+    csv_file << pedal_index.at(p) << ",";
+    for (std::size_t v = 0; v < vel_index.size(); v++) {
+      csv_file << std::setprecision(3) << value_map.at(p).at(v);
+      if (v != vel_index.size() - 1) {
+        csv_file << ",";
+      }
+    }
+    csv_file << "\n";
+  }
+  csv_file.close();
+  RCLCPP_DEBUG_STREAM(
+    rclcpp::get_logger("accel_brake_map_calibrator"), "output map to " << filename);
+  return true;
+}
@@ -0,0 +1,151 @@
+//
+// Copyright 2021 Tier IV, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include "accel_brake_map_calibrator/accel_brake_map_estimator.hpp"
+#include "accel_brake_map_calibrator/calibration_log.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+/*
+ * Replay the calibration log of accel_brake_map_calibrator (output_log_file with
+ * pedal_accel_graph_output) offline, and write the calibrated maps.
+ */
+
+namespace
+{
+bool readMap(const std::string & map_dir, AccelMap * accel_map, BrakeMap * brake_map)
+{
+  const std::string accel_map_file = map_dir + "/accel_map.csv";
+  const std::string brake_map_file = map_dir + "/brake_map.csv";
+  if (!accel_map->readAccelMapFromCSV(accel_map_file)) {
+    std::cerr << "Cannot read accelmap. csv path = " << accel_map_file << std::endl;
+    return false;
+  }
+  if (!brake_map->readBrakeMapFromCSV(brake_map_file)) {
+    std::cerr << "Cannot read brakemap. csv path = " << brake_map_file << std::endl;
+    return false;
+  }
+  return true;
+}
+}  // namespace
+
+int main(int argc, char ** argv)
+{
+  if (argc < 4) {
+    std::cerr << "Usage: " << argv[0]
+              << " <calibration log> <original map dir> <calibrated map dir>"
+                 " [update_offset_each_cell|update_offset_total]"
+              << std::endl;
+    return 1;
+  }
+  const std::string log_file = argv[1];
+  const std::string original_map_dir = argv[2];
+  const std::string calibrated_map_dir = argv[3];
+
+  AccelBrakeMapEstimator::Param param;
+  if (argc > 4) {
+    const std::string update_method_str = argv[4];
+    if (update_method_str == "update_offset_each_cell") {
+      param.update_method = AccelBrakeMapEstimator::UPDATE_METHOD::UPDATE_OFFSET_EACH_CELL;
+    } else if (update_method_str == "update_offset_total") {
+      param.update_method = AccelBrakeMapEstimator::UPDATE_METHOD::UPDATE_OFFSET_TOTAL;
+    } else {
+      std::cerr << "update_method is wrong. (available method: update_offset_each_cell, "
+                   "update_offset_total)"
+                << std::endl;
+      return 1;
+    }
+  }
+
+  std::vector<CalibrationSample> samples;
+  if (!readCalibrationLog(log_file, &samples) || samples.empty()) {
+    std::cerr << "No sample in " << log_file << std::endl;
+    return 1;
+  }
+
+  // calibrate
+  AccelMap accel_map;
+  BrakeMap brake_map;
+  if (!readMap(original_map_dir, &accel_map, &brake_map)) {
+    return 1;
+  }
+  AccelBrakeMapEstimator estimator(param);
+  estimator.setMap(std::move(accel_map), std::move(brake_map));
+
+  const auto start = std::chrono::steady_clock::now();
+  for (const auto & sample : samples) {
+    estimator.update(sample);
+  }
+  const auto end = std::chrono::steady_clock::now();
+  const double replay_time = std::chrono::duration<double>(end - start).count();
+
+  const auto & counts = estimator.getCounts();
+  if (
+    counts.update_success == 0 ||
+    !AccelBrakeMapEstimator::writeMapToCSV(
+      estimator.getAccelVelIndex(), estimator.getAccelPedalIndex(),
+      estimator.getUpdateAccelMapValue(), calibrated_map_dir + "/accel_map.csv") ||
+    !AccelBrakeMapEstimator::writeMapToCSV(
+      estimator.getBrakeVelIndex(), estimator.getBrakePedalIndex(),
+      estimator.getUpdateBrakeMapValue(), calibrated_map_dir + "/brake_map.csv")) {
+    std::cerr << "Failed to output the calibrated map. update count: " << counts.update_success
+              << std::endl;
+    return 1;
+  }
+
+  // evaluate the original and the calibrated maps with all the samples
+  AccelBrakeMapEstimator::Param evaluation_param = param;
+  evaluation_param.full_mse_que_size = samples.size();
+  evaluation_param.part_mse_que_size = samples.size();
+  AccelMap original_accel_map;
+  BrakeMap original_brake_map;
+  AccelMap calibrated_accel_map;
+  BrakeMap calibrated_brake_map;
+  if (
+    !readMap(original_map_dir, &original_accel_map, &original_brake_map) ||
+    !readMap(calibrated_map_dir, &calibrated_accel_map, &calibrated_brake_map)) {
+    return 1;
+  }
+  AccelBrakeMapEstimator evaluator(evaluation_param);
+  evaluator.setMap(std::move(original_accel_map), std::move(original_brake_map));
+  evaluator.setNewMap(std::move(calibrated_accel_map), std::move(calibrated_brake_map));
+  for (const auto & sample : samples) {
+    evaluator.update(sample);
+  }
+
+  const double original_mse = evaluator.getFullOriginalAccelMSE();
+  const double calibrated_mse = evaluator.getNewAccelMSE();
+  std::cout << "samples: " << samples.size() << " (" << replay_time << " [s], "
+            << samples.size() / std::max(replay_time, 1e-9) << " [samples/s])" << std::endl
+            << "update success / fail: " << counts.update_success << " / " << counts.update_fail
+            << std::endl
+            << "too_low_speed_count: " << counts.too_low_speed << std::endl
+            << "too_large_pitch_count: " << counts.too_large_pitch << std::endl
+            << "too_large_steer_count: " << counts.too_large_steer << std::endl
+            << "too_large_jerk_count: " << counts.too_large_jerk << std::endl
+            << "invalid_acc_brake_count: " << counts.invalid_acc_brake << std::endl
+            << "too_large_pedal_spd_count: " << counts.too_large_pedal_spd << std::endl
+            << "original map error: " << original_mse << std::endl
+            << "calibrated map error: " << calibrated_mse << std::endl
+            << "map error ratio: " << (original_mse != 0.0 ? calibrated_mse / original_mse : 1.0)
+            << std::endl;
+  return 0;
+}
@@ -0,0 +1,72 @@
+//
+// Copyright 2021 Tier IV, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "accel_brake_map_calibrator/calibration_log.hpp"
+
+#include "raw_vehicle_cmd_converter/csv_loader.hpp"
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace
+{
+// columns of the calibration log
+enum LOG_COLUMN {
+  TIMESTAMP = 0,
+  VELOCITY = 1,
+  FINAL_ACCEL = 4,
+  ACCEL_PEDAL = 5,
+  BRAKE_PEDAL = 6,
+  ACCEL_PEDAL_SPEED = 7,
+  BRAKE_PEDAL_SPEED = 8,
+  PITCH = 9,
+  STEER = 10,
+  JERK = 11,
+  NUM_COLUMNS = 12,
+};
+}  // namespace
+
+bool readCalibrationLog(const std::string & csv_path, std::vector<CalibrationSample> * samples)
+{
+  raw_vehicle_cmd_converter::CSVLoader csv(csv_path);
+  std::vector<std::vector<std::string>> table;
+  if (!csv.readCSV(table)) {
+    std::cerr << "Cannot open " << csv_path << std::endl;
+    return false;
+  }
+
+  // the first row is the header
+  for (std::size_t i = 1; i < table.size(); i++) {
+    const auto & row = table.at(i);
+    if (row.size() < NUM_COLUMNS) {
+      std::cerr << "Cannot read " << csv_path << ". Line " << i + 1 << " should have at least "
+                << NUM_COLUMNS << " columns" << std::endl;
+      return false;
+    }
+    CalibrationSample sample;
+    sample.velocity = std::stod(row.at(VELOCITY));
+    sample.measured_acc = std::stod(row.at(FINAL_ACCEL));
+    sample.accel_pedal = std::stod(row.at(ACCEL_PEDAL));
+    sample.brake_pedal = std::stod(row.at(BRAKE_PEDAL));
+    sample.accel_pedal_speed = std::stod(row.at(ACCEL_PEDAL_SPEED));
+    sample.brake_pedal_speed = std::stod(row.at(BRAKE_PEDAL_SPEED));
+    sample.pitch = std::stod(row.at(PITCH));
+    sample.steer = std::stod(row.at(STEER));
+    sample.jerk = std::stod(row.at(JERK));
+    samples->push_back(sample);
+  }
+  return true;
+}
@@ -0,0 +1,216 @@
+//
+// Copyright 2021 Tier IV, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "accel_brake_map_calibrator/accel_brake_map_estimator.hpp"
+#include "accel_brake_map_calibrator/calibration_log.hpp"
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace
+{
+constexpr double epsilon = 1e-9;
+
+AccelBrakeMapEstimator createEstimator(const int update_method)
+{
+  AccelBrakeMapEstimator::Param param;
+  param.update_method = update_method;
+  AccelBrakeMapEstimator estimator(param);
+
+  AccelMap accel_map;
+  BrakeMap brake_map;
+  EXPECT_TRUE(accel_map.readAccelMapFromCSV(std::string(TEST_DATA_DIR) + "/accel_map.csv"));
+  EXPECT_TRUE(brake_map.readBrakeMapFromCSV(std::string(TEST_DATA_DIR) + "/brake_map.csv"));
+  estimator.setMap(std::move(accel_map), std::move(brake_map));
+  return estimator;
+}
+
+CalibrationSample createSample(
+  const double velocity, const double measured_acc, const double accel_pedal,
+  const double brake_pedal)
+{
+  CalibrationSample sample{};
+  sample.velocity = velocity;
+  sample.measured_acc = measured_acc;
+  sample.accel_pedal = accel_pedal;
+  sample.brake_pedal = brake_pedal;
+  return sample;
+}
+
+// offset after the recursive least squares is updated num times with the same map error
+double calcExpectedOffset(const int num, const double map_error)
+{
+  const AccelBrakeMapEstimator::Param param;
+  const double forgetting_factor = param.forgetting_factor;
+  double covariance = param.initial_covariance;
+  double offset = 0.0;
+  for (int i = 0; i < num; ++i) {
+    covariance =
+      (covariance - covariance * covariance / (forgetting_factor + covariance)) / forgetting_factor;
+    const double coef = covariance / (forgetting_factor + covariance);
+    offset += coef * (map_error - offset);
+  }
+  return offset;
+}
+}  // namespace
+
+TEST(AccelBrakeMapEstimator, UpdateEachCell)
+{
+  auto estimator = createEstimator(AccelBrakeMapEstimator::UPDATE_OFFSET_EACH_CELL);
+  const auto original_accel_map = estimator.getAccelMapValue();
+  const auto original_brake_map = estimator.getBrakeMapValue();
+
+  // accel pedal 0.5 at 5.0 m/s, whose map value is 0.8
+  const auto sample = createSample(5.0, 0.9, 0.5, 0.0);
+  ASSERT_TRUE(estimator.update(sample));
+  EXPECT_NEAR(
+    estimator.getUpdateAccelMapValue().at(1).at(1), 0.8 + calcExpectedOffset(1, 0.1), epsilon);
+
+  for (int i = 1; i < 1000; ++i) {
+    ASSERT_TRUE(estimator.update(sample));
+  }
+  const double updated_value = estimator.getUpdateAccelMapValue().at(1).at(1);
+  EXPECT_NEAR(updated_value, 0.8 + calcExpectedOffset(1000, 0.1), epsilon);
+  EXPECT_NEAR(updated_value, 0.9, 0.01);
+
+  // the other cells are not updated
+  auto expected_accel_map = original_accel_map;
+  expected_accel_map.at(1).at(1) = updated_value;
+  EXPECT_EQ(estimator.getUpdateAccelMapValue(), expected_accel_map);
+  EXPECT_EQ(estimator.getUpdateBrakeMapValue(), original_brake_map);
+
+  EXPECT_EQ(estimator.getCounts().update_success, 1000);
+  const int unified_index = estimator.getUnifiedIndexFromAccelBrakeIndex(true, 1);
+  EXPECT_EQ(estimator.getMapValueData().at(unified_index).at(1).size(), 1000U);
+}
+
+TEST(AccelBrakeMapEstimator, UpdateTotal)
+{
+  auto estimator = createEstimator(AccelBrakeMapEstimator::UPDATE_OFFSET_TOTAL);
+  const auto original_accel_map = estimator.getAccelMapValue();
+  const auto original_brake_map = estimator.getBrakeMapValue();
+
+  // brake pedal 0.5 at 10.0 m/s, whose map value is -1.4
+  ASSERT_TRUE(estimator.update(createSample(10.0, -1.3, 0.0, 0.5)));
+  const double offset = calcExpectedOffset(1, 0.1);
+
+  // all the cells but the last pedal and the last velocity are shifted by the offset
+  for (size_t ped = 0; ped < original_accel_map.size(); ++ped) {
+    for (size_t vel = 0; vel < original_accel_map.at(ped).size(); ++vel) {
+      const bool is_shifted = ped + 1 < original_accel_map.size() &&
+                              vel + 1 < original_accel_map.at(ped).size();
+      EXPECT_NEAR(
+        estimator.getUpdateAccelMapValue().at(ped).at(vel),
+        original_accel_map.at(ped).at(vel) + (is_shifted ? offset : 0.0), epsilon);
+    }
+  }
+  for (size_t ped = 0; ped < original_brake_map.size(); ++ped) {
+    for (size_t vel = 0; vel < original_brake_map.at(ped).size(); ++vel) {
+      const bool is_shifted = ped + 1 < original_brake_map.size() &&
+                              vel + 1 < original_brake_map.at(ped).size();
+      EXPECT_NEAR(
+        estimator.getUpdateBrakeMapValue().at(ped).at(vel),
+        original_brake_map.at(ped).at(vel) + (is_shifted ? offset : 0.0), epsilon);
+    }
+  }
+}
+
+TEST(AccelBrakeMapEstimator, InvalidSamples)
+{
+  auto estimator = createEstimator(AccelBrakeMapEstimator::UPDATE_OFFSET_EACH_CELL);
+
+  EXPECT_FALSE(estimator.update(createSample(0.05, 0.9, 0.5, 0.0)));
+  auto large_pitch_sample = createSample(5.0, 0.9, 0.5, 0.0);
+  large_pitch_sample.pitch = 0.1;
+  EXPECT_FALSE(estimator.update(large_pitch_sample));
+  EXPECT_FALSE(estimator.update(createSample(5.0, 0.9, 0.5, 0.5)));
+  // no pedal value in the index near 0.25
+  EXPECT_FALSE(estimator.update(createSample(5.0, 0.9, 0.25, 0.0)));
+
+  const auto & counts = estimator.getCounts();
+  EXPECT_EQ(counts.too_low_speed, 1);
+  EXPECT_EQ(counts.too_large_pitch, 1);
+  EXPECT_EQ(counts.invalid_acc_brake, 1);
+  EXPECT_EQ(counts.update_fail, 1);
+  EXPECT_EQ(counts.update_success, 0);
+  EXPECT_EQ(estimator.getUpdateAccelMapValue(), estimator.getAccelMapValue());
+}
+
+TEST(AccelBrakeMapEstimator, Reset)
+{
+  auto estimator = createEstimator(AccelBrakeMapEstimator::UPDATE_OFFSET_EACH_CELL);
+  const auto sample = createSample(5.0, 0.9, 0.5, 0.0);
+  ASSERT_TRUE(estimator.update(sample));
+  const auto first_updated_map = estimator.getUpdateAccelMapValue();
+  for (int i = 0; i < 10; ++i) {
+    ASSERT_TRUE(estimator.update(sample));
+  }
+
+  estimator.reset();
+  EXPECT_EQ(estimator.getUpdateAccelMapValue(), estimator.getAccelMapValue());
+  EXPECT_EQ(estimator.getUpdateBrakeMapValue(), estimator.getBrakeMapValue());
+  EXPECT_EQ(estimator.getCounts().update_success, 0);
+  for (const auto & data_row : estimator.getMapValueData()) {
+    for (const auto & data : data_row) {
+      EXPECT_TRUE(data.empty());
+    }
+  }
+
+  // the covariance is also reset
+  ASSERT_TRUE(estimator.update(sample));
+  EXPECT_EQ(estimator.getUpdateAccelMapValue(), first_updated_map);
+}
+
+TEST(AccelBrakeMapEstimator, ReplayCalibrationLog)
+{
+  std::vector<CalibrationSample> samples;
+  ASSERT_TRUE(readCalibrationLog(std::string(TEST_DATA_DIR) + "/calibration_log.csv", &samples));
+  ASSERT_EQ(samples.size(), 18U);
+
+  auto estimator = createEstimator(AccelBrakeMapEstimator::UPDATE_OFFSET_EACH_CELL);
+  for (const auto & sample : samples) {
+    estimator.update(sample);
+  }
+
+  // 10 samples at accel pedal 0.5 and 5.0 m/s, and 5 samples at brake pedal 0.5 and 10.0 m/s
+  auto expected_accel_map = estimator.getAccelMapValue();
+  expected_accel_map.at(1).at(1) += calcExpectedOffset(10, 0.1);
+  auto expected_brake_map = estimator.getBrakeMapValue();
+  expected_brake_map.at(1).at(2) += calcExpectedOffset(5, 0.1);
+  for (size_t ped = 0; ped < expected_accel_map.size(); ++ped) {
+    for (size_t vel = 0; vel < expected_accel_map.at(ped).size(); ++vel) {
+      EXPECT_NEAR(
+        estimator.getUpdateAccelMapValue().at(ped).at(vel), expected_accel_map.at(ped).at(vel),
+        epsilon);
+      EXPECT_NEAR(
+        estimator.getUpdateBrakeMapValue().at(ped).at(vel), expected_brake_map.at(ped).at(vel),
+        epsilon);
+    }
+  }
+
+  const auto & counts = estimator.getCounts();
+  EXPECT_EQ(counts.update_success, 15);
+  EXPECT_EQ(counts.update_fail, 1);
+  EXPECT_EQ(counts.too_low_speed, 1);
+  EXPECT_EQ(counts.too_large_pitch, 1);
+
+  // an unreadable log
+  std::vector<CalibrationSample> no_samples;
+  EXPECT_FALSE(readCalibrationLog(std::string(TEST_DATA_DIR) + "/accel_map.csv", &no_samples));
+  EXPECT_FALSE(readCalibrationLog(std::string(TEST_DATA_DIR) + "/not_exist.csv", &no_samples));
+}
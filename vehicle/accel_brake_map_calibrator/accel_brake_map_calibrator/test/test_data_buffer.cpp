@@ -0,0 +1,141 @@
+//
+// Copyright 2021 Tier IV, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "accel_brake_map_calibrator/data_buffer.hpp"
+
+#include <gtest/gtest.h>
+
+#include <numeric>
+#include <vector>
+
+TEST(DataBuffer, RingBuffer)
+{
+  RingBuffer<int> buffer(3);
+  EXPECT_TRUE(buffer.empty());
+  EXPECT_EQ(buffer.capacity(), 3U);
+
+  buffer.push(1);
+  buffer.push(2);
+  EXPECT_EQ(buffer.size(), 2U);
+  EXPECT_FALSE(buffer.full());
+  EXPECT_EQ(buffer.front(), 1);
+  EXPECT_EQ(buffer.back(), 2);
+
+  // the oldest ones are overwritten
+  for (int i = 3; i <= 5; ++i) {
+    buffer.push(i);
+  }
+  EXPECT_TRUE(buffer.full());
+  EXPECT_EQ(buffer.size(), 3U);
+  EXPECT_EQ(buffer[0], 3);
+  EXPECT_EQ(buffer[1], 4);
+  EXPECT_EQ(buffer[2], 5);
+
+  buffer.clear();
+  EXPECT_TRUE(buffer.empty());
+  buffer.push(6);
+  EXPECT_EQ(buffer.front(), 6);
+  EXPECT_EQ(buffer.back(), 6);
+
+  // nothing is stored without capacity
+  RingBuffer<int> zero_capacity_buffer(0);
+  zero_capacity_buffer.push(1);
+  EXPECT_TRUE(zero_capacity_buffer.empty());
+}
+
+TEST(DataBuffer, StampedDataBufferNearest)
+{
+  StampedDataBuffer buffer(10);
+  buffer.push(0.0, 10.0);
+  buffer.push(1.0, 11.0);
+  buffer.push(1.0, 12.0);
+  buffer.push(2.0, 13.0);
+
+  EXPECT_EQ(buffer.getNearest(-1.0).value, 10.0);
+  EXPECT_EQ(buffer.getNearest(0.2).value, 10.0);
+  EXPECT_EQ(buffer.getNearest(1.8).value, 13.0);
+  EXPECT_EQ(buffer.getNearest(5.0).value, 13.0);
+
+  // the oldest one of the equally near samples
+  EXPECT_EQ(buffer.getNearest(0.5).value, 10.0);
+  EXPECT_EQ(buffer.getNearest(1.0).value, 11.0);
+  EXPECT_EQ(buffer.getNearest(1.5).value, 11.0);
+}
+
+TEST(DataBuffer, StampedDataBufferOverwrite)
+{
+  StampedDataBuffer buffer(3);
+  for (int i = 0; i < 5; ++i) {
+    buffer.push(i, 10.0 + i);
+  }
+  EXPECT_EQ(buffer.size(), 3U);
+  EXPECT_EQ(buffer.getNearest(0.0).value, 12.0);
+  EXPECT_EQ(buffer.back().time, 4.0);
+}
+
+TEST(DataBuffer, StampedDataBufferTimeGoesBack)
+{
+  StampedDataBuffer buffer(10);
+  buffer.push(10.0, 1.0);
+  buffer.push(11.0, 2.0);
+
+  // e.g. the rosbag is played again
+  buffer.push(0.5, 3.0);
+  EXPECT_EQ(buffer.size(), 1U);
+  EXPECT_EQ(buffer.getNearest(10.0).value, 3.0);
+
+  // the same time is not regarded as going back
+  buffer.push(0.5, 4.0);
+  EXPECT_EQ(buffer.size(), 2U);
+}
+
+TEST(DataBuffer, MovingAverage)
+{
+  MovingAverage average(3);
+  EXPECT_EQ(average.size(), 0U);
+  EXPECT_EQ(average.average(), 0.0);
+
+  average.push(1.0);
+  average.push(2.0);
+  EXPECT_DOUBLE_EQ(average.average(), 1.5);
+  average.push(3.0);
+  EXPECT_DOUBLE_EQ(average.average(), 2.0);
+  average.push(7.0);
+  EXPECT_EQ(average.size(), 3U);
+  EXPECT_DOUBLE_EQ(average.average(), 4.0);
+
+  // the same as the average of the latest values after the sum is recomputed many times
+  std::vector<double> values;
+  for (int i = 0; i < 100; ++i) {
+    values.push_back(0.1 * i * i);
+    average.push(values.back());
+  }
+  const double expected = std::accumulate(values.end() - 3, values.end(), 0.0) / 3.0;
+  EXPECT_NEAR(average.average(), expected, 1e-9);
+}
+
+TEST(DataBuffer, MovingAverageZeroCapacity)
+{
+  // treated as one value
+  MovingAverage average(0);
+  EXPECT_EQ(average.average(), 0.0);
+
+  average.push(1.0);
+  EXPECT_EQ(average.size(), 1U);
+  EXPECT_DOUBLE_EQ(average.average(), 1.0);
+  average.push(5.0);
+  EXPECT_EQ(average.size(), 1U);
+  EXPECT_DOUBLE_EQ(average.average(), 5.0);
+}
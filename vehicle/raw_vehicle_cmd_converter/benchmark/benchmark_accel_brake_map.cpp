@@ -0,0 +1,242 @@
+//  Copyright 2021 Tier IV, Inc. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+
+#include "raw_vehicle_cmd_converter/actuation_map_grid.hpp"
+#include "raw_vehicle_cmd_converter/interpolate.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+namespace
+{
+using raw_vehicle_cmd_converter::ActuationMapGrid;
+using raw_vehicle_cmd_converter::LinearInterpolate;
+
+constexpr size_t num_query = 10000;
+
+// data/default/accel_map.csv and data/default/brake_map.csv
+const std::vector<double> vel_index = {0.0,  1.39, 2.78, 4.17,  5.56, 6.94,
+                                       8.33, 9.72, 11.11, 12.50, 13.89};
+const std::vector<double> throttle_index = {0.0, 0.1, 0.2, 0.3, 0.4, 0.5};
+const std::vector<std::vector<double>> accel_map = {
+  {0.3, -0.05, -0.3, -0.39, -0.4, -0.41, -0.42, -0.44, -0.46, -0.48, -0.5},
+  {0.6, 0.42, 0.24, 0.18, 0.12, 0.05, -0.08, -0.16, -0.2, -0.24, -0.28},
+  {1.15, 0.98, 0.78, 0.6, 0.48, 0.34, 0.26, 0.2, 0.1, 0.05, -0.03},
+  {1.75, 1.6, 1.42, 1.3, 1.14, 1, 0.9, 0.8, 0.72, 0.64, 0.58},
+  {2.65, 2.48, 2.3, 2.13, 1.95, 1.75, 1.58, 1.45, 1.32, 1.2, 1.1},
+  {3.3, 3.25, 3.12, 2.92, 2.68, 2.35, 2.17, 1.98, 1.88, 1.73, 1.61}};
+const std::vector<double> brake_index = {0.0, 0.1, 0.2, 0.3, 0.4, 0.5, 0.6, 0.7, 0.8};
+const std::vector<std::vector<double>> brake_map = {
+  {0.3, -0.05, -0.3, -0.39, -0.4, -0.41, -0.42, -0.44, -0.46, -0.48, -0.5},
+  {0.29, -0.06, -0.31, -0.4, -0.41, -0.42, -0.43, -0.45, -0.47, -0.49, -0.51},
+  {-0.38, -0.4, -0.72, -0.8, -0.82, -0.85, -0.87, -0.89, -0.91, -0.94, -0.96},
+  {-1, -1.04, -1.48, -1.55, -1.57, -1.59, -1.61, -1.63, -1.631, -1.632, -1.633},
+  {-1.48, -1.5, -1.85, -2.05, -2.1, -2.101, -2.102, -2.103, -2.104, -2.105, -2.106},
+  {-1.49, -1.51, -1.86, -2.06, -2.11, -2.111, -2.112, -2.113, -2.114, -2.115, -2.116},
+  {-1.5, -1.52, -1.87, -2.07, -2.12, -2.121, -2.122, -2.123, -2.124, -2.125, -2.126},
+  {-1.51, -1.53, -1.88, -2.08, -2.13, -2.131, -2.132, -2.133, -2.134, -2.135, -2.136},
+  {-2.18, -2.2, -2.7, -2.8, -2.9, -2.95, -2.951, -2.952, -2.953, -2.954, -2.955}};
+
+double clampVelocity(const double vel)
+{
+  return std::min(std::max(vel, vel_index.front()), vel_index.back());
+}
+
+// the lookups of AccelMap and BrakeMap before the maps were compiled into ActuationMapGrid
+std::vector<double> interpolateRows(const std::vector<std::vector<double>> & map, const double vel)
+{
+  std::vector<double> accs_interpolated;
+  for (std::vector<double> accs : map) {
+    double acc_interpolated;
+    LinearInterpolate::interpolate(vel_index, accs, vel, acc_interpolated);
+    accs_interpolated.push_back(acc_interpolated);
+  }
+  return accs_interpolated;
+}
+
+double getThrottleByRows(const double acc, const double vel)
+{
+  const auto accs_interpolated = interpolateRows(accel_map, clampVelocity(vel));
+  if (acc < accs_interpolated.front()) {
+    return -1.0;
+  } else if (accs_interpolated.back() < acc) {
+    return throttle_index.back();
+  }
+  double throttle;
+  LinearInterpolate::interpolate(accs_interpolated, throttle_index, acc, throttle);
+  return throttle;
+}
+
+double getBrakeByRows(const double acc, const double vel)
+{
+  auto accs_interpolated = interpolateRows(brake_map, clampVelocity(vel));
+  if (acc < accs_interpolated.back()) {
+    return brake_index.back();
+  } else if (accs_interpolated.front() < acc) {
+    return brake_index.front();
+  }
+  std::vector<double> brake_index_rev = brake_index;
+  std::reverse(brake_index_rev.begin(), brake_index_rev.end());
+  std::reverse(accs_interpolated.begin(), accs_interpolated.end());
+  double brake;
+  LinearInterpolate::interpolate(accs_interpolated, brake_index_rev, acc, brake);
+  return brake;
+}
+
+double getAccelerationByRows(const double throttle, const double vel)
+{
+  const auto accs_interpolated = interpolateRows(accel_map, clampVelocity(vel));
+  double acc;
+  LinearInterpolate::interpolate(throttle_index, accs_interpolated, throttle, acc);
+  return acc;
+}
+
+// the same as AccelMap and BrakeMap
+double getThrottleByGrid(const ActuationMapGrid & grid, const double acc, const double vel)
+{
+  if (acc < grid.getAccelerationOnRow(0, vel)) {
+    return -1.0;
+  } else if (grid.getAccelerationOnRow(grid.rows() - 1, vel) < acc) {
+    return throttle_index.back();
+  }
+  return grid.getPedal(acc, vel);
+}
+
+double getBrakeByGrid(const ActuationMapGrid & grid, const double acc, const double vel)
+{
+  if (acc < grid.getAccelerationOnRow(grid.rows() - 1, vel)) {
+    return brake_index.back();
+  } else if (grid.getAccelerationOnRow(0, vel) < acc) {
+    return brake_index.front();
+  }
+  return grid.getPedal(acc, vel);
+}
+
+struct Inputs
+{
+  std::vector<double> accs;
+  std::vector<double> vels;
+  std::vector<double> throttles;
+  ActuationMapGrid accel_grid;
+  ActuationMapGrid brake_grid;
+
+  Inputs()
+  {
+    std::mt19937 engine(0);
+    std::uniform_real_distribution<double> acc_dist(-3.5, 4.0);
+    std::uniform_real_distribution<double> vel_dist(-1.0, 15.0);
+    std::uniform_real_distribution<double> throttle_dist(0.0, 0.5);
+    for (size_t i = 0; i < num_query; ++i) {
+      accs.push_back(acc_dist(engine));
+      // some queries exactly on the velocity index
+      vels.push_back(i % 10 == 0 ? vel_index.at(i % vel_index.size()) : vel_dist(engine));
+      throttles.push_back(throttle_dist(engine));
+    }
+    accel_grid.setMap(throttle_index, vel_index, accel_map);
+    brake_grid.setMap(brake_index, vel_index, brake_map);
+  }
+};
+
+const Inputs & getInputs()
+{
+  static const Inputs inputs;
+  return inputs;
+}
+
+template <class Lookup>
+void runLookup(benchmark::State & state, Lookup && lookup)
+{
+  for (auto _ : state) {
+    for (size_t i = 0; i < num_query; ++i) {
+      benchmark::DoNotOptimize(lookup(i));
+    }
+  }
+}
+
+// the largest difference between the row by row lookup and ActuationMapGrid
+template <class Lookup, class Reference>
+double getMaxDiff(Lookup && lookup, Reference && reference)
+{
+  double max_diff = 0.0;
+  for (size_t i = 0; i < num_query; ++i) {
+    max_diff = std::max(max_diff, std::abs(lookup(i) - reference(i)));
+  }
+  return max_diff;
+}
+}  // namespace
+
+// acc -> throttle
+static void ThrottleByRows(benchmark::State & state)
+{
+  const auto & in = getInputs();
+  runLookup(state, [&in](const size_t i) { return getThrottleByRows(in.accs[i], in.vels[i]); });
+}
+BENCHMARK(ThrottleByRows);
+
+static void ThrottleByGrid(benchmark::State & state)
+{
+  const auto & in = getInputs();
+  const auto by_grid = [&in](const size_t i) {
+    return getThrottleByGrid(in.accel_grid, in.accs[i], in.vels[i]);
+  };
+  runLookup(state, by_grid);
+  state.counters["max_diff"] = getMaxDiff(
+    by_grid, [&in](const size_t i) { return getThrottleByRows(in.accs[i], in.vels[i]); });
+}
+BENCHMARK(ThrottleByGrid);
+
+// acc -> brake
+static void BrakeByRows(benchmark::State & state)
+{
+  const auto & in = getInputs();
+  runLookup(state, [&in](const size_t i) { return getBrakeByRows(in.accs[i], in.vels[i]); });
+}
+BENCHMARK(BrakeByRows);
+
+static void BrakeByGrid(benchmark::State & state)
+{
+  const auto & in = getInputs();
+  const auto by_grid = [&in](const size_t i) {
+    return getBrakeByGrid(in.brake_grid, in.accs[i], in.vels[i]);
+  };
+  runLookup(state, by_grid);
+  state.counters["max_diff"] =
+    getMaxDiff(by_grid, [&in](const size_t i) { return getBrakeByRows(in.accs[i], in.vels[i]); });
+}
+BENCHMARK(BrakeByGrid);
+
+// throttle -> acc
+static void AccelerationByRows(benchmark::State & state)
+{
+  const auto & in = getInputs();
+  runLookup(
+    state, [&in](const size_t i) { return getAccelerationByRows(in.throttles[i], in.vels[i]); });
+}
+BENCHMARK(AccelerationByRows);
+
+static void AccelerationByGrid(benchmark::State & state)
+{
+  const auto & in = getInputs();
+  const auto by_grid = [&in](const size_t i) {
+    return in.accel_grid.getAcceleration(in.throttles[i], in.vels[i]);
+  };
+  runLookup(state, by_grid);
+  state.counters["max_diff"] = getMaxDiff(
+    by_grid, [&in](const size_t i) { return getAccelerationByRows(in.throttles[i], in.vels[i]); });
+}
+BENCHMARK(AccelerationByGrid);
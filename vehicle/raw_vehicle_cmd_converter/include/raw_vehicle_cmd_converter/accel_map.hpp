@@ -15,6 +15,7 @@
 #ifndef RAW_VEHICLE_CMD_CONVERTER__ACCEL_MAP_HPP_
 #define RAW_VEHICLE_CMD_CONVERTER__ACCEL_MAP_HPP_
 
+#include "raw_vehicle_cmd_converter/actuation_map_grid.hpp"
 #include "raw_vehicle_cmd_converter/csv_loader.hpp"
 #include "raw_vehicle_cmd_converter/interpolate.hpp"
 
@@ -44,6 +45,9 @@ private:
   std::vector<double> vel_index_;
   std::vector<double> throttle_index_;
   std::vector<std::vector<double>> accel_map_;
+  ActuationMapGrid grid_;
+
+  double clampVelocity(const double vel);
 };
 }  // namespace raw_vehicle_cmd_converter
 
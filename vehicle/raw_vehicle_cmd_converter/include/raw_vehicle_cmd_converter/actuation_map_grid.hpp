@@ -0,0 +1,88 @@
+//  Copyright 2021 Tier IV, Inc. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+
+#ifndef RAW_VEHICLE_CMD_CONVERTER__ACTUATION_MAP_GRID_HPP_
+#define RAW_VEHICLE_CMD_CONVERTER__ACTUATION_MAP_GRID_HPP_
+
+#include <cstddef>
+#include <vector>
+
+namespace raw_vehicle_cmd_converter
+{
+/**
+ * @brief (pedal, vel) -> acc map compiled into a flat row-major grid (a row per pedal index and a
+ *        column per velocity index). A cell is found from the mean spacing of the index and the
+ *        lookups interpolate linearly in the same way as LinearInterpolate, without allocating.
+ */
+class ActuationMapGrid
+{
+public:
+  /**
+   * @brief compile the map. The pedal and velocity indices have to be strictly increasing.
+   * @return false if the indices or the size of the map are invalid
+   */
+  bool setMap(
+    const std::vector<double> & pedal_index, const std::vector<double> & vel_index,
+    const std::vector<std::vector<double>> & map);
+
+  bool empty() const { return acc_.empty(); }
+  size_t rows() const { return pedal_axis_.index.size(); }
+  size_t cols() const { return vel_axis_.index.size(); }
+
+  /**
+   * @brief acceleration of the pedal and the velocity. Both of them are clamped to the map.
+   */
+  double getAcceleration(const double pedal, const double vel) const;
+
+  /**
+   * @brief acceleration on the row of the pedal index at the velocity clamped to the map
+   */
+  double getAccelerationOnRow(const size_t row, const double vel) const;
+
+  /**
+   * @brief pedal with which the acceleration at the velocity becomes acc. The acceleration is
+   *        assumed to increase (accel map) or decrease (brake map) monotonically along the pedal,
+   *        and acc is clamped to the accelerations of the first and the last rows.
+   */
+  double getPedal(const double acc, const double vel) const;
+
+private:
+  struct Cell
+  {
+    size_t idx;  // upper index of the cell, or 0 when the query is on the first index
+    double dist_to_forward;
+    double dist_to_backward;
+  };
+
+  struct Axis
+  {
+    std::vector<double> index;
+    std::vector<double> spacing;  // spacing[i] = index[i] - index[i - 1]
+    double inv_mean_spacing{0.0};
+
+    bool set(const std::vector<double> & new_index);
+    double clamp(const double x) const;
+    Cell findCell(const double x) const;
+    double interpolate(const Cell & cell, const double v_backward, const double v_forward) const;
+  };
+
+  Axis pedal_axis_;
+  Axis vel_axis_;
+  std::vector<double> acc_;  // acc_[row * cols() + col]
+
+  double interpolateRow(const size_t row, const Cell & vel_cell) const;
+};
+}  // namespace raw_vehicle_cmd_converter
+
+#endif  // RAW_VEHICLE_CMD_CONVERTER__ACTUATION_MAP_GRID_HPP_
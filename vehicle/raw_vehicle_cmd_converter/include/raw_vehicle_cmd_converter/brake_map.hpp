@@ -15,6 +15,7 @@
 #ifndef RAW_VEHICLE_CMD_CONVERTER__BRAKE_MAP_HPP_
 #define RAW_VEHICLE_CMD_CONVERTER__BRAKE_MAP_HPP_
 
+#include "raw_vehicle_cmd_converter/actuation_map_grid.hpp"
 #include "raw_vehicle_cmd_converter/csv_loader.hpp"
 #include "raw_vehicle_cmd_converter/interpolate.hpp"
 
@@ -43,8 +44,10 @@ private:
   std::string vehicle_name_;
   std::vector<double> vel_index_;
   std::vector<double> brake_index_;
-  std::vector<double> brake_index_rev_;
   std::vector<std::vector<double>> brake_map_;
+  ActuationMapGrid grid_;
+
+  double clampVelocity(const double vel);
 };
 }  // namespace raw_vehicle_cmd_converter
 
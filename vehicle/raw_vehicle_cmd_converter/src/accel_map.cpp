@@ -57,82 +57,58 @@ bool AccelMap::readAccelMapFromCSV(std::string csv_path)
     accel_map_.push_back(accs);
   }
 
+  if (!grid_.setMap(throttle_index_, vel_index_, accel_map_)) {
+    RCLCPP_ERROR(
+      logger_, "Cannot read %s. Throttle and velocity should be strictly increasing",
+      csv_path.c_str());
+    return false;
+  }
+
   return true;
 }
 
-bool AccelMap::getThrottle(double acc, double vel, double & throttle)
+double AccelMap::clampVelocity(const double vel)
 {
-  LinearInterpolate linear_interp;
-  std::vector<double> accs_interpolated;
-
   if (vel < vel_index_.front()) {
     RCLCPP_WARN_SKIPFIRST_THROTTLE(
       logger_, clock_, 1000,
       "Exceeding the vel range. Current vel: %f < min vel on map: %f. Use min "
       "velocity.",
       vel, vel_index_.front());
-    vel = vel_index_.front();
+    return vel_index_.front();
   } else if (vel_index_.back() < vel) {
     RCLCPP_WARN_SKIPFIRST_THROTTLE(
       logger_, clock_, 1000,
       "Exceeding the vel range. Current vel: %f > max vel on map: %f. Use max "
       "velocity.",
       vel, vel_index_.back());
-    vel = vel_index_.back();
+    return vel_index_.back();
   }
+  return vel;
+}
 
-  // (throttle, vel, acc) map => (throttle, acc) map by fixing vel
-  for (std::vector<double> accs : accel_map_) {
-    double acc_interpolated;
-    linear_interp.interpolate(vel_index_, accs, vel, acc_interpolated);
-    accs_interpolated.push_back(acc_interpolated);
-  }
+bool AccelMap::getThrottle(double acc, double vel, double & throttle)
+{
+  vel = clampVelocity(vel);
 
   // calculate throttle
   // When the desired acceleration is smaller than the throttle area, return false => brake sequence
   // When the desired acceleration is greater than the throttle area, return max throttle
-  if (acc < accs_interpolated.front()) {
+  if (acc < grid_.getAccelerationOnRow(0, vel)) {
     return false;
-  } else if (accs_interpolated.back() < acc) {
+  } else if (grid_.getAccelerationOnRow(grid_.rows() - 1, vel) < acc) {
     throttle = throttle_index_.back();
     return true;
   }
-  linear_interp.interpolate(accs_interpolated, throttle_index_, acc, throttle);
+  throttle = grid_.getPedal(acc, vel);
 
   return true;
 }
 
 bool AccelMap::getAcceleration(double throttle, double vel, double & acc)
 {
-  LinearInterpolate linear_interp;
-  std::vector<double> accs_interpolated;
+  vel = clampVelocity(vel);
 
-  if (vel < vel_index_.front()) {
-    RCLCPP_WARN_SKIPFIRST_THROTTLE(
-      logger_, clock_, 1000,
-      "Exceeding the vel range. Current vel: %f < min vel on map: %f. Use min "
-      "velocity.",
-      vel, vel_index_.front());
-    vel = vel_index_.front();
-  } else if (vel_index_.back() < vel) {
-    RCLCPP_WARN_SKIPFIRST_THROTTLE(
-      logger_, clock_, 1000,
-      "Exceeding the vel range. Current vel: %f > max vel on map: %f. Use max "
-      "velocity.",
-      vel, vel_index_.back());
-    vel = vel_index_.back();
-  }
-
-  // (throttle, vel, acc) map => (throttle, acc) map by fixing vel
-  for (std::vector<double> accs : accel_map_) {
-    double acc_interpolated;
-    linear_interp.interpolate(vel_index_, accs, vel, acc_interpolated);
-    accs_interpolated.push_back(acc_interpolated);
-  }
-
-  // calculate throttle
-  // When the desired acceleration is smaller than the throttle area, return false => brake sequence
-  // When the desired acceleration is greater than the throttle area, return max throttle
   const double max_throttle = throttle_index_.back();
   const double min_throttle = throttle_index_.front();
   if (throttle < min_throttle || max_throttle < throttle) {
@@ -141,7 +117,7 @@ bool AccelMap::getAcceleration(double throttle, double vel, double & acc)
     throttle = std::min(std::max(throttle, min_throttle), max_throttle);
   }
 
-  linear_interp.interpolate(throttle_index_, accs_interpolated, throttle, acc);
+  acc = grid_.getAcceleration(throttle, vel);
 
   return true;
 }
@@ -0,0 +1,148 @@
+//  Copyright 2021 Tier IV, Inc. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+
+#include "raw_vehicle_cmd_converter/actuation_map_grid.hpp"
+
+#include <algorithm>
+#include <vector>
+
+namespace raw_vehicle_cmd_converter
+{
+bool ActuationMapGrid::Axis::set(const std::vector<double> & new_index)
+{
+  if (new_index.empty()) {
+    return false;
+  }
+  for (size_t i = 1; i < new_index.size(); ++i) {
+    if (!(new_index[i - 1] < new_index[i])) {
+      return false;
+    }
+  }
+
+  index = new_index;
+  spacing.assign(index.size(), 0.0);
+  for (size_t i = 1; i < index.size(); ++i) {
+    spacing[i] = index[i] - index[i - 1];
+  }
+  inv_mean_spacing =
+    index.size() < 2 ? 0.0 : static_cast<double>(index.size() - 1) / (index.back() - index.front());
+  return true;
+}
+
+double ActuationMapGrid::Axis::clamp(const double x) const
+{
+  return std::min(std::max(x, index.front()), index.back());
+}
+
+ActuationMapGrid::Cell ActuationMapGrid::Axis::findCell(const double x) const
+{
+  // x is on the first index (or NaN)
+  if (!(index.front() < x)) {
+    return Cell{0, 0.0, 0.0};
+  }
+
+  // guess the cell from the mean spacing and correct it by the neighboring indices, so that the
+  // cell is the same as the linear walk of LinearInterpolate: the first i with x <= index[i]
+  size_t i = std::min(
+    static_cast<size_t>((x - index.front()) * inv_mean_spacing) + 1, index.size() - 1);
+  while (x <= index[i - 1]) {
+    --i;
+  }
+  while (index[i] < x && i + 1 < index.size()) {
+    ++i;
+  }
+  return Cell{i, index[i] - x, x - index[i - 1]};
+}
+
+double ActuationMapGrid::Axis::interpolate(
+  const Cell & cell, const double v_backward, const double v_forward) const
+{
+  if (cell.idx == 0) {
+    return v_forward;
+  }
+  return (cell.dist_to_backward * v_forward + cell.dist_to_forward * v_backward) /
+         spacing[cell.idx];
+}
+
+bool ActuationMapGrid::setMap(
+  const std::vector<double> & pedal_index, const std::vector<double> & vel_index,
+  const std::vector<std::vector<double>> & map)
+{
+  acc_.clear();
+  if (!pedal_axis_.set(pedal_index) || !vel_axis_.set(vel_index) || map.size() != rows()) {
+    return false;
+  }
+
+  acc_.reserve(rows() * cols());
+  for (const auto & accs : map) {
+    if (accs.size() != cols()) {
+      acc_.clear();
+      return false;
+    }
+    acc_.insert(acc_.end(), accs.begin(), accs.end());
+  }
+  return true;
+}
+
+double ActuationMapGrid::interpolateRow(const size_t row, const Cell & vel_cell) const
+{
+  const double * accs = &acc_[row * cols()];
+  return vel_axis_.interpolate(
+    vel_cell, vel_cell.idx == 0 ? accs[0] : accs[vel_cell.idx - 1], accs[vel_cell.idx]);
+}
+
+double ActuationMapGrid::getAccelerationOnRow(const size_t row, const double vel) const
+{
+  return interpolateRow(row, vel_axis_.findCell(vel_axis_.clamp(vel)));
+}
+
+double ActuationMapGrid::getAcceleration(const double pedal, const double vel) const
+{
+  const Cell vel_cell = vel_axis_.findCell(vel_axis_.clamp(vel));
+  const Cell pedal_cell = pedal_axis_.findCell(pedal_axis_.clamp(pedal));
+  if (pedal_cell.idx == 0) {
+    return interpolateRow(0, vel_cell);
+  }
+  return pedal_axis_.interpolate(
+    pedal_cell, interpolateRow(pedal_cell.idx - 1, vel_cell),
+    interpolateRow(pedal_cell.idx, vel_cell));
+}
+
+double ActuationMapGrid::getPedal(const double acc, const double vel) const
+{
+  const Cell vel_cell = vel_axis_.findCell(vel_axis_.clamp(vel));
+
+  // walk the rows in the order of increasing acceleration
+  const size_t n = rows();
+  const bool is_increasing = interpolateRow(0, vel_cell) <= interpolateRow(n - 1, vel_cell);
+  const auto row_at = [&](const size_t k) { return is_increasing ? k : n - 1 - k; };
+
+  double acc_prev = interpolateRow(row_at(0), vel_cell);
+  if (!(acc_prev < acc)) {
+    return pedal_axis_.index[row_at(0)];
+  }
+  for (size_t k = 1; k < n; ++k) {
+    const double acc_k = interpolateRow(row_at(k), vel_cell);
+    if (acc <= acc_k) {
+      const double dist_to_forward = acc_k - acc;
+      const double dist_to_backward = acc - acc_prev;
+      return (dist_to_backward * pedal_axis_.index[row_at(k)] +
+              dist_to_forward * pedal_axis_.index[row_at(k - 1)]) /
+             (acc_k - acc_prev);
+    }
+    acc_prev = acc_k;
+  }
+  return pedal_axis_.index[row_at(n - 1)];
+}
+}  // namespace raw_vehicle_cmd_converter
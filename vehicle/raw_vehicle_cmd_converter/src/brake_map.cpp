@@ -55,93 +55,65 @@ bool BrakeMap::readBrakeMapFromCSV(std::string csv_path)
     brake_map_.push_back(accs);
   }
 
-  brake_index_rev_ = brake_index_;
-  std::reverse(std::begin(brake_index_rev_), std::end(brake_index_rev_));
+  if (!grid_.setMap(brake_index_, vel_index_, brake_map_)) {
+    RCLCPP_ERROR(
+      logger_, "Cannot read %s. Brake and velocity should be strictly increasing",
+      csv_path.c_str());
+    return false;
+  }
 
   return true;
 }
 
-bool BrakeMap::getBrake(double acc, double vel, double & brake)
+double BrakeMap::clampVelocity(const double vel)
 {
-  LinearInterpolate linear_interp;
-  std::vector<double> accs_interpolated;
-
   if (vel < vel_index_.front()) {
     RCLCPP_WARN_SKIPFIRST_THROTTLE(
       logger_, clock_, 1000,
       "Exceeding the vel range. Current vel: %f < min vel on map: %f. Use min "
       "velocity.",
       vel, vel_index_.front());
-    vel = vel_index_.front();
+    return vel_index_.front();
   } else if (vel_index_.back() < vel) {
     RCLCPP_WARN_SKIPFIRST_THROTTLE(
       logger_, clock_, 1000,
       "Exceeding the vel range. Current vel: %f > max vel on map: %f. Use max "
       "velocity.",
       vel, vel_index_.back());
-    vel = vel_index_.back();
+    return vel_index_.back();
   }
+  return vel;
+}
 
-  // (throttle, vel, acc) map => (throttle, acc) map by fixing vel
-  for (std::vector<double> accs : brake_map_) {
-    double acc_interpolated;
-    linear_interp.interpolate(vel_index_, accs, vel, acc_interpolated);
-    accs_interpolated.push_back(acc_interpolated);
-  }
+bool BrakeMap::getBrake(double acc, double vel, double & brake)
+{
+  vel = clampVelocity(vel);
 
   // calculate brake
   // When the desired acceleration is smaller than the brake area, return max brake on the map
   // When the desired acceleration is greater than the brake area, return min brake on the map
-  if (acc < accs_interpolated.back()) {
+  const double min_acc = grid_.getAccelerationOnRow(grid_.rows() - 1, vel);
+  if (acc < min_acc) {
     RCLCPP_WARN_SKIPFIRST_THROTTLE(
       logger_, clock_, 1000,
       "Exceeding the acc range. Desired acc: %f < min acc on map: %f. return max "
       "value.",
-      acc, accs_interpolated.back());
+      acc, min_acc);
     brake = brake_index_.back();
     return true;
-  } else if (accs_interpolated.front() < acc) {
+  } else if (grid_.getAccelerationOnRow(0, vel) < acc) {
     brake = brake_index_.front();
     return true;
   }
-
-  std::reverse(std::begin(accs_interpolated), std::end(accs_interpolated));
-  linear_interp.interpolate(accs_interpolated, brake_index_rev_, acc, brake);
+  brake = grid_.getPedal(acc, vel);
 
   return true;
 }
 
 bool BrakeMap::getAcceleration(double brake, double vel, double & acc)
 {
-  LinearInterpolate linear_interp;
-  std::vector<double> accs_interpolated;
+  vel = clampVelocity(vel);
 
-  if (vel < vel_index_.front()) {
-    RCLCPP_WARN_SKIPFIRST_THROTTLE(
-      logger_, clock_, 1000,
-      "Exceeding the vel range. Current vel: %f < min vel on map: %f. Use min "
-      "velocity.",
-      vel, vel_index_.front());
-    vel = vel_index_.front();
-  } else if (vel_index_.back() < vel) {
-    RCLCPP_WARN_SKIPFIRST_THROTTLE(
-      logger_, clock_, 1000,
-      "Exceeding the vel range. Current vel: %f > max vel on map: %f. Use max "
-      "velocity.",
-      vel, vel_index_.back());
-    vel = vel_index_.back();
-  }
-
-  // (throttle, vel, acc) map => (throttle, acc) map by fixing vel
-  for (std::vector<double> accs : brake_map_) {
-    double acc_interpolated;
-    linear_interp.interpolate(vel_index_, accs, vel, acc_interpolated);
-    accs_interpolated.push_back(acc_interpolated);
-  }
-
-  // calculate brake
-  // When the desired acceleration is smaller than the brake area, return max brake on the map
-  // When the desired acceleration is greater than the brake area, return min brake on the map
   const double max_brake = brake_index_.back();
   const double min_brake = brake_index_.front();
   if (brake < min_brake || max_brake < brake) {
@@ -150,7 +122,7 @@ bool BrakeMap::getAcceleration(double brake, double vel, double & acc)
     brake = std::min(std::max(brake, min_brake), max_brake);
   }
 
-  linear_interp.interpolate(brake_index_, accs_interpolated, brake, acc);
+  acc = grid_.getAcceleration(brake, vel);
 
   return true;
 }